@@ -22,6 +22,7 @@ rm -rf generated
 mkdir -p generated/include generated/common
 
 python ../vk-generate.py Android dispatch-table-ops layer > generated/include/vk_dispatch_table_helper.h
+python ../vk-generate.py AllPlatforms proc-name-hash > generated/include/vk_proc_name_hash.h
 
 python ../vk_helper.py --gen_enum_string_helper ../include/vulkan/vulkan.h --abs_out_dir generated/include
 python ../vk_helper.py --gen_struct_wrappers ../include/vulkan/vulkan.h --abs_out_dir generated/include
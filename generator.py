@@ -375,6 +375,8 @@ class ThreadGeneratorOptions(GeneratorOptions):
 #     parameter on a separate line
 #   alignFuncParam - if nonzero and parameters are being put on a
 #     separate line, align parameter names at the specified column
+#   commands - if not None, the names of the only commands to generate
+#     checks for
 class ParamCheckerGeneratorOptions(GeneratorOptions):
     """Represents options during C interface generation for headers"""
     def __init__(self,
@@ -399,7 +401,8 @@ class ParamCheckerGeneratorOptions(GeneratorOptions):
                  indentFuncProto = True,
                  indentFuncPointer = False,
                  alignFuncParam = 0,
-                 genDirectory = None):
+                 genDirectory = None,
+                 commands = None):
         GeneratorOptions.__init__(self, filename, apiname, profile,
                                   versions, emitversions, defaultExtensions,
                                   addExtensions, removeExtensions, sortProcedure)
@@ -416,6 +419,7 @@ class ParamCheckerGeneratorOptions(GeneratorOptions):
         self.indentFuncPointer = indentFuncPointer
         self.alignFuncParam  = alignFuncParam
         self.genDirectory    = genDirectory
+        self.commands        = commands
 
 
 # OutputGenerator - base class for generating API interfaces.
@@ -2891,6 +2895,11 @@ class ParamCheckerOutputGenerator(OutputGenerator):
                                                         'condition', 'cdecl'])
         self.CommandData = namedtuple('CommandData', ['name', 'params', 'cdecl'])
         self.StructMemberData = namedtuple('StructMemberData', ['name', 'members'])
+        # Number of leading name string arguments each validate_* function takes, which its is_valid_* counterpart omits
+        self.fastPathNameArgs = { 'required_pointer' : 2, 'array' : 3, 'string_array' : 3, 'struct_type' : 3,
+                                  'struct_type_array' : 4, 'required_handle' : 2, 'handle_array' : 3, 'struct_pnext' : 3,
+                                  'bool32' : 2, 'ranged_enum' : 3, 'ranged_enum_array' : 4, 'reserved_flags' : 2,
+                                  'flags' : 3, 'flags_array' : 4 }
     #
     def incIndent(self, indent):
         inc = ' ' * self.INDENT_SPACES
@@ -3637,6 +3646,52 @@ class ParamCheckerOutputGenerator(OutputGenerator):
                 unused.append(value.name)
         return lines, unused
     #
+    # Split the arguments of a generated validate_* call, ignoring commas nested in parentheses, brackets, or strings
+    def splitCallArgs(self, args):
+        result = []
+        depth = 0
+        quoted = False
+        current = ''
+        for c in args:
+            if c == '"':
+                quoted = not quoted
+            elif not quoted and c in '([<{':
+                depth += 1
+            elif not quoted and c in ')]>}' and not current.endswith('-'):
+                depth -= 1
+            elif not quoted and depth == 0 and c == ',':
+                result.append(current.strip())
+                current = ''
+                continue
+            current += c
+        result.append(current.strip())
+        return result
+    #
+    # Convert the lines generated by genFuncBody into the equivalent is_valid_* checks, which take the same arguments
+    # minus report_data and the name strings that are only needed to format messages.  Returns None if the lines
+    # contain code that has no fast-path equivalent.
+    def genFastPathBody(self, lines):
+        fastLines = []
+        for line in lines:
+            subLines = line if type(line) is list else [line]
+            for sub in subLines:
+                for text in sub.splitlines(True):
+                    stripped = text.strip()
+                    if not stripped:
+                        continue
+                    match = re.match(r'(\s*)skipCall \|= validate_(\w+)\(report_data, (.*)\);$', text.rstrip('\n'))
+                    if match:
+                        func = match.group(2)
+                        if not func in self.fastPathNameArgs:
+                            return None
+                        args = self.splitCallArgs(match.group(3))[self.fastPathNameArgs[func]:]
+                        fastLines.append('{}valid &= is_valid_{}({});\n'.format(match.group(1), func, ', '.join(args)))
+                    elif stripped.startswith('if (') or stripped.startswith('for (') or stripped in ['{', '}']:
+                        fastLines.append(text if text.endswith('\n') else text + '\n')
+                    else:
+                        return None
+        return fastLines
+    #
     # Generate the struct member check code from the captured data
     def processStructMemberData(self):
         indent = self.incIndent(None)
@@ -3651,6 +3706,8 @@ class ParamCheckerOutputGenerator(OutputGenerator):
     def processCmdData(self):
         indent = self.incIndent(None)
         for command in self.commands:
+            if self.genOpts.commands is not None and command.name not in self.genOpts.commands:
+                continue
             # Skip first parameter if it is a dispatch handle (everything except vkCreateInstance)
             startIndex = 0 if command.name == 'vkCreateInstance' else 1
             lines, unused = self.genFuncBody(command.name, command.params[startIndex:], '', '', None)
@@ -3665,6 +3722,18 @@ class ParamCheckerOutputGenerator(OutputGenerator):
                         cmdDef += indent + 'UNUSED_PARAMETER({});\n'.format(name)
                     if len(unused) > 0:
                         cmdDef += '\n'
+                # The hot command buffer entrypoints check every parameter without referencing any message strings
+                # first, and only run the logging validation when one of those checks fails
+                fastLines = self.genFastPathBody(lines) if command.name.startswith('vkCmd') else None
+                if fastLines:
+                    cmdDef += indent + 'bool valid = true;\n'
+                    for line in fastLines:
+                        cmdDef += indent + line
+                    cmdDef += '\n'
+                    cmdDef += indent + 'if (valid) {\n'
+                    cmdDef += indent + indent + 'return false;\n'
+                    cmdDef += indent + '}\n'
+                    cmdDef += '\n'
                 cmdDef += indent + 'bool skipCall = false;\n'
                 for line in lines:
                     cmdDef += '\n'
@@ -32,6 +32,7 @@ dump    = False
 profile = False
 protect = True
 target  = None
+commands= None
 timeit  = False
 validate= False
 # Default input / log files
@@ -71,6 +72,10 @@ if __name__ == '__main__':
             outDir = sys.argv[i]
             i = i+1
             write('Using output directory ', outDir, file=sys.stderr)
+        elif (arg == '-commands'):
+            commands = sys.argv[i].split(',')
+            i = i+1
+            write('Only generating commands', ', '.join(commands), file=sys.stderr)
         elif (arg[0:1] == '-'):
             write('Unrecognized argument:', arg, file=sys.stderr)
             exit(1)
@@ -306,7 +311,8 @@ buildList = [
         apientry          = 'VKAPI_CALL ',
         apientryp         = 'VKAPI_PTR *',
         alignFuncParam    = 48,
-        genDirectory      = outDir)
+        genDirectory      = outDir,
+        commands          = commands)
     ],
     None
 ]
@@ -29,9 +29,110 @@
 #include "cmd_priv.h"
 #include "fb.h"
 
+/**
+ * Take an idle bo of \p size bytes from the pool, or return NULL.
+ */
+static struct intel_bo *cmd_pool_take_bo(struct intel_cmd_pool *pool,
+                                         size_t size)
+{
+    uint32_t i = pool->bo_used;
+
+    /* the most recently released bo is the most likely to be cached */
+    while (i--) {
+        struct intel_bo *bo = pool->bos[i].bo;
+
+        if (pool->bos[i].size != size)
+            continue;
+
+        pool->bo_cache_size -= size;
+        pool->bo_used--;
+        memmove(&pool->bos[i], &pool->bos[i + 1],
+                sizeof(pool->bos[0]) * (pool->bo_used - i));
+
+        return bo;
+    }
+
+    return NULL;
+}
+
+/**
+ * Give an unmapped writer bo of \p size bytes back to the pool.  The bo is
+ * freed when the pool has cached enough.
+ */
+static void cmd_pool_release_bo(struct intel_cmd_pool *pool,
+                                struct intel_bo *bo, size_t size)
+{
+    if (!bo)
+        return;
+
+    if (pool->bo_cache_size + size > INTEL_CMD_POOL_BO_CACHE_SIZE) {
+        intel_bo_unref(bo);
+        return;
+    }
+
+    if (pool->bo_used == pool->bo_alloc) {
+        const uint32_t new_alloc = (pool->bo_alloc) ? pool->bo_alloc << 1 : 16;
+        struct intel_cmd_pool_bo *bos;
+
+        bos = intel_alloc(pool, sizeof(pool->bos[0]) * new_alloc,
+                sizeof(int), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        if (!bos) {
+            intel_bo_unref(bo);
+            return;
+        }
+
+        if (pool->bo_used)
+            memcpy(bos, pool->bos, sizeof(pool->bos[0]) * pool->bo_used);
+        intel_free(pool, pool->bos);
+
+        pool->bos = bos;
+        pool->bo_alloc = new_alloc;
+    }
+
+    /* drop the references to the reloc targets now */
+    intel_bo_reset_relocs(bo);
+
+    pool->bos[pool->bo_used].bo = bo;
+    pool->bos[pool->bo_used].size = size;
+    pool->bo_used++;
+    pool->bo_cache_size += size;
+}
+
+static void cmd_pool_release_all_bos(struct intel_cmd_pool *pool)
+{
+    uint32_t i;
+
+    for (i = 0; i < pool->bo_used; i++)
+        intel_bo_unref(pool->bos[i].bo);
+
+    pool->bo_used = 0;
+    pool->bo_cache_size = 0;
+}
+
+/**
+ * Give the chained blocks of a writer back to the pool.
+ */
+static void cmd_writer_release_chain(struct intel_cmd *cmd,
+                                     enum intel_cmd_writer_type which)
+{
+    struct intel_cmd_writer *writer = &cmd->writers[which];
+    uint32_t i;
+
+    for (i = 0; i < writer->chain_used; i++) {
+        struct intel_cmd_writer_block *block = &writer->chain[i];
+
+        if (block->ptr)
+            intel_bo_unmap(block->bo);
+
+        cmd_pool_release_bo(cmd->pool, block->bo, writer->size);
+    }
+
+    writer->chain_used = 0;
+}
+
 /**
  * Free all resources used by a writer.  Note that the initial size is not
- * reset.
+ * reset.  The bos are kept by the pool for reuse.
  */
 static void cmd_writer_reset(struct intel_cmd *cmd,
                              enum intel_cmd_writer_type which)
@@ -43,11 +144,18 @@ static void cmd_writer_reset(struct intel_cmd *cmd,
         writer->ptr = NULL;
     }
 
-    intel_bo_unref(writer->bo);
+    cmd_pool_release_bo(cmd->pool, writer->bo, writer->size);
     writer->bo = NULL;
 
     writer->used = 0;
 
+    cmd_writer_release_chain(cmd, which);
+    if (writer->chain) {
+        intel_free(cmd, writer->chain);
+        writer->chain = NULL;
+        writer->chain_alloc = 0;
+    }
+
     writer->sba_offset = 0;
 
     if (writer->items) {
@@ -69,6 +177,8 @@ static void cmd_writer_discard(struct intel_cmd *cmd,
     intel_bo_truncate_relocs(writer->bo, 0);
     writer->used = 0;
     writer->item_used = 0;
+
+    cmd_writer_release_chain(cmd, which);
 }
 
 static struct intel_bo *alloc_writer_bo(struct intel_winsys *winsys,
@@ -85,6 +195,22 @@ static struct intel_bo *alloc_writer_bo(struct intel_winsys *winsys,
     return intel_winsys_alloc_bo(winsys, writer_names[which], size, true);
 }
 
+/**
+ * Get a bo for a writer, from the pool when possible.
+ */
+static struct intel_bo *cmd_writer_alloc_bo(struct intel_cmd *cmd,
+                                            enum intel_cmd_writer_type which,
+                                            size_t size)
+{
+    struct intel_bo *bo;
+
+    bo = cmd_pool_take_bo(cmd->pool, size);
+    if (!bo)
+        bo = alloc_writer_bo(cmd->dev->winsys, which, size);
+
+    return bo;
+}
+
 /**
  * Allocate and map the buffer for writing.
  */
@@ -94,9 +220,9 @@ static VkResult cmd_writer_alloc_and_map(struct intel_cmd *cmd,
     struct intel_cmd_writer *writer = &cmd->writers[which];
     struct intel_bo *bo;
 
-    bo = alloc_writer_bo(cmd->dev->winsys, which, writer->size);
+    bo = cmd_writer_alloc_bo(cmd, which, writer->size);
     if (bo) {
-        intel_bo_unref(writer->bo);
+        cmd_pool_release_bo(cmd->pool, writer->bo, writer->size);
         writer->bo = bo;
     } else if (writer->bo) {
         /* reuse the old bo */
@@ -123,14 +249,106 @@ static void cmd_writer_unmap(struct intel_cmd *cmd,
                              enum intel_cmd_writer_type which)
 {
     struct intel_cmd_writer *writer = &cmd->writers[which];
+    uint32_t i;
+
+    for (i = 0; i < writer->chain_used; i++) {
+        intel_bo_unmap(writer->chain[i].bo);
+        writer->chain[i].ptr = NULL;
+    }
 
     intel_bo_unmap(writer->bo);
     writer->ptr = NULL;
 }
 
 /**
- * Grow a mapped writer to at least \p new_size.  Failures are handled
- * silently.
+ * Continue a mapped writer in a new block of the same size, by ending the
+ * current block with an MI_BATCH_BUFFER_START.  The address of the command is
+ * patched in intel_cmd_end().  Failures are handled silently.
+ */
+static void cmd_writer_chain(struct intel_cmd *cmd,
+                             enum intel_cmd_writer_type which)
+{
+    struct intel_cmd_writer *writer = &cmd->writers[which];
+    struct intel_cmd_writer_block *block;
+    struct intel_bo *new_bo;
+    void *new_ptr;
+    uint32_t *dw;
+
+    assert(which == INTEL_CMD_WRITER_BATCH);
+
+    if (writer->chain_used == writer->chain_alloc) {
+        const uint32_t new_alloc = (writer->chain_alloc) ?
+            writer->chain_alloc << 1 : 8;
+        struct intel_cmd_writer_block *chain;
+
+        chain = intel_alloc(cmd, sizeof(writer->chain[0]) * new_alloc,
+                sizeof(int), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        if (!chain) {
+            cmd_writer_discard(cmd, which);
+            cmd_fail(cmd, VK_ERROR_OUT_OF_HOST_MEMORY);
+            return;
+        }
+
+        if (writer->chain_used) {
+            memcpy(chain, writer->chain,
+                    sizeof(writer->chain[0]) * writer->chain_used);
+        }
+        intel_free(cmd, writer->chain);
+
+        writer->chain = chain;
+        writer->chain_alloc = new_alloc;
+    }
+
+    new_bo = cmd_writer_alloc_bo(cmd, which, writer->size);
+    if (!new_bo) {
+        cmd_writer_discard(cmd, which);
+        cmd_fail(cmd, VK_ERROR_OUT_OF_DEVICE_MEMORY);
+        return;
+    }
+
+    new_ptr = intel_bo_map(new_bo, true);
+    if (!new_ptr) {
+        cmd_pool_release_bo(cmd->pool, new_bo, writer->size);
+        cmd_writer_discard(cmd, which);
+        cmd_fail(cmd, VK_ERROR_VALIDATION_FAILED_EXT);
+        return;
+    }
+
+    /* keep the block QWord aligned */
+    dw = (uint32_t *) ((char *) writer->ptr + writer->used);
+    if (writer->used & 0x7) {
+        *dw++ = GEN6_MI_CMD(MI_NOOP);
+        writer->used += 4;
+    }
+
+    /* a second level batch stays at the second level */
+    dw[0] = GEN6_MI_CMD(MI_BATCH_BUFFER_START) |
+            GEN6_MI_BATCH_BUFFER_START_DW0_USE_PPGTT;
+    if (cmd_gen(cmd) >= INTEL_GEN(7.5)) {
+        dw[0] |= GEN75_MI_BATCH_BUFFER_START_DW0_NON_PRIVILEGED;
+        if (!cmd->primary)
+            dw[0] |= GEN75_MI_BATCH_BUFFER_START_DW0_SECOND_LEVEL;
+    }
+    dw[1] = 0;
+    writer->used += 8;
+
+    assert(writer->used <= writer->size);
+
+    block = &writer->chain[writer->chain_used++];
+    block->bo = writer->bo;
+    block->ptr = writer->ptr;
+    block->used = writer->used;
+
+    writer->bo = new_bo;
+    writer->ptr = new_ptr;
+    writer->used = 0;
+}
+
+/**
+ * Grow a mapped writer to at least \p new_size.  The batch writer is chained
+ * to a new block instead, as growing means copying all commands.  The other
+ * writers are addressed relative to STATE_BASE_ADDRESS and must stay in one
+ * bo.  Failures are handled silently.
  */
 void cmd_writer_grow(struct intel_cmd *cmd,
                      enum intel_cmd_writer_type which,
@@ -140,12 +358,19 @@ void cmd_writer_grow(struct intel_cmd *cmd,
     struct intel_bo *new_bo;
     void *new_ptr;
 
+    if (which == INTEL_CMD_WRITER_BATCH) {
+        assert(new_size - writer->used <=
+                writer->size - INTEL_CMD_CHAIN_RESERVED_SIZE);
+        cmd_writer_chain(cmd, which);
+        return;
+    }
+
     if (new_size < writer->size << 1)
         new_size = writer->size << 1;
     /* STATE_BASE_ADDRESS requires page-aligned buffers */
     new_size = u_align(new_size, 4096);
 
-    new_bo = alloc_writer_bo(cmd->dev->winsys, which, new_size);
+    new_bo = cmd_writer_alloc_bo(cmd, which, new_size);
     if (!new_bo) {
         cmd_writer_discard(cmd, which);
         cmd_fail(cmd, VK_ERROR_OUT_OF_DEVICE_MEMORY);
@@ -155,7 +380,7 @@ void cmd_writer_grow(struct intel_cmd *cmd,
     /* map and copy the data over */
     new_ptr = intel_bo_map(new_bo, true);
     if (!new_ptr) {
-        intel_bo_unref(new_bo);
+        cmd_pool_release_bo(cmd->pool, new_bo, new_size);
         cmd_writer_discard(cmd, which);
         cmd_fail(cmd, VK_ERROR_VALIDATION_FAILED_EXT);
         return;
@@ -164,7 +389,7 @@ void cmd_writer_grow(struct intel_cmd *cmd,
     memcpy(new_ptr, writer->ptr, writer->used);
 
     intel_bo_unmap(writer->bo);
-    intel_bo_unref(writer->bo);
+    cmd_pool_release_bo(cmd->pool, writer->bo, writer->size);
 
     writer->size = new_size;
     writer->bo = new_bo;
@@ -210,14 +435,61 @@ void cmd_writer_record(struct intel_cmd *cmd,
     item->size = size;
 }
 
+static struct intel_bo *cmd_writer_block_bo(const struct intel_cmd *cmd,
+                                            enum intel_cmd_writer_type which,
+                                            uint32_t block)
+{
+    const struct intel_cmd_writer *writer = &cmd->writers[which];
+
+    return (block < writer->chain_used) ?
+        writer->chain[block].bo : writer->bo;
+}
+
 static void cmd_writer_patch(struct intel_cmd *cmd,
                              enum intel_cmd_writer_type which,
-                             size_t offset, uint32_t val)
+                             uint32_t block, size_t offset, uint32_t val)
 {
     struct intel_cmd_writer *writer = &cmd->writers[which];
+    void *ptr = writer->ptr;
+    size_t used = writer->used;
+
+    if (block < writer->chain_used) {
+        ptr = writer->chain[block].ptr;
+        used = writer->chain[block].used;
+    }
 
-    assert(offset + sizeof(val) <= writer->used);
-    *((uint32_t *) ((char *) writer->ptr + offset)) = val;
+    assert(offset + sizeof(val) <= used);
+    *((uint32_t *) ((char *) ptr + offset)) = val;
+}
+
+/**
+ * Point the MI_BATCH_BUFFER_START at the end of each block to the next block.
+ * This is done backward after all other relocs, because libdrm_intel
+ * disallows adding relocs to a bo once it is a reloc target.
+ */
+static void cmd_writer_link_chain(struct intel_cmd *cmd,
+                                  enum intel_cmd_writer_type which)
+{
+    const struct intel_cmd_writer *writer = &cmd->writers[which];
+    uint32_t i = writer->chain_used;
+
+    while (i--) {
+        const struct intel_cmd_writer_block *block = &writer->chain[i];
+        const size_t offset = block->used - 4;
+        uint64_t presumed_offset;
+        int err;
+
+        err = intel_bo_add_reloc(block->bo, offset,
+                cmd_writer_block_bo(cmd, which, i + 1), 0, 0,
+                &presumed_offset);
+        if (err) {
+            cmd_fail(cmd, VK_ERROR_OUT_OF_DEVICE_MEMORY);
+            break;
+        }
+
+        assert(presumed_offset == (uint64_t) (uint32_t) presumed_offset);
+        cmd_writer_patch(cmd, which, i, offset, (uint32_t) presumed_offset);
+    }
 }
 
 static void cmd_reset(struct intel_cmd *cmd)
@@ -279,6 +551,7 @@ VkResult intel_cmd_create(struct intel_dev *dev,
     cmd->obj.destroy = cmd_destroy;
 
     cmd->dev = dev;
+    cmd->pool = pool;
     cmd->scratch_bo = dev->cmd_scratch_bo;
     cmd->primary = (info->level == VK_COMMAND_BUFFER_LEVEL_PRIMARY);
     cmd->pipeline_select = pipeline_select;
@@ -296,6 +569,11 @@ VkResult intel_cmd_create(struct intel_dev *dev,
         return VK_ERROR_OUT_OF_HOST_MEMORY;
     }
 
+    cmd->pool_next = pool->cmds;
+    if (pool->cmds)
+        pool->cmds->pool_prev = cmd;
+    pool->cmds = cmd;
+
     *cmd_ret = cmd;
 
     return VK_SUCCESS;
@@ -305,6 +583,13 @@ void intel_cmd_destroy(struct intel_cmd *cmd)
 {
     cmd_reset(cmd);
 
+    if (cmd->pool_prev)
+        cmd->pool_prev->pool_next = cmd->pool_next;
+    else if (cmd->pool->cmds == cmd)
+        cmd->pool->cmds = cmd->pool_next;
+    if (cmd->pool_next)
+        cmd->pool_next->pool_prev = cmd->pool_prev;
+
     intel_free(cmd, cmd->relocs);
     intel_base_destroy(&cmd->obj.base);
 }
@@ -356,6 +641,7 @@ VkResult intel_cmd_begin(struct intel_cmd *cmd, const VkCommandBufferBeginInfo *
 VkResult intel_cmd_end(struct intel_cmd *cmd)
 {
     struct intel_winsys *winsys = cmd->dev->winsys;
+    struct intel_bo *batch;
     uint32_t i;
 
     /* draw_state: no matching intel_cmd_begin() */
@@ -363,10 +649,15 @@ VkResult intel_cmd_end(struct intel_cmd *cmd)
 
     cmd_batch_end(cmd);
 
+    /* the relocs may be to discarded commands */
+    if (cmd->result != VK_SUCCESS)
+        cmd->reloc_used = 0;
+
     /* TODO we need a more "explicit" winsys */
     for (i = 0; i < cmd->reloc_used; i++) {
         const struct intel_cmd_reloc *reloc = &cmd->relocs[i];
-        const struct intel_cmd_writer *writer = &cmd->writers[reloc->which];
+        struct intel_bo *bo =
+            cmd_writer_block_bo(cmd, reloc->which, reloc->block);
         uint64_t presumed_offset;
         int err;
 
@@ -379,7 +670,7 @@ VkResult intel_cmd_end(struct intel_cmd *cmd)
         if (reloc->flags & INTEL_CMD_RELOC_TARGET_IS_WRITER)
             continue;
 
-        err = intel_bo_add_reloc(writer->bo, reloc->offset,
+        err = intel_bo_add_reloc(bo, reloc->offset,
                 (struct intel_bo *) reloc->target, reloc->target_offset,
                 reloc->flags, &presumed_offset);
         if (err) {
@@ -388,19 +679,20 @@ VkResult intel_cmd_end(struct intel_cmd *cmd)
         }
 
         assert(presumed_offset == (uint64_t) (uint32_t) presumed_offset);
-        cmd_writer_patch(cmd, reloc->which, reloc->offset,
+        cmd_writer_patch(cmd, reloc->which, reloc->block, reloc->offset,
                 (uint32_t) presumed_offset);
     }
     for (i = 0; i < cmd->reloc_used; i++) {
         const struct intel_cmd_reloc *reloc = &cmd->relocs[i];
-        const struct intel_cmd_writer *writer = &cmd->writers[reloc->which];
+        struct intel_bo *bo =
+            cmd_writer_block_bo(cmd, reloc->which, reloc->block);
         uint64_t presumed_offset;
         int err;
 
         if (!(reloc->flags & INTEL_CMD_RELOC_TARGET_IS_WRITER))
             continue;
 
-        err = intel_bo_add_reloc(writer->bo, reloc->offset,
+        err = intel_bo_add_reloc(bo, reloc->offset,
                 cmd->writers[reloc->target].bo, reloc->target_offset,
                 reloc->flags & ~INTEL_CMD_RELOC_TARGET_IS_WRITER,
                 &presumed_offset);
@@ -410,18 +702,21 @@ VkResult intel_cmd_end(struct intel_cmd *cmd)
         }
 
         assert(presumed_offset == (uint64_t) (uint32_t) presumed_offset);
-        cmd_writer_patch(cmd, reloc->which, reloc->offset,
+        cmd_writer_patch(cmd, reloc->which, reloc->block, reloc->offset,
                 (uint32_t) presumed_offset);
     }
 
+    if (cmd->result == VK_SUCCESS)
+        cmd_writer_link_chain(cmd, INTEL_CMD_WRITER_BATCH);
+
     for (i = 0; i < INTEL_CMD_WRITER_COUNT; i++)
         cmd_writer_unmap(cmd, i);
 
     if (cmd->result != VK_SUCCESS)
         return cmd->result;
 
-    if (intel_winsys_can_submit_bo(winsys,
-                &cmd->writers[INTEL_CMD_WRITER_BATCH].bo, 1))
+    batch = intel_cmd_get_batch(cmd, NULL);
+    if (intel_winsys_can_submit_bo(winsys, &batch, 1))
         return VK_SUCCESS;
     else {
         assert(0 && "intel_winsys_can_submit_bo failed");
@@ -460,9 +755,26 @@ VkResult intel_cmd_pool_create(struct intel_dev *dev,
 
 void intel_cmd_pool_destroy(struct intel_cmd_pool *cmd_pool)
 {
-    //cmd_reset(cmd);
-    //intel_free(cmd, cmd->relocs);
-    //intel_base_destroy(&cmd->obj.base);
+    /* command buffers are freed with their pool */
+    while (cmd_pool->cmds)
+        intel_cmd_destroy(cmd_pool->cmds);
+
+    cmd_pool_release_all_bos(cmd_pool);
+    intel_free(cmd_pool, cmd_pool->bos);
+
+    intel_base_destroy(&cmd_pool->obj.base);
+}
+
+void intel_cmd_pool_reset(struct intel_cmd_pool *cmd_pool,
+                          VkCommandPoolResetFlags flags)
+{
+    struct intel_cmd *cmd;
+
+    for (cmd = cmd_pool->cmds; cmd; cmd = cmd->pool_next)
+        cmd_reset(cmd);
+
+    if (flags & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT)
+        cmd_pool_release_all_bos(cmd_pool);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL vkCreateCommandPool(
@@ -482,6 +794,12 @@ VKAPI_ATTR void VKAPI_CALL vkDestroyCommandPool(
     VkCommandPool                                   commandPool,
     const VkAllocationCallbacks*                    pAllocator)
 {
+    struct intel_obj *obj = intel_obj(commandPool);
+
+    if (!obj)
+        return;
+
+    obj->destroy(obj);
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandPool(
@@ -489,7 +807,10 @@ VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandPool(
     VkCommandPool                                   commandPool,
     VkCommandPoolResetFlags                         flags)
 {
-    // TODO
+    struct intel_cmd_pool *pool = intel_cmd_pool(commandPool);
+
+    intel_cmd_pool_reset(pool, flags);
+
     return VK_SUCCESS;
 }
 
@@ -501,6 +822,9 @@ void intel_free_cmd_buffers(
     for (uint32_t i = 0; i < count; i++) {
         struct intel_obj *obj = intel_obj(cmd_bufs[i]);
 
+        if (!obj)
+            continue;
+
         obj->destroy(obj);
     }
 }
@@ -207,6 +207,18 @@ struct intel_cmd_bind {
     uint32_t wa_flags;
 };
 
+/*
+ * A full block of a chained writer.  It ends with an MI_BATCH_BUFFER_START to
+ * the next block.
+ */
+struct intel_cmd_writer_block {
+    struct intel_bo *bo;
+    void *ptr;
+
+    /* including the MI_BATCH_BUFFER_START */
+    size_t used;
+};
+
 struct intel_cmd_writer {
     size_t size;
     struct intel_bo *bo;
@@ -216,18 +228,47 @@ struct intel_cmd_writer {
 
     uint32_t sba_offset;
 
+    /*
+     * The batch writer does not grow.  When a block is full, it is chained to
+     * a new block of the same size, and bo, ptr, and used refer to the new
+     * block.
+     */
+    struct intel_cmd_writer_block *chain;
+    uint32_t chain_alloc;
+    uint32_t chain_used;
+
     /* for decoding */
     struct intel_cmd_item *items;
     uint32_t item_alloc;
     uint32_t item_used;
 };
 
+/*
+ * Keep up to this many bytes of idle writer bos in a command pool for its
+ * command buffers to reuse.
+ */
+#define INTEL_CMD_POOL_BO_CACHE_SIZE (16 * 1024 * 1024)
+
+struct intel_cmd_pool_bo {
+    struct intel_bo *bo;
+    size_t size;
+};
+
 struct intel_cmd_pool {
     struct intel_obj obj;
     struct intel_dev *dev;
 
     uint32_t queue_family_index;
     uint32_t create_flags;
+
+    /* command buffers allocated from the pool */
+    struct intel_cmd *cmds;
+
+    /* writer bos released by reset command buffers, most recent last */
+    struct intel_cmd_pool_bo *bos;
+    uint32_t bo_alloc;
+    uint32_t bo_used;
+    size_t bo_cache_size;
 };
 
 static inline struct intel_cmd_pool *intel_cmd_pool(VkCommandPool pool)
@@ -249,6 +290,8 @@ VkResult intel_cmd_pool_create(struct intel_dev *dev,
                             const VkCommandPoolCreateInfo *info,
                             struct intel_cmd_pool **cmd_pool_ret);
 void intel_cmd_pool_destroy(struct intel_cmd_pool *pool);
+void intel_cmd_pool_reset(struct intel_cmd_pool *pool,
+                          VkCommandPoolResetFlags flags);
 
 void intel_free_cmd_buffers(
         struct intel_cmd_pool              *cmd_pool,
@@ -259,6 +302,10 @@ struct intel_cmd {
     struct intel_obj obj;
 
     struct intel_dev *dev;
+    struct intel_cmd_pool *pool;
+    struct intel_cmd *pool_prev;
+    struct intel_cmd *pool_next;
+
     struct intel_bo *scratch_bo;
     bool primary;
     int pipeline_select;
@@ -296,12 +343,23 @@ VkResult intel_cmd_end(struct intel_cmd *cmd);
 
 void intel_cmd_decode(struct intel_cmd *cmd, bool decode_inst_writer);
 
+/**
+ * Return the bo to submit, and the number of bytes to execute in it.  Chained
+ * blocks are reached from it.
+ */
 static inline struct intel_bo *intel_cmd_get_batch(const struct intel_cmd *cmd,
                                                    VkDeviceSize *used)
 {
     const struct intel_cmd_writer *writer =
         &cmd->writers[INTEL_CMD_WRITER_BATCH];
 
+    if (writer->chain_used) {
+        if (used)
+            *used = writer->chain[0].used;
+
+        return writer->chain[0].bo;
+    }
+
     if (used)
         *used = writer->used;
 
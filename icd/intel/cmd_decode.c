@@ -555,11 +555,19 @@ static void cmd_writer_decode(struct intel_cmd *cmd,
                               bool decode_inst_writer)
 {
     struct intel_cmd_writer *writer = &cmd->writers[which];
+    uint32_t i;
 
     assert(writer->bo && !writer->ptr);
 
     switch (which) {
     case INTEL_CMD_WRITER_BATCH:
+        for (i = 0; i < writer->chain_used; i++) {
+            fprintf(stderr, "decoding batch buffer block %u: %zu bytes\n",
+                    i, writer->chain[i].used);
+            intel_winsys_decode_bo(cmd->dev->winsys,
+                    writer->chain[i].bo, writer->chain[i].used);
+        }
+
         fprintf(stderr, "decoding batch buffer: %zu bytes\n", writer->used);
         if (writer->used) {
             intel_winsys_decode_bo(cmd->dev->winsys,
@@ -62,8 +62,16 @@ struct intel_cmd_item {
 };
 
 #define INTEL_CMD_RELOC_TARGET_IS_WRITER (1u << 31)
+
+/*
+ * Bytes kept at the end of each batch block for an MI_NOOP, to keep the block
+ * QWord aligned, and an MI_BATCH_BUFFER_START to the next block.
+ */
+#define INTEL_CMD_CHAIN_RESERVED_SIZE 12
 struct intel_cmd_reloc {
     enum intel_cmd_writer_type which;
+    /* the block of a chained writer, and the offset in the block */
+    uint32_t block;
     size_t offset;
 
     intptr_t target;
@@ -179,12 +187,15 @@ static inline size_t cmd_writer_reserve(struct intel_cmd *cmd,
                                         size_t alignment, size_t size)
 {
     struct intel_cmd_writer *writer = &cmd->writers[which];
+    /* the batch writer needs room to chain to the next block */
+    const size_t limit = (which == INTEL_CMD_WRITER_BATCH) ?
+        writer->size - INTEL_CMD_CHAIN_RESERVED_SIZE : writer->size;
     size_t offset;
 
     assert(alignment && u_is_pow2(alignment));
     offset = u_align(writer->used, alignment);
 
-    if (offset + size > writer->size) {
+    if (offset + size > limit) {
         cmd_writer_grow(cmd, which, offset + size);
         /* align again in case of errors */
         offset = u_align(writer->used, alignment);
@@ -208,6 +219,7 @@ static inline void cmd_writer_reloc(struct intel_cmd *cmd,
     assert(cmd->reloc_used < cmd->reloc_count);
 
     reloc->which = which;
+    reloc->block = cmd->writers[which].chain_used;
     reloc->offset = offset;
     reloc->target = target;
     reloc->target_offset = target_offset;
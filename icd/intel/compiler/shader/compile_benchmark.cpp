@@ -0,0 +1,247 @@
+/*
+ *
+ * Copyright (C) 2016 Valve Corporation
+ * Copyright (C) 2016 LunarG, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+/** @file compile_benchmark.cpp
+ *
+ * Times compiling a set of SPIR-V shaders the way vkCreateGraphicsPipelines
+ * does, first one after the other and then on a _mesa_threadpool, to see
+ * what parallel pipeline creation gains.  The backend targets a fixed
+ * Haswell GT3, as the standalone compiler does, so no GPU is needed.
+ *
+ *   compile_benchmark [-c copies] [-t threads] shader.vert.spv shader.frag.spv ...
+ *
+ * Every copy of every shader is a separate job with its own IR, like
+ * stages of pipelines built from separate shader modules.
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <inttypes.h>
+
+#include "gpu.h"
+#include "pipeline.h"
+#include "compiler_interface.h"
+#include "pipeline_compiler_interface.h"
+#include "compiler/mesa-utils/src/glsl/threadpool.h"
+
+struct compile_job {
+    const void *code;
+    size_t size;
+    VkShaderStageFlagBits stage;
+    const struct intel_gpu *gpu;
+    VkResult ret;
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_nsec + ts.tv_sec * INT64_C(1000000000);
+}
+
+static bool has_ext(const char *name, const char *ext)
+{
+    const size_t len = strlen(name), ext_len = strlen(ext);
+
+    return len >= ext_len && !strcmp(name + len - ext_len, ext);
+}
+
+static void *load_spv_file(const char *filename, size_t *psize)
+{
+    FILE *fp = fopen(filename, "rb");
+    void *code;
+    long size;
+
+    if (!fp)
+        return NULL;
+
+    fseek(fp, 0L, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0L, SEEK_SET);
+
+    code = malloc(size);
+    if (code && fread(code, size, 1, fp) != 1) {
+        free(code);
+        code = NULL;
+    }
+    fclose(fp);
+
+    *psize = size;
+    return code;
+}
+
+// What pipeline_compile_shader() does for a stage that is not cached
+static void compile_job_run(void *data)
+{
+    struct compile_job *job = (struct compile_job *) data;
+    struct intel_ir *ir = NULL;
+    struct intel_pipeline_shader sh;
+
+    shader_create_ir_with_lock(job->gpu, job->code, job->size, job->stage, &ir);
+    if (!ir) {
+        job->ret = VK_ERROR_OUT_OF_HOST_MEMORY;
+        return;
+    }
+
+    memset(&sh, 0, sizeof(sh));
+    job->ret = intel_pipeline_shader_compile(&sh, job->gpu, NULL, NULL, ir);
+    if (job->ret == VK_SUCCESS)
+        intel_pipeline_shader_cleanup(&sh, job->gpu);
+
+    shader_destroy_ir(ir);
+}
+
+static bool check_jobs(const struct compile_job *jobs, int job_count)
+{
+    for (int i = 0; i < job_count; i++) {
+        if (jobs[i].ret != VK_SUCCESS) {
+            printf("job %d failed: %d\n", i, jobs[i].ret);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int copies = 8;
+    int threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:t:")) != -1) {
+        switch (opt) {
+        case 'c':
+            copies = atoi(optarg);
+            break;
+        case 't':
+            threads = atoi(optarg);
+            break;
+        default:
+            printf("usage: %s [-c copies] [-t threads] file.{vert,frag,geom}.spv...\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const int file_count = argc - optind;
+    if (file_count < 1 || copies < 1 || threads < 1) {
+        printf("usage: %s [-c copies] [-t threads] file.{vert,frag,geom}.spv...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Set up only the fields needed for backend compile
+    struct intel_gpu gpu = { 0 };
+    gpu.gen_opaque = INTEL_GEN(7.5);
+    gpu.gt = 3;
+
+    const int job_count = file_count * copies;
+    struct compile_job *jobs = (struct compile_job *) calloc(job_count, sizeof(jobs[0]));
+
+    for (int f = 0; f < file_count; f++) {
+        const char *name = argv[optind + f];
+        VkShaderStageFlagBits stage;
+        size_t size;
+        void *code;
+
+        if (has_ext(name, "vert.spv")) {
+            stage = VK_SHADER_STAGE_VERTEX_BIT;
+        } else if (has_ext(name, "frag.spv")) {
+            stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        } else if (has_ext(name, "geom.spv")) {
+            stage = VK_SHADER_STAGE_GEOMETRY_BIT;
+        } else {
+            printf("%s: file must be .vert.spv, .frag.spv or .geom.spv\n", name);
+            return EXIT_FAILURE;
+        }
+
+        code = load_spv_file(name, &size);
+        if (!code) {
+            printf("%s: cannot read file\n", name);
+            return EXIT_FAILURE;
+        }
+
+        for (int c = 0; c < copies; c++) {
+            struct compile_job *job = &jobs[c * file_count + f];
+
+            job->code = code;
+            job->size = size;
+            job->stage = stage;
+            job->gpu = &gpu;
+        }
+    }
+
+    // The first compile initializes the compiler's builtins; keep it out of the timings
+    compile_job_run(&jobs[0]);
+    if (!check_jobs(jobs, 1))
+        return EXIT_FAILURE;
+
+    uint64_t begin = now_ns();
+    for (int i = 0; i < job_count; i++)
+        compile_job_run(&jobs[i]);
+    const uint64_t serial_ns = now_ns() - begin;
+
+    if (!check_jobs(jobs, job_count))
+        return EXIT_FAILURE;
+
+    struct _mesa_threadpool *pool = _mesa_threadpool_create(threads);
+    struct _mesa_threadpool_task **tasks =
+        (struct _mesa_threadpool_task **) calloc(job_count, sizeof(tasks[0]));
+    int task_count = 0;
+
+    begin = now_ns();
+    for (int i = 0; i < job_count; i++) {
+        jobs[i].ret = VK_ERROR_INITIALIZATION_FAILED;
+        struct _mesa_threadpool_task *task =
+            _mesa_threadpool_queue_task(pool, compile_job_run, &jobs[i]);
+        if (task)
+            tasks[task_count++] = task;
+        else
+            compile_job_run(&jobs[i]);
+    }
+    _mesa_threadpool_complete_tasks(pool, tasks, task_count);
+    const uint64_t parallel_ns = now_ns() - begin;
+
+    if (!check_jobs(jobs, job_count))
+        return EXIT_FAILURE;
+
+    printf("%d jobs (%d shaders x %d copies)\n", job_count, file_count, copies);
+    printf("serial:   %8.2f ms, %.3f ms per job\n",
+           serial_ns / 1e6, serial_ns / 1e6 / job_count);
+    printf("parallel: %8.2f ms on %d threads, %.2fx\n",
+           parallel_ns / 1e6, threads, (double) serial_ns / parallel_ns);
+
+    _mesa_threadpool_unref(pool);
+    free(tasks);
+    for (int f = 0; f < file_count; f++)
+        free((void *) jobs[f].code);
+    free(jobs);
+
+    return EXIT_SUCCESS;
+}
@@ -151,6 +151,27 @@ VkResult intel_desc_region_create(struct intel_dev *dev,
         return VK_ERROR_OUT_OF_HOST_MEMORY;
     }
 
+    if (intel_desc_allocator_init(&region->surface_allocator, dev,
+                VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, 0,
+                region->size.surface) != VK_SUCCESS) {
+        intel_free(dev, region->samplers);
+        intel_free(dev, region->surfaces);
+        intel_free(dev, region);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    if (intel_desc_allocator_init(&region->sampler_allocator, dev,
+                VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, 0,
+                region->size.sampler) != VK_SUCCESS) {
+        intel_desc_allocator_cleanup(&region->surface_allocator);
+        intel_free(dev, region->samplers);
+        intel_free(dev, region->surfaces);
+        intel_free(dev, region);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    pthread_mutex_init(&region->mutex, NULL);
+
     *region_ret = region;
 
     return VK_SUCCESS;
@@ -159,6 +180,9 @@ VkResult intel_desc_region_create(struct intel_dev *dev,
 void intel_desc_region_destroy(struct intel_dev *dev,
                                struct intel_desc_region *region)
 {
+    pthread_mutex_destroy(&region->mutex);
+    intel_desc_allocator_cleanup(&region->sampler_allocator);
+    intel_desc_allocator_cleanup(&region->surface_allocator);
     intel_free(dev, region->samplers);
     intel_free(dev, region->surfaces);
     intel_free(dev, region);
@@ -210,13 +234,13 @@ VkResult intel_desc_region_alloc(struct intel_desc_region *region,
 {
     uint32_t surface_size = 0, sampler_size = 0;
     struct intel_desc_offset alloc;
+    VkResult ret;
     uint32_t i;
 
     /* calculate sizes needed */
     for (i = 0; i < info->poolSizeCount; i++) {
         const VkDescriptorPoolSize *tc = &info->pPoolSizes[i];
         struct intel_desc_offset size;
-        VkResult ret;
 
         ret = desc_region_get_desc_size(region, tc->type, &size);
         if (ret != VK_SUCCESS)
@@ -231,14 +255,25 @@ VkResult intel_desc_region_alloc(struct intel_desc_region *region,
 
     intel_desc_offset_set(&alloc, surface_size, sampler_size);
 
-    *begin = region->cur;
-    intel_desc_offset_add(end, &region->cur, &alloc);
+    pthread_mutex_lock(&region->mutex);
 
-    if (!intel_desc_offset_within(end, &region->size))
-        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    ret = intel_desc_allocator_alloc(&region->surface_allocator,
+            alloc.surface, &begin->surface);
+    if (ret == VK_SUCCESS) {
+        ret = intel_desc_allocator_alloc(&region->sampler_allocator,
+                alloc.sampler, &begin->sampler);
+        if (ret != VK_SUCCESS) {
+            intel_desc_allocator_free(&region->surface_allocator,
+                    begin->surface, alloc.surface);
+        }
+    }
+
+    pthread_mutex_unlock(&region->mutex);
 
-    /* increment the writer pointer */
-    region->cur = *end;
+    if (ret != VK_SUCCESS)
+        return ret;
+
+    intel_desc_offset_add(end, begin, &alloc);
 
     return VK_SUCCESS;
 }
@@ -260,7 +295,12 @@ void intel_desc_region_free(struct intel_desc_region *region,
 {
     desc_region_validate_begin_end(region, begin, end);
 
-    /* is it ok not to reclaim? */
+    pthread_mutex_lock(&region->mutex);
+    intel_desc_allocator_free(&region->surface_allocator,
+            begin->surface, end->surface - begin->surface);
+    intel_desc_allocator_free(&region->sampler_allocator,
+            begin->sampler, end->sampler - begin->sampler);
+    pthread_mutex_unlock(&region->mutex);
 }
 
 void intel_desc_region_update(struct intel_desc_region *region,
@@ -392,8 +432,26 @@ VkResult intel_desc_pool_create(struct intel_dev *dev,
         return ret;
     }
 
-    /* point to head */
-    pool->cur = pool->region_begin;
+    ret = intel_desc_allocator_init(&pool->surface_allocator, pool,
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT, pool->region_begin.surface,
+            pool->region_end.surface);
+    if (ret != VK_SUCCESS) {
+        intel_desc_region_free(dev->desc_region,
+                &pool->region_begin, &pool->region_end);
+        intel_base_destroy(&pool->obj.base);
+        return ret;
+    }
+
+    ret = intel_desc_allocator_init(&pool->sampler_allocator, pool,
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT, pool->region_begin.sampler,
+            pool->region_end.sampler);
+    if (ret != VK_SUCCESS) {
+        intel_desc_allocator_cleanup(&pool->surface_allocator);
+        intel_desc_region_free(dev->desc_region,
+                &pool->region_begin, &pool->region_end);
+        intel_base_destroy(&pool->obj.base);
+        return ret;
+    }
 
     pool->obj.destroy = desc_pool_destroy;
 
@@ -404,6 +462,8 @@ VkResult intel_desc_pool_create(struct intel_dev *dev,
 
 void intel_desc_pool_destroy(struct intel_desc_pool *pool)
 {
+    intel_desc_allocator_cleanup(&pool->sampler_allocator);
+    intel_desc_allocator_cleanup(&pool->surface_allocator);
     intel_desc_region_free(pool->dev->desc_region,
             &pool->region_begin, &pool->region_end);
     intel_base_destroy(&pool->obj.base);
@@ -414,22 +474,44 @@ VkResult intel_desc_pool_alloc(struct intel_desc_pool *pool,
                                  struct intel_desc_offset *begin,
                                  struct intel_desc_offset *end)
 {
-    *begin = pool->cur;
-    intel_desc_offset_add(end, &pool->cur, &layout->region_size);
+    const struct intel_desc_offset *size = &layout->region_size;
+    VkResult ret;
 
-    if (!intel_desc_offset_within(end, &pool->region_end))
-        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    ret = intel_desc_allocator_alloc(&pool->surface_allocator,
+            size->surface, &begin->surface);
+    if (ret != VK_SUCCESS)
+        return ret;
 
-    /* increment the writer pointer */
-    pool->cur = *end;
+    ret = intel_desc_allocator_alloc(&pool->sampler_allocator,
+            size->sampler, &begin->sampler);
+    if (ret != VK_SUCCESS) {
+        intel_desc_allocator_free(&pool->surface_allocator,
+                begin->surface, size->surface);
+        return ret;
+    }
+
+    intel_desc_offset_add(end, begin, size);
 
     return VK_SUCCESS;
 }
 
+void intel_desc_pool_free(struct intel_desc_pool *pool,
+                          const struct intel_desc_offset *begin,
+                          const struct intel_desc_offset *end)
+{
+    assert(intel_desc_offset_within(&pool->region_begin, begin) &&
+           intel_desc_offset_within(end, &pool->region_end));
+
+    intel_desc_allocator_free(&pool->surface_allocator,
+            begin->surface, end->surface - begin->surface);
+    intel_desc_allocator_free(&pool->sampler_allocator,
+            begin->sampler, end->sampler - begin->sampler);
+}
+
 void intel_desc_pool_reset(struct intel_desc_pool *pool)
 {
-    /* reset to head */
-    pool->cur = pool->region_begin;
+    intel_desc_allocator_reset(&pool->surface_allocator);
+    intel_desc_allocator_reset(&pool->sampler_allocator);
 }
 
 static void desc_set_destroy(struct intel_obj *obj)
@@ -453,6 +535,7 @@ VkResult intel_desc_set_create(struct intel_dev *dev,
     if (!set)
         return VK_ERROR_OUT_OF_HOST_MEMORY;
 
+    set->pool = pool;
     set->region = dev->desc_region;
     ret = intel_desc_pool_alloc(pool, layout,
             &set->region_begin, &set->region_end);
@@ -472,6 +555,7 @@ VkResult intel_desc_set_create(struct intel_dev *dev,
 
 void intel_desc_set_destroy(struct intel_desc_set *set)
 {
+    intel_desc_pool_free(set->pool, &set->region_begin, &set->region_end);
     intel_base_destroy(&set->obj.base);
 }
 
@@ -854,6 +938,15 @@ VKAPI_ATTR VkResult VKAPI_CALL vkAllocateDescriptorSets(
             break;
     }
 
+    /* give the space of the sets created so far back */
+    if (ret != VK_SUCCESS) {
+        pDescriptorSets[i] = VK_NULL_HANDLE;
+        while (i--) {
+            intel_desc_set_destroy(intel_desc_set(pDescriptorSets[i]));
+            pDescriptorSets[i] = VK_NULL_HANDLE;
+        }
+    }
+
     return ret;
 }
 
@@ -866,8 +959,10 @@ VKAPI_ATTR VkResult VKAPI_CALL vkFreeDescriptorSets(
     uint32_t i;
 
     for (i = 0; i < descriptorSetCount; i++) {
-        intel_desc_set_destroy(
-           *(struct intel_desc_set **) &pDescriptorSets[i]);
+        struct intel_desc_set *set = intel_desc_set(pDescriptorSets[i]);
+
+        if (set)
+            intel_desc_set_destroy(set);
     }
     return VK_SUCCESS;
 }
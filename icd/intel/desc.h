@@ -22,8 +22,11 @@
 #ifndef DESC_H
 #define DESC_H
 
+#include <pthread.h>
+
 #include "intel.h"
 #include "obj.h"
+#include "desc_allocator.h"
 
 struct intel_cmd;
 struct intel_dev;
@@ -67,7 +70,11 @@ struct intel_desc_region {
     struct intel_desc_sampler *samplers;
 
     struct intel_desc_offset size;
-    struct intel_desc_offset cur;
+
+    /* pools are created and destroyed from any thread */
+    pthread_mutex_t mutex;
+    struct intel_desc_allocator surface_allocator;
+    struct intel_desc_allocator sampler_allocator;
 };
 
 struct intel_desc_pool {
@@ -79,7 +86,9 @@ struct intel_desc_pool {
     struct intel_desc_offset region_begin;
     struct intel_desc_offset region_end;
 
-    struct intel_desc_offset cur;
+    /* sets are suballocated from the area */
+    struct intel_desc_allocator surface_allocator;
+    struct intel_desc_allocator sampler_allocator;
 };
 
 struct intel_desc_layout;
@@ -88,6 +97,7 @@ struct intel_desc_set {
     struct intel_obj obj;
 
     /* suballocated from a pool */
+    struct intel_desc_pool *pool;
     struct intel_desc_region *region;
     struct intel_desc_offset region_begin;
     struct intel_desc_offset region_end;
@@ -264,6 +274,9 @@ VkResult intel_desc_pool_alloc(struct intel_desc_pool *pool,
                                  const struct intel_desc_layout *layout,
                                  struct intel_desc_offset *begin,
                                  struct intel_desc_offset *end);
+void intel_desc_pool_free(struct intel_desc_pool *pool,
+                          const struct intel_desc_offset *begin,
+                          const struct intel_desc_offset *end);
 void intel_desc_pool_reset(struct intel_desc_pool *pool);
 
 VkResult intel_desc_set_create(struct intel_dev *dev,
@@ -0,0 +1,187 @@
+/*
+ *
+ * Copyright (C) 2016 Valve Corporation
+ * Copyright (C) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "desc_allocator.h"
+
+static bool desc_allocator_reserve(struct intel_desc_allocator *allocator,
+                                   uint32_t count)
+{
+    struct intel_desc_range *ranges;
+    uint32_t capacity;
+
+    if (count <= allocator->free_capacity)
+        return true;
+
+    capacity = (allocator->free_capacity) ? allocator->free_capacity : 8;
+    while (capacity < count)
+        capacity *= 2;
+
+    ranges = intel_alloc(allocator->handle, sizeof(*ranges) * capacity,
+            sizeof(int), allocator->scope);
+    if (!ranges)
+        return false;
+
+    if (allocator->free_count) {
+        memcpy(ranges, allocator->free_ranges,
+                sizeof(*ranges) * allocator->free_count);
+    }
+
+    if (allocator->free_ranges)
+        intel_free(allocator->handle, allocator->free_ranges);
+
+    allocator->free_ranges = ranges;
+    allocator->free_capacity = capacity;
+
+    return true;
+}
+
+VkResult intel_desc_allocator_init(struct intel_desc_allocator *allocator,
+                                   const void *handle,
+                                   VkSystemAllocationScope scope,
+                                   uint32_t begin, uint32_t end)
+{
+    assert(begin <= end);
+
+    memset(allocator, 0, sizeof(*allocator));
+
+    allocator->handle = handle;
+    allocator->scope = scope;
+    allocator->begin = begin;
+    allocator->end = end;
+
+    if (!desc_allocator_reserve(allocator, 1))
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    intel_desc_allocator_reset(allocator);
+
+    return VK_SUCCESS;
+}
+
+void intel_desc_allocator_cleanup(struct intel_desc_allocator *allocator)
+{
+    intel_free(allocator->handle, allocator->free_ranges);
+}
+
+/**
+ * Free all allocations at once.
+ */
+void intel_desc_allocator_reset(struct intel_desc_allocator *allocator)
+{
+    if (allocator->begin < allocator->end) {
+        allocator->free_ranges[0].begin = allocator->begin;
+        allocator->free_ranges[0].end = allocator->end;
+        allocator->free_count = 1;
+    } else {
+        allocator->free_count = 0;
+    }
+
+    allocator->alloc_count = 0;
+}
+
+VkResult intel_desc_allocator_alloc(struct intel_desc_allocator *allocator,
+                                    uint32_t size, uint32_t *offset)
+{
+    struct intel_desc_range *range;
+    uint32_t i;
+
+    /* empty allocations take no space and need not be freed */
+    if (!size) {
+        *offset = allocator->begin;
+        return VK_SUCCESS;
+    }
+
+    for (i = 0; i < allocator->free_count; i++) {
+        if (allocator->free_ranges[i].end - allocator->free_ranges[i].begin >= size)
+            break;
+    }
+    if (i >= allocator->free_count)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    /* make sure a later free has room to split a range */
+    if (!desc_allocator_reserve(allocator, allocator->alloc_count + 2))
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    range = &allocator->free_ranges[i];
+    *offset = range->begin;
+    range->begin += size;
+
+    if (range->begin == range->end) {
+        memmove(range, range + 1,
+                sizeof(*range) * (allocator->free_count - i - 1));
+        allocator->free_count--;
+    }
+
+    allocator->alloc_count++;
+
+    return VK_SUCCESS;
+}
+
+void intel_desc_allocator_free(struct intel_desc_allocator *allocator,
+                               uint32_t offset, uint32_t size)
+{
+    struct intel_desc_range *ranges = allocator->free_ranges;
+    const uint32_t end = offset + size;
+    uint32_t lo = 0, hi = allocator->free_count;
+    bool merge_prev, merge_next;
+
+    if (!size)
+        return;
+
+    assert(allocator->begin <= offset && end <= allocator->end);
+    assert(allocator->alloc_count > 0);
+
+    /* find the first free range after the freed one */
+    while (lo < hi) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+
+        if (ranges[mid].begin < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    /* no double free */
+    assert(lo == 0 || ranges[lo - 1].end <= offset);
+    assert(lo == allocator->free_count || end <= ranges[lo].begin);
+
+    merge_prev = (lo > 0 && ranges[lo - 1].end == offset);
+    merge_next = (lo < allocator->free_count && ranges[lo].begin == end);
+
+    if (merge_prev && merge_next) {
+        ranges[lo - 1].end = ranges[lo].end;
+        memmove(&ranges[lo], &ranges[lo + 1],
+                sizeof(*ranges) * (allocator->free_count - lo - 1));
+        allocator->free_count--;
+    } else if (merge_prev) {
+        ranges[lo - 1].end = end;
+    } else if (merge_next) {
+        ranges[lo].begin = offset;
+    } else {
+        /* reserved by intel_desc_allocator_alloc() */
+        assert(allocator->free_count < allocator->free_capacity);
+
+        memmove(&ranges[lo + 1], &ranges[lo],
+                sizeof(*ranges) * (allocator->free_count - lo));
+        ranges[lo].begin = offset;
+        ranges[lo].end = end;
+        allocator->free_count++;
+    }
+
+    allocator->alloc_count--;
+}
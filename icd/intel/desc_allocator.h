@@ -0,0 +1,69 @@
+/*
+ *
+ * Copyright (C) 2016 Valve Corporation
+ * Copyright (C) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef DESC_ALLOCATOR_H
+#define DESC_ALLOCATOR_H
+
+#include "intel.h"
+
+/**
+ * A free range, [begin, end), of a descriptor allocator.
+ */
+struct intel_desc_range {
+    uint32_t begin;
+    uint32_t end;
+};
+
+/**
+ * First-fit sub-allocator for one dimension (surface or sampler bytes) of
+ * the descriptor region.  Free ranges are kept sorted and coalesced, so
+ * there are never more of them than live allocations plus one; alloc
+ * reserves room for that many and free never allocates, nor fails.
+ */
+struct intel_desc_allocator {
+    /* this is not an intel_obj */
+
+    const void *handle;
+    VkSystemAllocationScope scope;
+
+    uint32_t begin;
+    uint32_t end;
+
+    struct intel_desc_range *free_ranges;
+    uint32_t free_count;
+    uint32_t free_capacity;
+
+    /* non-empty allocations not freed yet */
+    uint32_t alloc_count;
+};
+
+VkResult intel_desc_allocator_init(struct intel_desc_allocator *allocator,
+                                   const void *handle,
+                                   VkSystemAllocationScope scope,
+                                   uint32_t begin, uint32_t end);
+void intel_desc_allocator_cleanup(struct intel_desc_allocator *allocator);
+
+void intel_desc_allocator_reset(struct intel_desc_allocator *allocator);
+
+VkResult intel_desc_allocator_alloc(struct intel_desc_allocator *allocator,
+                                    uint32_t size, uint32_t *offset);
+void intel_desc_allocator_free(struct intel_desc_allocator *allocator,
+                               uint32_t offset, uint32_t size);
+
+#endif /* DESC_ALLOCATOR_H */
@@ -21,7 +21,9 @@
  */
 
 #include <stdarg.h>
+#include <unistd.h>
 #include "kmd/winsys.h"
+#include "compiler/mesa-utils/src/glsl/threadpool.h"
 #include "desc.h"
 #include "gpu.h"
 #include "pipeline.h"
@@ -144,6 +146,9 @@ VkResult intel_dev_create(struct intel_gpu *gpu,
         return ret;
     }
 
+    /* threads are only spawned when needed; without a pool we compile serially */
+    dev->compile_pool = _mesa_threadpool_create(sysconf(_SC_NPROCESSORS_ONLN));
+
     intel_pipeline_init_default_sample_patterns(dev,
             (uint8_t *) &dev->sample_pattern_1x,
             (uint8_t *) &dev->sample_pattern_2x,
@@ -173,6 +178,9 @@ void intel_dev_destroy(struct intel_dev *dev)
             intel_queue_destroy(dev->queues[i]);
     }
 
+    if (dev->compile_pool)
+        _mesa_threadpool_unref(dev->compile_pool);
+
     if (dev->desc_region)
         intel_desc_region_destroy(dev, dev->desc_region);
 
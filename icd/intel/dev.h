@@ -31,6 +31,7 @@ struct intel_desc_region;
 struct intel_pipeline_shader;
 struct intel_queue;
 struct intel_winsys;
+struct _mesa_threadpool;
 
 enum intel_dev_meta_shader {
     /*
@@ -147,6 +148,9 @@ struct intel_dev {
 
     struct intel_desc_region *desc_region;
 
+    /* compiles the stages of vkCreateGraphicsPipelines() in parallel */
+    struct _mesa_threadpool *compile_pool;
+
     uint32_t sample_pattern_1x;
     uint32_t sample_pattern_2x;
     uint32_t sample_pattern_4x;
@@ -35,6 +35,7 @@
 #include "queue.h"
 #include "gpu.h"
 #include "instance.h"
+#include "pipeline_cache.h"
 #include "wsi.h"
 #include "icd.h"
 
@@ -278,6 +279,8 @@ void intel_gpu_get_props(const struct intel_gpu *gpu,
 
     props->deviceType = VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
 
+    intel_pipeline_cache_get_uuid(gpu, props->pipelineCacheUUID);
+
     /* copy GPU name */
     name = gpu_get_name(gpu);
     name_len = strlen(name);
@@ -1992,6 +1992,27 @@ drm_intel_gem_bo_clear_relocs(drm_intel_bo *bo, int start)
 
 }
 
+/**
+ * Removes all relocations from the buffer and forgets that it has been the
+ * target of relocations, so that it can be filled and have relocations added
+ * again as if it had just been allocated.
+ *
+ * The caller must make sure that no buffer with a relocation to this one is
+ * executed again.
+ */
+drm_public void
+drm_intel_gem_bo_reset_relocs(drm_intel_bo *bo)
+{
+	drm_intel_bufmgr_gem *bufmgr_gem = (drm_intel_bufmgr_gem *) bo->bufmgr;
+	drm_intel_bo_gem *bo_gem = (drm_intel_bo_gem *) bo;
+
+	drm_intel_gem_bo_clear_relocs(bo, 0);
+
+	bo_gem->used_as_reloc_target = false;
+	bo_gem->reloc_tree_fences = 0;
+	drm_intel_bo_gem_set_in_aperture_size(bufmgr_gem, bo_gem);
+}
+
 /**
  * Walk the tree of relocations rooted at BO and accumulate the list of
  * validations to be performed and update the relocation buffers with
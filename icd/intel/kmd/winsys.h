@@ -291,6 +291,14 @@ intel_bo_get_reloc_count(struct intel_bo *bo);
 void
 intel_bo_truncate_relocs(struct intel_bo *bo, int start);
 
+/**
+ * Remove all relocations and forget that \p bo has been a relocation target,
+ * so that it can be reused as if it were newly allocated.  No bo with a
+ * relocation to \p bo may be submitted again.
+ */
+void
+intel_bo_reset_relocs(struct intel_bo *bo);
+
 /**
  * Return true if \p target_bo is on the relocation list of \p bo, or on
  * the relocation list of some bo that is referenced by \p bo.
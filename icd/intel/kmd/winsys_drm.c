@@ -579,6 +579,12 @@ intel_bo_truncate_relocs(struct intel_bo *bo, int start)
    drm_intel_gem_bo_clear_relocs(gem_bo(bo), start);
 }
 
+void
+intel_bo_reset_relocs(struct intel_bo *bo)
+{
+   drm_intel_gem_bo_reset_relocs(gem_bo(bo));
+}
+
 bool
 intel_bo_has_reloc(struct intel_bo *bo, struct intel_bo *target_bo)
 {
@@ -25,10 +25,12 @@
 
 #include "genhw/genhw.h"
 #include "compiler/pipeline/pipeline_compiler_interface.h"
+#include "compiler/mesa-utils/src/glsl/threadpool.h"
 #include "cmd.h"
 #include "format.h"
 #include "shader.h"
 #include "pipeline.h"
+#include "pipeline_cache.h"
 #include "mem.h"
 
 static int translate_blend_func(VkBlendOp func)
@@ -142,6 +144,27 @@ struct intel_pipeline_create_info {
     VkPipelineShaderStageCreateInfo        tes;
     VkPipelineShaderStageCreateInfo        gs;
     VkPipelineShaderStageCreateInfo        fs;
+
+    struct intel_pipeline_cache           *cache;
+};
+
+/* a stage of a pipeline being created, compiled by pipeline_run_shader_jobs() */
+struct intel_pipeline_shader_job {
+    struct intel_pipeline *pipeline;
+    struct intel_pipeline_cache *cache;
+    const VkPipelineShaderStageCreateInfo *sh_info;
+    struct intel_pipeline_shader *sh;
+    VkResult ret;
+};
+
+/* a pipeline of a vkCreateGraphicsPipelines() call */
+struct intel_pipeline_create_job {
+    struct intel_pipeline_create_info info;
+    struct intel_pipeline *pipeline;
+    VkResult ret;
+
+    struct intel_pipeline_shader_job shaders[6];
+    uint32_t shader_count;
 };
 
 /* in S1.3 */
@@ -254,61 +277,187 @@ void intel_pipeline_shader_destroy(struct intel_dev *dev,
     intel_free(dev, sh);
 }
 
-static VkResult pipeline_build_shader(struct intel_pipeline *pipeline,
+/*
+ * Compile one stage.  Stages of different pipelines are compiled in
+ * parallel, but a module's IR is linked in place by the backend, so
+ * compiles of the same module are serialized.
+ */
+static VkResult pipeline_compile_shader(struct intel_pipeline *pipeline,
+                                        struct intel_pipeline_cache *cache,
                                         const VkPipelineShaderStageCreateInfo *sh_info,
                                         struct intel_pipeline_shader *sh)
 {
     struct intel_shader_module *mod =
         intel_shader_module(sh_info->module);
-    const struct intel_ir *ir =
-        intel_shader_module_get_ir(mod, sh_info->stage);
-    VkResult ret;
+    struct intel_pipeline_cache_key key;
+    bool cached = false;
+    VkResult ret = VK_SUCCESS;
 
-    if (!ir)
-        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    if (cache) {
+        if (!intel_pipeline_cache_key_init(&key, cache, sh_info,
+                    pipeline->pipeline_layout))
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
 
-    ret = intel_pipeline_shader_compile(sh,
-            pipeline->dev->gpu, pipeline->pipeline_layout, sh_info, ir);
+        cached = intel_pipeline_cache_lookup(cache, &key, sh);
+    }
 
-    if (ret != VK_SUCCESS)
-        return ret;
+    if (!cached) {
+        const struct intel_ir *ir;
+
+        pthread_mutex_lock(&mod->compile_mutex);
 
-    sh->max_threads =
-        intel_gpu_get_max_threads(pipeline->dev->gpu, sh_info->stage);
+        ir = intel_shader_module_get_ir(mod, sh_info->stage);
+        if (ir) {
+            ret = intel_pipeline_shader_compile(sh, pipeline->dev->gpu,
+                    pipeline->pipeline_layout, sh_info, ir);
+        } else {
+            ret = VK_ERROR_OUT_OF_HOST_MEMORY;
+        }
 
-    /* 1KB aligned */
-    sh->scratch_offset = u_align(pipeline->scratch_size, 1024);
-    pipeline->scratch_size = sh->scratch_offset +
-        sh->per_thread_scratch_size * sh->max_threads;
+        pthread_mutex_unlock(&mod->compile_mutex);
 
-    pipeline->active_shaders |= sh_info->stage;
+        if (cache && ret == VK_SUCCESS)
+            intel_pipeline_cache_insert(cache, &key, sh);
+    }
 
-    return VK_SUCCESS;
+    if (cache)
+        intel_pipeline_cache_key_cleanup(&key, cache);
+
+    return ret;
+}
+
+static void pipeline_shader_job_run(void *data)
+{
+    struct intel_pipeline_shader_job *job =
+        (struct intel_pipeline_shader_job *) data;
+
+    job->ret = pipeline_compile_shader(job->pipeline, job->cache,
+            job->sh_info, job->sh);
+}
+
+static void pipeline_shader_job_init(struct intel_pipeline_create_job *job,
+                                     const VkPipelineShaderStageCreateInfo *sh_info,
+                                     struct intel_pipeline_shader *sh)
+{
+    struct intel_pipeline_shader_job *sh_job =
+        &job->shaders[job->shader_count++];
+
+    assert(job->shader_count <= ARRAY_SIZE(job->shaders));
+
+    sh_job->pipeline = job->pipeline;
+    sh_job->cache = job->info.cache;
+    sh_job->sh_info = sh_info;
+    sh_job->sh = sh;
+    /* until the job has run */
+    sh_job->ret = VK_ERROR_INITIALIZATION_FAILED;
+}
+
+/* list the stages to compile, in the order they are set up afterwards */
+static void pipeline_init_shader_jobs(struct intel_pipeline_create_job *job)
+{
+    const struct intel_pipeline_create_info *info = &job->info;
+    struct intel_pipeline *pipeline = job->pipeline;
+
+    job->shader_count = 0;
+
+    if (info->vs.module)
+        pipeline_shader_job_init(job, &info->vs, &pipeline->vs);
+    if (info->tcs.module)
+        pipeline_shader_job_init(job, &info->tcs, &pipeline->tcs);
+    if (info->tes.module)
+        pipeline_shader_job_init(job, &info->tes, &pipeline->tes);
+    if (info->gs.module)
+        pipeline_shader_job_init(job, &info->gs, &pipeline->gs);
+    if (info->fs.module)
+        pipeline_shader_job_init(job, &info->fs, &pipeline->fs);
+    if (info->compute.stage.module)
+        pipeline_shader_job_init(job, &info->compute.stage, &pipeline->cs);
+}
+
+/*
+ * Compile the stages of all jobs on the device's compile pool.  The calling
+ * thread runs whatever has not been picked up by the time it waits, so a
+ * single stage is never slower than compiling it directly.
+ */
+static void pipeline_run_shader_jobs(struct intel_dev *dev,
+                                     struct intel_pipeline_create_job *jobs,
+                                     uint32_t job_count)
+{
+    struct _mesa_threadpool_task **tasks = NULL;
+    uint32_t shader_count = 0, task_count = 0;
+    uint32_t i, j;
+
+    for (i = 0; i < job_count; i++) {
+        if (jobs[i].ret == VK_SUCCESS)
+            shader_count += jobs[i].shader_count;
+    }
+
+    if (dev->compile_pool && shader_count > 1) {
+        tasks = intel_alloc(dev, sizeof(tasks[0]) * shader_count,
+                sizeof(int), VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    }
+
+    for (i = 0; i < job_count; i++) {
+        if (jobs[i].ret != VK_SUCCESS)
+            continue;
+
+        for (j = 0; j < jobs[i].shader_count; j++) {
+            struct intel_pipeline_shader_job *sh_job = &jobs[i].shaders[j];
+            struct _mesa_threadpool_task *task = NULL;
+
+            if (tasks) {
+                task = _mesa_threadpool_queue_task(dev->compile_pool,
+                        pipeline_shader_job_run, sh_job);
+            }
+
+            if (task)
+                tasks[task_count++] = task;
+            else
+                pipeline_shader_job_run(sh_job);
+        }
+    }
+
+    if (task_count) {
+        _mesa_threadpool_complete_tasks(dev->compile_pool, tasks,
+                task_count);
+    }
+
+    intel_free(dev, tasks);
 }
 
+/* set up the compiled stages in order; stage scratch space is packed */
 static VkResult pipeline_build_shaders(struct intel_pipeline *pipeline,
-                                         const struct intel_pipeline_create_info *info)
+                                       const struct intel_pipeline_create_job *job)
 {
     VkResult ret = VK_SUCCESS;
+    uint32_t i;
 
-    if (ret == VK_SUCCESS && info->vs.module)
-        ret = pipeline_build_shader(pipeline, &info->vs, &pipeline->vs);
-    if (ret == VK_SUCCESS && info->tcs.module)
-        ret = pipeline_build_shader(pipeline, &info->tcs,&pipeline->tcs);
-    if (ret == VK_SUCCESS && info->tes.module)
-        ret = pipeline_build_shader(pipeline, &info->tes,&pipeline->tes);
-    if (ret == VK_SUCCESS && info->gs.module)
-        ret = pipeline_build_shader(pipeline, &info->gs, &pipeline->gs);
-    if (ret == VK_SUCCESS && info->fs.module)
-        ret = pipeline_build_shader(pipeline, &info->fs, &pipeline->fs);
-
-    if (ret == VK_SUCCESS && info->compute.stage.module) {
-        ret = pipeline_build_shader(pipeline,
-                &info->compute.stage, &pipeline->cs);
+    for (i = 0; i < job->shader_count; i++) {
+        const struct intel_pipeline_shader_job *sh_job = &job->shaders[i];
+        struct intel_pipeline_shader *sh = sh_job->sh;
+
+        /* keep going so that every compiled stage is cleaned up */
+        if (sh_job->ret != VK_SUCCESS) {
+            if (ret == VK_SUCCESS)
+                ret = sh_job->ret;
+            continue;
+        }
+
+        sh->max_threads =
+            intel_gpu_get_max_threads(pipeline->dev->gpu,
+                    sh_job->sh_info->stage);
+
+        /* 1KB aligned */
+        sh->scratch_offset = u_align(pipeline->scratch_size, 1024);
+        pipeline->scratch_size = sh->scratch_offset +
+            sh->per_thread_scratch_size * sh->max_threads;
+
+        pipeline->active_shaders |= sh_job->sh_info->stage;
     }
 
     return ret;
 }
+
 static uint32_t *pipeline_cmd_ptr(struct intel_pipeline *pipeline, int cmd_len)
 {
     uint32_t *ptr;
@@ -1143,13 +1292,14 @@ static void pipeline_build_state(struct intel_pipeline *pipeline,
 
 
 static VkResult pipeline_build_all(struct intel_pipeline *pipeline,
-                                   const struct intel_pipeline_create_info *info)
+                                   const struct intel_pipeline_create_job *job)
 {
+    const struct intel_pipeline_create_info *info = &job->info;
     VkResult ret;
 
     pipeline_build_state(pipeline, info);
 
-    ret = pipeline_build_shaders(pipeline, info);
+    ret = pipeline_build_shaders(pipeline, job);
     if (ret != VK_SUCCESS)
         return ret;
 
@@ -1325,19 +1475,25 @@ static VkResult pipeline_create_info_init(struct intel_pipeline_create_info  *in
     return VK_SUCCESS;
 }
 
-static VkResult graphics_pipeline_create(struct intel_dev *dev,
-                                         const VkGraphicsPipelineCreateInfo *info_,
-                                         struct intel_pipeline **pipeline_ret)
+/* create the pipeline object of job and list its stages to compile */
+static VkResult graphics_pipeline_begin(struct intel_dev *dev,
+                                        struct intel_pipeline_cache *cache,
+                                        const VkGraphicsPipelineCreateInfo *info_,
+                                        struct intel_pipeline_create_job *job)
 {
-    struct intel_pipeline_create_info info;
     struct intel_pipeline *pipeline;
     VkResult ret;
 
-    ret = pipeline_create_info_init(&info, info_);
+    job->pipeline = NULL;
+    job->shader_count = 0;
+
+    ret = pipeline_create_info_init(&job->info, info_);
 
     if (ret != VK_SUCCESS)
         return ret;
 
+    job->info.cache = cache;
+
     pipeline = (struct intel_pipeline *) intel_base_create(&dev->base.handle,
                         sizeof (*pipeline), dev->base.dbg,
                         VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT, info_, 0);
@@ -1345,11 +1501,24 @@ static VkResult graphics_pipeline_create(struct intel_dev *dev,
         return VK_ERROR_OUT_OF_HOST_MEMORY;
 
     pipeline->dev = dev;
-    pipeline->pipeline_layout = intel_pipeline_layout(info.graphics.layout);
+    pipeline->pipeline_layout = intel_pipeline_layout(job->info.graphics.layout);
 
     pipeline->obj.destroy = pipeline_destroy;
 
-    ret = pipeline_build_all(pipeline, &info);
+    job->pipeline = pipeline;
+    pipeline_init_shader_jobs(job);
+
+    return VK_SUCCESS;
+}
+
+/* build the rest of the pipeline once its stages are compiled */
+static VkResult graphics_pipeline_end(struct intel_dev *dev,
+                                      struct intel_pipeline_create_job *job)
+{
+    struct intel_pipeline *pipeline = job->pipeline;
+    VkResult ret;
+
+    ret = pipeline_build_all(pipeline, job);
     if (ret != VK_SUCCESS) {
         pipeline_destroy(&pipeline->obj);
         return ret;
@@ -1362,47 +1531,9 @@ static VkResult graphics_pipeline_create(struct intel_dev *dev,
     mem_reqs.memoryTypeIndex = 0;
     intel_mem_alloc(dev, &mem_reqs, &pipeline->obj.mem);
 
-    *pipeline_ret = pipeline;
     return VK_SUCCESS;
 }
 
-VKAPI_ATTR VkResult VKAPI_CALL vkCreatePipelineCache(
-    VkDevice                                    device,
-    const VkPipelineCacheCreateInfo*            pCreateInfo,
-    const VkAllocationCallbacks*                     pAllocator,
-    VkPipelineCache*                            pPipelineCache)
-{
-
-    // non-dispatchable objects only need to be 64 bits currently
-    *((uint64_t *)pPipelineCache) = 1;
-    return VK_SUCCESS;
-}
-
-VKAPI_ATTR void VKAPI_CALL vkDestroyPipelineCache(
-    VkDevice                                    device,
-    VkPipelineCache                             pipelineCache,
-    const VkAllocationCallbacks*                     pAllocator)
-{
-}
-
-VKAPI_ATTR VkResult VKAPI_CALL vkGetPipelineCacheData(
-    VkDevice                                    device,
-    VkPipelineCache                             pipelineCache,
-    size_t*                                     pDataSize,
-    void*                                       pData)
-{
-    return VK_ERROR_VALIDATION_FAILED_EXT;
-}
-
-VKAPI_ATTR VkResult VKAPI_CALL vkMergePipelineCaches(
-    VkDevice                                    device,
-    VkPipelineCache                             dstCache,
-    uint32_t                                    srcCacheCount,
-    const VkPipelineCache*                      pSrcCaches)
-{
-    return VK_ERROR_VALIDATION_FAILED_EXT;
-}
-
 VKAPI_ATTR VkResult VKAPI_CALL vkCreateGraphicsPipelines(
     VkDevice                                  device,
     VkPipelineCache                           pipelineCache,
@@ -1412,19 +1543,44 @@ VKAPI_ATTR VkResult VKAPI_CALL vkCreateGraphicsPipelines(
     VkPipeline*                               pPipelines)
 {
     struct intel_dev *dev = intel_dev(device);
+    struct intel_pipeline_cache *cache = intel_pipeline_cache(pipelineCache);
+    struct intel_pipeline_create_job *jobs;
     uint32_t i;
     VkResult res = VK_SUCCESS;
     bool one_succeeded = false;
 
+    jobs = intel_alloc(dev, sizeof(jobs[0]) * createInfoCount, sizeof(int),
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (!jobs) {
+        for (i = 0; i < createInfoCount; i++)
+            pPipelines[i] = VK_NULL_HANDLE;
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
     for (i = 0; i < createInfoCount; i++) {
-        res =  graphics_pipeline_create(dev, &(pCreateInfos[i]),
-            (struct intel_pipeline **) &(pPipelines[i]));
+        jobs[i].ret = graphics_pipeline_begin(dev, cache, &pCreateInfos[i],
+                &jobs[i]);
+    }
+
+    /* the stages of all pipelines are independent */
+    pipeline_run_shader_jobs(dev, jobs, createInfoCount);
+
+    for (i = 0; i < createInfoCount; i++) {
+        res = jobs[i].ret;
+        if (res == VK_SUCCESS)
+            res = graphics_pipeline_end(dev, &jobs[i]);
+
         //return NULL handle for unsuccessful creates
-        if (res != VK_SUCCESS)
+        if (res != VK_SUCCESS) {
             pPipelines[i] = VK_NULL_HANDLE;
-        else
+        } else {
+            *(struct intel_pipeline **) &pPipelines[i] = jobs[i].pipeline;
             one_succeeded = true;
+        }
     }
+
+    intel_free(dev, jobs);
+
     //return VK_SUCCESS if any of count creates succeeded
     if (one_succeeded)
         return VK_SUCCESS;
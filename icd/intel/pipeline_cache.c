@@ -0,0 +1,696 @@
+/*
+ *
+ * Copyright (C) 2016 Valve Corporation
+ * Copyright (C) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "desc.h"
+#include "dev.h"
+#include "gpu.h"
+#include "pipeline.h"
+#include "shader.h"
+#include "pipeline_cache.h"
+
+#define PIPELINE_CACHE_MIN_BUCKETS 64
+
+/*
+ * A cached shader.  The scalar state is kept in sh and rmap, with their
+ * pointers cleared; the rmap slots, the kernel and the key are stored right
+ * after the entry, in the same allocation.
+ */
+struct intel_pipeline_cache_entry {
+    struct intel_pipeline_cache_entry *next;
+    uint64_t hash;
+
+    struct intel_pipeline_shader sh;
+    struct intel_pipeline_rmap rmap;
+
+    const struct intel_pipeline_rmap_slot *slots;
+    const void *code;
+    const void *key;
+    uint32_t key_size;
+};
+
+/*
+ * vkGetPipelineCacheData() returns the header followed by the entries, each
+ * of them an intel_pipeline_cache_entry_data followed by the rmap slots, the
+ * kernel and the key.  Entries are only ever written whole, so data cut
+ * short by a small buffer still loads.
+ */
+struct intel_pipeline_cache_header {
+    uint32_t header_size;
+    uint32_t header_version;
+    uint32_t vendor_id;
+    uint32_t device_id;
+    uint8_t uuid[VK_UUID_SIZE];
+};
+
+struct intel_pipeline_cache_entry_data {
+    uint32_t key_size;
+    uint32_t code_size;
+    uint32_t slot_count;
+    uint32_t reserved;
+
+    struct intel_pipeline_shader sh;
+    struct intel_pipeline_rmap rmap;
+};
+
+/* FNV-1a */
+static uint64_t pipeline_cache_hash(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+static size_t pipeline_cache_entry_data_size(const struct intel_pipeline_cache_entry *entry)
+{
+    return sizeof(struct intel_pipeline_cache_entry_data) +
+        sizeof(entry->slots[0]) * entry->rmap.slot_count +
+        entry->sh.codeSize + entry->key_size;
+}
+
+static struct intel_pipeline_cache_entry *
+pipeline_cache_entry_create(struct intel_pipeline_cache *cache,
+                            const struct intel_pipeline_shader *sh,
+                            const struct intel_pipeline_rmap *rmap,
+                            const void *slots, const void *code,
+                            const void *key, uint32_t key_size,
+                            uint64_t hash)
+{
+    const size_t slots_size =
+        sizeof(struct intel_pipeline_rmap_slot) * rmap->slot_count;
+    struct intel_pipeline_cache_entry *entry;
+    uint8_t *ptr;
+
+    entry = intel_alloc(cache, sizeof(*entry) + slots_size +
+            sh->codeSize + key_size, sizeof(uint64_t),
+            VK_SYSTEM_ALLOCATION_SCOPE_CACHE);
+    if (!entry)
+        return NULL;
+
+    entry->next = NULL;
+    entry->hash = hash;
+
+    entry->sh = *sh;
+    entry->sh.pCode = NULL;
+    entry->sh.rmap = NULL;
+    entry->sh.max_threads = 0;
+    entry->sh.scratch_offset = 0;
+
+    entry->rmap = *rmap;
+    entry->rmap.slots = NULL;
+
+    ptr = (uint8_t *) (entry + 1);
+
+    memcpy(ptr, slots, slots_size);
+    entry->slots = (const struct intel_pipeline_rmap_slot *) ptr;
+    ptr += slots_size;
+
+    memcpy(ptr, code, sh->codeSize);
+    entry->code = ptr;
+    ptr += sh->codeSize;
+
+    memcpy(ptr, key, key_size);
+    entry->key = ptr;
+    entry->key_size = key_size;
+
+    return entry;
+}
+
+static struct intel_pipeline_cache_entry *
+pipeline_cache_find_locked(const struct intel_pipeline_cache *cache,
+                           const void *key, uint32_t key_size, uint64_t hash)
+{
+    struct intel_pipeline_cache_entry *entry;
+
+    entry = cache->buckets[hash & (cache->bucket_count - 1)];
+    for (; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->key_size == key_size &&
+            !memcmp(entry->key, key, key_size))
+            return entry;
+    }
+
+    return NULL;
+}
+
+static void pipeline_cache_grow_locked(struct intel_pipeline_cache *cache)
+{
+    const uint32_t bucket_count = cache->bucket_count * 2;
+    struct intel_pipeline_cache_entry **buckets;
+    uint32_t i;
+
+    buckets = intel_alloc(cache, sizeof(buckets[0]) * bucket_count,
+            sizeof(int), VK_SYSTEM_ALLOCATION_SCOPE_CACHE);
+    /* keep the longer chains rather than fail */
+    if (!buckets)
+        return;
+
+    memset(buckets, 0, sizeof(buckets[0]) * bucket_count);
+
+    for (i = 0; i < cache->bucket_count; i++) {
+        struct intel_pipeline_cache_entry *entry = cache->buckets[i];
+
+        while (entry) {
+            struct intel_pipeline_cache_entry *next = entry->next;
+            const uint32_t b = entry->hash & (bucket_count - 1);
+
+            entry->next = buckets[b];
+            buckets[b] = entry;
+            entry = next;
+        }
+    }
+
+    intel_free(cache, cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = bucket_count;
+}
+
+/* take ownership of entry, or free it when the key is already cached */
+static void pipeline_cache_add_locked(struct intel_pipeline_cache *cache,
+                                      struct intel_pipeline_cache_entry *entry)
+{
+    uint32_t b;
+
+    if (pipeline_cache_find_locked(cache, entry->key, entry->key_size,
+                entry->hash)) {
+        intel_free(cache, entry);
+        return;
+    }
+
+    if (cache->entry_count >= cache->bucket_count)
+        pipeline_cache_grow_locked(cache);
+
+    b = entry->hash & (cache->bucket_count - 1);
+    entry->next = cache->buckets[b];
+    cache->buckets[b] = entry;
+
+    cache->entry_count++;
+    cache->data_size += pipeline_cache_entry_data_size(entry);
+}
+
+static void pipeline_cache_init_header(const struct intel_gpu *gpu,
+                                       struct intel_pipeline_cache_header *header)
+{
+    memset(header, 0, sizeof(*header));
+    header->header_size = sizeof(*header);
+    header->header_version = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    header->vendor_id = 0x8086;
+    header->device_id = gpu->devid;
+    intel_pipeline_cache_get_uuid(gpu, header->uuid);
+}
+
+/*
+ * Load the entries of data saved by vkGetPipelineCacheData().  Data saved
+ * for another device or by another driver build is ignored, as is anything
+ * after the last complete entry.
+ */
+static void pipeline_cache_load(struct intel_pipeline_cache *cache,
+                                const void *data, size_t size)
+{
+    struct intel_pipeline_cache_header expected, header;
+    const uint8_t *ptr = (const uint8_t *) data;
+    const uint8_t *end = ptr + size;
+
+    if (size < sizeof(header))
+        return;
+
+    pipeline_cache_init_header(cache->gpu, &expected);
+    memcpy(&header, ptr, sizeof(header));
+    if (header.header_size < sizeof(header) ||
+        header.header_size > size ||
+        header.header_version != expected.header_version ||
+        header.vendor_id != expected.vendor_id ||
+        header.device_id != expected.device_id ||
+        memcmp(header.uuid, expected.uuid, sizeof(header.uuid)))
+        return;
+
+    ptr += header.header_size;
+
+    while ((size_t) (end - ptr) >= sizeof(struct intel_pipeline_cache_entry_data)) {
+        struct intel_pipeline_cache_entry_data entry_data;
+        struct intel_pipeline_cache_entry *entry;
+        const uint8_t *slots, *code, *key;
+        size_t slots_size;
+
+        memcpy(&entry_data, ptr, sizeof(entry_data));
+        ptr += sizeof(entry_data);
+
+        if (entry_data.code_size != entry_data.sh.codeSize ||
+            entry_data.slot_count != entry_data.rmap.slot_count)
+            break;
+
+        slots_size = sizeof(struct intel_pipeline_rmap_slot) *
+            (size_t) entry_data.slot_count;
+        if ((size_t) (end - ptr) < slots_size ||
+            (size_t) (end - ptr) - slots_size < entry_data.code_size ||
+            (size_t) (end - ptr) - slots_size - entry_data.code_size <
+                entry_data.key_size)
+            break;
+
+        slots = ptr;
+        code = slots + slots_size;
+        key = code + entry_data.code_size;
+        ptr = key + entry_data.key_size;
+
+        entry = pipeline_cache_entry_create(cache, &entry_data.sh,
+                &entry_data.rmap, slots, code, key, entry_data.key_size,
+                pipeline_cache_hash(key, entry_data.key_size));
+        if (!entry)
+            break;
+
+        pipeline_cache_add_locked(cache, entry);
+    }
+}
+
+static void pipeline_cache_destroy(struct intel_obj *obj)
+{
+    struct intel_pipeline_cache *cache = intel_pipeline_cache_from_obj(obj);
+
+    intel_pipeline_cache_destroy(cache);
+}
+
+void intel_pipeline_cache_get_uuid(const struct intel_gpu *gpu,
+                                   uint8_t uuid[VK_UUID_SIZE])
+{
+    const uint32_t version = INTEL_PIPELINE_CACHE_VERSION;
+    const uint32_t gen = intel_gpu_gen(gpu);
+    const uint16_t shader_size = sizeof(struct intel_pipeline_shader);
+    const uint16_t slot_size = sizeof(struct intel_pipeline_rmap_slot);
+
+    /* what the cached kernels and the serialized structs depend on */
+    memset(uuid, 0, VK_UUID_SIZE);
+    memcpy(uuid, "i965", 4);
+    memcpy(uuid + 4, &version, sizeof(version));
+    memcpy(uuid + 8, &gen, sizeof(gen));
+    memcpy(uuid + 12, &shader_size, sizeof(shader_size));
+    memcpy(uuid + 14, &slot_size, sizeof(slot_size));
+}
+
+VkResult intel_pipeline_cache_create(struct intel_dev *dev,
+                                     const VkPipelineCacheCreateInfo *info,
+                                     struct intel_pipeline_cache **cache_ret)
+{
+    struct intel_pipeline_cache *cache;
+
+    cache = (struct intel_pipeline_cache *) intel_base_create(&dev->base.handle,
+            sizeof(*cache), dev->base.dbg,
+            VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_CACHE_EXT, info, 0);
+    if (!cache)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    cache->gpu = dev->gpu;
+    pthread_mutex_init(&cache->mutex, NULL);
+
+    cache->bucket_count = PIPELINE_CACHE_MIN_BUCKETS;
+    cache->buckets = intel_alloc(cache,
+            sizeof(cache->buckets[0]) * cache->bucket_count, sizeof(int),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    if (!cache->buckets) {
+        intel_pipeline_cache_destroy(cache);
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+    memset(cache->buckets, 0,
+            sizeof(cache->buckets[0]) * cache->bucket_count);
+
+    cache->obj.destroy = pipeline_cache_destroy;
+
+    if (info->initialDataSize)
+        pipeline_cache_load(cache, info->pInitialData, info->initialDataSize);
+
+    *cache_ret = cache;
+
+    return VK_SUCCESS;
+}
+
+void intel_pipeline_cache_destroy(struct intel_pipeline_cache *cache)
+{
+    uint32_t i;
+
+    for (i = 0; cache->buckets && i < cache->bucket_count; i++) {
+        struct intel_pipeline_cache_entry *entry = cache->buckets[i];
+
+        while (entry) {
+            struct intel_pipeline_cache_entry *next = entry->next;
+
+            intel_free(cache, entry);
+            entry = next;
+        }
+    }
+
+    intel_free(cache, cache->buckets);
+    pthread_mutex_destroy(&cache->mutex);
+
+    intel_base_destroy(&cache->obj.base);
+}
+
+static void key_write(uint8_t *data, size_t *size,
+                      const void *src, size_t src_size)
+{
+    if (data)
+        memcpy(data + *size, src, src_size);
+    *size += src_size;
+}
+
+static void key_write_u32(uint8_t *data, size_t *size, uint32_t val)
+{
+    key_write(data, size, &val, sizeof(val));
+}
+
+/* write the key to data, or only count its size when data is NULL */
+static size_t key_write_all(uint8_t *data,
+                            const VkPipelineShaderStageCreateInfo *sh_info,
+                            const struct intel_pipeline_layout *pipeline_layout)
+{
+    const struct intel_shader_module *mod =
+        intel_shader_module(sh_info->module);
+    const VkSpecializationInfo *spec = sh_info->pSpecializationInfo;
+    const uint32_t name_len = strlen(sh_info->pName);
+    size_t size = 0;
+    uint32_t i, j;
+
+    key_write_u32(data, &size, sh_info->stage);
+
+    key_write_u32(data, &size, mod->code_size);
+    key_write(data, &size, mod->code, mod->code_size);
+
+    key_write_u32(data, &size, name_len);
+    key_write(data, &size, sh_info->pName, name_len);
+
+    if (spec) {
+        key_write_u32(data, &size, spec->mapEntryCount);
+        for (i = 0; i < spec->mapEntryCount; i++) {
+            const VkSpecializationMapEntry *ent = &spec->pMapEntries[i];
+
+            key_write_u32(data, &size, ent->constantID);
+            key_write_u32(data, &size, ent->offset);
+            key_write_u32(data, &size, (uint32_t) ent->size);
+        }
+
+        key_write_u32(data, &size, (uint32_t) spec->dataSize);
+        key_write(data, &size, spec->pData, spec->dataSize);
+    } else {
+        key_write_u32(data, &size, 0);
+        key_write_u32(data, &size, 0);
+    }
+
+    /* the rmap is built from where each binding lives in its set */
+    key_write_u32(data, &size, pipeline_layout->layout_count);
+    for (i = 0; i < pipeline_layout->layout_count; i++) {
+        const struct intel_desc_layout *layout = pipeline_layout->layouts[i];
+
+        key_write_u32(data, &size, pipeline_layout->dynamic_desc_indices[i]);
+        key_write_u32(data, &size, layout->binding_count);
+
+        for (j = 0; j < layout->binding_count; j++) {
+            const struct intel_desc_layout_binding *binding =
+                &layout->bindings[j];
+
+            key_write_u32(data, &size, binding->binding);
+            key_write_u32(data, &size, binding->type);
+            key_write_u32(data, &size, binding->array_size);
+            key_write_u32(data, &size, binding->offset.surface);
+            key_write_u32(data, &size, binding->offset.sampler);
+            key_write_u32(data, &size, binding->increment.surface);
+            key_write_u32(data, &size, binding->increment.sampler);
+        }
+    }
+
+    return size;
+}
+
+bool intel_pipeline_cache_key_init(struct intel_pipeline_cache_key *key,
+                                   const struct intel_pipeline_cache *cache,
+                                   const VkPipelineShaderStageCreateInfo *sh_info,
+                                   const struct intel_pipeline_layout *pipeline_layout)
+{
+    key->size = key_write_all(NULL, sh_info, pipeline_layout);
+    key->data = intel_alloc(cache, key->size, sizeof(int),
+            VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (!key->data)
+        return false;
+
+    key_write_all(key->data, sh_info, pipeline_layout);
+    key->hash = pipeline_cache_hash(key->data, key->size);
+
+    return true;
+}
+
+void intel_pipeline_cache_key_cleanup(struct intel_pipeline_cache_key *key,
+                                      const struct intel_pipeline_cache *cache)
+{
+    intel_free(cache, key->data);
+    key->data = NULL;
+}
+
+/*
+ * Give sh a copy of the cached shader, allocated the way the compiler
+ * allocates them, so that intel_pipeline_shader_cleanup() frees it.
+ */
+bool intel_pipeline_cache_lookup(struct intel_pipeline_cache *cache,
+                                 const struct intel_pipeline_cache_key *key,
+                                 struct intel_pipeline_shader *sh)
+{
+    const struct intel_pipeline_cache_entry *entry;
+    const struct intel_gpu *gpu = cache->gpu;
+    size_t slots_size;
+
+    pthread_mutex_lock(&cache->mutex);
+    entry = pipeline_cache_find_locked(cache, key->data, key->size, key->hash);
+    pthread_mutex_unlock(&cache->mutex);
+
+    /* entries live until the cache is destroyed */
+    if (!entry)
+        return false;
+
+    *sh = entry->sh;
+
+    sh->pCode = intel_alloc(gpu, entry->sh.codeSize, sizeof(int),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    sh->rmap = intel_alloc(gpu, sizeof(*sh->rmap), sizeof(int),
+            VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    if (!sh->pCode || !sh->rmap) {
+        intel_free(gpu, sh->pCode);
+        intel_free(gpu, sh->rmap);
+        memset(sh, 0, sizeof(*sh));
+        return false;
+    }
+
+    memcpy(sh->pCode, entry->code, entry->sh.codeSize);
+    *sh->rmap = entry->rmap;
+
+    slots_size = sizeof(entry->slots[0]) * entry->rmap.slot_count;
+    if (slots_size) {
+        sh->rmap->slots = intel_alloc(gpu, slots_size, sizeof(int),
+                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+        if (!sh->rmap->slots) {
+            intel_free(gpu, sh->pCode);
+            intel_free(gpu, sh->rmap);
+            memset(sh, 0, sizeof(*sh));
+            return false;
+        }
+        memcpy(sh->rmap->slots, entry->slots, slots_size);
+    }
+
+    return true;
+}
+
+void intel_pipeline_cache_insert(struct intel_pipeline_cache *cache,
+                                 const struct intel_pipeline_cache_key *key,
+                                 const struct intel_pipeline_shader *sh)
+{
+    struct intel_pipeline_cache_entry *entry;
+
+    if (!sh->rmap)
+        return;
+
+    entry = pipeline_cache_entry_create(cache, sh, sh->rmap, sh->rmap->slots,
+            sh->pCode, key->data, key->size, key->hash);
+    if (!entry)
+        return;
+
+    pthread_mutex_lock(&cache->mutex);
+    pipeline_cache_add_locked(cache, entry);
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+VkResult intel_pipeline_cache_get_data(struct intel_pipeline_cache *cache,
+                                       size_t *size, void *data)
+{
+    struct intel_pipeline_cache_header header;
+    uint8_t *ptr = (uint8_t *) data;
+    size_t avail = *size;
+    VkResult ret = VK_SUCCESS;
+    uint32_t i;
+
+    pthread_mutex_lock(&cache->mutex);
+
+    if (!data) {
+        *size = sizeof(header) + cache->data_size;
+        pthread_mutex_unlock(&cache->mutex);
+        return VK_SUCCESS;
+    }
+
+    if (avail < sizeof(header)) {
+        *size = 0;
+        pthread_mutex_unlock(&cache->mutex);
+        return VK_INCOMPLETE;
+    }
+
+    pipeline_cache_init_header(cache->gpu, &header);
+    memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+    avail -= sizeof(header);
+
+    for (i = 0; i < cache->bucket_count && ret == VK_SUCCESS; i++) {
+        const struct intel_pipeline_cache_entry *entry;
+
+        for (entry = cache->buckets[i]; entry; entry = entry->next) {
+            const size_t slots_size =
+                sizeof(entry->slots[0]) * entry->rmap.slot_count;
+            struct intel_pipeline_cache_entry_data entry_data;
+
+            if (avail < pipeline_cache_entry_data_size(entry)) {
+                ret = VK_INCOMPLETE;
+                break;
+            }
+
+            memset(&entry_data, 0, sizeof(entry_data));
+            entry_data.key_size = entry->key_size;
+            entry_data.code_size = entry->sh.codeSize;
+            entry_data.slot_count = entry->rmap.slot_count;
+            entry_data.sh = entry->sh;
+            entry_data.rmap = entry->rmap;
+
+            memcpy(ptr, &entry_data, sizeof(entry_data));
+            ptr += sizeof(entry_data);
+            memcpy(ptr, entry->slots, slots_size);
+            ptr += slots_size;
+            memcpy(ptr, entry->code, entry->sh.codeSize);
+            ptr += entry->sh.codeSize;
+            memcpy(ptr, entry->key, entry->key_size);
+            ptr += entry->key_size;
+
+            avail -= pipeline_cache_entry_data_size(entry);
+        }
+    }
+
+    pthread_mutex_unlock(&cache->mutex);
+
+    *size = ptr - (uint8_t *) data;
+
+    return ret;
+}
+
+VkResult intel_pipeline_cache_merge(struct intel_pipeline_cache *cache,
+                                    struct intel_pipeline_cache *src)
+{
+    struct intel_pipeline_cache_entry *copies = NULL;
+    VkResult ret = VK_SUCCESS;
+    uint32_t i;
+
+    /* copy first, so that only one of the two caches is locked at a time */
+    pthread_mutex_lock(&src->mutex);
+    for (i = 0; i < src->bucket_count && ret == VK_SUCCESS; i++) {
+        const struct intel_pipeline_cache_entry *entry;
+
+        for (entry = src->buckets[i]; entry; entry = entry->next) {
+            struct intel_pipeline_cache_entry *copy;
+
+            copy = pipeline_cache_entry_create(cache, &entry->sh,
+                    &entry->rmap, entry->slots, entry->code,
+                    entry->key, entry->key_size, entry->hash);
+            if (!copy) {
+                ret = VK_ERROR_OUT_OF_HOST_MEMORY;
+                break;
+            }
+
+            copy->next = copies;
+            copies = copy;
+        }
+    }
+    pthread_mutex_unlock(&src->mutex);
+
+    pthread_mutex_lock(&cache->mutex);
+    while (copies) {
+        struct intel_pipeline_cache_entry *next = copies->next;
+
+        pipeline_cache_add_locked(cache, copies);
+        copies = next;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+
+    return ret;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkCreatePipelineCache(
+    VkDevice                                    device,
+    const VkPipelineCacheCreateInfo*            pCreateInfo,
+    const VkAllocationCallbacks*                     pAllocator,
+    VkPipelineCache*                            pPipelineCache)
+{
+    struct intel_dev *dev = intel_dev(device);
+
+    return intel_pipeline_cache_create(dev, pCreateInfo,
+            (struct intel_pipeline_cache **) pPipelineCache);
+}
+
+VKAPI_ATTR void VKAPI_CALL vkDestroyPipelineCache(
+    VkDevice                                    device,
+    VkPipelineCache                             pipelineCache,
+    const VkAllocationCallbacks*                     pAllocator)
+{
+    struct intel_obj *obj = intel_obj(pipelineCache);
+
+    if (obj)
+        obj->destroy(obj);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetPipelineCacheData(
+    VkDevice                                    device,
+    VkPipelineCache                             pipelineCache,
+    size_t*                                     pDataSize,
+    void*                                       pData)
+{
+    struct intel_pipeline_cache *cache = intel_pipeline_cache(pipelineCache);
+
+    return intel_pipeline_cache_get_data(cache, pDataSize, pData);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL vkMergePipelineCaches(
+    VkDevice                                    device,
+    VkPipelineCache                             dstCache,
+    uint32_t                                    srcCacheCount,
+    const VkPipelineCache*                      pSrcCaches)
+{
+    struct intel_pipeline_cache *cache = intel_pipeline_cache(dstCache);
+    VkResult ret = VK_SUCCESS;
+    uint32_t i;
+
+    for (i = 0; i < srcCacheCount && ret == VK_SUCCESS; i++) {
+        ret = intel_pipeline_cache_merge(cache,
+                intel_pipeline_cache(pSrcCaches[i]));
+    }
+
+    return ret;
+}
@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright (C) 2016 Valve Corporation
+ * Copyright (C) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef PIPELINE_CACHE_H
+#define PIPELINE_CACHE_H
+
+#include <pthread.h>
+
+#include "intel.h"
+#include "obj.h"
+
+struct intel_dev;
+struct intel_gpu;
+struct intel_pipeline_layout;
+struct intel_pipeline_shader;
+struct intel_pipeline_cache_entry;
+
+/*
+ * Bump whenever the compiler output, struct intel_pipeline_shader or the
+ * serialized layout changes, so that data saved by an older driver is
+ * ignored rather than loaded.
+ */
+#define INTEL_PIPELINE_CACHE_VERSION 1
+
+/*
+ * Compiled shaders, keyed by everything their compilation depends on: the
+ * SPIR-V words, the stage and entry point, the specialization constants,
+ * and the descriptor set layouts the resource map is built from.
+ */
+struct intel_pipeline_cache {
+    struct intel_obj obj;
+
+    const struct intel_gpu *gpu;
+
+    pthread_mutex_t mutex;
+
+    struct intel_pipeline_cache_entry **buckets;
+    uint32_t bucket_count;
+    uint32_t entry_count;
+
+    /* size of the data vkGetPipelineCacheData() would return */
+    size_t data_size;
+};
+
+/* the key of one shader stage; see intel_pipeline_cache_key_init() */
+struct intel_pipeline_cache_key {
+    void *data;
+    size_t size;
+    uint64_t hash;
+};
+
+static inline struct intel_pipeline_cache *intel_pipeline_cache(VkPipelineCache pipelineCache)
+{
+    return *(struct intel_pipeline_cache **) &pipelineCache;
+}
+
+static inline struct intel_pipeline_cache *intel_pipeline_cache_from_obj(struct intel_obj *obj)
+{
+    return (struct intel_pipeline_cache *) obj;
+}
+
+void intel_pipeline_cache_get_uuid(const struct intel_gpu *gpu,
+                                   uint8_t uuid[VK_UUID_SIZE]);
+
+VkResult intel_pipeline_cache_create(struct intel_dev *dev,
+                                     const VkPipelineCacheCreateInfo *info,
+                                     struct intel_pipeline_cache **cache_ret);
+void intel_pipeline_cache_destroy(struct intel_pipeline_cache *cache);
+
+bool intel_pipeline_cache_key_init(struct intel_pipeline_cache_key *key,
+                                   const struct intel_pipeline_cache *cache,
+                                   const VkPipelineShaderStageCreateInfo *sh_info,
+                                   const struct intel_pipeline_layout *pipeline_layout);
+void intel_pipeline_cache_key_cleanup(struct intel_pipeline_cache_key *key,
+                                      const struct intel_pipeline_cache *cache);
+
+bool intel_pipeline_cache_lookup(struct intel_pipeline_cache *cache,
+                                 const struct intel_pipeline_cache_key *key,
+                                 struct intel_pipeline_shader *sh);
+void intel_pipeline_cache_insert(struct intel_pipeline_cache *cache,
+                                 const struct intel_pipeline_cache_key *key,
+                                 const struct intel_pipeline_shader *sh);
+
+VkResult intel_pipeline_cache_get_data(struct intel_pipeline_cache *cache,
+                                       size_t *size, void *data);
+VkResult intel_pipeline_cache_merge(struct intel_pipeline_cache *cache,
+                                    struct intel_pipeline_cache *src);
+
+#endif /* PIPELINE_CACHE_H */
@@ -45,6 +45,8 @@ static void shader_module_destroy(struct intel_obj *obj)
     free(sm->code);
     sm->code = 0;
 
+    pthread_mutex_destroy(&sm->compile_mutex);
+
     intel_base_destroy(&sm->obj.base);
 }
 
@@ -95,6 +97,7 @@ static VkResult shader_module_create(struct intel_dev *dev,
         return VK_ERROR_OUT_OF_HOST_MEMORY;
 
     sm->gpu = dev->gpu;
+    pthread_mutex_init(&sm->compile_mutex, NULL);
     sm->code_size = info->codeSize;
     sm->code = malloc(info->codeSize);
     if (!sm->code) {
@@ -23,6 +23,8 @@
 #ifndef SHADER_H
 #define SHADER_H
 
+#include <pthread.h>
+
 #include "intel.h"
 #include "obj.h"
 
@@ -36,6 +38,9 @@ struct intel_shader_module {
     uint32_t code_size;
     void *code;
 
+    /* held while the IR is linked and compiled, which modifies it */
+    pthread_mutex_t compile_mutex;
+
     /* simple cache */
     struct intel_ir *vs;
     struct intel_ir *tcs;
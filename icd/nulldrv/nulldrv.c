@@ -471,6 +471,23 @@ static VkResult graphics_pipeline_create(struct nulldrv_dev *dev,
     return VK_SUCCESS;
 }
 
+static VkResult compute_pipeline_create(struct nulldrv_dev *dev,
+                                          const VkComputePipelineCreateInfo *info_,
+                                          struct nulldrv_pipeline **pipeline_ret)
+{
+    struct nulldrv_pipeline *pipeline;
+
+    pipeline = (struct nulldrv_pipeline *)
+        nulldrv_base_create(dev, sizeof(*pipeline),
+                VK_DEBUG_REPORT_OBJECT_TYPE_PIPELINE_EXT);
+    if (!pipeline)
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+
+    *pipeline_ret = pipeline;
+
+    return VK_SUCCESS;
+}
+
 static VkResult nulldrv_cmd_create(struct nulldrv_dev *dev,
                             const VkCommandBufferAllocateInfo *info,
                             struct nulldrv_cmd **cmd_ret)
@@ -1815,6 +1832,16 @@ VKAPI_ATTR VkResult VKAPI_CALL vkCreateComputePipelines(
     VkPipeline*                               pPipeline)
 {
     NULLDRV_LOG_FUNC;
+    struct nulldrv_dev *dev = nulldrv_dev(device);
+    uint32_t i;
+
+    for (i = 0; i < createInfoCount; i++) {
+        VkResult ret = compute_pipeline_create(dev, &pCreateInfo[i],
+                (struct nulldrv_pipeline **) &pPipeline[i]);
+        if (ret != VK_SUCCESS)
+            return ret;
+    }
+
     return VK_SUCCESS;
 }
 
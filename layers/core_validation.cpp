@@ -60,6 +60,8 @@
 #include "vk_layer_data.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_sampling.h"
+#include "vk_layer_proc_table.h"
 #include "spirv-tools/libspirv.h"
 
 #if defined __ANDROID__
@@ -152,6 +154,8 @@ struct layer_data {
     VkPhysicalDeviceMemoryProperties phys_dev_mem_props;
     VkPhysicalDeviceFeatures physical_device_features;
     unique_ptr<PHYSICAL_DEVICE_STATE> physical_device_state;
+    // Chooses which command buffers get draw time and barrier validation
+    validation_sampler sampler;
 
     layer_data()
         : instance_state(nullptr), report_data(nullptr), device_dispatch_table(nullptr), instance_dispatch_table(nullptr),
@@ -159,8 +163,7 @@ struct layer_data {
           physical_device_state(nullptr){};
 };
 
-// TODO : Do we need to guard access to layer_data_map w/ lock?
-static unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 
 static const VkLayerProperties global_layer = {
     "VK_LAYER_LUNARG_core_validation", VK_LAYER_API_VERSION, 1, "LunarG Validation Layer",
@@ -3017,6 +3020,16 @@ static bool validate_and_update_draw_state(layer_data *my_data, GLOBAL_CB_NODE *
         if (result)
             return true;
     }
+    // Command buffers left out by sampling mode only record the images and buffers this draw may write
+    if (!pCB->sampled && pPipe) {
+        for (auto &setBindingPair : pPipe->active_slots) {
+            uint32_t setIndex = setBindingPair.first;
+            if ((setIndex < state.boundDescriptorSets.size()) && state.boundDescriptorSets[setIndex])
+                state.boundDescriptorSets[setIndex]->GetStorageUpdates(setBindingPair.second, &pCB->updateBuffers,
+                                                                       &pCB->updateImages);
+        }
+        return result;
+    }
     // First check flag states
     if (VK_PIPELINE_BIND_POINT_GRAPHICS == bindPoint)
         result = validate_draw_state_flags(my_data, pCB, pPipe, indexedDraw);
@@ -3863,6 +3876,7 @@ static void resetCB(layer_data *dev_data, const VkCommandBuffer cb) {
         pCB->state = CB_NEW;
         pCB->submitCount = 0;
         pCB->status = 0;
+        pCB->sampled = true;
         pCB->viewportMask = 0;
         pCB->scissorMask = 0;
 
@@ -4238,6 +4252,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice gpu, const VkDevice
     }
     // Store physical device mem limits into device layer_data struct
     my_instance_data->instance_dispatch_table->GetPhysicalDeviceMemoryProperties(gpu, &my_device_data->phys_dev_mem_props);
+    my_device_data->sampler.init("lunarg_core_validation");
     lock.unlock();
 
     ValidateLayerOrdering(*pCreateInfo);
@@ -6512,6 +6527,7 @@ BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo
         }
         // Set updated state here in case implicit reset occurs above
         pCB->state = CB_RECORDING;
+        pCB->sampled = dev_data->sampler.command_buffer_sampled(commandBuffer);
         pCB->beginInfo = *pBeginInfo;
         if (pCB->beginInfo.pInheritanceInfo) {
             pCB->inheritanceInfo = *(pCB->beginInfo.pInheritanceInfo);
@@ -8241,9 +8257,10 @@ CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent
             skip_call |= report_error_no_cb_begin(dev_data, commandBuffer, "vkCmdWaitEvents()");
         }
         skip_call |= TransitionImageLayouts(commandBuffer, imageMemoryBarrierCount, pImageMemoryBarriers);
-        skip_call |=
-            ValidateBarriers("vkCmdWaitEvents", commandBuffer, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                             pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        if (pCB->sampled)
+            skip_call |= ValidateBarriers("vkCmdWaitEvents", commandBuffer, memoryBarrierCount, pMemoryBarriers,
+                                          bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount,
+                                          pImageMemoryBarriers);
     }
     lock.unlock();
     if (!skip_call)
@@ -8264,9 +8281,10 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
     if (pCB) {
         skip_call |= addCmd(dev_data, pCB, CMD_PIPELINEBARRIER, "vkCmdPipelineBarrier()");
         skip_call |= TransitionImageLayouts(commandBuffer, imageMemoryBarrierCount, pImageMemoryBarriers);
-        skip_call |=
-            ValidateBarriers("vkCmdPipelineBarrier", commandBuffer, memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
-                             pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        if (pCB->sampled)
+            skip_call |= ValidateBarriers("vkCmdPipelineBarrier", commandBuffer, memoryBarrierCount, pMemoryBarriers,
+                                          bufferMemoryBarrierCount, pBufferMemoryBarriers, imageMemoryBarrierCount,
+                                          pImageMemoryBarriers);
     }
     lock.unlock();
     if (!skip_call)
@@ -10504,6 +10522,7 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
     }
 
     VkResult result = dev_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo);
+    dev_data->sampler.frame_presented();
 
     if (result != VK_ERROR_VALIDATION_FAILED_EXT) {
         // Semaphore waits occur before error generation, if the call reached
@@ -10784,6 +10803,8 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     return pTable->GetInstanceProcAddr(instance, funcName);
 }
 
+static layer_proc_table core_instance_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_instance_command(const char *name) {
     static const struct {
@@ -10803,14 +10824,11 @@ intercept_core_instance_command(const char *name) {
         { "vkEnumerateDeviceExtensionProperties", reinterpret_cast<PFN_vkVoidFunction>(EnumerateDeviceExtensionProperties) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_instance_commands); i++) {
-        if (!strcmp(core_instance_commands[i].name, name))
-            return core_instance_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_instance_commands_table.find(core_instance_commands, name);
 }
 
+static layer_proc_table core_device_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_device_command(const char *name) {
     static const struct {
@@ -10935,14 +10953,11 @@ intercept_core_device_command(const char *name) {
         {"vkCreateEvent", reinterpret_cast<PFN_vkVoidFunction>(CreateEvent)},
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_device_commands); i++) {
-        if (!strcmp(core_device_commands[i].name, name))
-            return core_device_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_device_commands_table.find(core_device_commands, name);
 }
 
+static layer_proc_table khr_swapchain_commands_table;
+
 static PFN_vkVoidFunction
 intercept_khr_swapchain_command(const char *name, VkDevice dev) {
     static const struct {
@@ -10962,12 +10977,7 @@ intercept_khr_swapchain_command(const char *name, VkDevice dev) {
             return nullptr;
     }
 
-    for (size_t i = 0; i < ARRAY_SIZE(khr_swapchain_commands); i++) {
-        if (!strcmp(khr_swapchain_commands[i].name, name))
-            return khr_swapchain_commands[i].proc;
-    }
-
-    return nullptr;
+    return khr_swapchain_commands_table.find(khr_swapchain_commands, name);
 }
 
 } // namespace core_validation
@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "vk_loader_platform.h"
@@ -45,8 +46,11 @@
 #include "vk_layer_table.h"
 #include "vk_layer_data.h"
 #include "vk_layer_extension_utils.h"
+#include "vk_layer_handle_map.h"
 #include "vk_layer_utils.h"
 #include "vk_layer_logging.h"
+#include "vk_layer_sampling.h"
+#include "vk_layer_proc_table.h"
 
 using namespace std;
 
@@ -62,26 +66,37 @@ struct layer_data {
     VkPhysicalDevice physicalDevice;
     VkPhysicalDeviceProperties physicalDeviceProperties;
 
-    unordered_map<VkImage, IMAGE_STATE> imageMap;
+    // Fixed once the image is created, so commands read it without locking
+    handle_map<IMAGE_STATE> imageMap;
+    // Chooses which command buffers get their vkCmd* parameters checked
+    validation_sampler sampler;
+    // The sampling decision for each command buffer, looked up by every vkCmd* call
+    handle_map<COMMAND_BUFFER_STATE> commandBufferMap;
+    // Command buffers allocated from each pool, so destroying the pool can drop their state
+    std::mutex commandPoolLock;
+    unordered_map<uint64_t, unordered_set<VkCommandBuffer>> commandPoolMap;
 
     layer_data()
         : report_data(nullptr), device_dispatch_table(nullptr), instance_dispatch_table(nullptr), physicalDevice(0),
           physicalDeviceProperties(){};
 };
 
-static unordered_map<void *, layer_data *> layer_data_map;
-static std::mutex global_lock;
+static dispatch_key_map<layer_data> layer_data_map;
 
 static void init_image(layer_data *my_data, const VkAllocationCallbacks *pAllocator) {
     layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, "lunarg_image");
 }
 
 static IMAGE_STATE const *getImageState(layer_data const *dev_data, VkImage image) {
-    auto it = dev_data->imageMap.find(image);
-    if (it == dev_data->imageMap.end()) {
-        return nullptr;
-    }
-    return &it->second;
+    return dev_data->imageMap.find(reinterpret_cast<uint64_t &>(image));
+}
+
+// False if sampling mode skips the vkCmd* checks for the recording commandBuffer is in
+static bool command_buffer_sampled(const layer_data *dev_data, VkCommandBuffer commandBuffer) {
+    if (!dev_data->sampler.enabled())
+        return true;
+    const COMMAND_BUFFER_STATE *cb_state = dev_data->commandBufferMap.find(reinterpret_cast<uint64_t>(commandBuffer));
+    return !cb_state || cb_state->sampled;
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
@@ -194,6 +209,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateDevice(VkPhysicalDevice physicalDevice,
 
     my_instance_data->instance_dispatch_table->GetPhysicalDeviceProperties(physicalDevice,
                                                                            &(my_device_data->physicalDeviceProperties));
+    my_device_data->sampler.init("lunarg_image");
 
     return result;
 }
@@ -203,6 +219,8 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
     layer_data *my_data = get_my_data_ptr(key, layer_data_map);
     my_data->device_dispatch_table->DestroyDevice(device, pAllocator);
     delete my_data->device_dispatch_table;
+    my_data->imageMap.clear([](IMAGE_STATE *image_state) { delete image_state; });
+    my_data->commandBufferMap.clear([](COMMAND_BUFFER_STATE *cb_state) { delete cb_state; });
     layer_data_map.erase(key);
 }
 
@@ -384,20 +402,75 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateImage(VkDevice device, const VkImageCreateI
         result = device_data->device_dispatch_table->CreateImage(device, pCreateInfo, pAllocator, pImage);
     }
     if (result == VK_SUCCESS) {
-        std::lock_guard<std::mutex> lock(global_lock);
-        device_data->imageMap[*pImage] = IMAGE_STATE(pCreateInfo);
+        device_data->imageMap.insert(reinterpret_cast<uint64_t &>(*pImage), new IMAGE_STATE(pCreateInfo));
     }
     return result;
 }
 
 VKAPI_ATTR void VKAPI_CALL DestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *pAllocator) {
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
-    device_data->imageMap.erase(image);
-    lock.unlock();
+    delete device_data->imageMap.erase(reinterpret_cast<uint64_t &>(image));
     device_data->device_dispatch_table->DestroyImage(device, image, pAllocator);
 }
 
+VKAPI_ATTR void VKAPI_CALL DestroyCommandPool(VkDevice device, VkCommandPool commandPool, const VkAllocationCallbacks *pAllocator) {
+    layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
+    {
+        std::lock_guard<std::mutex> lock(device_data->commandPoolLock);
+        auto pool_it = device_data->commandPoolMap.find(reinterpret_cast<uint64_t &>(commandPool));
+        if (pool_it != device_data->commandPoolMap.end()) {
+            for (auto commandBuffer : pool_it->second) {
+                delete device_data->commandBufferMap.erase(reinterpret_cast<uint64_t>(commandBuffer));
+            }
+            device_data->commandPoolMap.erase(pool_it);
+        }
+    }
+    device_data->device_dispatch_table->DestroyCommandPool(device, commandPool, pAllocator);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL AllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *pAllocateInfo,
+                                                      VkCommandBuffer *pCommandBuffers) {
+    layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
+    VkResult result = device_data->device_dispatch_table->AllocateCommandBuffers(device, pAllocateInfo, pCommandBuffers);
+    if (result == VK_SUCCESS && device_data->sampler.enabled()) {
+        std::lock_guard<std::mutex> lock(device_data->commandPoolLock);
+        auto &pool_command_buffers = device_data->commandPoolMap[reinterpret_cast<const uint64_t &>(pAllocateInfo->commandPool)];
+        for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; i++) {
+            device_data->commandBufferMap.insert(reinterpret_cast<uint64_t>(pCommandBuffers[i]), new COMMAND_BUFFER_STATE());
+            pool_command_buffers.insert(pCommandBuffers[i]);
+        }
+    }
+    return result;
+}
+
+VKAPI_ATTR void VKAPI_CALL FreeCommandBuffers(VkDevice device, VkCommandPool commandPool, uint32_t commandBufferCount,
+                                              const VkCommandBuffer *pCommandBuffers) {
+    layer_data *device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
+    if (device_data->sampler.enabled()) {
+        std::lock_guard<std::mutex> lock(device_data->commandPoolLock);
+        auto pool_it = device_data->commandPoolMap.find(reinterpret_cast<uint64_t &>(commandPool));
+        for (uint32_t i = 0; i < commandBufferCount; i++) {
+            delete device_data->commandBufferMap.erase(reinterpret_cast<uint64_t>(pCommandBuffers[i]));
+            if (pool_it != device_data->commandPoolMap.end()) {
+                pool_it->second.erase(pCommandBuffers[i]);
+            }
+        }
+    }
+    device_data->device_dispatch_table->FreeCommandBuffers(device, commandPool, commandBufferCount, pCommandBuffers);
+}
+
+// Decides once per recording whether sampling mode checks it, as core_validation does
+VKAPI_ATTR VkResult VKAPI_CALL BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo *pBeginInfo) {
+    layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (device_data->sampler.enabled()) {
+        COMMAND_BUFFER_STATE *cb_state = device_data->commandBufferMap.find(reinterpret_cast<uint64_t>(commandBuffer));
+        if (cb_state) {
+            cb_state->sampled = device_data->sampler.command_buffer_sampled(commandBuffer);
+        }
+    }
+    return device_data->device_dispatch_table->BeginCommandBuffer(commandBuffer, pBeginInfo);
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL CreateRenderPass(VkDevice device, const VkRenderPassCreateInfo *pCreateInfo,
                                                 const VkAllocationCallbacks *pAllocator,
                                                 VkRenderPass *pRenderPass) {
@@ -614,6 +687,10 @@ VKAPI_ATTR void VKAPI_CALL CmdClearColorImage(VkCommandBuffer commandBuffer, VkI
                                               uint32_t rangeCount, const VkImageSubresourceRange *pRanges) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdClearColorImage(commandBuffer, image, imageLayout, pColor, rangeCount, pRanges);
+        return;
+    }
 
     if (imageLayout != VK_IMAGE_LAYOUT_GENERAL && imageLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
         skipCall |= log_msg(device_data->report_data, VK_DEBUG_REPORT_ERROR_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_COMMAND_BUFFER_EXT,
@@ -663,6 +740,11 @@ CmdClearDepthStencilImage(VkCommandBuffer commandBuffer, VkImage image, VkImageL
                           const VkImageSubresourceRange *pRanges) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdClearDepthStencilImage(commandBuffer, image, imageLayout, pDepthStencil, rangeCount,
+                                                                      pRanges);
+        return;
+    }
     // For each range, Image aspect must be depth or stencil or both
     for (uint32_t i = 0; i < rangeCount; i++) {
         if (((pRanges[i].aspectMask & VK_IMAGE_ASPECT_DEPTH_BIT) != VK_IMAGE_ASPECT_DEPTH_BIT) &&
@@ -918,6 +1000,11 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImage(VkCommandBuffer commandBuffer, VkImage s
 
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdCopyImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
+                                                         regionCount, pRegions);
+        return;
+    }
 
     skipCall = cmd_copy_image_valid_usage(commandBuffer, srcImage, dstImage, regionCount, pRegions);
 
@@ -933,6 +1020,10 @@ VKAPI_ATTR void VKAPI_CALL CmdClearAttachments(VkCommandBuffer commandBuffer, ui
     bool skipCall = false;
     VkImageAspectFlags aspectMask;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdClearAttachments(commandBuffer, attachmentCount, pAttachments, rectCount, pRects);
+        return;
+    }
     for (uint32_t i = 0; i < attachmentCount; i++) {
         aspectMask = pAttachments[i].aspectMask;
         if (aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) {
@@ -967,6 +1058,11 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyImageToBuffer(VkCommandBuffer commandBuffer, V
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdCopyImageToBuffer(commandBuffer, srcImage, srcImageLayout, dstBuffer, regionCount,
+                                                                 pRegions);
+        return;
+    }
     // For each region, the number of layers in the image subresource should not be zero
     // Image aspect must be ONE OF color, depth, stencil
     for (uint32_t i = 0; i < regionCount; i++) {
@@ -999,6 +1095,11 @@ VKAPI_ATTR void VKAPI_CALL CmdCopyBufferToImage(VkCommandBuffer commandBuffer, V
                                                 uint32_t regionCount, const VkBufferImageCopy *pRegions) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, dstImageLayout, regionCount,
+                                                                 pRegions);
+        return;
+    }
     // For each region, the number of layers in the image subresource should not be zero
     // Image aspect must be ONE OF color, depth, stencil
     for (uint32_t i = 0; i < regionCount; i++) {
@@ -1031,6 +1132,11 @@ CmdBlitImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout srcI
              VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageBlit *pRegions, VkFilter filter) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdBlitImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout, regionCount,
+                                                         pRegions, filter);
+        return;
+    }
 
     auto srcImageEntry = getImageState(device_data, srcImage);
     auto dstImageEntry = getImageState(device_data, dstImage);
@@ -1157,6 +1263,12 @@ CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageM
                    uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier *pImageMemoryBarriers) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, dependencyFlags,
+                                                               memoryBarrierCount, pMemoryBarriers, bufferMemoryBarrierCount,
+                                                               pBufferMemoryBarriers, imageMemoryBarrierCount, pImageMemoryBarriers);
+        return;
+    }
 
     for (uint32_t i = 0; i < imageMemoryBarrierCount; ++i) {
         VkImageMemoryBarrier const *const barrier = (VkImageMemoryBarrier const *const) & pImageMemoryBarriers[i];
@@ -1184,6 +1296,11 @@ CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout s
                 VkImageLayout dstImageLayout, uint32_t regionCount, const VkImageResolve *pRegions) {
     bool skipCall = false;
     layer_data *device_data = get_my_data_ptr(get_dispatch_key(commandBuffer), layer_data_map);
+    if (!command_buffer_sampled(device_data, commandBuffer)) {
+        device_data->device_dispatch_table->CmdResolveImage(commandBuffer, srcImage, srcImageLayout, dstImage, dstImageLayout,
+                                                            regionCount, pRegions);
+        return;
+    }
     auto srcImageEntry = getImageState(device_data, srcImage);
     auto dstImageEntry = getImageState(device_data, dstImage);
 
@@ -1250,6 +1367,14 @@ CmdResolveImage(VkCommandBuffer commandBuffer, VkImage srcImage, VkImageLayout s
     }
 }
 
+// Only intercepted to count frames for sampling mode
+VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
+    layer_data *device_data = get_my_data_ptr(get_dispatch_key(queue), layer_data_map);
+    VkResult result = device_data->device_dispatch_table->QueuePresentKHR(queue, pPresentInfo);
+    device_data->sampler.frame_presented();
+    return result;
+}
+
 VKAPI_ATTR void VKAPI_CALL
 GetImageSubresourceLayout(VkDevice device, VkImage image, const VkImageSubresource *pSubresource, VkSubresourceLayout *pLayout) {
     bool skipCall = false;
@@ -1367,6 +1492,8 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     return pTable->GetInstanceProcAddr(instance, funcName);
 }
 
+static layer_proc_table core_instance_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_instance_command(const char *name) {
     static const struct {
@@ -1384,14 +1511,11 @@ intercept_core_instance_command(const char *name) {
         { "vkGetPhysicalDeviceProperties", reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceProperties) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_instance_commands); i++) {
-        if (!strcmp(core_instance_commands[i].name, name))
-            return core_instance_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_instance_commands_table.find(core_instance_commands, name);
 }
 
+static layer_proc_table core_device_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_device_command(const char *name) {
     static const struct {
@@ -1404,6 +1528,10 @@ intercept_core_device_command(const char *name) {
         { "vkDestroyImage", reinterpret_cast<PFN_vkVoidFunction>(DestroyImage) },
         { "vkCreateImageView", reinterpret_cast<PFN_vkVoidFunction>(CreateImageView) },
         { "vkCreateRenderPass", reinterpret_cast<PFN_vkVoidFunction>(CreateRenderPass) },
+        { "vkDestroyCommandPool", reinterpret_cast<PFN_vkVoidFunction>(DestroyCommandPool) },
+        { "vkAllocateCommandBuffers", reinterpret_cast<PFN_vkVoidFunction>(AllocateCommandBuffers) },
+        { "vkFreeCommandBuffers", reinterpret_cast<PFN_vkVoidFunction>(FreeCommandBuffers) },
+        { "vkBeginCommandBuffer", reinterpret_cast<PFN_vkVoidFunction>(BeginCommandBuffer) },
         { "vkCmdClearColorImage", reinterpret_cast<PFN_vkVoidFunction>(CmdClearColorImage) },
         { "vkCmdClearDepthStencilImage", reinterpret_cast<PFN_vkVoidFunction>(CmdClearDepthStencilImage) },
         { "vkCmdClearAttachments", reinterpret_cast<PFN_vkVoidFunction>(CmdClearAttachments) },
@@ -1414,14 +1542,10 @@ intercept_core_device_command(const char *name) {
         { "vkCmdPipelineBarrier", reinterpret_cast<PFN_vkVoidFunction>(CmdPipelineBarrier) },
         { "vkCmdResolveImage", reinterpret_cast<PFN_vkVoidFunction>(CmdResolveImage) },
         { "vkGetImageSubresourceLayout", reinterpret_cast<PFN_vkVoidFunction>(GetImageSubresourceLayout) },
+        { "vkQueuePresentKHR", reinterpret_cast<PFN_vkVoidFunction>(QueuePresentKHR) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_device_commands); i++) {
-        if (!strcmp(core_device_commands[i].name, name))
-            return core_device_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_device_commands_table.find(core_device_commands, name);
 }
 
 } // namespace image
@@ -65,4 +65,10 @@ struct IMAGE_STATE {
           usage(pCreateInfo->usage){};
 };
 
+// Only tracked while sampling mode is skipping work
+struct COMMAND_BUFFER_STATE {
+    bool sampled; // Decided at vkBeginCommandBuffer so one recording is checked all or nothing
+    COMMAND_BUFFER_STATE() : sampled(true){};
+};
+
 #endif // IMAGE_H
@@ -24,6 +24,7 @@
 
 #include "vk_enum_string_helper.h"
 #include "vk_layer_extension_utils.h"
+#include "vk_layer_sampling.h"
 #include "vk_layer_table.h"
 #include "vk_layer_utils.h"
 #include "vulkan/vk_layer.h"
@@ -52,6 +53,7 @@ enum ObjectStatusFlagBits {
     OBJSTATUS_DEPTH_STENCIL_BOUND = 0x00000010,      // Viewport state object has been bound
     OBJSTATUS_GPU_MEM_MAPPED = 0x00000020,           // Memory object is currently mapped
     OBJSTATUS_COMMAND_BUFFER_SECONDARY = 0x00000040, // Command Buffer is of type SECONDARY
+    OBJSTATUS_COMMAND_BUFFER_UNSAMPLED = 0x00000080, // Sampling mode skips this Command Buffer's current recording
 };
 
 // Object and state information structure
@@ -143,6 +145,8 @@ struct layer_data {
     std::unordered_map<uint64_t, OBJTRACK_NODE *> swapchainImageMap;
     // Map of queue information structures, one per queue
     std::unordered_map<VkQueue, OT_QUEUE_INFO *> queue_info_map;
+    // Chooses which command buffers get their vkCmd* handles checked
+    validation_sampler sampler;
     // Preinitialized array of name strings for object types
     // LUGMAL std::unordered_map<VkDebugReportObjectTypeEXT, std::string> object_name;
 
@@ -156,7 +160,7 @@ struct layer_data {
 
 
 static std::unordered_map<void *, struct instance_extension_enables> instanceExtMap;
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 static device_table_map ot_device_table_map;
 static instance_table_map ot_instance_table_map;
 static std::mutex global_lock;
@@ -46,6 +46,7 @@
 #include "vk_layer_logging.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_proc_table.h"
 
 #include "parameter_validation.h"
 
@@ -76,7 +77,7 @@ struct layer_data {
           physical_device_features{}, physical_device{} {};
 };
 
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 static device_table_map pc_device_table_map;
 static instance_table_map pc_instance_table_map;
 
@@ -4658,6 +4659,8 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     return get_dispatch_table(pc_instance_table_map, instance)->GetInstanceProcAddr(instance, funcName);
 }
 
+static layer_proc_table core_instance_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_instance_command(const char *name) {
     static const struct {
@@ -4682,14 +4685,11 @@ intercept_core_instance_command(const char *name) {
         { "vkEnumerateDeviceExtensionProperties", reinterpret_cast<PFN_vkVoidFunction>(EnumerateDeviceExtensionProperties) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_instance_commands); i++) {
-        if (!strcmp(core_instance_commands[i].name, name))
-            return core_instance_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_instance_commands_table.find(core_instance_commands, name);
 }
 
+static layer_proc_table core_device_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_device_command(const char *name) {
     static const struct {
@@ -4810,12 +4810,7 @@ intercept_core_device_command(const char *name) {
         { "vkCmdNextSubpass", reinterpret_cast<PFN_vkVoidFunction>(CmdNextSubpass) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_device_commands); i++) {
-        if (!strcmp(core_device_commands[i].name, name))
-            return core_device_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_device_commands_table.find(core_device_commands, name);
 }
 
 } // namespace parameter_validation
@@ -125,8 +125,8 @@ bool ValidateGreaterThan(debug_report_data *report_data, const char *api_name, c
  * @param value Pointer to validate.
  * @return Boolean value indicating that the call should be skipped.
  */
-static bool validate_required_pointer(debug_report_data *report_data, const char *apiName, const char *parameterName,
-                                      const void *value) {
+static inline bool validate_required_pointer(debug_report_data *report_data, const char *apiName, const char *parameterName,
+                                             const void *value) {
     bool skipCall = false;
 
     if (value == NULL) {
@@ -414,8 +414,9 @@ bool validate_handle_array(debug_report_data *report_data, const char *api_name,
  * @param arrayRequired The 'array' parameter may not be NULL when true.
  * @return Boolean value indicating that the call should be skipped.
  */
-static bool validate_string_array(debug_report_data *report_data, const char *apiName, const char *countName, const char *arrayName,
-                                  uint32_t count, const char *const *array, bool countRequired, bool arrayRequired) {
+static inline bool validate_string_array(debug_report_data *report_data, const char *apiName, const char *countName,
+                                         const char *arrayName, uint32_t count, const char *const *array, bool countRequired,
+                                         bool arrayRequired) {
     bool skipCall = false;
 
     if ((count == 0) || (array == NULL)) {
@@ -451,9 +452,9 @@ static bool validate_string_array(debug_report_data *report_data, const char *ap
  * @param header_version Version of header defining the pNext validation rules.
  * @return Boolean value indicating that the call should be skipped.
  */
-static bool validate_struct_pnext(debug_report_data *report_data, const char *api_name, const char *parameter_name,
-                                  const char *allowed_struct_names, const void *next, size_t allowed_type_count,
-                                  const VkStructureType *allowed_types, uint32_t header_version) {
+static inline bool validate_struct_pnext(debug_report_data *report_data, const char *api_name, const char *parameter_name,
+                                         const char *allowed_struct_names, const void *next, size_t allowed_type_count,
+                                         const VkStructureType *allowed_types, uint32_t header_version) {
     bool skip_call = false;
     const char disclaimer[] = "This warning is based on the Valid Usage documentation for version %d of the Vulkan header.  It "
                               "is possible that you are using a struct from a private extension or an extension that was added "
@@ -513,7 +514,7 @@ static bool validate_struct_pnext(debug_report_data *report_data, const char *ap
 * @param value Boolean value to validate.
 * @return Boolean value indicating that the call should be skipped.
 */
-static bool validate_bool32(debug_report_data *report_data, const char *apiName, const char *parameterName, VkBool32 value) {
+static inline bool validate_bool32(debug_report_data *report_data, const char *apiName, const char *parameterName, VkBool32 value) {
     bool skipCall = false;
 
     if ((value != VK_TRUE) && (value != VK_FALSE)) {
@@ -618,8 +619,8 @@ static bool validate_ranged_enum_array(debug_report_data *report_data, const cha
 * @param value Value to validate.
 * @return Boolean value indicating that the call should be skipped.
 */
-static bool validate_reserved_flags(debug_report_data *report_data, const char *api_name, const char *parameter_name,
-                                    VkFlags value) {
+static inline bool validate_reserved_flags(debug_report_data *report_data, const char *api_name, const char *parameter_name,
+                                           VkFlags value) {
     bool skip_call = false;
 
     if (value != 0) {
@@ -645,8 +646,8 @@ static bool validate_reserved_flags(debug_report_data *report_data, const char *
 * @param flags_required The 'value' parameter may not be 0 when true.
 * @return Boolean value indicating that the call should be skipped.
 */
-static bool validate_flags(debug_report_data *report_data, const char *api_name, const char *parameter_name,
-                           const char *flag_bits_name, VkFlags all_flags, VkFlags value, bool flags_required) {
+static inline bool validate_flags(debug_report_data *report_data, const char *api_name, const char *parameter_name,
+                                  const char *flag_bits_name, VkFlags all_flags, VkFlags value, bool flags_required) {
     bool skip_call = false;
 
     if (value == 0) {
@@ -682,9 +683,9 @@ static bool validate_flags(debug_report_data *report_data, const char *api_name,
 * @param array_required The 'array' parameter may not be NULL when true.
 * @return Boolean value indicating that the call should be skipped.
 */
-static bool validate_flags_array(debug_report_data *report_data, const char *api_name, const char *count_name,
-                                 const char *array_name, const char *flag_bits_name, VkFlags all_flags, uint32_t count,
-                                 const VkFlags *array, bool count_required, bool array_required) {
+static inline bool validate_flags_array(debug_report_data *report_data, const char *api_name, const char *count_name,
+                                        const char *array_name, const char *flag_bits_name, VkFlags all_flags, uint32_t count,
+                                        const VkFlags *array, bool count_required, bool array_required) {
     bool skip_call = false;
 
     if ((count == 0) || (array == NULL)) {
@@ -712,6 +713,132 @@ static bool validate_flags_array(debug_report_data *report_data, const char *api
     return skip_call;
 }
 
+/**
+* Fast-path parameter checks.
+*
+* Each is_valid_* function below evaluates the same condition as its validate_* counterpart, taking the same arguments
+* minus report_data and the name strings, and returns true when the counterpart would not log anything.  Conditions
+* are combined with bitwise operators so the common, valid case runs without data-dependent branches.  The generated
+* validators for the hot vkCmd* entrypoints run these first and only fall back to the validate_* functions, and the
+* message strings they format, when a check fails.
+*/
+static inline bool is_valid_required_pointer(const void *value) { return value != NULL; }
+
+template <typename T> inline bool is_valid_array(T count, const void *array, bool countRequired, bool arrayRequired) {
+    return !((count == 0) & countRequired) & !((array == NULL) & arrayRequired & (count != 0));
+}
+
+template <typename T>
+inline bool is_valid_array(const T *count, const void *array, bool countPtrRequired, bool countValueRequired,
+                           bool arrayRequired) {
+    if (count == NULL) {
+        return !countPtrRequired;
+    }
+    return is_valid_array(*count, array, countValueRequired, arrayRequired);
+}
+
+template <typename T> inline bool is_valid_struct_type(const T *value, VkStructureType sType, bool required) {
+    if (value == NULL) {
+        return !required;
+    }
+    return value->sType == sType;
+}
+
+template <typename T>
+inline bool is_valid_struct_type_array(uint32_t count, const T *array, VkStructureType sType, bool countRequired,
+                                       bool arrayRequired) {
+    if ((count == 0) || (array == NULL)) {
+        return is_valid_array(count, array, countRequired, arrayRequired);
+    }
+    bool valid = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        valid &= (array[i].sType == sType);
+    }
+    return valid;
+}
+
+template <typename T>
+inline bool is_valid_struct_type_array(const uint32_t *count, const T *array, VkStructureType sType, bool countPtrRequired,
+                                       bool countValueRequired, bool arrayRequired) {
+    if (count == NULL) {
+        return !countPtrRequired;
+    }
+    return is_valid_struct_type_array(*count, array, sType, countValueRequired, arrayRequired);
+}
+
+template <typename T> inline bool is_valid_required_handle(T value) { return value != VK_NULL_HANDLE; }
+
+template <typename T> inline bool is_valid_handle_array(uint32_t count, const T *array, bool countRequired, bool arrayRequired) {
+    if ((count == 0) || (array == NULL)) {
+        return is_valid_array(count, array, countRequired, arrayRequired);
+    }
+    bool valid = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        valid &= (array[i] != VK_NULL_HANDLE);
+    }
+    return valid;
+}
+
+static inline bool is_valid_string_array(uint32_t count, const char *const *array, bool countRequired, bool arrayRequired) {
+    if ((count == 0) || (array == NULL)) {
+        return is_valid_array(count, array, countRequired, arrayRequired);
+    }
+    bool valid = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        valid &= (array[i] != NULL);
+    }
+    return valid;
+}
+
+static inline bool is_valid_struct_pnext(const void *next, size_t allowed_type_count, const VkStructureType *allowed_types,
+                                         uint32_t header_version) {
+    (void)header_version;
+    const VkStructureType *end = allowed_types + allowed_type_count;
+    for (const GenericHeader *current = reinterpret_cast<const GenericHeader *>(next); current != NULL;
+         current = reinterpret_cast<const GenericHeader *>(current->pNext)) {
+        if (std::find(allowed_types, end, current->sType) == end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool is_valid_bool32(VkBool32 value) { return (value == VK_TRUE) | (value == VK_FALSE); }
+
+template <typename T> inline bool is_valid_ranged_enum(T begin, T end, T value) {
+    return ((value >= begin) & (value <= end)) || is_extension_added_token(value);
+}
+
+template <typename T>
+inline bool is_valid_ranged_enum_array(T begin, T end, uint32_t count, const T *array, bool countRequired, bool arrayRequired) {
+    if ((count == 0) || (array == NULL)) {
+        return is_valid_array(count, array, countRequired, arrayRequired);
+    }
+    bool valid = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        valid &= is_valid_ranged_enum(begin, end, array[i]);
+    }
+    return valid;
+}
+
+static inline bool is_valid_reserved_flags(VkFlags value) { return value == 0; }
+
+static inline bool is_valid_flags(VkFlags all_flags, VkFlags value, bool flags_required) {
+    return !((value == 0) & flags_required) & ((value & (~all_flags)) == 0);
+}
+
+static inline bool is_valid_flags_array(VkFlags all_flags, uint32_t count, const VkFlags *array, bool count_required,
+                                        bool array_required) {
+    if ((count == 0) || (array == NULL)) {
+        return is_valid_array(count, array, count_required, array_required);
+    }
+    bool valid = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        valid &= is_valid_flags(all_flags, array[i], array_required);
+    }
+    return valid;
+}
+
 /**
 * Get VkResult code description.
 *
@@ -721,7 +848,7 @@ static bool validate_flags_array(debug_report_data *report_data, const char *api
 * @param value VkResult code to process.
 * @return String describing the specified VkResult code.
 */
-static std::string get_result_description(VkResult result) {
+static inline std::string get_result_description(VkResult result) {
     // clang-format off
     switch (result) {
         case VK_SUCCESS:                        return "a command completed successfully";
@@ -768,7 +895,7 @@ static std::string get_result_description(VkResult result) {
 * @param apiName Name of API call being validated.
 * @param value VkResult value to validate.
 */
-static void validate_result(debug_report_data *report_data, const char *apiName, VkResult result) {
+static inline void validate_result(debug_report_data *report_data, const char *apiName, VkResult result) {
     if (result < 0) {
         std::string resultName = string_VkResult(result);
 
@@ -28,13 +28,22 @@
 #include "vk_layer_extension_utils.h"
 #include "vk_enum_string_helper.h"
 #include "vk_layer_utils.h"
+#include "vk_layer_proc_table.h"
 
 namespace swapchain {
 
 static std::mutex global_lock;
 
 // The following is for logging error messages:
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
+
+static SwpSwapchain *getSwapchain(layer_data *my_data, VkSwapchainKHR swapchain) {
+    return my_data->swapchainMap.find(reinterpret_cast<uint64_t &>(swapchain));
+}
+
+static SwpQueue *getQueue(layer_data *my_data, VkQueue queue) {
+    return my_data->queueMap.find(reinterpret_cast<uintptr_t>(queue));
+}
 
 static const VkExtensionProperties instance_extensions[] = {{VK_EXT_DEBUG_REPORT_EXTENSION_NAME, VK_EXT_DEBUG_REPORT_SPEC_VERSION}};
 
@@ -1209,6 +1218,9 @@ DestroySurfaceKHR(VkInstance instance, VkSurfaceKHR surface, const VkAllocationC
                 if (it->second->pDevice) {
                     it->second->pDevice->swapchains.clear();
                 }
+                // The swapchain stays in its device's swapchainMap until the
+                // device is destroyed, so it mustn't point at this surface:
+                it->second->pSurface = NULL;
             }
             pSurface->swapchains.clear();
         }
@@ -1338,6 +1350,13 @@ VKAPI_ATTR void VKAPI_CALL DestroyDevice(VkDevice device, const VkAllocationCall
         }
         my_data->deviceMap.erase(device);
     }
+    my_data->swapchainMap.clear([](SwpSwapchain *pSwapchain) {
+        if (pSwapchain->pSurface) {
+            pSwapchain->pSurface->swapchains.erase(pSwapchain->swapchain);
+        }
+        delete pSwapchain;
+    });
+    my_data->queueMap.clear([](SwpQueue *pQueue) { delete pQueue; });
     delete my_data->device_dispatch_table;
     layer_data_map.erase(key);
 }
@@ -1919,11 +1938,7 @@ static bool validateCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
 
     // Validate pCreateInfo->oldSwapchain:
     if (pCreateInfo && pCreateInfo->oldSwapchain) {
-        SwpSwapchain *pOldSwapchain = NULL;
-        {
-          auto it = my_data->swapchainMap.find(pCreateInfo->oldSwapchain);
-          pOldSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-        }
+        SwpSwapchain *pOldSwapchain = getSwapchain(my_data, pCreateInfo->oldSwapchain);
         if (pOldSwapchain) {
             if (device != pOldSwapchain->pDevice->device) {
                 skipCall |= LOG_ERROR(VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, device, "VkDevice",
@@ -1931,7 +1946,7 @@ static bool validateCreateSwapchainKHR(VkDevice device, const VkSwapchainCreateI
                                                                           "than the VkSwapchainKHR was created with.",
                                       __FUNCTION__);
             }
-            if (pCreateInfo->surface != pOldSwapchain->pSurface->surface) {
+            if (pOldSwapchain->pSurface && (pCreateInfo->surface != pOldSwapchain->pSurface->surface)) {
                 skipCall |= LOG_ERROR(VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, device, "VkDevice",
                                       SWAPCHAIN_CREATE_SWAP_DIFF_SURFACE, "%s() called with pCreateInfo->oldSwapchain "
                                                                           "that has a different VkSurfaceKHR than "
@@ -1970,23 +1985,33 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(VkDevice device, const VkSwapc
                 pDevice = (it == my_data->deviceMap.end()) ? NULL : &it->second;
             }
 
-            my_data->swapchainMap[*pSwapchain].swapchain = *pSwapchain;
+            SwpSwapchain *pNewSwapchain = new SwpSwapchain;
+            pNewSwapchain->swapchain = *pSwapchain;
             if (pDevice) {
-                pDevice->swapchains[*pSwapchain] = &my_data->swapchainMap[*pSwapchain];
+                pDevice->swapchains[*pSwapchain] = pNewSwapchain;
             }
-            my_data->swapchainMap[*pSwapchain].pDevice = pDevice;
-            my_data->swapchainMap[*pSwapchain].imageCount = 0;
-            my_data->swapchainMap[*pSwapchain].usedAllocatorToCreate = (pAllocator != NULL);
+            pNewSwapchain->pDevice = pDevice;
+            pNewSwapchain->imageCount = 0;
+            pNewSwapchain->usedAllocatorToCreate = (pAllocator != NULL);
             // Store a pointer to the surface
             SwpPhysicalDevice *pPhysicalDevice = pDevice->pPhysicalDevice;
+            pNewSwapchain->minImageCount =
+                (pPhysicalDevice && pPhysicalDevice->gotSurfaceCapabilities) ? pPhysicalDevice->surfaceCapabilities.minImageCount : 0;
             SwpInstance *pInstance = (pPhysicalDevice) ? pPhysicalDevice->pInstance : NULL;
             layer_data *my_instance_data =
                 ((pInstance) ? get_my_data_ptr(get_dispatch_key(pInstance->instance), layer_data_map) : NULL);
             SwpSurface *pSurface = ((my_data && pCreateInfo) ? &my_instance_data->surfaceMap[pCreateInfo->surface] : NULL);
-            my_data->swapchainMap[*pSwapchain].pSurface = pSurface;
+            pNewSwapchain->pSurface = pSurface;
             if (pSurface) {
-                pSurface->swapchains[*pSwapchain] = &my_data->swapchainMap[*pSwapchain];
+                pSurface->swapchains[*pSwapchain] = pNewSwapchain;
+                if (pSurface->numQueueFamilyIndexSupport) {
+                    pNewSwapchain->queueFamilyIndexSupport.assign(
+                        pSurface->pQueueFamilyIndexSupport,
+                        pSurface->pQueueFamilyIndexSupport + pSurface->numQueueFamilyIndexSupport);
+                }
             }
+            // Publish it for vkAcquireNextImageKHR() and vkQueuePresentKHR() once it is complete:
+            my_data->swapchainMap.insert(reinterpret_cast<uint64_t &>(*pSwapchain), pNewSwapchain);
         }
         lock.unlock();
 
@@ -2019,11 +2044,7 @@ DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocatio
     }
 
     // Regardless of skipCall value, do some internal cleanup:
-    SwpSwapchain *pSwapchain = NULL;
-    {
-        auto it = my_data->swapchainMap.find(swapchain);
-        pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-    }
+    SwpSwapchain *pSwapchain = my_data->swapchainMap.erase(reinterpret_cast<uint64_t &>(swapchain));
     if (pSwapchain) {
         // Delete the SwpSwapchain associated with this swapchain:
         if (pSwapchain->pDevice) {
@@ -2047,7 +2068,7 @@ DestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocatio
                       "the object was created.",
                       __FUNCTION__);
         }
-        my_data->swapchainMap.erase(swapchain);
+        delete pSwapchain;
     }
     lock.unlock();
 
@@ -2062,7 +2083,7 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    std::unique_lock<std::mutex> lock(my_data->device_lock);
     SwpDevice *pDevice = NULL;
     {
         auto it = my_data->deviceMap.find(device);
@@ -2075,11 +2096,7 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
                               "%s() called even though the %s extension was not enabled for this VkDevice.", __FUNCTION__,
                               VK_KHR_SWAPCHAIN_EXTENSION_NAME);
     }
-    SwpSwapchain *pSwapchain = NULL;
-    {
-        auto it = my_data->swapchainMap.find(swapchain);
-        pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-    }
+    SwpSwapchain *pSwapchain = getSwapchain(my_data, swapchain);
     if (!pSwapchainImageCount) {
         skipCall |= LOG_ERROR_NULL_POINTER(VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, device, "pSwapchainImageCount");
     } else if (pSwapchain && pSwapchainImages) {
@@ -2108,10 +2125,7 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
         lock.lock();
 
         // Obtain this pointer again after locking:
-        {
-            auto it = my_data->swapchainMap.find(swapchain);
-            pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-        }
+        pSwapchain = getSwapchain(my_data, swapchain);
         if ((result == VK_SUCCESS) && pSwapchain && !pSwapchainImages && pSwapchainImageCount) {
             // Record the result of this preliminary query:
             pSwapchain->imageCount = *pSwapchainImageCount;
@@ -2119,6 +2133,9 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain, uint32_t *pSwap
                    pSwapchainImageCount && (*pSwapchainImageCount > 0)) {
             // Record the images and their state:
             pSwapchain->imageCount = *pSwapchainImageCount;
+            if (pSwapchain->images.size() < *pSwapchainImageCount) {
+                pSwapchain->images.resize(*pSwapchainImageCount);
+            }
             for (uint32_t i = 0; i < *pSwapchainImageCount; i++) {
                 pSwapchain->images[i].image = pSwapchainImages[i];
                 pSwapchain->images[i].pSwapchain = pSwapchain;
@@ -2149,7 +2166,10 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
     VkResult result = VK_SUCCESS;
     bool skipCall = false;
     layer_data *my_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
-    std::unique_lock<std::mutex> lock(global_lock);
+    // Everything read below belongs to this device, and the swapchain's
+    // minImageCount was recorded when it was created, so only this device's
+    // lock is needed:
+    std::unique_lock<std::mutex> lock(my_data->device_lock);
     SwpDevice *pDevice = NULL;
     {
         auto it = my_data->deviceMap.find(device);
@@ -2167,19 +2187,14 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
                               "%s() called with both the semaphore and fence parameters set to "
                               "VK_NULL_HANDLE (at least one should be used).", __FUNCTION__);
     }
-    SwpSwapchain *pSwapchain = NULL;
-    {
-        auto it = my_data->swapchainMap.find(swapchain);
-        pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-    }
-    SwpPhysicalDevice *pPhysicalDevice = pDevice->pPhysicalDevice;
-    if (pSwapchain && pPhysicalDevice && pPhysicalDevice->gotSurfaceCapabilities) {
+    SwpSwapchain *pSwapchain = getSwapchain(my_data, swapchain);
+    if (pSwapchain && pSwapchain->minImageCount) {
         // Look to see if the application has already acquired the maximum
         // number of images, and this will push it past the spec-defined
         // limits:
-        uint32_t minImageCount = pPhysicalDevice->surfaceCapabilities.minImageCount;
+        uint32_t minImageCount = pSwapchain->minImageCount;
         uint32_t imagesAcquiredByApp = 0;
-        for (uint32_t i = 0; i < pSwapchain->imageCount; i++) {
+        for (uint32_t i = 0; i < pSwapchain->images.size(); i++) {
             if (pSwapchain->images[i].acquiredByApp) {
                 imagesAcquiredByApp++;
             }
@@ -2212,12 +2227,13 @@ VKAPI_ATTR VkResult VKAPI_CALL AcquireNextImageKHR(VkDevice device, VkSwapchainK
         lock.lock();
 
         // Obtain this pointer again after locking:
-        {
-            auto it = my_data->swapchainMap.find(swapchain);
-            pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-        }
+        pSwapchain = getSwapchain(my_data, swapchain);
         if (((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR)) && pSwapchain) {
-            // Change the state of the image (now acquired by the application):
+            // Change the state of the image (now acquired by the application),
+            // even if vkGetSwapchainImagesKHR() hasn't recorded it yet:
+            if (pSwapchain->images.size() <= *pImageIndex) {
+                pSwapchain->images.resize(*pImageIndex + 1);
+            }
             pSwapchain->images[*pImageIndex].acquiredByApp = true;
         }
         lock.unlock();
@@ -2262,14 +2278,13 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
         // Note: pPresentInfo->pResults is allowed to be NULL
     }
 
-    std::unique_lock<std::mutex> lock(global_lock);
+    // As in vkAcquireNextImageKHR(), only this device's lock is needed; the
+    // surface support is read from the swapchain's copy:
+    std::unique_lock<std::mutex> lock(my_data->device_lock);
+    SwpQueue *pQueue = getQueue(my_data, queue);
     for (uint32_t i = 0; pPresentInfo && (i < pPresentInfo->swapchainCount); i++) {
         uint32_t index = pPresentInfo->pImageIndices[i];
-        SwpSwapchain *pSwapchain = NULL;
-        {
-            auto it = my_data->swapchainMap.find(pPresentInfo->pSwapchains[i]);
-            pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-        }
+        SwpSwapchain *pSwapchain = getSwapchain(my_data, pPresentInfo->pSwapchains[i]);
         if (pSwapchain) {
             if (!pSwapchain->pDevice->swapchainExtensionEnabled) {
                 skipCall |= LOG_ERROR(VK_DEBUG_REPORT_OBJECT_TYPE_DEVICE_EXT, pSwapchain->pDevice, "VkDevice",
@@ -2284,7 +2299,7 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
                                                                  "images in this VkSwapchainKHR.\n",
                                       __FUNCTION__, index, pSwapchain->imageCount);
             } else {
-                if (!pSwapchain->images[index].acquiredByApp) {
+                if ((index >= pSwapchain->images.size()) || !pSwapchain->images[index].acquiredByApp) {
                     skipCall |= LOG_ERROR(VK_DEBUG_REPORT_OBJECT_TYPE_SWAPCHAIN_KHR_EXT, pPresentInfo->pSwapchains[i],
                                           "VkSwapchainKHR", SWAPCHAIN_INDEX_NOT_IN_USE, "%s() returned an index (i.e. %d) "
                                                                                         "for an image that is not acquired by "
@@ -2292,18 +2307,12 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
                                           __FUNCTION__, index);
                 }
             }
-            SwpQueue *pQueue = NULL;
-            {
-                auto it = my_data->queueMap.find(queue);
-                pQueue = (it == my_data->queueMap.end()) ? NULL : &it->second;
-            }
-            SwpSurface *pSurface = pSwapchain->pSurface;
-            if (pQueue && pSurface && pSurface->numQueueFamilyIndexSupport) {
+            const std::vector<VkBool32> &support = pSwapchain->queueFamilyIndexSupport;
+            if (pQueue && !support.empty()) {
                 uint32_t queueFamilyIndex = pQueue->queueFamilyIndex;
                 // Note: the 1st test is to ensure queueFamilyIndex is in range,
                 // and the 2nd test is the validation check:
-                if ((pSurface->numQueueFamilyIndexSupport > queueFamilyIndex) &&
-                    (!pSurface->pQueueFamilyIndexSupport[queueFamilyIndex])) {
+                if ((support.size() > queueFamilyIndex) && (!support[queueFamilyIndex])) {
                     skipCall |=
                         LOG_ERROR(VK_DEBUG_REPORT_OBJECT_TYPE_SWAPCHAIN_KHR_EXT, pPresentInfo->pSwapchains[i], "VkSwapchainKHR",
                                   SWAPCHAIN_SURFACE_NOT_SUPPORTED_WITH_QUEUE, "%s() called with a swapchain whose "
@@ -2325,13 +2334,9 @@ VKAPI_ATTR VkResult VKAPI_CALL QueuePresentKHR(VkQueue queue, const VkPresentInf
 
         if (pPresentInfo && ((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
             for (uint32_t i = 0; i < pPresentInfo->swapchainCount; i++) {
-                int index = pPresentInfo->pImageIndices[i];
-                SwpSwapchain *pSwapchain = NULL;
-                {
-                    auto it = my_data->swapchainMap.find(pPresentInfo->pSwapchains[i]);
-                    pSwapchain = (it == my_data->swapchainMap.end()) ? NULL : &it->second;
-                }
-                if (pSwapchain) {
+                uint32_t index = pPresentInfo->pImageIndices[i];
+                SwpSwapchain *pSwapchain = getSwapchain(my_data, pPresentInfo->pSwapchains[i]);
+                if (pSwapchain && (index < pSwapchain->images.size())) {
                     // Change the state of the image (no longer acquired by the
                     // application):
                     pSwapchain->images[index].acquiredByApp = false;
@@ -2361,12 +2366,17 @@ GetDeviceQueue(VkDevice device, uint32_t queueFamilyIndex, uint32_t queueIndex,
             auto it = my_data->deviceMap.find(device);
             pDevice = (it == my_data->deviceMap.end()) ? NULL : &it->second;
         }
-        my_data->queueMap[&pQueue].queue = *pQueue;
+        if (getQueue(my_data, *pQueue)) {
+            return;
+        }
+        SwpQueue *pSwpQueue = new SwpQueue;
+        pSwpQueue->queue = *pQueue;
         if (pDevice) {
-            pDevice->queues[*pQueue] = &my_data->queueMap[*pQueue];
+            pDevice->queues[*pQueue] = pSwpQueue;
         }
-        my_data->queueMap[&pQueue].pDevice = pDevice;
-        my_data->queueMap[&pQueue].queueFamilyIndex = queueFamilyIndex;
+        pSwpQueue->pDevice = pDevice;
+        pSwpQueue->queueFamilyIndex = queueFamilyIndex;
+        my_data->queueMap.insert(reinterpret_cast<uintptr_t>(*pQueue), pSwpQueue);
     }
 }
 
@@ -2490,6 +2500,8 @@ VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetInstanceProcAddr(VkInstance instance
     return pTable->GetInstanceProcAddr(instance, funcName);
 }
 
+static layer_proc_table core_instance_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_instance_command(const char *name) {
     static const struct {
@@ -2508,14 +2520,11 @@ intercept_core_instance_command(const char *name) {
         { "vkGetPhysicalDeviceQueueFamilyProperties", reinterpret_cast<PFN_vkVoidFunction>(GetPhysicalDeviceQueueFamilyProperties) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_instance_commands); i++) {
-        if (!strcmp(core_instance_commands[i].name, name))
-            return core_instance_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_instance_commands_table.find(core_instance_commands, name);
 }
 
+static layer_proc_table khr_surface_commands_table;
+
 static PFN_vkVoidFunction
 intercept_khr_surface_command(const char *name, VkInstance instance) {
     static const struct {
@@ -2561,14 +2570,11 @@ intercept_khr_surface_command(const char *name, VkInstance instance) {
 
     // do not check if VK_KHR_*_surface is enabled (why?)
 
-    for (size_t i = 0; i < ARRAY_SIZE(khr_surface_commands); i++) {
-        if (!strcmp(khr_surface_commands[i].name, name))
-            return khr_surface_commands[i].proc;
-    }
-
-    return nullptr;
+    return khr_surface_commands_table.find(khr_surface_commands, name);
 }
 
+static layer_proc_table core_device_commands_table;
+
 static PFN_vkVoidFunction
 intercept_core_device_command(const char *name) {
     static const struct {
@@ -2580,14 +2586,11 @@ intercept_core_device_command(const char *name) {
         { "vkGetDeviceQueue", reinterpret_cast<PFN_vkVoidFunction>(GetDeviceQueue) },
     };
 
-    for (size_t i = 0; i < ARRAY_SIZE(core_device_commands); i++) {
-        if (!strcmp(core_device_commands[i].name, name))
-            return core_device_commands[i].proc;
-    }
-
-    return nullptr;
+    return core_device_commands_table.find(core_device_commands, name);
 }
 
+static layer_proc_table khr_swapchain_commands_table;
+
 static PFN_vkVoidFunction
 intercept_khr_swapchain_command(const char *name, VkDevice dev) {
     static const struct {
@@ -2603,12 +2606,7 @@ intercept_khr_swapchain_command(const char *name, VkDevice dev) {
 
     // do not check if VK_KHR_swapchain is enabled (why?)
 
-    for (size_t i = 0; i < ARRAY_SIZE(khr_swapchain_commands); i++) {
-        if (!strcmp(khr_swapchain_commands[i].name, name))
-            return khr_swapchain_commands[i].proc;
-    }
-
-    return nullptr;
+    return khr_swapchain_commands_table.find(khr_swapchain_commands, name);
 }
 
 } // namespace swapchain
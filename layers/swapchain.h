@@ -25,6 +25,8 @@
 #include "vulkan/vk_layer.h"
 #include "vk_layer_config.h"
 #include "vk_layer_logging.h"
+#include "vk_layer_handle_map.h"
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -307,9 +309,19 @@ struct SwpSwapchain {
     SwpSurface *pSurface;
 
     // When vkGetSwapchainImagesKHR is called, the VkImage's are
-    // remembered:
+    // remembered, indexed the way vkAcquireNextImageKHR() returns them:
     uint32_t imageCount;
-    unordered_map<int, SwpImage> images;
+    std::vector<SwpImage> images;
+
+    // The surface's minImageCount when the swapchain was created, or 0 if
+    // the application hadn't queried the surface capabilities yet:
+    uint32_t minImageCount;
+
+    // The surface's support for presenting from each queue family, as the
+    // application had queried it when the swapchain was created.  The
+    // surface's own array may be reallocated under the global lock, which
+    // vkQueuePresentKHR() doesn't take:
+    std::vector<VkBool32> queueFamilyIndexSupport;
 
     // 'true' if pAllocator was non-NULL when vkCreateSwapchainKHR was called:
     bool usedAllocatorToCreate;
@@ -347,8 +359,13 @@ struct layer_data {
     std::unordered_map<VkSurfaceKHR, SwpSurface> surfaceMap;
     std::unordered_map<void *, SwpPhysicalDevice> physicalDeviceMap;
     std::unordered_map<void *, SwpDevice> deviceMap;
-    std::unordered_map<VkSwapchainKHR, SwpSwapchain> swapchainMap;
-    std::unordered_map<void *, SwpQueue> queueMap;
+    //
+    // vkAcquireNextImageKHR() and vkQueuePresentKHR() find their swapchains
+    // and queues without taking global_lock, and only take device_lock to
+    // update which images the application has acquired.
+    handle_map<SwpSwapchain> swapchainMap;
+    handle_map<SwpQueue> queueMap;
+    std::mutex device_lock;
 
     layer_data()
         : report_data(nullptr), device_dispatch_table(nullptr), instance_dispatch_table(nullptr), num_tmp_callbacks(0),
@@ -38,6 +38,7 @@
 #include "vk_layer_logging.h"
 #include "vk_layer_extension_utils.h"
 #include "vk_safe_struct.h"
+#include "vk_layer_scratch.h"
 #include "vk_layer_utils.h"
 
 namespace unique_objects {
@@ -67,7 +68,7 @@ struct instance_extension_enables {
 };
 
 static std::unordered_map<void *, struct instance_extension_enables> instanceExtMap;
-static std::unordered_map<void *, layer_data *> layer_data_map;
+static dispatch_key_map<layer_data> layer_data_map;
 static device_table_map unique_objects_device_table_map;
 static instance_table_map unique_objects_instance_table_map;
 static std::mutex global_lock; // Protect map accesses and unique_id increments
@@ -226,43 +227,39 @@ void explicit_DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAlloc
 VkResult explicit_AllocateMemory(VkDevice device, const VkMemoryAllocateInfo *pAllocateInfo,
                                  const VkAllocationCallbacks *pAllocator, VkDeviceMemory *pMemory) {
     const VkMemoryAllocateInfo *input_allocate_info = pAllocateInfo;
-    std::unique_ptr<safe_VkMemoryAllocateInfo> safe_allocate_info;
-    std::unique_ptr<safe_VkDedicatedAllocationMemoryAllocateInfoNV> safe_dedicated_allocate_info;
+    safe_VkMemoryAllocateInfo safe_allocate_info;
+    safe_VkDedicatedAllocationMemoryAllocateInfoNV safe_dedicated_allocate_info;
     layer_data *my_map_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
     if ((pAllocateInfo != nullptr) &&
         ContainsExtStruct(pAllocateInfo, VK_STRUCTURE_TYPE_DEDICATED_ALLOCATION_MEMORY_ALLOCATE_INFO_NV)) {
         // Assuming there is only one extension struct of this type in the list for now
-        safe_dedicated_allocate_info =
-            std::unique_ptr<safe_VkDedicatedAllocationMemoryAllocateInfoNV>(new safe_VkDedicatedAllocationMemoryAllocateInfoNV);
-        safe_allocate_info = std::unique_ptr<safe_VkMemoryAllocateInfo>(new safe_VkMemoryAllocateInfo);
-
-        safe_allocate_info->initialize(pAllocateInfo);
-        input_allocate_info = reinterpret_cast<const VkMemoryAllocateInfo *>(safe_allocate_info.get());
+        safe_allocate_info.initialize(pAllocateInfo);
+        input_allocate_info = safe_allocate_info.ptr();
 
         const GenericHeader *orig_pnext = reinterpret_cast<const GenericHeader *>(pAllocateInfo->pNext);
-        GenericHeader *input_pnext = reinterpret_cast<GenericHeader *>(safe_allocate_info.get());
+        GenericHeader *input_pnext = reinterpret_cast<GenericHeader *>(&safe_allocate_info);
         while (orig_pnext != nullptr) {
             if (orig_pnext->sType == VK_STRUCTURE_TYPE_DEDICATED_ALLOCATION_MEMORY_ALLOCATE_INFO_NV) {
-                safe_dedicated_allocate_info->initialize(
+                safe_dedicated_allocate_info.initialize(
                     reinterpret_cast<const VkDedicatedAllocationMemoryAllocateInfoNV *>(orig_pnext));
 
                 std::unique_lock<std::mutex> lock(global_lock);
 
-                if (safe_dedicated_allocate_info->buffer != VK_NULL_HANDLE) {
-                    uint64_t local_buffer = reinterpret_cast<uint64_t &>(safe_dedicated_allocate_info->buffer);
-                    safe_dedicated_allocate_info->buffer =
+                if (safe_dedicated_allocate_info.buffer != VK_NULL_HANDLE) {
+                    uint64_t local_buffer = reinterpret_cast<uint64_t &>(safe_dedicated_allocate_info.buffer);
+                    safe_dedicated_allocate_info.buffer =
                         reinterpret_cast<VkBuffer &>(my_map_data->unique_id_mapping[local_buffer]);
                 }
 
-                if (safe_dedicated_allocate_info->image != VK_NULL_HANDLE) {
-                    uint64_t local_image = reinterpret_cast<uint64_t &>(safe_dedicated_allocate_info->image);
-                    safe_dedicated_allocate_info->image = reinterpret_cast<VkImage &>(my_map_data->unique_id_mapping[local_image]);
+                if (safe_dedicated_allocate_info.image != VK_NULL_HANDLE) {
+                    uint64_t local_image = reinterpret_cast<uint64_t &>(safe_dedicated_allocate_info.image);
+                    safe_dedicated_allocate_info.image = reinterpret_cast<VkImage &>(my_map_data->unique_id_mapping[local_image]);
                 }
 
                 lock.unlock();
 
-                input_pnext->pNext = reinterpret_cast<GenericHeader *>(safe_dedicated_allocate_info.get());
+                input_pnext->pNext = reinterpret_cast<GenericHeader *>(&safe_dedicated_allocate_info);
                 input_pnext = reinterpret_cast<GenericHeader *>(input_pnext->pNext);
             } else {
                 // TODO: generic handling of pNext copies
@@ -292,10 +289,11 @@ VkResult explicit_CreateComputePipelines(VkDevice device, VkPipelineCache pipeli
     // 'layout': 'VkPipelineLayout', 'basePipelineHandle': 'VkPipeline'}}
     // LOCAL DECLS:{'pCreateInfos': 'VkComputePipelineCreateInfo*'}
     layer_data *my_device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
+    VkLayerScratchScope scratch_scope;
     safe_VkComputePipelineCreateInfo *local_pCreateInfos = NULL;
     if (pCreateInfos) {
         std::lock_guard<std::mutex> lock(global_lock);
-        local_pCreateInfos = new safe_VkComputePipelineCreateInfo[createInfoCount];
+        local_pCreateInfos = layer_scratch_new_array<safe_VkComputePipelineCreateInfo>(createInfoCount);
         for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
             local_pCreateInfos[idx0].initialize(&pCreateInfos[idx0]);
             if (pCreateInfos[idx0].basePipelineHandle) {
@@ -323,7 +321,7 @@ VkResult explicit_CreateComputePipelines(VkDevice device, VkPipelineCache pipeli
     VkResult result = get_dispatch_table(unique_objects_device_table_map, device)
                           ->CreateComputePipelines(device, pipelineCache, createInfoCount,
                                                    (const VkComputePipelineCreateInfo *)local_pCreateInfos, pAllocator, pPipelines);
-    delete[] local_pCreateInfos;
+    layer_scratch_delete_array(local_pCreateInfos);
     if (VK_SUCCESS == result) {
         uint64_t unique_id = 0;
         std::lock_guard<std::mutex> lock(global_lock);
@@ -343,9 +341,10 @@ VkResult explicit_CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipel
     // 'pStages[stageCount]': {'module': 'VkShaderModule'}, 'renderPass': 'VkRenderPass', 'basePipelineHandle': 'VkPipeline'}}
     // LOCAL DECLS:{'pCreateInfos': 'VkGraphicsPipelineCreateInfo*'}
     layer_data *my_device_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
+    VkLayerScratchScope scratch_scope;
     safe_VkGraphicsPipelineCreateInfo *local_pCreateInfos = NULL;
     if (pCreateInfos) {
-        local_pCreateInfos = new safe_VkGraphicsPipelineCreateInfo[createInfoCount];
+        local_pCreateInfos = layer_scratch_new_array<safe_VkGraphicsPipelineCreateInfo>(createInfoCount);
         std::lock_guard<std::mutex> lock(global_lock);
         for (uint32_t idx0 = 0; idx0 < createInfoCount; ++idx0) {
             local_pCreateInfos[idx0].initialize(&pCreateInfos[idx0]);
@@ -384,7 +383,7 @@ VkResult explicit_CreateGraphicsPipelines(VkDevice device, VkPipelineCache pipel
         get_dispatch_table(unique_objects_device_table_map, device)
             ->CreateGraphicsPipelines(device, pipelineCache, createInfoCount,
                                       (const VkGraphicsPipelineCreateInfo *)local_pCreateInfos, pAllocator, pPipelines);
-    delete[] local_pCreateInfos;
+    layer_scratch_delete_array(local_pCreateInfos);
     if (VK_SUCCESS == result) {
         uint64_t unique_id = 0;
         std::lock_guard<std::mutex> lock(global_lock);
@@ -401,10 +400,11 @@ VkResult explicit_CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInf
                                      const VkAllocationCallbacks *pAllocator, VkSwapchainKHR *pSwapchain) {
     layer_data *my_map_data = get_my_data_ptr(get_dispatch_key(device), layer_data_map);
 
+    VkLayerScratchScope scratch_scope;
     safe_VkSwapchainCreateInfoKHR *local_pCreateInfo = NULL;
     if (pCreateInfo) {
         std::lock_guard<std::mutex> lock(global_lock);
-        local_pCreateInfo = new safe_VkSwapchainCreateInfoKHR(pCreateInfo);
+        local_pCreateInfo = layer_scratch_new<safe_VkSwapchainCreateInfoKHR>(pCreateInfo);
         local_pCreateInfo->oldSwapchain =
             (VkSwapchainKHR)my_map_data->unique_id_mapping[reinterpret_cast<const uint64_t &>(pCreateInfo->oldSwapchain)];
         // Need to pull surface mapping from the instance-level map
@@ -416,7 +416,7 @@ VkResult explicit_CreateSwapchainKHR(VkDevice device, const VkSwapchainCreateInf
     VkResult result = get_dispatch_table(unique_objects_device_table_map, device)
                           ->CreateSwapchainKHR(device, (const VkSwapchainCreateInfoKHR *)local_pCreateInfo, pAllocator, pSwapchain);
     if (local_pCreateInfo)
-        delete local_pCreateInfo;
+        layer_scratch_delete(local_pCreateInfo);
     if (VK_SUCCESS == result) {
         std::lock_guard<std::mutex> lock(global_lock);
         uint64_t unique_id =global_unique_id++;
@@ -456,11 +456,12 @@ VkResult explicit_GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchai
 VkResult explicit_GetPhysicalDeviceDisplayPropertiesKHR(VkPhysicalDevice physicalDevice, uint32_t* pPropertyCount, VkDisplayPropertiesKHR* pProperties)
 {
     layer_data *my_map_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
+    VkLayerScratchScope scratch_scope;
     safe_VkDisplayPropertiesKHR* local_pProperties = NULL;
     {
         std::lock_guard<std::mutex> lock(global_lock);
         if (pProperties) {
-            local_pProperties = new safe_VkDisplayPropertiesKHR[*pPropertyCount];
+            local_pProperties = layer_scratch_new_array<safe_VkDisplayPropertiesKHR>(*pPropertyCount);
             for (uint32_t idx0=0; idx0<*pPropertyCount; ++idx0) {
                 local_pProperties[idx0].initialize(&pProperties[idx0]);
                 if (pProperties[idx0].display) {
@@ -488,7 +489,7 @@ VkResult explicit_GetPhysicalDeviceDisplayPropertiesKHR(VkPhysicalDevice physica
         }
     }
     if (local_pProperties)
-        delete[] local_pProperties;
+        layer_scratch_delete_array(local_pProperties);
     return result;
 }
 
@@ -513,12 +514,13 @@ VkResult explicit_GetDisplayPlaneSupportedDisplaysKHR(VkPhysicalDevice physicalD
 VkResult explicit_GetDisplayModePropertiesKHR(VkPhysicalDevice physicalDevice, VkDisplayKHR display, uint32_t* pPropertyCount, VkDisplayModePropertiesKHR* pProperties)
 {
     layer_data *my_map_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);
+    VkLayerScratchScope scratch_scope;
     safe_VkDisplayModePropertiesKHR* local_pProperties = NULL;
     {
         std::lock_guard<std::mutex> lock(global_lock);
         display = (VkDisplayKHR)my_map_data->unique_id_mapping[reinterpret_cast<uint64_t &>(display)];
         if (pProperties) {
-            local_pProperties = new safe_VkDisplayModePropertiesKHR[*pPropertyCount];
+            local_pProperties = layer_scratch_new_array<safe_VkDisplayModePropertiesKHR>(*pPropertyCount);
             for (uint32_t idx0=0; idx0<*pPropertyCount; ++idx0) {
                 local_pProperties[idx0].initialize(&pProperties[idx0]);
             }
@@ -540,7 +542,7 @@ VkResult explicit_GetDisplayModePropertiesKHR(VkPhysicalDevice physicalDevice, V
         }
     }
     if (local_pProperties)
-        delete[] local_pProperties;
+        layer_scratch_delete_array(local_pProperties);
     return result;
 }
 #endif
@@ -20,24 +20,12 @@
 #ifndef LAYER_DATA_H
 #define LAYER_DATA_H
 
-#include <unordered_map>
 #include "vk_layer_table.h"
 
-template <typename DATA_T> DATA_T *get_my_data_ptr(void *data_key, std::unordered_map<void *, DATA_T *> &layer_data_map) {
-    DATA_T *debug_data;
-    typename std::unordered_map<void *, DATA_T *>::const_iterator got;
-
-    /* TODO: We probably should lock here, or have caller lock */
-    got = layer_data_map.find(data_key);
-
-    if (got == layer_data_map.end()) {
-        debug_data = new DATA_T;
-        layer_data_map[(void *)data_key] = debug_data;
-    } else {
-        debug_data = got->second;
-    }
-
-    return debug_data;
+// Per-instance/per-device layer state is keyed by dispatch key (see vk_layer_dispatch_map.h).
+// Lock-free in the common case; the first lookup for a key creates its DATA_T.
+template <typename DATA_T> DATA_T *get_my_data_ptr(void *data_key, dispatch_key_map<DATA_T> &layer_data_map) {
+    return layer_data_map.find_or_create(data_key);
 }
 
 #endif // LAYER_DATA_H
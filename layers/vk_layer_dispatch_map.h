@@ -0,0 +1,165 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+// Map from a loader dispatch key to per-instance or per-device layer state.
+//
+// Every intercepted call looks up its dispatch table and layer_data by dispatch key, so the
+// lookup must be cheap and must not race with instances/devices being created on other threads.
+// Keys are registered into a small fixed array of slots when the instance or device is created;
+// the slot a key lands in is its index for the rest of its lifetime.  find() is lock-free: it
+// hashes the key and probes a handful of slots with acquire loads.  insert() and erase() only
+// happen at create/destroy time and are serialized by a mutex.  Should more keys be live than the
+// slot array can hold, the remainder spill into a locked overflow map.
+template <typename T> class dispatch_key_map {
+  public:
+    dispatch_key_map() : live_(0), overflow_count_(0) {
+        for (uint32_t i = 0; i < kSlotCount; ++i) {
+            slots_[i].key.store(nullptr, std::memory_order_relaxed);
+            slots_[i].value.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    T *find(const void *key) const {
+        uint32_t index = hash(key);
+        for (uint32_t probe = 0; probe < kSlotCount; ++probe, index = (index + 1) & kSlotMask) {
+            const void *slot_key = slots_[index].key.load(std::memory_order_acquire);
+            if (slot_key == key)
+                return slots_[index].value.load(std::memory_order_relaxed);
+            if (slot_key == nullptr)
+                break;
+        }
+        if (overflow_count_.load(std::memory_order_acquire) == 0)
+            return nullptr;
+        std::lock_guard<std::mutex> lock(lock_);
+        auto it = overflow_.find(key);
+        return (it == overflow_.end()) ? nullptr : it->second;
+    }
+
+    // Returns the value already registered for key, or registers and returns value
+    T *insert(const void *key, T *value) {
+        std::lock_guard<std::mutex> lock(lock_);
+        T *existing = find_locked(key);
+        if (existing)
+            return existing;
+        insert_locked(key, value);
+        return value;
+    }
+
+    // Returns the value registered for key, creating it with new T if there is none
+    T *find_or_create(const void *key) {
+        T *value = find(key);
+        if (value)
+            return value;
+        std::lock_guard<std::mutex> lock(lock_);
+        value = find_locked(key);
+        if (!value) {
+            value = new T;
+            insert_locked(key, value);
+        }
+        return value;
+    }
+
+    // Unregisters key; the value itself is owned by the caller
+    size_t erase(const void *key) {
+        std::lock_guard<std::mutex> lock(lock_);
+        uint32_t index = hash(key);
+        for (uint32_t probe = 0; probe < kSlotCount; ++probe, index = (index + 1) & kSlotMask) {
+            const void *slot_key = slots_[index].key.load(std::memory_order_relaxed);
+            if (slot_key == key) {
+                // Leave a tombstone so probes for keys further along the chain still reach them
+                slots_[index].value.store(nullptr, std::memory_order_relaxed);
+                slots_[index].key.store(tombstone(), std::memory_order_release);
+                --live_;
+                return 1;
+            }
+            if (slot_key == nullptr)
+                break;
+        }
+        if (overflow_.erase(key)) {
+            overflow_count_.store(overflow_.size(), std::memory_order_release);
+            return 1;
+        }
+        return 0;
+    }
+
+  private:
+    dispatch_key_map(const dispatch_key_map &);
+    dispatch_key_map &operator=(const dispatch_key_map &);
+
+    static const uint32_t kSlotBits = 7;
+    static const uint32_t kSlotCount = 1 << kSlotBits;
+    static const uint32_t kSlotMask = kSlotCount - 1;
+    // Keep probe chains short by spilling to the overflow map past 3/4 occupancy
+    static const uint32_t kMaxLive = kSlotCount * 3 / 4;
+
+    struct slot {
+        std::atomic<const void *> key;
+        std::atomic<T *> value;
+    };
+
+    static const void *tombstone() { return reinterpret_cast<const void *>(static_cast<uintptr_t>(1)); }
+
+    static uint32_t hash(const void *key) {
+        // Dispatch keys are heap pointers to the loader's dispatch tables; drop the alignment bits
+        uint32_t bits = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(key) >> 4);
+        return (bits * 2654435761u) >> (32 - kSlotBits);
+    }
+
+    T *find_locked(const void *key) const {
+        uint32_t index = hash(key);
+        for (uint32_t probe = 0; probe < kSlotCount; ++probe, index = (index + 1) & kSlotMask) {
+            const void *slot_key = slots_[index].key.load(std::memory_order_relaxed);
+            if (slot_key == key)
+                return slots_[index].value.load(std::memory_order_relaxed);
+            if (slot_key == nullptr)
+                break;
+        }
+        auto it = overflow_.find(key);
+        return (it == overflow_.end()) ? nullptr : it->second;
+    }
+
+    void insert_locked(const void *key, T *value) {
+        if (live_ < kMaxLive) {
+            uint32_t index = hash(key);
+            for (uint32_t probe = 0; probe < kSlotCount; ++probe, index = (index + 1) & kSlotMask) {
+                const void *slot_key = slots_[index].key.load(std::memory_order_relaxed);
+                if (slot_key == nullptr || slot_key == tombstone()) {
+                    // Publish the value before the key so a reader that sees the key sees the value
+                    slots_[index].value.store(value, std::memory_order_relaxed);
+                    slots_[index].key.store(key, std::memory_order_release);
+                    ++live_;
+                    return;
+                }
+            }
+        }
+        overflow_[key] = value;
+        overflow_count_.store(overflow_.size(), std::memory_order_release);
+    }
+
+    slot slots_[kSlotCount];
+    uint32_t live_;
+    std::atomic<size_t> overflow_count_;
+    std::unordered_map<const void *, T *> overflow_;
+    mutable std::mutex lock_;
+};
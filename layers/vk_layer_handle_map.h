@@ -0,0 +1,225 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "vk_loader_platform.h"
+
+// Map from a Vulkan handle to the layer state recorded for it when the object was created.
+//
+// Commands look their objects up far more often than objects come and go, and from every thread
+// recording on the device, so find() takes no lock.  It probes an open-addressed table of atomic
+// key/value pairs, as dispatch_key_map does, but the table grows with the number of objects.
+// insert() and erase() are serialized by a per-map mutex.  erase() clears the value and leaves the
+// key behind, so a handle the driver hands out again reuses its slot; once live and erased keys
+// fill the table it is rebuilt without the erased ones and published with one store.
+//
+// A rebuilt table is only freed when no find() can still be reading it: readers count themselves
+// in and out of one of a few counters, picked per thread so that threads recording in parallel
+// don't share a cache line, and the writer frees retired tables once it sees all counters at zero.
+//
+// The values are owned by the caller.  Vulkan does not allow an object to be used while it is
+// being destroyed, so the value erase() returns can be freed straight away.
+template <typename T> class handle_map {
+  public:
+    handle_map() : table_(new table(kMinCapacity)), live_(0), used_(0) {
+        for (uint32_t i = 0; i < kReaderStripes; ++i)
+            readers_[i].count.store(0, std::memory_order_relaxed);
+    }
+
+    ~handle_map() {
+        delete table_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < retired_.size(); ++i)
+            delete retired_[i];
+    }
+
+    T *find(uint64_t handle) const {
+        std::atomic<uint32_t> &readers = readers_[reader_stripe()].count;
+        readers.fetch_add(1, std::memory_order_seq_cst);
+        const table *t = table_.load(std::memory_order_seq_cst);
+        T *value = nullptr;
+        uint32_t index = hash(handle) & t->mask;
+        for (uint32_t probe = 0; probe <= t->mask; ++probe, index = (index + 1) & t->mask) {
+            uint64_t key = t->slots[index].key.load(std::memory_order_acquire);
+            if (key == handle) {
+                value = t->slots[index].value.load(std::memory_order_acquire);
+                break;
+            }
+            if (key == 0)
+                break;
+        }
+        readers.fetch_sub(1, std::memory_order_release);
+        return value;
+    }
+
+    // Registers value for handle, replacing any value it already has
+    void insert(uint64_t handle, T *value) {
+        if (handle == 0)
+            return;
+        std::lock_guard<std::mutex> lock(lock_);
+        table *t = table_.load(std::memory_order_relaxed);
+        slot *s = find_locked(t, handle);
+        if (s) {
+            if (!s->value.load(std::memory_order_relaxed))
+                ++live_;
+            s->value.store(value, std::memory_order_release);
+            return;
+        }
+        if ((used_ + 1) * 4 > (t->mask + 1) * 3) {
+            t = rebuild(t);
+        }
+        insert_new(t, handle, value);
+        ++live_;
+        ++used_;
+        reclaim();
+    }
+
+    // Unregisters handle and returns its value, or NULL if it had none
+    T *erase(uint64_t handle) {
+        if (handle == 0)
+            return nullptr;
+        std::lock_guard<std::mutex> lock(lock_);
+        slot *s = find_locked(table_.load(std::memory_order_relaxed), handle);
+        T *value = s ? s->value.load(std::memory_order_relaxed) : nullptr;
+        if (value) {
+            s->value.store(nullptr, std::memory_order_release);
+            --live_;
+        }
+        reclaim();
+        return value;
+    }
+
+    // Unregisters every handle, passing each value to release
+    template <typename Func> void clear(Func release) {
+        std::lock_guard<std::mutex> lock(lock_);
+        table *t = table_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i <= t->mask; ++i) {
+            T *value = t->slots[i].value.load(std::memory_order_relaxed);
+            if (value) {
+                t->slots[i].value.store(nullptr, std::memory_order_release);
+                release(value);
+            }
+        }
+        live_ = 0;
+    }
+
+  private:
+    handle_map(const handle_map &);
+    handle_map &operator=(const handle_map &);
+
+    static const uint32_t kMinCapacity = 64;
+    static const uint32_t kReaderStripes = 16;
+
+    struct slot {
+        std::atomic<uint64_t> key;
+        std::atomic<T *> value;
+    };
+
+    struct table {
+        explicit table(uint32_t capacity) : slots(new slot[capacity]), mask(capacity - 1) {
+            for (uint32_t i = 0; i < capacity; ++i) {
+                slots[i].key.store(0, std::memory_order_relaxed);
+                slots[i].value.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        ~table() { delete[] slots; }
+
+        slot *slots;
+        uint32_t mask;
+    };
+
+    struct reader_count {
+        std::atomic<uint32_t> count;
+        char pad[64 - sizeof(std::atomic<uint32_t>)];
+    };
+
+    static uint32_t hash(uint64_t handle) {
+        // Handles are usually pointers or small indices; fold the high bits in before mixing
+        uint64_t bits = handle ^ (handle >> 29);
+        return static_cast<uint32_t>((bits * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    static uint32_t reader_stripe() {
+        static std::atomic<uint32_t> next_stripe(0);
+        static THREAD_LOCAL_DECL uint32_t stripe = 0;
+        if (stripe == 0)
+            stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % kReaderStripes + 1;
+        return stripe - 1;
+    }
+
+    static slot *find_locked(table *t, uint64_t handle) {
+        uint32_t index = hash(handle) & t->mask;
+        for (uint32_t probe = 0; probe <= t->mask; ++probe, index = (index + 1) & t->mask) {
+            uint64_t key = t->slots[index].key.load(std::memory_order_relaxed);
+            if (key == handle)
+                return &t->slots[index];
+            if (key == 0)
+                break;
+        }
+        return nullptr;
+    }
+
+    static void insert_new(table *t, uint64_t handle, T *value) {
+        uint32_t index = hash(handle) & t->mask;
+        while (t->slots[index].key.load(std::memory_order_relaxed) != 0)
+            index = (index + 1) & t->mask;
+        // Publish the value before the key so a reader that sees the key sees the value
+        t->slots[index].value.store(value, std::memory_order_relaxed);
+        t->slots[index].key.store(handle, std::memory_order_release);
+    }
+
+    // Moves the live entries to a table with room for as many again, and retires the old one
+    table *rebuild(table *old) {
+        uint32_t capacity = kMinCapacity;
+        while (capacity < (live_ + 1) * 2)
+            capacity *= 2;
+        table *t = new table(capacity);
+        for (uint32_t i = 0; i <= old->mask; ++i) {
+            T *value = old->slots[i].value.load(std::memory_order_relaxed);
+            if (value)
+                insert_new(t, old->slots[i].key.load(std::memory_order_relaxed), value);
+        }
+        used_ = live_;
+        // A reader that counted itself in after this store reads the new table
+        table_.store(t, std::memory_order_seq_cst);
+        retired_.push_back(old);
+        return t;
+    }
+
+    void reclaim() {
+        if (retired_.empty())
+            return;
+        for (uint32_t i = 0; i < kReaderStripes; ++i) {
+            if (readers_[i].count.load(std::memory_order_seq_cst) != 0)
+                return;
+        }
+        for (size_t i = 0; i < retired_.size(); ++i)
+            delete retired_[i];
+        retired_.clear();
+    }
+
+    std::atomic<table *> table_;
+    uint32_t live_; // Keys with a value
+    uint32_t used_; // Keys in the table, erased or not
+    std::vector<table *> retired_;
+    mutable reader_count readers_[kReaderStripes];
+    std::mutex lock_;
+};
@@ -0,0 +1,88 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include "vulkan/vulkan.h"
+#include "vk_proc_name_hash.h"
+
+// Name lookup for a layer's table of intercepted entrypoints.
+//
+// Layers keep their intercepts in static arrays of { name, proc } entries and used to strcmp
+// through them on every vkGet*ProcAddr call.  A layer_proc_table turns such an array into a
+// direct-indexed table keyed by the generated perfect hash in vk_proc_name_hash.h, so a lookup
+// costs one hash and one strcmp regardless of how many entrypoints the layer intercepts.
+//
+// The index is built the first time find() is called.  Entries whose names the hash does not know
+// (commands added to the layer ahead of vulkan.py) are still found by a linear search, but only
+// for names that also miss the hash.  Declare tables at namespace scope; VS2013 does not make
+// function-local statics thread-safe.
+class layer_proc_table {
+  public:
+    layer_proc_table() : built_(false), unindexed_(false) {
+        for (int i = 0; i < VK_PROC_COUNT; ++i)
+            procs_[i] = nullptr;
+    }
+
+    template <typename Entry, size_t N> PFN_vkVoidFunction find(const Entry (&entries)[N], const char *name) {
+        if (!built_.load(std::memory_order_acquire))
+            build(entries);
+
+        int index = vk_proc_index(name);
+        if (index >= 0)
+            return procs_[index];
+        if (!unindexed_)
+            return nullptr;
+
+        for (size_t i = 0; i < N; ++i) {
+            if (!strcmp(entries[i].name, name))
+                return entries[i].proc;
+        }
+        return nullptr;
+    }
+
+  private:
+    layer_proc_table(const layer_proc_table &);
+    layer_proc_table &operator=(const layer_proc_table &);
+
+    template <typename Entry, size_t N> void build(const Entry (&entries)[N]) {
+        std::lock_guard<std::mutex> lock(lock_);
+        if (built_.load(std::memory_order_relaxed))
+            return;
+
+        for (size_t i = 0; i < N; ++i) {
+            int index = vk_proc_index(entries[i].name);
+            if (index < 0) {
+                unindexed_ = true;
+                continue;
+            }
+            // Keep the first entry for a name, as the linear search did
+            if (!procs_[index])
+                procs_[index] = entries[i].proc;
+        }
+        built_.store(true, std::memory_order_release);
+    }
+
+    PFN_vkVoidFunction procs_[VK_PROC_COUNT];
+    std::atomic<bool> built_;
+    bool unindexed_;
+    std::mutex lock_;
+};
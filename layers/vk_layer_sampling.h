@@ -0,0 +1,96 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <string>
+#include "vk_layer_config.h"
+
+// Sampling mode for the validation layers.
+//
+// Two vk_layer_settings.txt options bound the CPU cost of leaving validation enabled under load:
+//
+//   <LayerIdentifier>.sample_frame_interval = N
+//       Only validate work recorded during every Nth frame.  Frames are counted at vkQueuePresentKHR.
+//   <LayerIdentifier>.sample_command_buffer_percent = P
+//       Within a sampled frame, only validate roughly P percent of command buffers.  The subset is
+//       chosen by hashing the command buffer handle with the frame number, so it changes every frame.
+//
+// Layers keep tracking state for every call; only the checks on unsampled work are skipped.
+// With neither option present every frame and command buffer is sampled.
+class validation_sampler {
+  public:
+    validation_sampler() : frame_interval_(1), command_buffer_percent_(100), frame_(0) {}
+
+    void init(const char *layer_identifier) {
+        frame_interval_ = read_option(layer_identifier, ".sample_frame_interval", 1, 1, UINT32_MAX);
+        command_buffer_percent_ = read_option(layer_identifier, ".sample_command_buffer_percent", 100, 0, 100);
+    }
+
+    // True if any work is being skipped
+    bool enabled() const { return frame_interval_ > 1 || command_buffer_percent_ < 100; }
+
+    // Called from vkQueuePresentKHR to advance to the next frame
+    void frame_presented() { frame_.fetch_add(1, std::memory_order_relaxed); }
+
+    bool frame_sampled() const { return (frame_.load(std::memory_order_relaxed) % frame_interval_) == 0; }
+
+    bool command_buffer_sampled(const void *command_buffer) const {
+        if (!enabled())
+            return true;
+        uint64_t frame = frame_.load(std::memory_order_relaxed);
+        if ((frame % frame_interval_) != 0)
+            return false;
+        if (command_buffer_percent_ >= 100)
+            return true;
+        return (mix(reinterpret_cast<uintptr_t>(command_buffer) ^ (frame * 0x9E3779B97F4A7C15ull)) % 100) <
+               command_buffer_percent_;
+    }
+
+  private:
+    static uint32_t read_option(const char *layer_identifier, const char *setting, uint32_t default_value, uint32_t min_value,
+                                uint32_t max_value) {
+        std::string key = layer_identifier;
+        key.append(setting);
+        const char *value = getLayerOption(key.c_str());
+        if (!value || !*value)
+            return default_value;
+        unsigned long parsed = strtoul(value, nullptr, 10);
+        if (parsed < min_value)
+            return min_value;
+        if (parsed > max_value)
+            return max_value;
+        return static_cast<uint32_t>(parsed);
+    }
+
+    // 64-bit finalizer from MurmurHash3
+    static uint64_t mix(uint64_t bits) {
+        bits ^= bits >> 33;
+        bits *= 0xff51afd7ed558ccdull;
+        bits ^= bits >> 33;
+        bits *= 0xc4ceb9fe1a85ec53ull;
+        bits ^= bits >> 33;
+        return bits;
+    }
+
+    uint32_t frame_interval_;
+    uint32_t command_buffer_percent_;
+    std::atomic<uint64_t> frame_;
+};
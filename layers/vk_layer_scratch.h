@@ -0,0 +1,162 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include "vk_loader_platform.h"
+
+// Scratch memory for deep copies that only live for the duration of one intercepted call,
+// such as the safe_Vk* copies unique_objects makes in order to unwrap handles.
+//
+// A VkLayerScratchScope is declared on the stack at the top of an entrypoint.  While it is the
+// current scope for the calling thread, layer_scratch_new() and layer_scratch_new_array()
+// bump-allocate from it, and everything is released at once when the scope is destroyed.  The
+// first block lives inside the scope object itself so typical calls never reach the heap; large
+// batches chain additional heap blocks that are freed along with the scope.
+//
+// Outside of a scope the helpers fall back to plain new/delete, so safe_Vk* structs that a layer
+// keeps around (e.g. core_validation's pipeline state) behave exactly as before.
+class VkLayerScratchScope {
+  public:
+    VkLayerScratchScope() : prev_(current()), base_(inline_.bytes), capacity_(kInlineSize), offset_(0), overflow_(nullptr) {
+        current() = this;
+    }
+
+    ~VkLayerScratchScope() {
+        current() = prev_;
+        while (overflow_) {
+            Block *next = overflow_->next;
+            ::operator delete(overflow_);
+            overflow_ = next;
+        }
+    }
+
+    // The innermost live scope on the calling thread, or NULL
+    static VkLayerScratchScope *&current() {
+        static THREAD_LOCAL_DECL VkLayerScratchScope *scope = nullptr;
+        return scope;
+    }
+
+    void *alloc(size_t size) {
+        size = (size + kAlign - 1) & ~(kAlign - 1);
+        if (capacity_ - offset_ < size) {
+            size_t block_size = capacity_ * 2;
+            if (block_size < size)
+                block_size = size;
+            Block *block = static_cast<Block *>(::operator new(sizeof(Block) + block_size));
+            block->next = overflow_;
+            block->size = block_size;
+            overflow_ = block;
+            base_ = reinterpret_cast<char *>(block + 1);
+            capacity_ = block_size;
+            offset_ = 0;
+        }
+        void *ptr = base_ + offset_;
+        offset_ += size;
+        return ptr;
+    }
+
+    // True if ptr was handed out by this scope or one it is nested in
+    bool owns(const void *ptr) const {
+        const char *p = static_cast<const char *>(ptr);
+        for (const VkLayerScratchScope *scope = this; scope; scope = scope->prev_) {
+            if (p >= scope->inline_.bytes && p < scope->inline_.bytes + kInlineSize)
+                return true;
+            for (const Block *block = scope->overflow_; block; block = block->next) {
+                const char *data = reinterpret_cast<const char *>(block + 1);
+                if (p >= data && p < data + block->size)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // Element count is stored just ahead of arrays so they can be destroyed without the caller's help
+    static const size_t kArrayHeader = 8;
+
+  private:
+    VkLayerScratchScope(const VkLayerScratchScope &);
+    VkLayerScratchScope &operator=(const VkLayerScratchScope &);
+
+    static const size_t kAlign = 8;
+    static const size_t kInlineSize = 4096;
+
+    struct Block {
+        Block *next;
+        size_t size;
+        uint64_t align;
+    };
+
+    VkLayerScratchScope *prev_;
+    union {
+        char bytes[kInlineSize];
+        uint64_t align_u64;
+        double align_double;
+        void *align_ptr;
+    } inline_;
+    char *base_;
+    size_t capacity_;
+    size_t offset_;
+    Block *overflow_;
+};
+
+template <typename T, typename A> T *layer_scratch_new(const A &arg) {
+    VkLayerScratchScope *scope = VkLayerScratchScope::current();
+    if (!scope)
+        return new T(arg);
+    return new (scope->alloc(sizeof(T))) T(arg);
+}
+
+template <typename T> void layer_scratch_delete(T *obj) {
+    if (!obj)
+        return;
+    VkLayerScratchScope *scope = VkLayerScratchScope::current();
+    if (scope && scope->owns(obj)) {
+        obj->~T();
+        return;
+    }
+    delete obj;
+}
+
+template <typename T> T *layer_scratch_new_array(size_t count) {
+    VkLayerScratchScope *scope = VkLayerScratchScope::current();
+    if (!scope)
+        return new T[count];
+    char *mem = static_cast<char *>(scope->alloc(VkLayerScratchScope::kArrayHeader + sizeof(T) * count));
+    *reinterpret_cast<size_t *>(mem) = count;
+    T *array = reinterpret_cast<T *>(mem + VkLayerScratchScope::kArrayHeader);
+    for (size_t i = 0; i < count; ++i)
+        new (&array[i]) T;
+    return array;
+}
+
+template <typename T> void layer_scratch_delete_array(T *array) {
+    if (!array)
+        return;
+    VkLayerScratchScope *scope = VkLayerScratchScope::current();
+    if (scope && scope->owns(array)) {
+        const char *mem = reinterpret_cast<const char *>(array) - VkLayerScratchScope::kArrayHeader;
+        size_t count = *reinterpret_cast<const size_t *>(mem);
+        for (size_t i = 0; i < count; ++i)
+            array[i].~T();
+        return;
+    }
+    delete[] array;
+}
@@ -18,7 +18,6 @@
  * Author: Tobin Ehlis <tobin@lunarg.com>
  */
 #include <assert.h>
-#include <unordered_map>
 #include "vk_dispatch_table_helper.h"
 #include "vulkan/vk_layer.h"
 #include "vk_layer_table.h"
@@ -30,34 +29,34 @@ static instance_table_map tableInstanceMap;
 // Map lookup must be thread safe
 VkLayerDispatchTable *device_dispatch_table(void *object) {
     dispatch_key key = get_dispatch_key(object);
-    device_table_map::const_iterator it = tableMap.find((void *)key);
-    assert(it != tableMap.end() && "Not able to find device dispatch entry");
-    return it->second;
+    VkLayerDispatchTable *pTable = tableMap.find(key);
+    assert(pTable && "Not able to find device dispatch entry");
+    return pTable;
 }
 
 VkLayerInstanceDispatchTable *instance_dispatch_table(void *object) {
     dispatch_key key = get_dispatch_key(object);
-    instance_table_map::const_iterator it = tableInstanceMap.find((void *)key);
+    VkLayerInstanceDispatchTable *pTable = tableInstanceMap.find(key);
 #if DISPATCH_MAP_DEBUG
-    if (it != tableInstanceMap.end()) {
+    if (pTable) {
         fprintf(stderr, "instance_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table:  0x%p\n", &tableInstanceMap, object, key,
-                it->second);
+                pTable);
     } else {
         fprintf(stderr, "instance_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table: UNKNOWN\n", &tableInstanceMap, object, key);
     }
 #endif
-    assert(it != tableInstanceMap.end() && "Not able to find instance dispatch entry");
-    return it->second;
+    assert(pTable && "Not able to find instance dispatch entry");
+    return pTable;
 }
 
 void destroy_dispatch_table(device_table_map &map, dispatch_key key) {
 #if DISPATCH_MAP_DEBUG
-    device_table_map::const_iterator it = map.find((void *)key);
-    if (it != map.end()) {
-        fprintf(stderr, "destroy device dispatch_table: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, it->second);
+    VkLayerDispatchTable *pTable = map.find(key);
+    if (pTable) {
+        fprintf(stderr, "destroy device dispatch_table: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pTable);
     } else {
         fprintf(stderr, "destroy device dispatch table: map:  0x%p, key:  0x%p, table: UNKNOWN\n", &map, key);
-        assert(it != map.end());
+        assert(pTable);
     }
 #endif
     map.erase(key);
@@ -65,12 +64,12 @@ void destroy_dispatch_table(device_table_map &map, dispatch_key key) {
 
 void destroy_dispatch_table(instance_table_map &map, dispatch_key key) {
 #if DISPATCH_MAP_DEBUG
-    instance_table_map::const_iterator it = map.find((void *)key);
-    if (it != map.end()) {
-        fprintf(stderr, "destroy instance dispatch_table: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, it->second);
+    VkLayerInstanceDispatchTable *pTable = map.find(key);
+    if (pTable) {
+        fprintf(stderr, "destroy instance dispatch_table: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pTable);
     } else {
         fprintf(stderr, "destroy instance dispatch table: map:  0x%p, key:  0x%p, table: UNKNOWN\n", &map, key);
-        assert(it != map.end());
+        assert(pTable);
     }
 #endif
     map.erase(key);
@@ -82,33 +81,33 @@ void destroy_instance_dispatch_table(dispatch_key key) { destroy_dispatch_table(
 
 VkLayerDispatchTable *get_dispatch_table(device_table_map &map, void *object) {
     dispatch_key key = get_dispatch_key(object);
-    device_table_map::const_iterator it = map.find((void *)key);
+    VkLayerDispatchTable *pTable = map.find(key);
 #if DISPATCH_MAP_DEBUG
-    if (it != map.end()) {
+    if (pTable) {
         fprintf(stderr, "device_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table:  0x%p\n", &tableInstanceMap, object, key,
-                it->second);
+                pTable);
     } else {
         fprintf(stderr, "device_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table: UNKNOWN\n", &tableInstanceMap, object, key);
     }
 #endif
-    assert(it != map.end() && "Not able to find device dispatch entry");
-    return it->second;
+    assert(pTable && "Not able to find device dispatch entry");
+    return pTable;
 }
 
 VkLayerInstanceDispatchTable *get_dispatch_table(instance_table_map &map, void *object) {
     //    VkLayerInstanceDispatchTable *pDisp = *(VkLayerInstanceDispatchTable **) object;
     dispatch_key key = get_dispatch_key(object);
-    instance_table_map::const_iterator it = map.find((void *)key);
+    VkLayerInstanceDispatchTable *pTable = map.find(key);
 #if DISPATCH_MAP_DEBUG
-    if (it != map.end()) {
+    if (pTable) {
         fprintf(stderr, "instance_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table:  0x%p\n", &tableInstanceMap, object, key,
-                it->second);
+                pTable);
     } else {
         fprintf(stderr, "instance_dispatch_table: map:  0x%p, object:  0x%p, key:  0x%p, table: UNKNOWN\n", &tableInstanceMap, object, key);
     }
 #endif
-    assert(it != map.end() && "Not able to find instance dispatch entry");
-    return it->second;
+    assert(pTable && "Not able to find instance dispatch entry");
+    return pTable;
 }
 
 VkLayerInstanceCreateInfo *get_chain_info(const VkInstanceCreateInfo *pCreateInfo, VkLayerFunction func) {
@@ -139,23 +138,23 @@ VkLayerDeviceCreateInfo *get_chain_info(const VkDeviceCreateInfo *pCreateInfo, V
 VkLayerInstanceDispatchTable *initInstanceTable(VkInstance instance, const PFN_vkGetInstanceProcAddr gpa, instance_table_map &map) {
     VkLayerInstanceDispatchTable *pTable;
     dispatch_key key = get_dispatch_key(instance);
-    instance_table_map::const_iterator it = map.find((void *)key);
+    VkLayerInstanceDispatchTable *pExisting = map.find(key);
 
-    if (it == map.end()) {
+    if (!pExisting) {
+        // Fill the table before publishing it so lock-free lookups never see it half initialized
         pTable = new VkLayerInstanceDispatchTable;
-        map[(void *)key] = pTable;
+        layer_init_instance_dispatch_table(instance, pTable, gpa);
+        map.insert(key, pTable);
 #if DISPATCH_MAP_DEBUG
         fprintf(stderr, "New, Instance: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pTable);
 #endif
     } else {
 #if DISPATCH_MAP_DEBUG
-        fprintf(stderr, "Instance: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, it->second);
+        fprintf(stderr, "Instance: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pExisting);
 #endif
-        return it->second;
+        return pExisting;
     }
 
-    layer_init_instance_dispatch_table(instance, pTable, gpa);
-
     return pTable;
 }
 
@@ -166,23 +165,23 @@ VkLayerInstanceDispatchTable *initInstanceTable(VkInstance instance, const PFN_v
 VkLayerDispatchTable *initDeviceTable(VkDevice device, const PFN_vkGetDeviceProcAddr gpa, device_table_map &map) {
     VkLayerDispatchTable *pTable;
     dispatch_key key = get_dispatch_key(device);
-    device_table_map::const_iterator it = map.find((void *)key);
+    VkLayerDispatchTable *pExisting = map.find(key);
 
-    if (it == map.end()) {
+    if (!pExisting) {
+        // Fill the table before publishing it so lock-free lookups never see it half initialized
         pTable = new VkLayerDispatchTable;
-        map[(void *)key] = pTable;
+        layer_init_device_dispatch_table(device, pTable, gpa);
+        map.insert(key, pTable);
 #if DISPATCH_MAP_DEBUG
         fprintf(stderr, "New, Device: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pTable);
 #endif
     } else {
 #if DISPATCH_MAP_DEBUG
-        fprintf(stderr, "Device: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, it->second);
+        fprintf(stderr, "Device: map:  0x%p, key:  0x%p, table:  0x%p\n", &map, key, pExisting);
 #endif
-        return it->second;
+        return pExisting;
     }
 
-    layer_init_device_dispatch_table(device, pTable, gpa);
-
     return pTable;
 }
 
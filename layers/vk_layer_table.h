@@ -21,10 +21,10 @@
 
 #include "vulkan/vk_layer.h"
 #include "vulkan/vulkan.h"
-#include <unordered_map>
+#include "vk_layer_dispatch_map.h"
 
-typedef std::unordered_map<void *, VkLayerDispatchTable *> device_table_map;
-typedef std::unordered_map<void *, VkLayerInstanceDispatchTable *> instance_table_map;
+typedef dispatch_key_map<VkLayerDispatchTable> device_table_map;
+typedef dispatch_key_map<VkLayerInstanceDispatchTable> instance_table_map;
 VkLayerDispatchTable *initDeviceTable(VkDevice device, const PFN_vkGetDeviceProcAddr gpa, device_table_map &map);
 VkLayerDispatchTable *initDeviceTable(VkDevice device, const PFN_vkGetDeviceProcAddr gpa);
 VkLayerInstanceDispatchTable *initInstanceTable(VkInstance instance, const PFN_vkGetInstanceProcAddr gpa, instance_table_map &map);
@@ -0,0 +1,232 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+// Binary capture format for api_dump.
+//
+// With lunarg_api_dump.binary set, the layer writes one record per call instead of formatting
+// text: the call, the thread index and frame, then the parameters in declaration order.  Values
+// are copied as raw bytes and pointers as their 64-bit address, followed by a copy of whatever
+// the text output would have dereferenced: an element count and the raw elements, and for
+// structs the same again for each of their pointer members, pNext chains included.  Records are
+// only readable on the ABI they were written on, which the file header identifies.
+//
+// vk_api_dump_print reads the records back, points each parameter at its copy, and renders the
+// text api_dump would have written, addresses included.
+
+#define API_DUMP_CAPTURE_MAGIC "VKAPIDMP"
+#define API_DUMP_CAPTURE_VERSION 1
+
+// Settings the text output depends on, in ApiDumpCaptureHeader::flags
+#define API_DUMP_CAPTURE_DETAILED 0x1
+#define API_DUMP_CAPTURE_ADDRESSES 0x2
+
+struct ApiDumpCaptureHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t pointerSize;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct ApiDumpRecordHeader {
+    uint32_t size; // Bytes of parameter data following the header
+    uint32_t call; // ApiDumpCallId
+    uint32_t thread;
+    uint32_t reserved;
+    uint64_t frame;
+};
+
+// Builds one record on the stack; the first few KB never touch the heap
+class ApiDumpRecordWriter {
+  public:
+    ApiDumpRecordWriter(uint32_t call, uint64_t frame)
+        : data_(inline_.bytes), capacity_(kInlineSize), size_(sizeof(ApiDumpRecordHeader)), failed_(false) {
+        ApiDumpRecordHeader *hdr = header();
+        hdr->size = 0;
+        hdr->call = call;
+        hdr->thread = 0;
+        hdr->reserved = 0;
+        hdr->frame = frame;
+    }
+
+    ~ApiDumpRecordWriter() {
+        if (data_ != inline_.bytes)
+            free(data_);
+    }
+
+    void write(const void *src, size_t size) {
+        if (failed_)
+            return;
+        if (capacity_ - size_ < size && !grow(size))
+            return;
+        memcpy(data_ + size_, src, size);
+        size_ += size;
+    }
+
+    template <typename T> void write_value(const T &value) { write(&value, sizeof(T)); }
+
+    void write_pointer(const void *pointer) { write_value((uint64_t)(uintptr_t)pointer); }
+
+    // Count and elements of an array the text output reads through a pointer
+    template <typename T> void write_array(const T *elements, uint32_t count) {
+        write_value(count);
+        write(elements, sizeof(T) * count);
+    }
+
+    void write_string(const char *str) { write_array(str, (uint32_t)strlen(str)); }
+
+    ApiDumpRecordHeader *header() { return reinterpret_cast<ApiDumpRecordHeader *>(data_); }
+
+    // The complete record, with the header's size filled in
+    const void *finish() {
+        header()->size = (uint32_t)(size_ - sizeof(ApiDumpRecordHeader));
+        return data_;
+    }
+
+    size_t size() const { return size_; }
+
+    // True if the record ran out of memory; it is incomplete and should be dropped
+    bool failed() const { return failed_; }
+
+  private:
+    ApiDumpRecordWriter(const ApiDumpRecordWriter &);
+    ApiDumpRecordWriter &operator=(const ApiDumpRecordWriter &);
+
+    static const size_t kInlineSize = 4096;
+
+    bool grow(size_t size) {
+        size_t capacity = capacity_ * 2;
+        while (capacity - size_ < size)
+            capacity *= 2;
+        char *data = (char *)malloc(capacity);
+        if (!data) {
+            failed_ = true;
+            return false;
+        }
+        memcpy(data, data_, size_);
+        if (data_ != inline_.bytes)
+            free(data_);
+        data_ = data;
+        capacity_ = capacity;
+        return true;
+    }
+
+    union {
+        char bytes[kInlineSize];
+        uint64_t align_u64;
+    } inline_;
+    char *data_;
+    size_t capacity_;
+    size_t size_;
+    bool failed_;
+};
+
+// Reads one record back.  Arrays are copied into storage owned by the reader, which remembers the
+// address each copy stands for so the text output can show the captured addresses.
+class ApiDumpRecordReader {
+  public:
+    ApiDumpRecordReader(const void *data, size_t size)
+        : data_(static_cast<const char *>(data)), size_(size), offset_(0), failed_(false) {}
+
+    ~ApiDumpRecordReader() {
+        for (size_t i = 0; i < blocks_.size(); ++i)
+            delete[] blocks_[i].data;
+    }
+
+    void read(void *dst, size_t size) {
+        if (failed_ || size_ - offset_ < size) {
+            failed_ = true;
+            memset(dst, 0, size);
+            return;
+        }
+        memcpy(dst, data_ + offset_, size);
+        offset_ += size;
+    }
+
+    template <typename T> void read_value(T &value) { read(&value, sizeof(T)); }
+
+    uint64_t read_pointer() {
+        uint64_t pointer;
+        read_value(pointer);
+        return pointer;
+    }
+
+    // Replaces a captured pointer with a copy of the array written by write_array, and returns the
+    // element count.  A truncated record leaves the pointer NULL.
+    template <typename T> uint32_t read_array(T *&pointer) {
+        typedef typename std::remove_const<T>::type Element;
+        uint32_t count;
+        read_value(count);
+        if (failed_ || (size_ - offset_) / sizeof(Element) < count) {
+            failed_ = true;
+            pointer = NULL;
+            return 0;
+        }
+        Element *copy = static_cast<Element *>(alloc(sizeof(Element) * count + 1, (uint64_t)(uintptr_t)pointer));
+        read(copy, sizeof(Element) * count);
+        pointer = copy;
+        return count;
+    }
+
+    // Storage standing in for the object captured at original
+    void *alloc(size_t size, uint64_t original) {
+        Block block;
+        block.data = new uint64_t[(size + sizeof(uint64_t) - 1) / sizeof(uint64_t)]();
+        block.size = size;
+        block.original = original;
+        blocks_.push_back(block);
+        return block.data;
+    }
+
+    // Maps an address inside a copy back to the captured one; other addresses are returned as is
+    uint64_t original_address(uint64_t address) const {
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+            uint64_t data = (uint64_t)(uintptr_t)blocks_[i].data;
+            if (address >= data && address < data + blocks_[i].size)
+                return blocks_[i].original + (address - data);
+        }
+        return address;
+    }
+
+    // True once the whole record has been read without running past its end
+    bool complete() const { return !failed_ && offset_ == size_; }
+
+  private:
+    ApiDumpRecordReader(const ApiDumpRecordReader &);
+    ApiDumpRecordReader &operator=(const ApiDumpRecordReader &);
+
+    struct Block {
+        uint64_t *data;
+        size_t size;
+        uint64_t original;
+    };
+
+    const char *data_;
+    size_t size_;
+    size_t offset_;
+    bool failed_;
+    std::vector<Block> blocks_;
+};
@@ -0,0 +1,129 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Entrypoint patterns for the lunarg_api_dump.entrypoints and exclude_entrypoints settings, and
+// the frame range for lunarg_api_dump.frames.
+
+// Matches a name against a pattern where '*' stands for any run of characters
+static inline bool matchEntrypoint(const char *pattern, const char *patternEnd, const char *name) {
+    const char *star = NULL;
+    const char *starName = NULL;
+    while (*name) {
+        if (pattern != patternEnd && *pattern == '*') {
+            star = pattern++;
+            starName = name;
+        } else if (pattern != patternEnd && *pattern == *name) {
+            ++pattern;
+            ++name;
+        } else if (star) {
+            pattern = star + 1;
+            name = ++starName;
+        } else {
+            return false;
+        }
+    }
+    while (pattern != patternEnd && *pattern == '*')
+        ++pattern;
+    return pattern == patternEnd;
+}
+
+static inline bool isEntrypointListSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Steps to the next pattern in a comma separated list, setting [begin, end) to it with the
+// whitespace around it trimmed.  Empty patterns are skipped.  False at the end of the list.
+static inline bool nextEntrypointPattern(const char **list, const char **begin, const char **end) {
+    while (**list) {
+        const char *first = *list;
+        const char *last = strchr(first, ',');
+        if (last == NULL)
+            last = first + strlen(first);
+        *list = *last ? last + 1 : last;
+        while (first != last && isEntrypointListSpace(*first))
+            ++first;
+        while (last != first && isEntrypointListSpace(last[-1]))
+            --last;
+        if (last != first) {
+            *begin = first;
+            *end = last;
+            return true;
+        }
+    }
+    return false;
+}
+
+// True if name matches any pattern in a comma separated list.  Whitespace around each pattern is
+// ignored, so "vkQueueSubmit, vkCmdDraw*" works as well as "vkQueueSubmit,vkCmdDraw*".
+static inline bool matchEntrypointList(const char *list, const char *name) {
+    const char *begin, *end;
+    while (nextEntrypointPattern(&list, &begin, &end)) {
+        if (matchEntrypoint(begin, end, name))
+            return true;
+    }
+    return false;
+}
+
+// Reads a decimal frame number from [begin, end) with the whitespace around it trimmed.  False
+// unless it's all digits and fits in 64 bits.
+static inline bool parseFrameNumber(const char *begin, const char *end, uint64_t *frame) {
+    while (begin != end && isEntrypointListSpace(*begin))
+        ++begin;
+    while (end != begin && isEntrypointListSpace(end[-1]))
+        --end;
+    if (begin == end)
+        return false;
+    uint64_t value = 0;
+    for (; begin != end; ++begin) {
+        if (*begin < '0' || *begin > '9')
+            return false;
+        uint64_t digit = (uint64_t)(*begin - '0');
+        if (value > (UINT64_MAX - digit) / 10)
+            return false;
+        value = value * 10 + digit;
+    }
+    *frame = value;
+    return true;
+}
+
+// Reads a frame range: "first-last", "first-" (to the end) or a single frame, with whitespace
+// allowed around each number.  False, leaving first and last alone, if it's malformed or last
+// comes before first.
+static inline bool parseFrameRange(const char *frames, uint64_t *first, uint64_t *last) {
+    const char *end = frames + strlen(frames);
+    const char *dash = strchr(frames, '-');
+    uint64_t start, stop = UINT64_MAX;
+    if (!parseFrameNumber(frames, dash ? dash : end, &start))
+        return false;
+    if (dash == NULL) {
+        stop = start;
+    } else {
+        const char *rest = dash + 1;
+        while (rest != end && isEntrypointListSpace(*rest))
+            ++rest;
+        if (rest != end && !parseFrameNumber(rest, end, &stop))
+            return false;
+    }
+    if (start > stop)
+        return false;
+    *first = start;
+    *last = stop;
+    return true;
+}
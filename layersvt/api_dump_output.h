@@ -0,0 +1,282 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "vk_loader_platform.h"
+
+// Buffered output for api_dump.
+//
+// Each thread formats its calls into entries of its own and hands them over through a lock-free
+// list, so calls on different threads never wait for each other.  Every entry is numbered when the
+// call starts formatting; a writer thread collects the entries every few milliseconds and writes
+// them in that order, then hands them back to their thread to be reused.
+
+class ApiDumpThread;
+
+struct ApiDumpEntry {
+    ApiDumpEntry *next;
+    ApiDumpThread *owner;
+    uint64_t sequence;
+    size_t size;
+    std::vector<char> data; // Kept between calls, so it only grows while the first few calls are dumped
+};
+
+// Lets a std::ostream write straight into an entry's storage
+class ApiDumpEntryBuf : public std::streambuf {
+  public:
+    ApiDumpEntryBuf() : entry_(NULL) {}
+
+    void begin(ApiDumpEntry *entry) {
+        entry_ = entry;
+        if (entry->data.empty())
+            entry->data.resize(kInitialSize);
+        setp(entry->data.data(), entry->data.data() + entry->data.size());
+    }
+
+    void end() {
+        entry_->size = (size_t)(pptr() - pbase());
+        entry_ = NULL;
+    }
+
+  protected:
+    int_type overflow(int_type c) {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        grow(1);
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) {
+        if (epptr() - pptr() < n)
+            grow((size_t)n);
+        memcpy(pptr(), s, (size_t)n);
+        pbump((int)n);
+        return n;
+    }
+
+  private:
+    static const size_t kInitialSize = 256;
+
+    void grow(size_t size) {
+        size_t used = (size_t)(pptr() - pbase());
+        size_t capacity = entry_->data.size() * 2;
+        while (capacity - used < size)
+            capacity *= 2;
+        entry_->data.resize(capacity);
+        setp(entry_->data.data(), entry_->data.data() + capacity);
+        pbump((int)used);
+    }
+
+    ApiDumpEntry *entry_;
+};
+
+class ApiDumpThread {
+  public:
+    // Threads are numbered in the order they first make a call
+    uint32_t index() const { return index_; }
+
+  private:
+    friend class ApiDumpOutput;
+
+    explicit ApiDumpThread(uint32_t index) : index_(index), stream_(&buf_), current_(NULL), cache_(NULL), pending_(NULL), free_(NULL) {}
+
+    ~ApiDumpThread() {
+        release(cache_);
+        release(pending_.load());
+        release(free_.load());
+    }
+
+    static void release(ApiDumpEntry *entry) {
+        while (entry) {
+            ApiDumpEntry *next = entry->next;
+            delete entry;
+            entry = next;
+        }
+    }
+
+    static void push(std::atomic<ApiDumpEntry *> &list, ApiDumpEntry *entry) {
+        entry->next = list.load(std::memory_order_relaxed);
+        while (!list.compare_exchange_weak(entry->next, entry, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint32_t index_;
+    ApiDumpEntryBuf buf_;
+    std::ostream stream_;
+    ApiDumpEntry *current_;
+    ApiDumpEntry *cache_;                  // Entries back from the writer, only touched by this thread
+    std::atomic<ApiDumpEntry *> pending_;  // Written entries, newest first
+    std::atomic<ApiDumpEntry *> free_;     // Entries the writer is done with
+};
+
+class ApiDumpOutput {
+  public:
+    ApiDumpOutput() : out_(NULL), flush_(false), stop_(false), sequence_(0), next_(0) {}
+
+    ~ApiDumpOutput() {
+        stop();
+        if (out_)
+            write(true);
+        for (size_t i = 0; i < threads_.size(); ++i)
+            delete threads_[i];
+    }
+
+    // Sets where entries are written.  With flush set, out is flushed each time entries are
+    // written rather than after every call.
+    void configure(std::ostream *out, bool flush) {
+        std::lock_guard<std::mutex> lock(writerLock_);
+        out_ = out;
+        flush_ = flush;
+    }
+
+    // Starts the writer if it isn't running
+    void start() {
+        std::lock_guard<std::mutex> lock(writerLock_);
+        if (writer_.joinable() || out_ == NULL)
+            return;
+        stop_ = false;
+        writer_ = std::thread(&ApiDumpOutput::run, this);
+    }
+
+    // Writes everything that's been dumped and stops the writer
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(writerLock_);
+            if (!writer_.joinable())
+                return;
+            stop_ = true;
+        }
+        wake_.notify_one();
+        writer_.join();
+    }
+
+    ApiDumpThread &thread() {
+        static THREAD_LOCAL_DECL ApiDumpThread *current = NULL;
+        if (current == NULL) {
+            std::lock_guard<std::mutex> lock(threadsLock_);
+            current = new ApiDumpThread((uint32_t)threads_.size());
+            threads_.push_back(current);
+        }
+        return *current;
+    }
+
+    // Numbers the calling thread's next entry and returns a stream that appends to it
+    std::ostream &begin(ApiDumpThread &thread) {
+        ApiDumpEntry *entry = thread.cache_;
+        if (entry == NULL)
+            entry = thread.free_.exchange(NULL, std::memory_order_acquire);
+        if (entry == NULL) {
+            entry = new ApiDumpEntry;
+            entry->next = NULL;
+            entry->owner = &thread;
+        }
+        thread.cache_ = entry->next;
+        entry->sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+        thread.current_ = entry;
+        thread.buf_.begin(entry);
+        return thread.stream_;
+    }
+
+    // Hands the entry begin() returned to the writer
+    void end(ApiDumpThread &thread) {
+        thread.buf_.end();
+        ApiDumpThread::push(thread.pending_, thread.current_);
+        thread.current_ = NULL;
+    }
+
+  private:
+    ApiDumpOutput(const ApiDumpOutput &);
+    ApiDumpOutput &operator=(const ApiDumpOutput &);
+
+    static const int kWritePeriodMs = 10;
+
+    struct Later {
+        bool operator()(const ApiDumpEntry *a, const ApiDumpEntry *b) const { return a->sequence > b->sequence; }
+    };
+
+    void run() {
+        // A copy, as binding kWritePeriodMs to the duration's const reference would need a definition
+        const int period_ms = kWritePeriodMs;
+        std::unique_lock<std::mutex> lock(writerLock_);
+        while (!stop_) {
+            wake_.wait_for(lock, std::chrono::milliseconds(period_ms));
+            lock.unlock();
+            write(false);
+            lock.lock();
+        }
+        lock.unlock();
+        write(true);
+    }
+
+    // Writes entries in sequence order as far as the next one still being formatted, or all of
+    // them once the application has stopped calling in
+    void write(bool final) {
+        {
+            std::lock_guard<std::mutex> lock(threadsLock_);
+            for (size_t i = 0; i < threads_.size(); ++i) {
+                ApiDumpEntry *entry = threads_[i]->pending_.exchange(NULL, std::memory_order_acquire);
+                for (; entry; entry = entry->next) {
+                    ready_.push_back(entry);
+                    std::push_heap(ready_.begin(), ready_.end(), Later());
+                }
+            }
+        }
+
+        // An entry older than next_ was still being formatted when the writer last stopped
+        bool wrote = false;
+        while (!ready_.empty() && (final || ready_.front()->sequence <= next_)) {
+            ApiDumpEntry *entry = ready_.front();
+            std::pop_heap(ready_.begin(), ready_.end(), Later());
+            ready_.pop_back();
+            out_->write(entry->data.data(), entry->size);
+            next_ = std::max(next_, entry->sequence + 1);
+            wrote = true;
+            ApiDumpThread::push(entry->owner->free_, entry);
+        }
+        if (wrote && (flush_ || final))
+            out_->flush();
+    }
+
+    std::ostream *out_;
+    bool flush_;
+    bool stop_;
+    std::atomic<uint64_t> sequence_;
+    uint64_t next_;                    // Writer only
+    std::vector<ApiDumpEntry *> ready_; // Writer only, a min-heap on sequence
+
+    std::mutex threadsLock_;
+    std::vector<ApiDumpThread *> threads_;
+
+    std::mutex writerLock_;
+    std::condition_variable wake_;
+    std::thread writer_;
+};
@@ -21,6 +21,7 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,9 +31,11 @@
 #include <algorithm>
 #include <list>
 #include <map>
-#include <set>
 #include <vector>
-#include <fstream>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 using namespace std;
 
@@ -43,6 +46,33 @@ using namespace std;
 #include "vk_layer_extension_utils.h"
 #include "vk_layer_utils.h"
 
+#if defined(SCREENSHOT_PNG)
+#include <zlib.h>
+#endif
+
+// Vector paths for packing pixels.  SSSE3 is checked for at run time; NEON is
+// always there on the ARM targets that have the header.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) ||            \
+    defined(_M_IX86)
+#define SCREENSHOT_SSSE3
+#include <tmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SCREENSHOT_TARGET_SSSE3
+static bool cpuHasSSSE3() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+}
+#else
+#define SCREENSHOT_TARGET_SSSE3 __attribute__((target("ssse3")))
+static bool cpuHasSSSE3() { return __builtin_cpu_supports("ssse3") != 0; }
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SCREENSHOT_NEON
+#include <arm_neon.h>
+#endif
+
 #if defined(__linux__)
 static inline char *local_getenv(const char *name) { return getenv(name); }
 
@@ -94,15 +124,19 @@ typedef struct {
 } ImageMapStruct;
 static unordered_map<VkImage, ImageMapStruct *> imageMap;
 
+struct DeviceCapture;
+
 // unordered map: associates a device with a queue, commandPool, and physical
 // device also contains per device info including dispatch table
 typedef struct {
     VkLayerDispatchTable *device_dispatch_table;
     bool wsi_enabled;
     VkQueue queue;
+    uint32_t queueFamilyIndex;
     VkCommandPool commandPool;
     VkPhysicalDevice physicalDevice;
     PFN_vkSetDeviceLoaderData pfn_dev_init;
+    DeviceCapture *capture; // Staging resources, made on the first capture
 } DeviceMapStruct;
 static unordered_map<VkDevice, DeviceMapStruct *> deviceMap;
 
@@ -110,12 +144,34 @@ static unordered_map<VkDevice, DeviceMapStruct *> deviceMap;
 typedef struct { VkInstance instance; } PhysDeviceMapStruct;
 static unordered_map<VkPhysicalDevice, PhysDeviceMapStruct *> physDeviceMap;
 
-// set: list of frames to take screenshots without duplication.
-static set<int> screenshotFrames;
+// Frames to take screenshots of: every step'th frame from first to last.  A
+// single frame has a step of 1 and the same first and last.
+typedef struct {
+    int first;
+    int last;
+    int step;
+} FrameRange;
+
+// list: frame ranges still to come, from _VK_SCREENSHOT.
+static list<FrameRange> screenshotFrames;
+
+// Number of most recent frames kept in memory, from _VK_SCREENSHOT_LAST, and
+// the file whose appearance writes them out, from _VK_SCREENSHOT_TRIGGER.
+static uint32_t screenshotRingSize = 0;
+static string screenshotTrigger;
+
+// Write PNG rather than PPM files, from _VK_SCREENSHOT_FORMAT
+static bool screenshotPNG = false;
 
 // Flag indicating we have queried _VK_SCREENSHOT env var
 static bool screenshotEnvQueried = false;
 
+// True once there is nothing more to capture
+static bool screenshotsDone() {
+    return screenshotEnvQueried && screenshotFrames.empty() &&
+           0 == screenshotRingSize;
+}
+
 static bool
 memory_type_from_properties(VkPhysicalDeviceMemoryProperties *memory_properties,
                             uint32_t typeBits, VkFlags requirements_mask,
@@ -156,101 +212,562 @@ static void init_screenshot() {
     }
 }
 
-// Track allocated resources in writePPM()
-// and clean them up when they go out of scope.
-struct WritePPMCleanupData {
-    VkDevice device;
-    VkLayerDispatchTable *pTableDevice;
+// Captures are pipelined through a few sets of staging resources per device.
+// The present thread records the copy of the swapchain image into a free slot
+// and submits it with the slot's fence.  The device's writer thread waits on
+// the fence, converts the pixels and writes the file, then frees the slot.
+// The present thread only waits when every slot is still being written.
+static const uint32_t captureSlotCount = 3;
+
+struct CaptureSlot {
     VkImage image2;
     VkImage image3;
     VkDeviceMemory mem2;
     VkDeviceMemory mem3;
-    bool mem2mapped;
-    bool mem3mapped;
     VkCommandBuffer commandBuffer;
+    VkFence fence;
+    const char *ptr; // The final image, mapped for as long as the slot lives
+    VkSubresourceLayout srLayout;
+    string fileName;
+    bool toRing; // Keep the frame in memory rather than write it now
+    bool busy;
+};
+
+// An image file held in memory until the ring of recent frames is written out
+typedef struct {
+    string fileName;
+    vector<char> data;
+} CapturedFrame;
+
+// The staging resources are made for one extent and format and kept until the
+// swapchain changes or the device is destroyed.
+struct DeviceCapture {
+    VkDevice device;
+    VkLayerDispatchTable *pTable;
     VkCommandPool commandPool;
-    ~WritePPMCleanupData();
+    VkExtent2D extent;
+    VkFormat format;
+    uint32_t numChannels;
+    bool copyOnly;
+    bool need2steps;
+    bool swapRB; // The staging image holds BGR(A) rather than RGB(A)
+    bool png;
+    CaptureSlot slots[captureSlotCount];
+
+    mutex lock;
+    condition_variable cond;
+    deque<CaptureSlot *> pending; // Submitted, or NULL to write out the ring
+    bool stop;
+    thread writer;
+    vector<char> fileData;     // Writer only
+    vector<uint8_t> pngRows;   // Writer only, filtered rows before deflate
+    uint32_t ringSize;         // Most recent frames to keep
+    deque<CapturedFrame> ring; // Writer only, oldest first
 };
 
-WritePPMCleanupData::~WritePPMCleanupData() {
-    if (mem2mapped)
-        pTableDevice->UnmapMemory(device, mem2);
-    if (mem2)
-        pTableDevice->FreeMemory(device, mem2, NULL);
-    if (image2)
-        pTableDevice->DestroyImage(device, image2, NULL);
-
-    if (mem3mapped)
-        pTableDevice->UnmapMemory(device, mem3);
-    if (mem3)
-        pTableDevice->FreeMemory(device, mem3, NULL);
-    if (image3)
-        pTableDevice->DestroyImage(device, image3, NULL);
-
-    if (commandBuffer)
-        pTableDevice->FreeCommandBuffers(device, commandPool, 1,
-                                         &commandBuffer);
+// Pack one row of 32-bit pixels into 24-bit RGB, dropping alpha and swapping
+// red and blue for BGRA sources.  Sixteen pixels are done at a time with SSSE3
+// or NEON where the CPU has them.
+static void packRowScalar(const uint8_t *src, uint8_t *dst, uint32_t width,
+                          bool swapRB) {
+    uint32_t const r = swapRB ? 2 : 0;
+    uint32_t const b = swapRB ? 0 : 2;
+    for (uint32_t x = 0; x < width; x++) {
+        dst[0] = src[r];
+        dst[1] = src[1];
+        dst[2] = src[b];
+        dst += 3;
+        src += 4;
+    }
 }
 
-// Save an image to a PPM image file.
-//
-// This function issues commands to copy/convert the swapchain image
-// from whatever compatible format the swapchain image uses
-// to a single format (VK_FORMAT_R8G8B8A8_UNORM) so that the converted
-// result can be easily written to a PPM file.
-//
-// Error handling: If there is a problem, this function should silently
-// fail without affecting the Present operation going on in the caller.
-// The numerous debug asserts are to catch programming errors and are not
-// expected to assert.  Recovery and clean up are implemented for image memory
-// allocation failures.
-// (TODO) It would be nice to pass any failure info to DebugReport or something.
-static void writePPM(const char *filename, VkImage image1) {
+#if defined(SCREENSHOT_SSSE3)
+SCREENSHOT_TARGET_SSSE3
+static void packRowSSSE3(const uint8_t *src, uint8_t *dst, uint32_t width,
+                         bool swapRB) {
+    __m128i const mask =
+        swapRB ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                               -1, -1)
+               : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1,
+                               -1, -1);
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        // Each shuffle leaves 4 pixels in the low 12 bytes; three stores of
+        // 16 bytes then hold all 16.
+        __m128i a = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(src + 0)), mask);
+        __m128i b = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(src + 16)), mask);
+        __m128i c = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(src + 32)), mask);
+        __m128i d = _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *)(src + 48)), mask);
+        _mm_storeu_si128((__m128i *)(dst + 0),
+                         _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128(
+            (__m128i *)(dst + 16),
+            _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128(
+            (__m128i *)(dst + 32),
+            _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+        src += 64;
+        dst += 48;
+    }
+    packRowScalar(src, dst, width - x, swapRB);
+}
+#endif
 
-    VkResult err;
-    bool pass;
+#if defined(SCREENSHOT_NEON)
+static void packRowNEON(const uint8_t *src, uint8_t *dst, uint32_t width,
+                        bool swapRB) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t in = vld4q_u8(src);
+        uint8x16x3_t out;
+        out.val[0] = swapRB ? in.val[2] : in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = swapRB ? in.val[0] : in.val[2];
+        vst3q_u8(dst, out);
+        src += 64;
+        dst += 48;
+    }
+    packRowScalar(src, dst, width - x, swapRB);
+}
+#endif
 
-    // Bail immediately if we can't find the image.
-    if (imageMap.empty() || imageMap.find(image1) == imageMap.end())
-        return;
+typedef void (*PackRowFunc)(const uint8_t *src, uint8_t *dst, uint32_t width,
+                            bool swapRB);
 
-    // Collect object info from maps.  This info is generally recorded
-    // by the other functions hooked in this layer.
-    VkDevice device = imageMap[image1]->device;
-    VkPhysicalDevice physicalDevice = deviceMap[device]->physicalDevice;
-    VkInstance instance = physDeviceMap[physicalDevice]->instance;
-    VkQueue queue = deviceMap[device]->queue;
-    DeviceMapStruct *devMap = get_dev_info(device);
-    if (NULL == devMap) {
-        assert(0);
+static PackRowFunc getPackRow() {
+#if defined(SCREENSHOT_SSSE3)
+    if (cpuHasSSSE3())
+        return packRowSSSE3;
+#elif defined(SCREENSHOT_NEON)
+    return packRowNEON;
+#endif
+    return packRowScalar;
+}
+
+// Convert one row of the captured image to 24-bit RGB
+static void convertRow(DeviceCapture *capture, const uint8_t *src,
+                       uint8_t *dst) {
+    uint32_t const width = capture->extent.width;
+    if (4 == capture->numChannels) {
+        static PackRowFunc const packRow = getPackRow();
+        packRow(src, dst, width, capture->swapRB);
+    } else if (capture->swapRB) {
+        for (uint32_t x = 0; x < width; x++) {
+            dst[0] = src[2];
+            dst[1] = src[1];
+            dst[2] = src[0];
+            dst += 3;
+            src += 3;
+        }
+    } else {
+        memcpy(dst, src, 3 * width);
+    }
+}
+
+// Convert a captured image to the contents of a PPM file.
+static void encodePPM(DeviceCapture *capture, CaptureSlot *slot,
+                      vector<char> &fileData) {
+    uint32_t const width = capture->extent.width;
+    uint32_t const height = capture->extent.height;
+    char header[64];
+    int headerSize =
+        snprintf(header, sizeof(header), "P6\n%u\n%u\n255\n", width, height);
+
+    fileData.resize(headerSize + 3 * (size_t)width * height);
+    memcpy(fileData.data(), header, headerSize);
+    uint8_t *out = (uint8_t *)fileData.data() + headerSize;
+
+    const uint8_t *ptr = (const uint8_t *)slot->ptr + slot->srLayout.offset;
+    for (uint32_t y = 0; y < height; y++) {
+        convertRow(capture, ptr, out);
+        out += 3 * width;
+        ptr += slot->srLayout.rowPitch;
+    }
+}
+
+#if defined(SCREENSHOT_PNG)
+static void putBigEndian32(vector<char> &out, uint32_t value) {
+    out.push_back((char)(value >> 24));
+    out.push_back((char)(value >> 16));
+    out.push_back((char)(value >> 8));
+    out.push_back((char)value);
+}
+
+// Append a PNG chunk whose data is already at the end of out, after the
+// 8 bytes reserved for its length and type.
+static void finishChunk(vector<char> &out, size_t start, const char *type) {
+    uint32_t const length = (uint32_t)(out.size() - start - 8);
+    for (int i = 0; i < 4; i++) {
+        out[start + i] = (char)(length >> (24 - 8 * i));
+        out[start + 4 + i] = type[i];
+    }
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, (const Bytef *)&out[start + 4], length + 4);
+    putBigEndian32(out, (uint32_t)crc);
+}
+
+// Convert a captured image to the contents of an 8-bit RGB PNG file.  Each
+// row uses the Sub filter, which costs little and lets the fastest deflate
+// level still compress rendered images well.  Returns false if the image
+// could not be compressed.
+static bool encodePNG(DeviceCapture *capture, CaptureSlot *slot,
+                      vector<char> &fileData) {
+    uint32_t const width = capture->extent.width;
+    uint32_t const height = capture->extent.height;
+    size_t const rowSize = 1 + 3 * (size_t)width;
+
+    vector<uint8_t> &rows = capture->pngRows;
+    rows.resize(rowSize * height);
+    const uint8_t *ptr = (const uint8_t *)slot->ptr + slot->srLayout.offset;
+    for (uint32_t y = 0; y < height; y++) {
+        uint8_t *row = &rows[y * rowSize];
+        row[0] = 1; // Sub
+        convertRow(capture, ptr, row + 1);
+        // Right to left, so each byte's left neighbour is still unfiltered
+        for (size_t x = rowSize - 1; x > 3; x--)
+            row[x] -= row[x - 3];
+        ptr += slot->srLayout.rowPitch;
+    }
+
+    static const char signature[8] = {'\x89', 'P',  'N',    'G',
+                                      '\r',   '\n', '\x1a', '\n'};
+    fileData.assign(signature, signature + sizeof(signature));
+
+    size_t start = fileData.size();
+    fileData.resize(start + 8);
+    putBigEndian32(fileData, width);
+    putBigEndian32(fileData, height);
+    fileData.push_back(8); // Bit depth
+    fileData.push_back(2); // RGB
+    fileData.push_back(0); // Deflate
+    fileData.push_back(0); // Adaptive filtering
+    fileData.push_back(0); // No interlace
+    finishChunk(fileData, start, "IHDR");
+
+    start = fileData.size();
+    uLongf compressedSize = compressBound((uLong)rows.size());
+    fileData.resize(start + 8 + compressedSize);
+    int const result = compress2((Bytef *)&fileData[start + 8], &compressedSize,
+                                 rows.data(), (uLong)rows.size(), Z_BEST_SPEED);
+    if (result != Z_OK) {
+        fprintf(stderr, "screenshot: could not compress %s (zlib error %d)\n",
+                slot->fileName.c_str(), result);
+        fileData.clear();
+        return false;
+    }
+    fileData.resize(start + 8 + compressedSize);
+    finishChunk(fileData, start, "IDAT");
+
+    start = fileData.size();
+    fileData.resize(start + 8);
+    finishChunk(fileData, start, "IEND");
+    return true;
+}
+#endif
+
+// Convert a captured image to the contents of its file.  Runs on the writer
+// thread once the copy has finished.  Returns false, leaving no file to write,
+// if the image could not be encoded.
+static bool encodeImage(DeviceCapture *capture, CaptureSlot *slot,
+                        vector<char> &fileData) {
+#if defined(SCREENSHOT_PNG)
+    if (capture->png)
+        return encodePNG(capture, slot, fileData);
+#endif
+    encodePPM(capture, slot, fileData);
+    return true;
+}
+
+static void writeFile(const string &fileName, const vector<char> &fileData) {
+    FILE *file = fopen(fileName.c_str(), "wb");
+    if (file) {
+        fwrite(fileData.data(), 1, fileData.size(), file);
+        fclose(file);
+    }
+}
+
+static void writeRing(deque<CapturedFrame> &ring) {
+    for (auto it = ring.begin(); it != ring.end(); it++)
+        writeFile(it->fileName, it->data);
+    ring.clear();
+}
+
+// Keep a captured image as the newest frame in the ring, evicting the oldest
+// frame once the ring is full.  The image is encoded into the writer's
+// scratch buffer first, so a failed encode leaves the ring as it was; the
+// storage it replaces becomes the next scratch buffer.
+static void keepInRing(DeviceCapture *capture, CaptureSlot *slot) {
+    if (!encodeImage(capture, slot, capture->fileData))
         return;
+    capture->ring.push_back(CapturedFrame());
+    if (capture->ring.size() > capture->ringSize) {
+        capture->ring.back().data.swap(capture->ring.front().data);
+        capture->ring.pop_front();
+    }
+    CapturedFrame &frame = capture->ring.back();
+    frame.fileName = slot->fileName;
+    frame.data.swap(capture->fileData);
+}
+
+static void captureWriter(DeviceCapture *capture) {
+    VkLayerDispatchTable *pTable = capture->pTable;
+    unique_lock<mutex> lock(capture->lock);
+    while (true) {
+        capture->cond.wait(lock, [capture] {
+            return capture->stop || !capture->pending.empty();
+        });
+        if (capture->pending.empty())
+            break;
+        CaptureSlot *slot = capture->pending.front();
+        capture->pending.pop_front();
+        lock.unlock();
+
+        if (NULL == slot) {
+            writeRing(capture->ring);
+            lock.lock();
+            continue;
+        }
+
+        VkResult err = pTable->WaitForFences(capture->device, 1, &slot->fence,
+                                             VK_TRUE, UINT64_MAX);
+        assert(!err);
+        if (VK_SUCCESS == err) {
+            VkMappedMemoryRange range = {
+                VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL,
+                capture->need2steps ? slot->mem3 : slot->mem2, 0,
+                VK_WHOLE_SIZE};
+            pTable->InvalidateMappedMemoryRanges(capture->device, 1, &range);
+            if (slot->toRing) {
+                keepInRing(capture, slot);
+            } else {
+                if (encodeImage(capture, slot, capture->fileData))
+                    writeFile(slot->fileName, capture->fileData);
+            }
+        }
+
+        lock.lock();
+        slot->busy = false;
+        capture->cond.notify_all();
+    }
+}
+
+static void destroyCaptureSlot(DeviceCapture *capture, CaptureSlot *slot) {
+    VkDevice device = capture->device;
+    VkLayerDispatchTable *pTable = capture->pTable;
+
+    if (slot->ptr)
+        pTable->UnmapMemory(device,
+                            capture->need2steps ? slot->mem3 : slot->mem2);
+    if (slot->mem2)
+        pTable->FreeMemory(device, slot->mem2, NULL);
+    if (slot->image2)
+        pTable->DestroyImage(device, slot->image2, NULL);
+    if (slot->mem3)
+        pTable->FreeMemory(device, slot->mem3, NULL);
+    if (slot->image3)
+        pTable->DestroyImage(device, slot->image3, NULL);
+    if (slot->fence)
+        pTable->DestroyFence(device, slot->fence, NULL);
+    if (slot->commandBuffer)
+        pTable->FreeCommandBuffers(device, capture->commandPool, 1,
+                                   &slot->commandBuffer);
+    *slot = CaptureSlot();
+}
+
+static bool createImage(DeviceCapture *capture, DeviceMapStruct *devMap,
+                        const VkImageCreateInfo *imgCreateInfo,
+                        VkFlags memoryProperties, VkImage *image,
+                        VkDeviceMemory *mem) {
+    VkDevice device = capture->device;
+    VkLayerDispatchTable *pTable = capture->pTable;
+    VkPhysicalDevice physicalDevice = devMap->physicalDevice;
+    VkLayerInstanceDispatchTable *pInstanceTable =
+        instance_dispatch_table(physDeviceMap[physicalDevice]->instance);
+
+    VkResult err = pTable->CreateImage(device, imgCreateInfo, NULL, image);
+    assert(!err);
+    if (VK_SUCCESS != err)
+        return false;
+
+    VkMemoryRequirements memRequirements;
+    VkPhysicalDeviceMemoryProperties memoryProps;
+    pTable->GetImageMemoryRequirements(device, *image, &memRequirements);
+    pInstanceTable->GetPhysicalDeviceMemoryProperties(physicalDevice,
+                                                      &memoryProps);
+    VkMemoryAllocateInfo memAllocInfo = {
+        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL, memRequirements.size, 0};
+    bool pass = memory_type_from_properties(
+        &memoryProps, memRequirements.memoryTypeBits, memoryProperties,
+        &memAllocInfo.memoryTypeIndex);
+    assert(pass);
+    if (!pass)
+        return false;
+    err = pTable->AllocateMemory(device, &memAllocInfo, NULL, mem);
+    assert(!err);
+    if (VK_SUCCESS != err)
+        return false;
+    err = pTable->BindImageMemory(device, *image, *mem, 0);
+    assert(!err);
+    return VK_SUCCESS == err;
+}
+
+// Set up the images a capture is copied through, the command buffer that
+// copies it and the fence that says when it's done, and map the final image.
+static bool createCaptureSlot(DeviceCapture *capture, DeviceMapStruct *devMap,
+                              CaptureSlot *slot) {
+    VkDevice device = capture->device;
+    VkLayerDispatchTable *pTable = capture->pTable;
+
+    // Set up the image creation info for both the blit and copy images, in
+    // case both are needed.
+    VkImageCreateInfo imgCreateInfo2 = {
+        VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        NULL,
+        0,
+        VK_IMAGE_TYPE_2D,
+        (3 == capture->numChannels) ? VK_FORMAT_R8G8B8_UNORM
+                                    : VK_FORMAT_R8G8B8A8_UNORM,
+        {capture->extent.width, capture->extent.height, 1},
+        1,
+        1,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_IMAGE_TILING_LINEAR,
+        VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        NULL,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    VkImageCreateInfo imgCreateInfo3 = imgCreateInfo2;
+
+    // If we need both images, set up image2 to be read/write and tiled.
+    if (capture->need2steps) {
+        imgCreateInfo2.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imgCreateInfo2.usage =
+            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+
+    // Create image2 and allocate its memory.  It could be the intermediate or
+    // final image.
+    if (!createImage(capture, devMap, &imgCreateInfo2,
+                     capture->need2steps ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+                                         : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                     &slot->image2, &slot->mem2))
+        return false;
+
+    // Create image3 and allocate its memory, if needed.
+    if (capture->need2steps &&
+        !createImage(capture, devMap, &imgCreateInfo3,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &slot->image3,
+                     &slot->mem3))
+        return false;
+
+    const VkCommandBufferAllocateInfo allocCommandBufferInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, NULL,
+        capture->commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+    VkResult err = pTable->AllocateCommandBuffers(
+        device, &allocCommandBufferInfo, &slot->commandBuffer);
+    assert(!err);
+    if (VK_SUCCESS != err)
+        return false;
+
+    // We have just created a dispatchable object, but the dispatch table has
+    // not been placed in the object yet.  When a "normal" application creates
+    // a command buffer, the dispatch table is installed by the top-level api
+    // binding (trampoline.c). But here, we have to do it ourselves.
+    if (!devMap->pfn_dev_init) {
+        *((const void **)slot->commandBuffer) = *(void **)device;
+    } else {
+        err = devMap->pfn_dev_init(device, (void *)slot->commandBuffer);
+        assert(!err);
     }
-    VkLayerDispatchTable *pTableDevice = devMap->device_dispatch_table;
-    VkLayerDispatchTable *pTableQueue =
-        get_dev_info(static_cast<VkDevice>(static_cast<void *>(queue)))
-            ->device_dispatch_table;
-    VkLayerInstanceDispatchTable *pInstanceTable;
-    pInstanceTable = instance_dispatch_table(instance);
-
-    // Gather incoming image info and check image format for compatibility with
-    // the target format.
+
+    const VkFenceCreateInfo fenceCreateInfo = {
+        VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, NULL, 0};
+    err = pTable->CreateFence(device, &fenceCreateInfo, NULL, &slot->fence);
+    assert(!err);
+    if (VK_SUCCESS != err)
+        return false;
+
+    // Map the final image so that the CPU can read it.
+    const VkImageSubresource sr = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0};
+    VkImage finalImage = capture->need2steps ? slot->image3 : slot->image2;
+    VkDeviceMemory finalMem = capture->need2steps ? slot->mem3 : slot->mem2;
+    pTable->GetImageSubresourceLayout(device, finalImage, &sr,
+                                      &slot->srLayout);
+    err = pTable->MapMemory(device, finalMem, 0, VK_WHOLE_SIZE, 0,
+                            (void **)&slot->ptr);
+    assert(!err);
+    if (VK_SUCCESS != err) {
+        slot->ptr = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Waits for every capture to be written, then frees the staging resources.
+// The frames in the ring are handed to keepRing if it's given, and written
+// out otherwise.
+static void destroyDeviceCapture(DeviceCapture *capture,
+                                 deque<CapturedFrame> *keepRing) {
+    {
+        lock_guard<mutex> lock(capture->lock);
+        capture->stop = true;
+    }
+    capture->cond.notify_all();
+    capture->writer.join();
+
+    if (keepRing)
+        keepRing->swap(capture->ring);
+    else
+        writeRing(capture->ring);
+
+    for (uint32_t i = 0; i < captureSlotCount; i++)
+        destroyCaptureSlot(capture, &capture->slots[i]);
+    if (capture->commandPool)
+        capture->pTable->DestroyCommandPool(capture->device,
+                                            capture->commandPool, NULL);
+    delete capture;
+}
+
+// Returns the device's staging resources for images of this extent and
+// format, making them if they don't exist or were made for another swapchain.
+static DeviceCapture *getDeviceCapture(VkDevice device,
+                                       DeviceMapStruct *devMap,
+                                       const ImageMapStruct *imageInfo) {
+    DeviceCapture *capture = devMap->capture;
+    if (capture && capture->extent.width == imageInfo->imageExtent.width &&
+        capture->extent.height == imageInfo->imageExtent.height &&
+        capture->format == imageInfo->format)
+        return capture;
+    // Recent frames outlive a change of swapchain.
+    deque<CapturedFrame> ring;
+    if (capture) {
+        destroyDeviceCapture(capture, &ring);
+        devMap->capture = NULL;
+    }
+
+    // Gather incoming image info and check image format for compatibility
+    // with the target format.
     // This function supports both 24-bit and 32-bit swapchain images.
     VkFormat const target32bitFormat = VK_FORMAT_R8G8B8A8_UNORM;
     VkFormat const target24bitFormat = VK_FORMAT_R8G8B8_UNORM;
-    uint32_t const width = imageMap[image1]->imageExtent.width;
-    uint32_t const height = imageMap[image1]->imageExtent.height;
-    VkFormat const format = imageMap[image1]->format;
+    VkFormat const format = imageInfo->format;
     uint32_t const numChannels = vk_format_get_channel_count(format);
     if ((vk_format_get_compatibility_class(target24bitFormat) !=
          vk_format_get_compatibility_class(format)) &&
         (vk_format_get_compatibility_class(target32bitFormat) !=
          vk_format_get_compatibility_class(format))) {
         assert(0);
-        return;
+        return NULL;
     }
     if ((3 != numChannels) && (4 != numChannels)) {
         assert(0);
-        return;
+        return NULL;
     }
 
     // General Approach
@@ -284,8 +801,13 @@ static void writePPM(const char *filename, VkImage image1) {
     // There is therefore no point in looking at the BLIT_SRC properties.
     //
     // There is also the optimization where the incoming and target formats are
-    // the same.  In this case, just do a COPY.
+    // the same.  In this case, just do a COPY.  BGR(A) images are copied too,
+    // and their red and blue swapped on the CPU while the pixels are packed,
+    // which costs nothing extra there and saves the blit.
 
+    VkPhysicalDevice physicalDevice = devMap->physicalDevice;
+    VkLayerInstanceDispatchTable *pInstanceTable =
+        instance_dispatch_table(physDeviceMap[physicalDevice]->instance);
     VkFormatProperties targetFormatProps;
     pInstanceTable->GetPhysicalDeviceFormatProperties(
         physicalDevice,
@@ -293,9 +815,25 @@ static void writePPM(const char *filename, VkImage image1) {
         &targetFormatProps);
     bool need2steps = false;
     bool copyOnly = false;
-    if ((target24bitFormat == format) || (target32bitFormat == format)) {
+    bool swapRB = false;
+    switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_R8G8B8_UNORM:
+    case VK_FORMAT_R8G8B8_SRGB:
         copyOnly = true;
-    } else {
+        break;
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+    case VK_FORMAT_B8G8R8_UNORM:
+    case VK_FORMAT_B8G8R8_SRGB:
+        copyOnly = true;
+        swapRB = true;
+        break;
+    default:
+        break;
+    }
+    if (!copyOnly) {
         bool const bltLinear = targetFormatProps.linearTilingFeatures &
                                        VK_FORMAT_FEATURE_BLIT_DST_BIT
                                    ? true
@@ -318,137 +856,109 @@ static void writePPM(const char *filename, VkImage image1) {
         // Else bltLinear is available and only 1 step is needed.
     }
 
-    // Put resources that need to be cleaned up in a struct with a destructor
-    // so that things get cleaned up when this function is exited.
-    WritePPMCleanupData data = {};
-    data.device = device;
-    data.pTableDevice = pTableDevice;
+    capture = new DeviceCapture();
+    capture->device = device;
+    capture->pTable = devMap->device_dispatch_table;
+    capture->extent = imageInfo->imageExtent;
+    capture->format = format;
+    capture->numChannels = numChannels;
+    capture->copyOnly = copyOnly;
+    capture->need2steps = need2steps;
+    capture->swapRB = swapRB;
+    capture->png = screenshotPNG;
+    capture->stop = false;
+    capture->ringSize = screenshotRingSize;
+    capture->ring.swap(ring);
+    capture->writer = thread(captureWriter, capture);
+
+    // The layer records into its own pool so the command buffers can be
+    // reset and reused, and the application's pools are left alone.
+    const VkCommandPoolCreateInfo poolCreateInfo = {
+        VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, NULL,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        devMap->queueFamilyIndex};
+    VkResult err = capture->pTable->CreateCommandPool(device, &poolCreateInfo,
+                                                      NULL,
+                                                      &capture->commandPool);
+    assert(!err);
+    bool pass = VK_SUCCESS == err;
+    for (uint32_t i = 0; pass && i < captureSlotCount; i++)
+        pass = createCaptureSlot(capture, devMap, &capture->slots[i]);
+    if (!pass) {
+        destroyDeviceCapture(capture, NULL);
+        return NULL;
+    }
 
-    // Set up the image creation info for both the blit and copy images, in case
-    // both are needed.
-    VkImageCreateInfo imgCreateInfo2 = {
-        VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-        NULL,
-        0,
-        VK_IMAGE_TYPE_2D,
-        VK_FORMAT_R8G8B8A8_UNORM,
-        {width, height, 1},
-        1,
-        1,
-        VK_SAMPLE_COUNT_1_BIT,
-        VK_IMAGE_TILING_LINEAR,
-        VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-        VK_SHARING_MODE_EXCLUSIVE,
-        0,
-        NULL,
-        VK_IMAGE_LAYOUT_UNDEFINED,
-    };
-    VkImageCreateInfo imgCreateInfo3 = imgCreateInfo2;
+    devMap->capture = capture;
+    return capture;
+}
 
-    // If we need both images, set up image2 to be read/write and tiled.
-    if (need2steps) {
-        imgCreateInfo2.tiling = VK_IMAGE_TILING_OPTIMAL;
-        imgCreateInfo2.usage =
-            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    }
+// Capture a swapchain image to an image file, or to the ring of recent
+// frames if toRing is set.
+//
+// This function issues commands to copy/convert the swapchain image
+// from whatever compatible format the swapchain image uses
+// to a single format (VK_FORMAT_R8G8B8A8_UNORM) so that the converted
+// result can be easily written to a PPM or PNG file.  The file is written
+// later by the device's writer thread.
+//
+// Error handling: If there is a problem, this function should silently
+// fail without affecting the Present operation going on in the caller.
+// The numerous debug asserts are to catch programming errors and are not
+// expected to assert.
+// (TODO) It would be nice to pass any failure info to DebugReport or something.
+static void captureImage(const string &fileName, VkImage image1,
+                         bool toRing) {
 
-    VkMemoryAllocateInfo memAllocInfo = {
-        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL,
-        0, // allocationSize, queried later
-        0  // memoryTypeIndex, queried later
-    };
-    VkMemoryRequirements memRequirements;
-    VkPhysicalDeviceMemoryProperties memoryProperties;
+    VkResult err;
 
-    // Create image2 and allocate its memory.  It could be the intermediate or
-    // final image.
-    err =
-        pTableDevice->CreateImage(device, &imgCreateInfo2, NULL, &data.image2);
-    assert(!err);
-    if (VK_SUCCESS != err)
-        return;
-    pTableDevice->GetImageMemoryRequirements(device, data.image2,
-                                             &memRequirements);
-    memAllocInfo.allocationSize = memRequirements.size;
-    pInstanceTable->GetPhysicalDeviceMemoryProperties(physicalDevice,
-                                                      &memoryProperties);
-    pass = memory_type_from_properties(
-        &memoryProperties, memRequirements.memoryTypeBits,
-        need2steps ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-                   : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-        &memAllocInfo.memoryTypeIndex);
-    assert(pass);
-    err = pTableDevice->AllocateMemory(device, &memAllocInfo, NULL, &data.mem2);
-    assert(!err);
-    if (VK_SUCCESS != err)
-        return;
-    err = pTableQueue->BindImageMemory(device, data.image2, data.mem2, 0);
-    assert(!err);
-    if (VK_SUCCESS != err)
+    // Bail immediately if we can't find the image.
+    if (imageMap.empty() || imageMap.find(image1) == imageMap.end())
         return;
 
-    // Create image3 and allocate its memory, if needed.
-    if (need2steps) {
-        err = pTableDevice->CreateImage(device, &imgCreateInfo3, NULL,
-                                        &data.image3);
-        assert(!err);
-        if (VK_SUCCESS != err)
-            return;
-        pTableDevice->GetImageMemoryRequirements(device, data.image3,
-                                                 &memRequirements);
-        memAllocInfo.allocationSize = memRequirements.size;
-        pInstanceTable->GetPhysicalDeviceMemoryProperties(physicalDevice,
-                                                          &memoryProperties);
-        pass = memory_type_from_properties(
-            &memoryProperties, memRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, &memAllocInfo.memoryTypeIndex);
-        assert(pass);
-        err = pTableDevice->AllocateMemory(device, &memAllocInfo, NULL,
-                                           &data.mem3);
-        assert(!err);
-        if (VK_SUCCESS != err)
-            return;
-        err = pTableQueue->BindImageMemory(device, data.image3, data.mem3, 0);
-        assert(!err);
-        if (VK_SUCCESS != err)
-            return;
+    // Collect object info from maps.  This info is generally recorded
+    // by the other functions hooked in this layer.
+    ImageMapStruct *imageInfo = imageMap[image1];
+    VkDevice device = imageInfo->device;
+    VkQueue queue = deviceMap[device]->queue;
+    DeviceMapStruct *devMap = get_dev_info(device);
+    if (NULL == devMap) {
+        assert(0);
+        return;
     }
 
-    // Set up the command buffer.  We get a command buffer from a pool we saved
-    // in a hooked function, which would be the application's pool.
-    const VkCommandBufferAllocateInfo allocCommandBufferInfo = {
-        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, NULL,
-        deviceMap[device]->commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
-    data.commandPool = deviceMap[device]->commandPool;
-    err = pTableDevice->AllocateCommandBuffers(device, &allocCommandBufferInfo,
-                                               &data.commandBuffer);
-    assert(!err);
-    if (VK_SUCCESS != err)
+    DeviceCapture *capture = getDeviceCapture(device, devMap, imageInfo);
+    if (NULL == capture)
         return;
-
-    VkDevice cmdBuf =
-        static_cast<VkDevice>(static_cast<void *>(data.commandBuffer));
-    deviceMap.emplace(cmdBuf, devMap);
-    VkLayerDispatchTable *pTableCommandBuffer;
-    pTableCommandBuffer = get_dev_info(cmdBuf)->device_dispatch_table;
-
-    // We have just created a dispatchable object, but the dispatch table has
-    // not been placed in the object yet.  When a "normal" application creates
-    // a command buffer, the dispatch table is installed by the top-level api
-    // binding (trampoline.c). But here, we have to do it ourselves.
-    if (!devMap->pfn_dev_init) {
-        *((const void **)data.commandBuffer) = *(void **)device;
-    } else {
-        err = devMap->pfn_dev_init(device, (void *)data.commandBuffer);
-        assert(!err);
+    VkLayerDispatchTable *pTable = capture->pTable;
+    uint32_t const width = capture->extent.width;
+    uint32_t const height = capture->extent.height;
+
+    // Take the first slot that isn't waiting to be written, waiting for one
+    // if they all are.
+    CaptureSlot *slot = NULL;
+    {
+        unique_lock<mutex> lock(capture->lock);
+        while (true) {
+            for (uint32_t i = 0; i < captureSlotCount && !slot; i++) {
+                if (!capture->slots[i].busy)
+                    slot = &capture->slots[i];
+            }
+            if (slot)
+                break;
+            capture->cond.wait(lock);
+        }
     }
 
+    err = pTable->ResetFences(device, 1, &slot->fence);
+    assert(!err);
+
     const VkCommandBufferBeginInfo commandBufferBeginInfo = {
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, NULL,
         VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
     };
-    err = pTableCommandBuffer->BeginCommandBuffer(data.commandBuffer,
-                                                  &commandBufferBeginInfo);
+    err = pTable->BeginCommandBuffer(slot->commandBuffer,
+                                     &commandBufferBeginInfo);
     assert(!err);
 
     // This barrier is used to transition from/to present Layout
@@ -464,8 +974,9 @@ static void writePPM(const char *filename, VkImage image1) {
         image1,
         {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
 
-    // This barrier is used to transition from a newly-created layout to a blt
-    // or copy destination layout.
+    // This barrier is used to transition from a discarded layout to a blt
+    // or copy destination layout.  The staging images are reused, so
+    // whatever the last capture left in them is thrown away.
     VkImageMemoryBarrier destMemoryBarrier = {
         VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         NULL,
@@ -475,20 +986,21 @@ static void writePPM(const char *filename, VkImage image1) {
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
         VK_QUEUE_FAMILY_IGNORED,
         VK_QUEUE_FAMILY_IGNORED,
-        data.image2,
+        slot->image2,
         {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
 
-    // This barrier is used to transition a dest layout to general layout.
+    // This barrier is used to transition a dest layout to general layout,
+    // and makes the copy visible to the host once the fence signals.
     VkImageMemoryBarrier generalMemoryBarrier = {
         VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         NULL,
         VK_ACCESS_TRANSFER_WRITE_BIT,
-        VK_ACCESS_TRANSFER_READ_BIT,
+        VK_ACCESS_HOST_READ_BIT,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
         VK_IMAGE_LAYOUT_GENERAL,
         VK_QUEUE_FAMILY_IGNORED,
         VK_QUEUE_FAMILY_IGNORED,
-        data.image2,
+        slot->image2,
         {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
 
     VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -496,15 +1008,13 @@ static void writePPM(const char *filename, VkImage image1) {
 
     // The source image needs to be transitioned from present to transfer
     // source.
-    pTableCommandBuffer->CmdPipelineBarrier(data.commandBuffer, srcStages,
-                                            dstStages, 0, 0, NULL, 0, NULL, 1,
-                                            &presentMemoryBarrier);
+    pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages, dstStages, 0, 0,
+                               NULL, 0, NULL, 1, &presentMemoryBarrier);
 
     // image2 needs to be transitioned from its undefined state to transfer
     // destination.
-    pTableCommandBuffer->CmdPipelineBarrier(data.commandBuffer, srcStages,
-                                            dstStages, 0, 0, NULL, 0, NULL, 1,
-                                            &destMemoryBarrier);
+    pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages, dstStages, 0, 0,
+                               NULL, 0, NULL, 1, &destMemoryBarrier);
 
     const VkImageCopy imageCopyRegion = {{VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
                                          {0, 0, 0},
@@ -512,11 +1022,12 @@ static void writePPM(const char *filename, VkImage image1) {
                                          {0, 0, 0},
                                          {width, height, 1}};
 
-    if (copyOnly) {
-        pTableCommandBuffer->CmdCopyImage(
-            data.commandBuffer, image1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            data.image2, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-            &imageCopyRegion);
+    if (capture->copyOnly) {
+        pTable->CmdCopyImage(slot->commandBuffer, image1,
+                             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                             slot->image2,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                             &imageCopyRegion);
     } else {
         VkImageBlit imageBlitRegion = {};
         imageBlitRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -534,43 +1045,45 @@ static void writePPM(const char *filename, VkImage image1) {
         imageBlitRegion.dstOffsets[1].y = height;
         imageBlitRegion.dstOffsets[1].z = 1;
 
-        pTableCommandBuffer->CmdBlitImage(
-            data.commandBuffer, image1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-            data.image2, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-            &imageBlitRegion, VK_FILTER_NEAREST);
-        if (need2steps) {
+        pTable->CmdBlitImage(slot->commandBuffer, image1,
+                             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                             slot->image2,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                             &imageBlitRegion, VK_FILTER_NEAREST);
+        if (capture->need2steps) {
             // image 3 needs to be transitioned from its undefined state to a
             // transfer destination.
-            destMemoryBarrier.image = data.image3;
-            pTableCommandBuffer->CmdPipelineBarrier(
-                data.commandBuffer, srcStages, dstStages, 0, 0, NULL, 0, NULL,
-                1, &destMemoryBarrier);
+            destMemoryBarrier.image = slot->image3;
+            pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages,
+                                       dstStages, 0, 0, NULL, 0, NULL, 1,
+                                       &destMemoryBarrier);
 
-            // Transition image2 so that it can be read for the upcoming copy to
-            // image 3.
+            // Transition image2 so that it can be read for the upcoming copy
+            // to image 3.
             destMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
             destMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
             destMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
             destMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-            destMemoryBarrier.image = data.image2;
-            pTableCommandBuffer->CmdPipelineBarrier(
-                data.commandBuffer, srcStages, dstStages, 0, 0, NULL, 0, NULL,
-                1, &destMemoryBarrier);
+            destMemoryBarrier.image = slot->image2;
+            pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages,
+                                       dstStages, 0, 0, NULL, 0, NULL, 1,
+                                       &destMemoryBarrier);
 
             // This step essentially untiles the image.
-            pTableCommandBuffer->CmdCopyImage(
-                data.commandBuffer, data.image2,
-                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, data.image3,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopyRegion);
-            generalMemoryBarrier.image = data.image3;
+            pTable->CmdCopyImage(slot->commandBuffer, slot->image2,
+                                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                 slot->image3,
+                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
+                                 &imageCopyRegion);
+            generalMemoryBarrier.image = slot->image3;
         }
     }
 
     // The destination needs to be transitioned from the optimal copy format to
     // the format we can read with the CPU.
-    pTableCommandBuffer->CmdPipelineBarrier(data.commandBuffer, srcStages,
-                                            dstStages, 0, 0, NULL, 0, NULL, 1,
-                                            &generalMemoryBarrier);
+    pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages,
+                               VK_PIPELINE_STAGE_HOST_BIT, 0, 0, NULL, 0, NULL,
+                               1, &generalMemoryBarrier);
 
     // Restore the swap chain image layout to what it was before.
     // This may not be strictly needed, but it is generally good to restore
@@ -579,14 +1092,12 @@ static void writePPM(const char *filename, VkImage image1) {
     presentMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
     presentMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
     presentMemoryBarrier.dstAccessMask = 0;
-    pTableCommandBuffer->CmdPipelineBarrier(data.commandBuffer, srcStages,
-                                            dstStages, 0, 0, NULL, 0, NULL, 1,
-                                            &presentMemoryBarrier);
+    pTable->CmdPipelineBarrier(slot->commandBuffer, srcStages, dstStages, 0, 0,
+                               NULL, 0, NULL, 1, &presentMemoryBarrier);
 
-    err = pTableCommandBuffer->EndCommandBuffer(data.commandBuffer);
+    err = pTable->EndCommandBuffer(slot->commandBuffer);
     assert(!err);
 
-    VkFence nullFence = {VK_NULL_HANDLE};
     VkSubmitInfo submitInfo;
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.pNext = NULL;
@@ -594,69 +1105,24 @@ static void writePPM(const char *filename, VkImage image1) {
     submitInfo.pWaitSemaphores = NULL;
     submitInfo.pWaitDstStageMask = NULL;
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &data.commandBuffer;
+    submitInfo.pCommandBuffers = &slot->commandBuffer;
     submitInfo.signalSemaphoreCount = 0;
     submitInfo.pSignalSemaphores = NULL;
 
-    err = pTableQueue->QueueSubmit(queue, 1, &submitInfo, nullFence);
+    err = pTable->QueueSubmit(queue, 1, &submitInfo, slot->fence);
     assert(!err);
+    if (VK_SUCCESS != err)
+        return;
 
-    err = pTableQueue->QueueWaitIdle(queue);
-    assert(!err);
-
-    err = pTableDevice->DeviceWaitIdle(device);
-    assert(!err);
-
-    // Map the final image so that the CPU can read it.
-    const VkImageSubresource sr = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0};
-    VkSubresourceLayout srLayout;
-    const char *ptr;
-    if (!need2steps) {
-        pTableDevice->GetImageSubresourceLayout(device, data.image2, &sr,
-                                                &srLayout);
-        err = pTableDevice->MapMemory(device, data.mem2, 0, VK_WHOLE_SIZE, 0,
-                                      (void **)&ptr);
-        assert(!err);
-        if (VK_SUCCESS != err)
-            return;
-        data.mem2mapped = true;
-    } else {
-        pTableDevice->GetImageSubresourceLayout(device, data.image3, &sr,
-                                                &srLayout);
-        err = pTableDevice->MapMemory(device, data.mem3, 0, VK_WHOLE_SIZE, 0,
-                                      (void **)&ptr);
-        assert(!err);
-        if (VK_SUCCESS != err)
-            return;
-        data.mem3mapped = true;
-    }
-
-    // Write the data to a PPM file.
-    ofstream file(filename, ios::binary);
-    file << "P6\n";
-    file << width << "\n";
-    file << height << "\n";
-    file << 255 << "\n";
-
-    ptr += srLayout.offset;
-    if (3 == numChannels) {
-        for (uint32_t y = 0; y < height; y++) {
-            file.write(ptr, 3 * width);
-            ptr += srLayout.rowPitch;
-        }
-    } else if (4 == numChannels) {
-        for (uint32_t y = 0; y < height; y++) {
-            const unsigned int *row = (const unsigned int *)ptr;
-            for (uint32_t x = 0; x < width; x++) {
-                file.write((char *)row, 3);
-                row++;
-            }
-            ptr += srLayout.rowPitch;
-        }
+    // Hand the slot to the writer thread.
+    {
+        lock_guard<mutex> lock(capture->lock);
+        slot->fileName = fileName;
+        slot->toRing = toRing;
+        slot->busy = true;
+        capture->pending.push_back(slot);
     }
-    file.close();
-
-    // Clean up handled by ~WritePPMCleanupData()
+    capture->cond.notify_all();
 }
 
 VKAPI_ATTR VkResult VKAPI_CALL
@@ -753,6 +1219,10 @@ CreateDevice(VkPhysicalDevice gpu, const VkDeviceCreateInfo *pCreateInfo,
     createDeviceRegisterExtensions(pCreateInfo, *pDevice);
     // Create a mapping from a device to a physicalDevice
     deviceMapElem->physicalDevice = gpu;
+    deviceMapElem->queue = VK_NULL_HANDLE;
+    deviceMapElem->queueFamilyIndex = 0;
+    deviceMapElem->commandPool = VK_NULL_HANDLE;
+    deviceMapElem->capture = NULL;
 
     // store the loader callback for initializing created dispatchable objects
     chain_info = get_chain_info(pCreateInfo, VK_LOADER_DATA_CALLBACK);
@@ -791,6 +1261,15 @@ DestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator) {
     DeviceMapStruct *devMap = get_dev_info(device);
     assert(devMap);
     VkLayerDispatchTable *pDisp = devMap->device_dispatch_table;
+
+    // Finish writing any captures before their resources go away.
+    loader_platform_thread_lock_mutex(&globalLock);
+    if (devMap->capture) {
+        destroyDeviceCapture(devMap->capture, NULL);
+        devMap->capture = NULL;
+    }
+    loader_platform_thread_unlock_mutex(&globalLock);
+
     pDisp->DestroyDevice(device, pAllocator);
 
     loader_platform_thread_lock_mutex(&globalLock);
@@ -812,7 +1291,7 @@ VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(VkDevice device,
 
     // Save the device queue in a map if we are taking screenshots.
     loader_platform_thread_lock_mutex(&globalLock);
-    if (screenshotEnvQueried && screenshotFrames.empty()) {
+    if (screenshotsDone()) {
         // No screenshots in the list to take
         loader_platform_thread_unlock_mutex(&globalLock);
         return;
@@ -823,6 +1302,7 @@ VKAPI_ATTR void VKAPI_CALL GetDeviceQueue(VkDevice device,
 
     // Create a mapping from a device to a queue
     devMap->queue = *pQueue;
+    devMap->queueFamilyIndex = queueNodeIndex;
     loader_platform_thread_unlock_mutex(&globalLock);
 }
 
@@ -837,7 +1317,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateCommandPool(
 
     // Save the command pool on a map if we are taking screenshots.
     loader_platform_thread_lock_mutex(&globalLock);
-    if (screenshotEnvQueried && screenshotFrames.empty()) {
+    if (screenshotsDone()) {
         // No screenshots in the list to take
         loader_platform_thread_unlock_mutex(&globalLock);
         return result;
@@ -866,7 +1346,7 @@ VKAPI_ATTR VkResult VKAPI_CALL CreateSwapchainKHR(
 
     // Save the swapchain in a map of we are taking screenshots.
     loader_platform_thread_lock_mutex(&globalLock);
-    if (screenshotEnvQueried && screenshotFrames.empty()) {
+    if (screenshotsDone()) {
         // No screenshots in the list to take
         loader_platform_thread_unlock_mutex(&globalLock);
         return result;
@@ -901,7 +1381,7 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain,
 
     // Save the swapchain images in a map if we are taking screenshots
     loader_platform_thread_lock_mutex(&globalLock);
-    if (screenshotEnvQueried && screenshotFrames.empty()) {
+    if (screenshotsDone()) {
         // No screenshots in the list to take
         loader_platform_thread_unlock_mutex(&globalLock);
         return result;
@@ -940,6 +1420,55 @@ GetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR swapchain,
     return result;
 }
 
+// Parse the frames to take screenshots of: a comma separated list of single
+// frames ("10"), ranges ("100-400"), and ranges with a step ("0-1000/10" takes
+// every 10th frame).  A range with no end ("100-") runs until the application
+// exits.  Words that don't start with a digit are ignored.
+static void parseScreenshotFrames(const char *spec) {
+    while (*spec) {
+        const char *end = strchr(spec, ',');
+        if (end == NULL)
+            end = spec + strlen(spec);
+        if (*spec >= '0' && *spec <= '9') {
+            char *next;
+            FrameRange range;
+            range.first = (int)strtol(spec, &next, 10);
+            range.last = range.first;
+            range.step = 1;
+            if (*next == '-') {
+                next++;
+                range.last = (*next >= '0' && *next <= '9')
+                                 ? (int)strtol(next, &next, 10)
+                                 : INT_MAX;
+            }
+            if (*next == '/') {
+                range.step = (int)strtol(next + 1, &next, 10);
+                if (range.step < 1)
+                    range.step = 1;
+            }
+            if (range.last >= range.first)
+                screenshotFrames.push_back(range);
+        }
+        spec = *end ? end + 1 : end;
+    }
+}
+
+// Check whether a frame is to be captured, dropping the ranges that have
+// already gone by.
+static bool isScreenshotFrame(int frame) {
+    bool take = false;
+    for (auto it = screenshotFrames.begin(); it != screenshotFrames.end();) {
+        if (frame >= it->first && frame <= it->last &&
+            0 == (frame - it->first) % it->step)
+            take = true;
+        if (frame >= it->last)
+            it = screenshotFrames.erase(it);
+        else
+            it++;
+    }
+    return take;
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL
 QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
     static int frameNumber = 0;
@@ -954,69 +1483,77 @@ QueuePresentKHR(VkQueue queue, const VkPresentInfoKHR *pPresentInfo) {
 
     if (!screenshotEnvQueried) {
         const char *_vk_screenshot = local_getenv("_VK_SCREENSHOT");
-        if (_vk_screenshot && *_vk_screenshot) {
-            string spec(_vk_screenshot), word;
-            size_t start = 0, comma = 0;
-
-            while (start < spec.size()) {
-                int frameToAdd;
-                comma = spec.find(',', start);
-                if (comma == string::npos)
-                    word = string(spec, start);
-                else
-                    word = string(spec, start, comma - start);
-                frameToAdd = atoi(word.c_str());
-                // Add the frame number to set, but only do it if the word
-                // started with a digit and if
-                // it's not already in the list
-                if (*(word.c_str()) >= '0' && *(word.c_str()) <= '9') {
-                    screenshotFrames.insert(frameToAdd);
-                }
-                if (comma == string::npos)
-                    break;
-                start = comma + 1;
-            }
-        }
+        if (_vk_screenshot && *_vk_screenshot)
+            parseScreenshotFrames(_vk_screenshot);
         local_free_getenv(_vk_screenshot);
+
+        const char *_vk_screenshot_last = local_getenv("_VK_SCREENSHOT_LAST");
+        if (_vk_screenshot_last && *_vk_screenshot_last)
+            screenshotRingSize = (uint32_t)atoi(_vk_screenshot_last);
+        local_free_getenv(_vk_screenshot_last);
+
+        const char *_vk_screenshot_trigger =
+            local_getenv("_VK_SCREENSHOT_TRIGGER");
+        if (_vk_screenshot_trigger && *_vk_screenshot_trigger)
+            screenshotTrigger = _vk_screenshot_trigger;
+        local_free_getenv(_vk_screenshot_trigger);
+
+#if defined(SCREENSHOT_PNG)
+        const char *_vk_screenshot_format =
+            local_getenv("_VK_SCREENSHOT_FORMAT");
+        screenshotPNG = _vk_screenshot_format &&
+                        0 == strcmp(_vk_screenshot_format, "png");
+        local_free_getenv(_vk_screenshot_format);
+#endif
         screenshotEnvQueried = true;
     }
 
-    if (result == VK_SUCCESS && !screenshotFrames.empty()) {
-        set<int>::iterator it;
-        it = screenshotFrames.find(frameNumber);
-        if (it != screenshotFrames.end()) {
-            string fileName;
-            fileName = to_string(frameNumber) + ".ppm";
-
-            VkImage image;
-            VkSwapchainKHR swapchain;
-            // We'll dump only one image: the first
-            swapchain = pPresentInfo->pSwapchains[0];
-            image = swapchainMap[swapchain]
-                        ->imageList[pPresentInfo->pImageIndices[0]];
-            writePPM(fileName.c_str(), image);
-            screenshotFrames.erase(it);
-
-            if (screenshotFrames.empty()) {
-                // Free all our maps since we are done with them.
-                for (auto it = swapchainMap.begin(); it != swapchainMap.end();
-                     it++) {
-                    SwapchainMapStruct *swapchainMapElem = it->second;
-                    delete swapchainMapElem;
-                }
-                for (auto it = imageMap.begin(); it != imageMap.end(); it++) {
-                    ImageMapStruct *imageMapElem = it->second;
-                    delete imageMapElem;
-                }
-                for (auto it = physDeviceMap.begin(); it != physDeviceMap.end();
-                     it++) {
-                    PhysDeviceMapStruct *physDeviceMapElem = it->second;
-                    delete physDeviceMapElem;
-                }
-                swapchainMap.clear();
-                imageMap.clear();
-                physDeviceMap.clear();
+    bool takeFrame = !screenshotFrames.empty() && isScreenshotFrame(frameNumber);
+    if (result == VK_SUCCESS && (takeFrame || screenshotRingSize > 0)) {
+        string fileName;
+        fileName =
+            to_string(frameNumber) + (screenshotPNG ? ".png" : ".ppm");
+
+        VkImage image;
+        VkSwapchainKHR swapchain;
+        // We'll dump only one image: the first
+        swapchain = pPresentInfo->pSwapchains[0];
+        image =
+            swapchainMap[swapchain]->imageList[pPresentInfo->pImageIndices[0]];
+        captureImage(fileName, image, !takeFrame);
+
+        // Write out the ring once this frame is in it.  The trigger file is
+        // removed so that it can be made again to write out a later set of
+        // frames.
+        DeviceCapture *capture = devMap->capture;
+        if (screenshotRingSize > 0 && capture && !screenshotTrigger.empty() &&
+            0 == remove(screenshotTrigger.c_str())) {
+            {
+                lock_guard<mutex> lock(capture->lock);
+                capture->pending.push_back(NULL);
+            }
+            capture->cond.notify_all();
+        }
+
+        if (screenshotsDone()) {
+            // Free all our maps since we are done with them.
+            for (auto it = swapchainMap.begin(); it != swapchainMap.end();
+                 it++) {
+                SwapchainMapStruct *swapchainMapElem = it->second;
+                delete swapchainMapElem;
+            }
+            for (auto it = imageMap.begin(); it != imageMap.end(); it++) {
+                ImageMapStruct *imageMapElem = it->second;
+                delete imageMapElem;
+            }
+            for (auto it = physDeviceMap.begin(); it != physDeviceMap.end();
+                 it++) {
+                PhysDeviceMapStruct *physDeviceMapElem = it->second;
+                delete physDeviceMapElem;
             }
+            swapchainMap.clear();
+            imageMap.clear();
+            physDeviceMap.clear();
         }
     }
     frameNumber++;
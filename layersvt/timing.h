@@ -0,0 +1,286 @@
+/* Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "vulkan/vk_layer.h"
+
+/*
+ * This file contains the static functions for the generated layer timing.
+ *
+ * Each entrypoint the layer passes down is timed from the call into the next layer until it
+ * returns, so a timing layer reports what the layers below it and the driver cost.  The same
+ * generated source is built into several libraries, each under its own name (TIMING_LAYER_NAME),
+ * so that copies can be enabled at several points in the chain: the difference between two
+ * copies is what the layers between them cost.
+ *
+ * Every thread adds its calls to counters of its own.  A summary of the calls made since the
+ * last one is written every few frames, at vkQueuePresentKHR, and the totals when the instance
+ * is destroyed.
+ */
+
+#ifndef TIMING_LAYER_NAME
+#define TIMING_LAYER_NAME "timing"
+#endif
+#define TIMING_LAYER_SETTINGS "lunarg_" TIMING_LAYER_NAME
+
+// The following is for logging error messages:
+struct layer_data {
+    debug_report_data *report_data;
+    std::vector<VkDebugReportCallbackEXT> logging_callback;
+
+    layer_data() : report_data(nullptr), logging_callback(VK_NULL_HANDLE){};
+};
+
+static const VkLayerProperties globalLayerProps[] = {{
+    "VK_LAYER_LUNARG_" TIMING_LAYER_NAME,
+    VK_MAKE_VERSION(1, 0, VK_HEADER_VERSION), // specVersion
+    1, "layer: " TIMING_LAYER_NAME,
+}};
+
+static const VkLayerProperties deviceLayerProps[] = {{
+    "VK_LAYER_LUNARG_" TIMING_LAYER_NAME,
+    VK_MAKE_VERSION(1, 0, VK_HEADER_VERSION), // specVersion
+    1, "layer: " TIMING_LAYER_NAME,
+}};
+
+struct devExts {
+    bool wsi_enabled;
+};
+struct instExts {
+    bool wsi_enabled;
+};
+static std::unordered_map<void *, struct devExts> deviceExtMap;
+static std::unordered_map<void *, struct instExts> instanceExtMap;
+
+static void createDeviceRegisterExtensions(const VkDeviceCreateInfo *pCreateInfo, VkDevice device) {
+    uint32_t i;
+    VkLayerDispatchTable *pDisp = device_dispatch_table(device);
+    PFN_vkGetDeviceProcAddr gpa = pDisp->GetDeviceProcAddr;
+    pDisp->CreateSwapchainKHR = (PFN_vkCreateSwapchainKHR)gpa(device, "vkCreateSwapchainKHR");
+    pDisp->DestroySwapchainKHR = (PFN_vkDestroySwapchainKHR)gpa(device, "vkDestroySwapchainKHR");
+    pDisp->GetSwapchainImagesKHR = (PFN_vkGetSwapchainImagesKHR)gpa(device, "vkGetSwapchainImagesKHR");
+    pDisp->AcquireNextImageKHR = (PFN_vkAcquireNextImageKHR)gpa(device, "vkAcquireNextImageKHR");
+    pDisp->QueuePresentKHR = (PFN_vkQueuePresentKHR)gpa(device, "vkQueuePresentKHR");
+
+    deviceExtMap[pDisp].wsi_enabled = false;
+    for (i = 0; i < pCreateInfo->enabledExtensionCount; i++) {
+        if (strcmp(pCreateInfo->ppEnabledExtensionNames[i], VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0)
+            deviceExtMap[pDisp].wsi_enabled = true;
+    }
+}
+
+static void createInstanceRegisterExtensions(const VkInstanceCreateInfo *pCreateInfo, VkInstance instance) {
+    uint32_t i;
+    VkLayerInstanceDispatchTable *pDisp = instance_dispatch_table(instance);
+    PFN_vkGetInstanceProcAddr gpa = pDisp->GetInstanceProcAddr;
+
+    pDisp->DestroySurfaceKHR = (PFN_vkDestroySurfaceKHR)gpa(instance, "vkDestroySurfaceKHR");
+    pDisp->GetPhysicalDeviceSurfaceSupportKHR =
+        (PFN_vkGetPhysicalDeviceSurfaceSupportKHR)gpa(instance, "vkGetPhysicalDeviceSurfaceSupportKHR");
+    pDisp->GetPhysicalDeviceSurfaceCapabilitiesKHR =
+        (PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR)gpa(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR");
+    pDisp->GetPhysicalDeviceSurfaceFormatsKHR =
+        (PFN_vkGetPhysicalDeviceSurfaceFormatsKHR)gpa(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR");
+    pDisp->GetPhysicalDeviceSurfacePresentModesKHR =
+        (PFN_vkGetPhysicalDeviceSurfacePresentModesKHR)gpa(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR");
+    instanceExtMap[pDisp].wsi_enabled = false;
+    for (i = 0; i < pCreateInfo->enabledExtensionCount; i++) {
+        if (strcmp(pCreateInfo->ppEnabledExtensionNames[i], VK_KHR_SURFACE_EXTENSION_NAME) == 0)
+            instanceExtMap[pDisp].wsi_enabled = true;
+    }
+}
+
+// Monotonic clock ticks; nanoseconds everywhere but Windows
+static inline uint64_t timing_ticks() {
+#if defined(_WIN32)
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return (uint64_t)count.QuadPart;
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((uint64_t)time.tv_sec * 1000000000) + time.tv_nsec;
+#endif
+}
+
+static inline double timing_ticks_per_ms() {
+#if defined(_WIN32)
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    return (double)freq.QuadPart / 1000.0;
+#else
+    return 1000000.0;
+#endif
+}
+
+// Calls made on one thread.  Only that thread writes the counters, so adding to them takes no
+// atomic read-modify-write; the summaries read them while the thread carries on.
+struct TimingThread {
+    TimingThread() {
+        for (uint32_t i = 0; i < TIMING_CALL_COUNT; ++i) {
+            calls[i].store(0, std::memory_order_relaxed);
+            ticks[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void add(uint32_t call, uint64_t elapsed) {
+        calls[call].store(calls[call].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        ticks[call].store(ticks[call].load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> calls[TIMING_CALL_COUNT];
+    std::atomic<uint64_t> ticks[TIMING_CALL_COUNT];
+};
+
+// The calling thread's counters.  Declared static here rather than inside a member function, where
+// every copy of the layer in the process would share one.
+static THREAD_LOCAL_DECL TimingThread *timing_thread = NULL;
+
+class TimingProfiler {
+  public:
+    TimingProfiler() : out_(stdout), frameInterval_(1), frame_(0), lastFrame_(0), calls_(TIMING_CALL_COUNT), ticks_(TIMING_CALL_COUNT) {}
+
+    ~TimingProfiler() {
+        for (size_t i = 0; i < threads_.size(); ++i)
+            delete threads_[i];
+    }
+
+    // Reads the layer's settings: where to write, and how many frames each summary covers
+    void configure() {
+        std::lock_guard<std::mutex> lock(lock_);
+        const char *filename = getLayerOption(TIMING_LAYER_SETTINGS ".log_filename");
+        if (out_ == stdout && filename && *filename)
+            out_ = getLayerLogOutput(filename, "VK_LAYER_LUNARG_" TIMING_LAYER_NAME);
+        const char *interval = getLayerOption(TIMING_LAYER_SETTINGS ".frame_interval");
+        if (interval && *interval)
+            frameInterval_ = (uint64_t)strtoull(interval, NULL, 10);
+    }
+
+    TimingThread &thread() {
+        if (timing_thread == NULL) {
+            std::lock_guard<std::mutex> lock(lock_);
+            timing_thread = new TimingThread;
+            threads_.push_back(timing_thread);
+        }
+        return *timing_thread;
+    }
+
+    // Counts a presented frame, and writes the calls made since the last summary every
+    // frame_interval frames
+    void end_frame() {
+        std::lock_guard<std::mutex> lock(lock_);
+        ++frame_;
+        if (frameInterval_ == 0 || frame_ - lastFrame_ < frameInterval_)
+            return;
+        std::vector<uint64_t> calls(TIMING_CALL_COUNT), ticks(TIMING_CALL_COUNT);
+        collect(calls, ticks);
+        for (uint32_t i = 0; i < TIMING_CALL_COUNT; ++i) {
+            uint64_t total_calls = calls[i], total_ticks = ticks[i];
+            calls[i] -= calls_[i];
+            ticks[i] -= ticks_[i];
+            calls_[i] = total_calls;
+            ticks_[i] = total_ticks;
+        }
+        char title[64];
+        if (frame_ - lastFrame_ == 1)
+            snprintf(title, sizeof(title), "frame %llu", (unsigned long long)lastFrame_);
+        else
+            snprintf(title, sizeof(title), "frames %llu-%llu", (unsigned long long)lastFrame_, (unsigned long long)frame_ - 1);
+        write(title, calls, ticks);
+        lastFrame_ = frame_;
+    }
+
+    // Writes every call made since the layer was loaded
+    void report_totals() {
+        std::lock_guard<std::mutex> lock(lock_);
+        std::vector<uint64_t> calls(TIMING_CALL_COUNT), ticks(TIMING_CALL_COUNT);
+        collect(calls, ticks);
+        char title[64];
+        snprintf(title, sizeof(title), "total over %llu frames", (unsigned long long)frame_);
+        write(title, calls, ticks);
+    }
+
+  private:
+    TimingProfiler(const TimingProfiler &);
+    TimingProfiler &operator=(const TimingProfiler &);
+
+    void collect(std::vector<uint64_t> &calls, std::vector<uint64_t> &ticks) const {
+        for (size_t t = 0; t < threads_.size(); ++t) {
+            for (uint32_t i = 0; i < TIMING_CALL_COUNT; ++i) {
+                calls[i] += threads_[t]->calls[i].load(std::memory_order_relaxed);
+                ticks[i] += threads_[t]->ticks[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // One line per entrypoint called, the most expensive first
+    void write(const char *title, const std::vector<uint64_t> &calls, const std::vector<uint64_t> &ticks) {
+        std::vector<uint32_t> order;
+        uint64_t total_calls = 0, total_ticks = 0;
+        for (uint32_t i = 0; i < TIMING_CALL_COUNT; ++i) {
+            if (calls[i] == 0)
+                continue;
+            order.push_back(i);
+            total_calls += calls[i];
+            total_ticks += ticks[i];
+        }
+        std::sort(order.begin(), order.end(), [&ticks](uint32_t a, uint32_t b) { return ticks[a] > ticks[b]; });
+
+        double per_ms = timing_ticks_per_ms();
+        fprintf(out_, "VK_LAYER_LUNARG_" TIMING_LAYER_NAME " %s: %.3f ms in %llu calls\n", title, total_ticks / per_ms,
+                (unsigned long long)total_calls);
+        for (size_t i = 0; i < order.size(); ++i) {
+            uint32_t call = order[i];
+            fprintf(out_, "    %-48s %10llu calls %12.3f ms %12.1f ns/call\n", timing_call_names[call], (unsigned long long)calls[call],
+                    ticks[call] / per_ms, ticks[call] / per_ms * 1000000.0 / calls[call]);
+        }
+        fflush(out_);
+    }
+
+    FILE *out_;
+    uint64_t frameInterval_;       // 0 when only the totals are written
+    uint64_t frame_;               // Frames presented so far
+    uint64_t lastFrame_;           // First frame the next summary covers
+    std::vector<uint64_t> calls_;  // Totals at the last summary
+    std::vector<uint64_t> ticks_;
+    std::mutex lock_;
+    std::vector<TimingThread *> threads_;
+};
+
+static TimingProfiler timing_profiler;
+
+// Adds the time until it goes out of scope to the calling thread's counters for call
+class TimingScope {
+  public:
+    explicit TimingScope(uint32_t call) : call_(call), start_(timing_ticks()) {}
+    ~TimingScope() { timing_profiler.thread().add(call_, timing_ticks() - start_); }
+
+  private:
+    uint32_t call_;
+    uint64_t start_;
+};
+
+#endif // TIMING_H
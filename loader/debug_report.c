@@ -307,7 +307,7 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDebugReportCallback(
     const VkAllocationCallbacks *pAllocator,
     VkDebugReportCallbackEXT *pCallback) {
     VkDebugReportCallbackEXT *icd_info;
-    const struct loader_icd *icd;
+    struct loader_icd *icd;
     struct loader_instance *inst = (struct loader_instance *)instance;
     VkResult res = VK_SUCCESS;
     uint32_t storage_idx;
@@ -333,11 +333,11 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDebugReportCallback(
 
     storage_idx = 0;
     for (icd = inst->icds; icd; icd = icd->next) {
-        if (!icd->CreateDebugReportCallbackEXT) {
+        if (!LOADER_ICD_PROC(icd, CreateDebugReportCallbackEXT)) {
             continue;
         }
 
-        res = icd->CreateDebugReportCallbackEXT(
+        res = LOADER_ICD_PROC(icd, CreateDebugReportCallbackEXT)(
             icd->instance, pCreateInfo, pAllocator, &icd_info[storage_idx]);
 
         if (res != VK_SUCCESS) {
@@ -350,12 +350,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDebugReportCallback(
     if (icd) {
         storage_idx = 0;
         for (icd = inst->icds; icd; icd = icd->next) {
-            if (NULL == icd->DestroyDebugReportCallbackEXT) {
+            if (NULL == LOADER_ICD_PROC(icd, DestroyDebugReportCallbackEXT)) {
                 continue;
             }
 
             if (icd_info[storage_idx]) {
-                icd->DestroyDebugReportCallbackEXT(
+                LOADER_ICD_PROC(icd, DestroyDebugReportCallbackEXT)(
                     icd->instance, icd_info[storage_idx], pAllocator);
             }
             storage_idx++;
@@ -378,18 +378,18 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroyDebugReportCallback(
     const VkAllocationCallbacks *pAllocator) {
     uint32_t storage_idx;
     VkDebugReportCallbackEXT *icd_info;
-    const struct loader_icd *icd;
+    struct loader_icd *icd;
 
     struct loader_instance *inst = (struct loader_instance *)instance;
     icd_info = *(VkDebugReportCallbackEXT **)&callback;
     storage_idx = 0;
     for (icd = inst->icds; icd; icd = icd->next) {
-        if (NULL == icd->DestroyDebugReportCallbackEXT) {
+        if (NULL == LOADER_ICD_PROC(icd, DestroyDebugReportCallbackEXT)) {
             continue;
         }
 
         if (icd_info[storage_idx]) {
-            icd->DestroyDebugReportCallbackEXT(
+            LOADER_ICD_PROC(icd, DestroyDebugReportCallbackEXT)(
                 icd->instance, icd_info[storage_idx], pAllocator);
         }
         storage_idx++;
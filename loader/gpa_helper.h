@@ -22,279 +22,283 @@
 #include <string.h>
 #include "debug_report.h"
 #include "wsi.h"
+#include "vk_proc_name_hash.h"
 
 static inline void *trampolineGetProcAddr(struct loader_instance *inst,
                                           const char *funcName) {
     // Don't include or check global functions
-    if (!strcmp(funcName, "vkGetInstanceProcAddr"))
+    switch (vk_proc_index(funcName)) {
+    case VK_PROC_GetInstanceProcAddr:
         return (PFN_vkVoidFunction)vkGetInstanceProcAddr;
-    if (!strcmp(funcName, "vkDestroyInstance"))
+    case VK_PROC_DestroyInstance:
         return (PFN_vkVoidFunction)vkDestroyInstance;
-    if (!strcmp(funcName, "vkEnumeratePhysicalDevices"))
+    case VK_PROC_EnumeratePhysicalDevices:
         return (PFN_vkVoidFunction)vkEnumeratePhysicalDevices;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceFeatures"))
+    case VK_PROC_GetPhysicalDeviceFeatures:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceFeatures;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceFormatProperties"))
+    case VK_PROC_GetPhysicalDeviceFormatProperties:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceFormatProperties;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceImageFormatProperties"))
+    case VK_PROC_GetPhysicalDeviceImageFormatProperties:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceImageFormatProperties;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceSparseImageFormatProperties"))
-        return (
-            PFN_vkVoidFunction)vkGetPhysicalDeviceSparseImageFormatProperties;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceProperties"))
+    case VK_PROC_GetPhysicalDeviceSparseImageFormatProperties:
+        return (PFN_vkVoidFunction)vkGetPhysicalDeviceSparseImageFormatProperties;
+    case VK_PROC_GetPhysicalDeviceProperties:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceProperties;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceQueueFamilyProperties"))
+    case VK_PROC_GetPhysicalDeviceQueueFamilyProperties:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceQueueFamilyProperties;
-    if (!strcmp(funcName, "vkGetPhysicalDeviceMemoryProperties"))
+    case VK_PROC_GetPhysicalDeviceMemoryProperties:
         return (PFN_vkVoidFunction)vkGetPhysicalDeviceMemoryProperties;
-    if (!strcmp(funcName, "vkEnumerateDeviceLayerProperties"))
+    case VK_PROC_EnumerateDeviceLayerProperties:
         return (PFN_vkVoidFunction)vkEnumerateDeviceLayerProperties;
-    if (!strcmp(funcName, "vkEnumerateDeviceExtensionProperties"))
+    case VK_PROC_EnumerateDeviceExtensionProperties:
         return (PFN_vkVoidFunction)vkEnumerateDeviceExtensionProperties;
-    if (!strcmp(funcName, "vkCreateDevice"))
+    case VK_PROC_CreateDevice:
         return (PFN_vkVoidFunction)vkCreateDevice;
-    if (!strcmp(funcName, "vkGetDeviceProcAddr"))
+    case VK_PROC_GetDeviceProcAddr:
         return (PFN_vkVoidFunction)vkGetDeviceProcAddr;
-    if (!strcmp(funcName, "vkDestroyDevice"))
+    case VK_PROC_DestroyDevice:
         return (PFN_vkVoidFunction)vkDestroyDevice;
-    if (!strcmp(funcName, "vkGetDeviceQueue"))
+    case VK_PROC_GetDeviceQueue:
         return (PFN_vkVoidFunction)vkGetDeviceQueue;
-    if (!strcmp(funcName, "vkQueueSubmit"))
+    case VK_PROC_QueueSubmit:
         return (PFN_vkVoidFunction)vkQueueSubmit;
-    if (!strcmp(funcName, "vkQueueWaitIdle"))
+    case VK_PROC_QueueWaitIdle:
         return (PFN_vkVoidFunction)vkQueueWaitIdle;
-    if (!strcmp(funcName, "vkDeviceWaitIdle"))
+    case VK_PROC_DeviceWaitIdle:
         return (PFN_vkVoidFunction)vkDeviceWaitIdle;
-    if (!strcmp(funcName, "vkAllocateMemory"))
+    case VK_PROC_AllocateMemory:
         return (PFN_vkVoidFunction)vkAllocateMemory;
-    if (!strcmp(funcName, "vkFreeMemory"))
+    case VK_PROC_FreeMemory:
         return (PFN_vkVoidFunction)vkFreeMemory;
-    if (!strcmp(funcName, "vkMapMemory"))
+    case VK_PROC_MapMemory:
         return (PFN_vkVoidFunction)vkMapMemory;
-    if (!strcmp(funcName, "vkUnmapMemory"))
+    case VK_PROC_UnmapMemory:
         return (PFN_vkVoidFunction)vkUnmapMemory;
-    if (!strcmp(funcName, "vkFlushMappedMemoryRanges"))
+    case VK_PROC_FlushMappedMemoryRanges:
         return (PFN_vkVoidFunction)vkFlushMappedMemoryRanges;
-    if (!strcmp(funcName, "vkInvalidateMappedMemoryRanges"))
+    case VK_PROC_InvalidateMappedMemoryRanges:
         return (PFN_vkVoidFunction)vkInvalidateMappedMemoryRanges;
-    if (!strcmp(funcName, "vkGetDeviceMemoryCommitment"))
+    case VK_PROC_GetDeviceMemoryCommitment:
         return (PFN_vkVoidFunction)vkGetDeviceMemoryCommitment;
-    if (!strcmp(funcName, "vkGetImageSparseMemoryRequirements"))
+    case VK_PROC_GetImageSparseMemoryRequirements:
         return (PFN_vkVoidFunction)vkGetImageSparseMemoryRequirements;
-    if (!strcmp(funcName, "vkGetImageMemoryRequirements"))
+    case VK_PROC_GetImageMemoryRequirements:
         return (PFN_vkVoidFunction)vkGetImageMemoryRequirements;
-    if (!strcmp(funcName, "vkGetBufferMemoryRequirements"))
+    case VK_PROC_GetBufferMemoryRequirements:
         return (PFN_vkVoidFunction)vkGetBufferMemoryRequirements;
-    if (!strcmp(funcName, "vkBindImageMemory"))
+    case VK_PROC_BindImageMemory:
         return (PFN_vkVoidFunction)vkBindImageMemory;
-    if (!strcmp(funcName, "vkBindBufferMemory"))
+    case VK_PROC_BindBufferMemory:
         return (PFN_vkVoidFunction)vkBindBufferMemory;
-    if (!strcmp(funcName, "vkQueueBindSparse"))
+    case VK_PROC_QueueBindSparse:
         return (PFN_vkVoidFunction)vkQueueBindSparse;
-    if (!strcmp(funcName, "vkCreateFence"))
+    case VK_PROC_CreateFence:
         return (PFN_vkVoidFunction)vkCreateFence;
-    if (!strcmp(funcName, "vkDestroyFence"))
+    case VK_PROC_DestroyFence:
         return (PFN_vkVoidFunction)vkDestroyFence;
-    if (!strcmp(funcName, "vkGetFenceStatus"))
+    case VK_PROC_GetFenceStatus:
         return (PFN_vkVoidFunction)vkGetFenceStatus;
-    if (!strcmp(funcName, "vkResetFences"))
+    case VK_PROC_ResetFences:
         return (PFN_vkVoidFunction)vkResetFences;
-    if (!strcmp(funcName, "vkWaitForFences"))
+    case VK_PROC_WaitForFences:
         return (PFN_vkVoidFunction)vkWaitForFences;
-    if (!strcmp(funcName, "vkCreateSemaphore"))
+    case VK_PROC_CreateSemaphore:
         return (PFN_vkVoidFunction)vkCreateSemaphore;
-    if (!strcmp(funcName, "vkDestroySemaphore"))
+    case VK_PROC_DestroySemaphore:
         return (PFN_vkVoidFunction)vkDestroySemaphore;
-    if (!strcmp(funcName, "vkCreateEvent"))
+    case VK_PROC_CreateEvent:
         return (PFN_vkVoidFunction)vkCreateEvent;
-    if (!strcmp(funcName, "vkDestroyEvent"))
+    case VK_PROC_DestroyEvent:
         return (PFN_vkVoidFunction)vkDestroyEvent;
-    if (!strcmp(funcName, "vkGetEventStatus"))
+    case VK_PROC_GetEventStatus:
         return (PFN_vkVoidFunction)vkGetEventStatus;
-    if (!strcmp(funcName, "vkSetEvent"))
+    case VK_PROC_SetEvent:
         return (PFN_vkVoidFunction)vkSetEvent;
-    if (!strcmp(funcName, "vkResetEvent"))
+    case VK_PROC_ResetEvent:
         return (PFN_vkVoidFunction)vkResetEvent;
-    if (!strcmp(funcName, "vkCreateQueryPool"))
+    case VK_PROC_CreateQueryPool:
         return (PFN_vkVoidFunction)vkCreateQueryPool;
-    if (!strcmp(funcName, "vkDestroyQueryPool"))
+    case VK_PROC_DestroyQueryPool:
         return (PFN_vkVoidFunction)vkDestroyQueryPool;
-    if (!strcmp(funcName, "vkGetQueryPoolResults"))
+    case VK_PROC_GetQueryPoolResults:
         return (PFN_vkVoidFunction)vkGetQueryPoolResults;
-    if (!strcmp(funcName, "vkCreateBuffer"))
+    case VK_PROC_CreateBuffer:
         return (PFN_vkVoidFunction)vkCreateBuffer;
-    if (!strcmp(funcName, "vkDestroyBuffer"))
+    case VK_PROC_DestroyBuffer:
         return (PFN_vkVoidFunction)vkDestroyBuffer;
-    if (!strcmp(funcName, "vkCreateBufferView"))
+    case VK_PROC_CreateBufferView:
         return (PFN_vkVoidFunction)vkCreateBufferView;
-    if (!strcmp(funcName, "vkDestroyBufferView"))
+    case VK_PROC_DestroyBufferView:
         return (PFN_vkVoidFunction)vkDestroyBufferView;
-    if (!strcmp(funcName, "vkCreateImage"))
+    case VK_PROC_CreateImage:
         return (PFN_vkVoidFunction)vkCreateImage;
-    if (!strcmp(funcName, "vkDestroyImage"))
+    case VK_PROC_DestroyImage:
         return (PFN_vkVoidFunction)vkDestroyImage;
-    if (!strcmp(funcName, "vkGetImageSubresourceLayout"))
+    case VK_PROC_GetImageSubresourceLayout:
         return (PFN_vkVoidFunction)vkGetImageSubresourceLayout;
-    if (!strcmp(funcName, "vkCreateImageView"))
+    case VK_PROC_CreateImageView:
         return (PFN_vkVoidFunction)vkCreateImageView;
-    if (!strcmp(funcName, "vkDestroyImageView"))
+    case VK_PROC_DestroyImageView:
         return (PFN_vkVoidFunction)vkDestroyImageView;
-    if (!strcmp(funcName, "vkCreateShaderModule"))
+    case VK_PROC_CreateShaderModule:
         return (PFN_vkVoidFunction)vkCreateShaderModule;
-    if (!strcmp(funcName, "vkDestroyShaderModule"))
+    case VK_PROC_DestroyShaderModule:
         return (PFN_vkVoidFunction)vkDestroyShaderModule;
-    if (!strcmp(funcName, "vkCreatePipelineCache"))
+    case VK_PROC_CreatePipelineCache:
         return (PFN_vkVoidFunction)vkCreatePipelineCache;
-    if (!strcmp(funcName, "vkDestroyPipelineCache"))
+    case VK_PROC_DestroyPipelineCache:
         return (PFN_vkVoidFunction)vkDestroyPipelineCache;
-    if (!strcmp(funcName, "vkGetPipelineCacheData"))
+    case VK_PROC_GetPipelineCacheData:
         return (PFN_vkVoidFunction)vkGetPipelineCacheData;
-    if (!strcmp(funcName, "vkMergePipelineCaches"))
+    case VK_PROC_MergePipelineCaches:
         return (PFN_vkVoidFunction)vkMergePipelineCaches;
-    if (!strcmp(funcName, "vkCreateGraphicsPipelines"))
+    case VK_PROC_CreateGraphicsPipelines:
         return (PFN_vkVoidFunction)vkCreateGraphicsPipelines;
-    if (!strcmp(funcName, "vkCreateComputePipelines"))
+    case VK_PROC_CreateComputePipelines:
         return (PFN_vkVoidFunction)vkCreateComputePipelines;
-    if (!strcmp(funcName, "vkDestroyPipeline"))
+    case VK_PROC_DestroyPipeline:
         return (PFN_vkVoidFunction)vkDestroyPipeline;
-    if (!strcmp(funcName, "vkCreatePipelineLayout"))
+    case VK_PROC_CreatePipelineLayout:
         return (PFN_vkVoidFunction)vkCreatePipelineLayout;
-    if (!strcmp(funcName, "vkDestroyPipelineLayout"))
+    case VK_PROC_DestroyPipelineLayout:
         return (PFN_vkVoidFunction)vkDestroyPipelineLayout;
-    if (!strcmp(funcName, "vkCreateSampler"))
+    case VK_PROC_CreateSampler:
         return (PFN_vkVoidFunction)vkCreateSampler;
-    if (!strcmp(funcName, "vkDestroySampler"))
+    case VK_PROC_DestroySampler:
         return (PFN_vkVoidFunction)vkDestroySampler;
-    if (!strcmp(funcName, "vkCreateDescriptorSetLayout"))
+    case VK_PROC_CreateDescriptorSetLayout:
         return (PFN_vkVoidFunction)vkCreateDescriptorSetLayout;
-    if (!strcmp(funcName, "vkDestroyDescriptorSetLayout"))
+    case VK_PROC_DestroyDescriptorSetLayout:
         return (PFN_vkVoidFunction)vkDestroyDescriptorSetLayout;
-    if (!strcmp(funcName, "vkCreateDescriptorPool"))
+    case VK_PROC_CreateDescriptorPool:
         return (PFN_vkVoidFunction)vkCreateDescriptorPool;
-    if (!strcmp(funcName, "vkDestroyDescriptorPool"))
+    case VK_PROC_DestroyDescriptorPool:
         return (PFN_vkVoidFunction)vkDestroyDescriptorPool;
-    if (!strcmp(funcName, "vkResetDescriptorPool"))
+    case VK_PROC_ResetDescriptorPool:
         return (PFN_vkVoidFunction)vkResetDescriptorPool;
-    if (!strcmp(funcName, "vkAllocateDescriptorSets"))
+    case VK_PROC_AllocateDescriptorSets:
         return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
-    if (!strcmp(funcName, "vkFreeDescriptorSets"))
+    case VK_PROC_FreeDescriptorSets:
         return (PFN_vkVoidFunction)vkFreeDescriptorSets;
-    if (!strcmp(funcName, "vkUpdateDescriptorSets"))
+    case VK_PROC_UpdateDescriptorSets:
         return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
-    if (!strcmp(funcName, "vkCreateFramebuffer"))
+    case VK_PROC_CreateFramebuffer:
         return (PFN_vkVoidFunction)vkCreateFramebuffer;
-    if (!strcmp(funcName, "vkDestroyFramebuffer"))
+    case VK_PROC_DestroyFramebuffer:
         return (PFN_vkVoidFunction)vkDestroyFramebuffer;
-    if (!strcmp(funcName, "vkCreateRenderPass"))
+    case VK_PROC_CreateRenderPass:
         return (PFN_vkVoidFunction)vkCreateRenderPass;
-    if (!strcmp(funcName, "vkDestroyRenderPass"))
+    case VK_PROC_DestroyRenderPass:
         return (PFN_vkVoidFunction)vkDestroyRenderPass;
-    if (!strcmp(funcName, "vkGetRenderAreaGranularity"))
+    case VK_PROC_GetRenderAreaGranularity:
         return (PFN_vkVoidFunction)vkGetRenderAreaGranularity;
-    if (!strcmp(funcName, "vkCreateCommandPool"))
+    case VK_PROC_CreateCommandPool:
         return (PFN_vkVoidFunction)vkCreateCommandPool;
-    if (!strcmp(funcName, "vkDestroyCommandPool"))
+    case VK_PROC_DestroyCommandPool:
         return (PFN_vkVoidFunction)vkDestroyCommandPool;
-    if (!strcmp(funcName, "vkResetCommandPool"))
+    case VK_PROC_ResetCommandPool:
         return (PFN_vkVoidFunction)vkResetCommandPool;
-    if (!strcmp(funcName, "vkAllocateCommandBuffers"))
+    case VK_PROC_AllocateCommandBuffers:
         return (PFN_vkVoidFunction)vkAllocateCommandBuffers;
-    if (!strcmp(funcName, "vkFreeCommandBuffers"))
+    case VK_PROC_FreeCommandBuffers:
         return (PFN_vkVoidFunction)vkFreeCommandBuffers;
-    if (!strcmp(funcName, "vkBeginCommandBuffer"))
+    case VK_PROC_BeginCommandBuffer:
         return (PFN_vkVoidFunction)vkBeginCommandBuffer;
-    if (!strcmp(funcName, "vkEndCommandBuffer"))
+    case VK_PROC_EndCommandBuffer:
         return (PFN_vkVoidFunction)vkEndCommandBuffer;
-    if (!strcmp(funcName, "vkResetCommandBuffer"))
+    case VK_PROC_ResetCommandBuffer:
         return (PFN_vkVoidFunction)vkResetCommandBuffer;
-    if (!strcmp(funcName, "vkCmdBindPipeline"))
+    case VK_PROC_CmdBindPipeline:
         return (PFN_vkVoidFunction)vkCmdBindPipeline;
-    if (!strcmp(funcName, "vkCmdBindDescriptorSets"))
+    case VK_PROC_CmdBindDescriptorSets:
         return (PFN_vkVoidFunction)vkCmdBindDescriptorSets;
-    if (!strcmp(funcName, "vkCmdBindVertexBuffers"))
+    case VK_PROC_CmdBindVertexBuffers:
         return (PFN_vkVoidFunction)vkCmdBindVertexBuffers;
-    if (!strcmp(funcName, "vkCmdBindIndexBuffer"))
+    case VK_PROC_CmdBindIndexBuffer:
         return (PFN_vkVoidFunction)vkCmdBindIndexBuffer;
-    if (!strcmp(funcName, "vkCmdSetViewport"))
+    case VK_PROC_CmdSetViewport:
         return (PFN_vkVoidFunction)vkCmdSetViewport;
-    if (!strcmp(funcName, "vkCmdSetScissor"))
+    case VK_PROC_CmdSetScissor:
         return (PFN_vkVoidFunction)vkCmdSetScissor;
-    if (!strcmp(funcName, "vkCmdSetLineWidth"))
+    case VK_PROC_CmdSetLineWidth:
         return (PFN_vkVoidFunction)vkCmdSetLineWidth;
-    if (!strcmp(funcName, "vkCmdSetDepthBias"))
+    case VK_PROC_CmdSetDepthBias:
         return (PFN_vkVoidFunction)vkCmdSetDepthBias;
-    if (!strcmp(funcName, "vkCmdSetBlendConstants"))
+    case VK_PROC_CmdSetBlendConstants:
         return (PFN_vkVoidFunction)vkCmdSetBlendConstants;
-    if (!strcmp(funcName, "vkCmdSetDepthBounds"))
+    case VK_PROC_CmdSetDepthBounds:
         return (PFN_vkVoidFunction)vkCmdSetDepthBounds;
-    if (!strcmp(funcName, "vkCmdSetStencilCompareMask"))
+    case VK_PROC_CmdSetStencilCompareMask:
         return (PFN_vkVoidFunction)vkCmdSetStencilCompareMask;
-    if (!strcmp(funcName, "vkCmdSetStencilWriteMask"))
+    case VK_PROC_CmdSetStencilWriteMask:
         return (PFN_vkVoidFunction)vkCmdSetStencilWriteMask;
-    if (!strcmp(funcName, "vkCmdSetStencilReference"))
+    case VK_PROC_CmdSetStencilReference:
         return (PFN_vkVoidFunction)vkCmdSetStencilReference;
-    if (!strcmp(funcName, "vkCmdDraw"))
+    case VK_PROC_CmdDraw:
         return (PFN_vkVoidFunction)vkCmdDraw;
-    if (!strcmp(funcName, "vkCmdDrawIndexed"))
+    case VK_PROC_CmdDrawIndexed:
         return (PFN_vkVoidFunction)vkCmdDrawIndexed;
-    if (!strcmp(funcName, "vkCmdDrawIndirect"))
+    case VK_PROC_CmdDrawIndirect:
         return (PFN_vkVoidFunction)vkCmdDrawIndirect;
-    if (!strcmp(funcName, "vkCmdDrawIndexedIndirect"))
+    case VK_PROC_CmdDrawIndexedIndirect:
         return (PFN_vkVoidFunction)vkCmdDrawIndexedIndirect;
-    if (!strcmp(funcName, "vkCmdDispatch"))
+    case VK_PROC_CmdDispatch:
         return (PFN_vkVoidFunction)vkCmdDispatch;
-    if (!strcmp(funcName, "vkCmdDispatchIndirect"))
+    case VK_PROC_CmdDispatchIndirect:
         return (PFN_vkVoidFunction)vkCmdDispatchIndirect;
-    if (!strcmp(funcName, "vkCmdCopyBuffer"))
+    case VK_PROC_CmdCopyBuffer:
         return (PFN_vkVoidFunction)vkCmdCopyBuffer;
-    if (!strcmp(funcName, "vkCmdCopyImage"))
+    case VK_PROC_CmdCopyImage:
         return (PFN_vkVoidFunction)vkCmdCopyImage;
-    if (!strcmp(funcName, "vkCmdBlitImage"))
+    case VK_PROC_CmdBlitImage:
         return (PFN_vkVoidFunction)vkCmdBlitImage;
-    if (!strcmp(funcName, "vkCmdCopyBufferToImage"))
+    case VK_PROC_CmdCopyBufferToImage:
         return (PFN_vkVoidFunction)vkCmdCopyBufferToImage;
-    if (!strcmp(funcName, "vkCmdCopyImageToBuffer"))
+    case VK_PROC_CmdCopyImageToBuffer:
         return (PFN_vkVoidFunction)vkCmdCopyImageToBuffer;
-    if (!strcmp(funcName, "vkCmdUpdateBuffer"))
+    case VK_PROC_CmdUpdateBuffer:
         return (PFN_vkVoidFunction)vkCmdUpdateBuffer;
-    if (!strcmp(funcName, "vkCmdFillBuffer"))
+    case VK_PROC_CmdFillBuffer:
         return (PFN_vkVoidFunction)vkCmdFillBuffer;
-    if (!strcmp(funcName, "vkCmdClearColorImage"))
+    case VK_PROC_CmdClearColorImage:
         return (PFN_vkVoidFunction)vkCmdClearColorImage;
-    if (!strcmp(funcName, "vkCmdClearDepthStencilImage"))
+    case VK_PROC_CmdClearDepthStencilImage:
         return (PFN_vkVoidFunction)vkCmdClearDepthStencilImage;
-    if (!strcmp(funcName, "vkCmdClearAttachments"))
+    case VK_PROC_CmdClearAttachments:
         return (PFN_vkVoidFunction)vkCmdClearAttachments;
-    if (!strcmp(funcName, "vkCmdResolveImage"))
+    case VK_PROC_CmdResolveImage:
         return (PFN_vkVoidFunction)vkCmdResolveImage;
-    if (!strcmp(funcName, "vkCmdSetEvent"))
+    case VK_PROC_CmdSetEvent:
         return (PFN_vkVoidFunction)vkCmdSetEvent;
-    if (!strcmp(funcName, "vkCmdResetEvent"))
+    case VK_PROC_CmdResetEvent:
         return (PFN_vkVoidFunction)vkCmdResetEvent;
-    if (!strcmp(funcName, "vkCmdWaitEvents"))
+    case VK_PROC_CmdWaitEvents:
         return (PFN_vkVoidFunction)vkCmdWaitEvents;
-    if (!strcmp(funcName, "vkCmdPipelineBarrier"))
+    case VK_PROC_CmdPipelineBarrier:
         return (PFN_vkVoidFunction)vkCmdPipelineBarrier;
-    if (!strcmp(funcName, "vkCmdBeginQuery"))
+    case VK_PROC_CmdBeginQuery:
         return (PFN_vkVoidFunction)vkCmdBeginQuery;
-    if (!strcmp(funcName, "vkCmdEndQuery"))
+    case VK_PROC_CmdEndQuery:
         return (PFN_vkVoidFunction)vkCmdEndQuery;
-    if (!strcmp(funcName, "vkCmdResetQueryPool"))
+    case VK_PROC_CmdResetQueryPool:
         return (PFN_vkVoidFunction)vkCmdResetQueryPool;
-    if (!strcmp(funcName, "vkCmdWriteTimestamp"))
+    case VK_PROC_CmdWriteTimestamp:
         return (PFN_vkVoidFunction)vkCmdWriteTimestamp;
-    if (!strcmp(funcName, "vkCmdCopyQueryPoolResults"))
+    case VK_PROC_CmdCopyQueryPoolResults:
         return (PFN_vkVoidFunction)vkCmdCopyQueryPoolResults;
-    if (!strcmp(funcName, "vkCmdPushConstants"))
+    case VK_PROC_CmdPushConstants:
         return (PFN_vkVoidFunction)vkCmdPushConstants;
-    if (!strcmp(funcName, "vkCmdBeginRenderPass"))
+    case VK_PROC_CmdBeginRenderPass:
         return (PFN_vkVoidFunction)vkCmdBeginRenderPass;
-    if (!strcmp(funcName, "vkCmdNextSubpass"))
+    case VK_PROC_CmdNextSubpass:
         return (PFN_vkVoidFunction)vkCmdNextSubpass;
-    if (!strcmp(funcName, "vkCmdEndRenderPass"))
+    case VK_PROC_CmdEndRenderPass:
         return (PFN_vkVoidFunction)vkCmdEndRenderPass;
-    if (!strcmp(funcName, "vkCmdExecuteCommands"))
+    case VK_PROC_CmdExecuteCommands:
         return (PFN_vkVoidFunction)vkCmdExecuteCommands;
+    default:
+        break;
+    }
 
     // Instance extensions
     void *addr;
@@ -309,18 +313,16 @@ static inline void *trampolineGetProcAddr(struct loader_instance *inst,
 }
 
 static inline void *globalGetProcAddr(const char *name) {
-    if (!name || name[0] != 'v' || name[1] != 'k')
-        return NULL;
-
-    name += 2;
-    if (!strcmp(name, "CreateInstance"))
+    switch (vk_proc_index(name)) {
+    case VK_PROC_CreateInstance:
         return (void *)vkCreateInstance;
-    if (!strcmp(name, "EnumerateInstanceExtensionProperties"))
+    case VK_PROC_EnumerateInstanceExtensionProperties:
         return (void *)vkEnumerateInstanceExtensionProperties;
-    if (!strcmp(name, "EnumerateInstanceLayerProperties"))
+    case VK_PROC_EnumerateInstanceLayerProperties:
         return (void *)vkEnumerateInstanceLayerProperties;
-
-    return NULL;
+    default:
+        return NULL;
+    }
 }
 
 /* These functions require special handling by the loader.
@@ -328,45 +330,40 @@ static inline void *globalGetProcAddr(const char *name) {
 *  Thus GPA must return loader entrypoint for these instead of first function
 *  in the chain. */
 static inline void *loader_non_passthrough_gipa(const char *name) {
-    if (!name || name[0] != 'v' || name[1] != 'k')
-        return NULL;
-
-    name += 2;
-    if (!strcmp(name, "CreateInstance"))
+    switch (vk_proc_index(name)) {
+    case VK_PROC_CreateInstance:
         return (void *)vkCreateInstance;
-    if (!strcmp(name, "DestroyInstance"))
+    case VK_PROC_DestroyInstance:
         return (void *)vkDestroyInstance;
-    if (!strcmp(name, "GetDeviceProcAddr"))
+    case VK_PROC_GetDeviceProcAddr:
         return (void *)vkGetDeviceProcAddr;
     // remove once no longer locks
-    if (!strcmp(name, "EnumeratePhysicalDevices"))
+    case VK_PROC_EnumeratePhysicalDevices:
         return (void *)vkEnumeratePhysicalDevices;
-    if (!strcmp(name, "EnumerateDeviceExtensionProperties"))
+    case VK_PROC_EnumerateDeviceExtensionProperties:
         return (void *)vkEnumerateDeviceExtensionProperties;
-    if (!strcmp(name, "EnumerateDeviceLayerProperties"))
+    case VK_PROC_EnumerateDeviceLayerProperties:
         return (void *)vkEnumerateDeviceLayerProperties;
-    if (!strcmp(name, "GetInstanceProcAddr"))
+    case VK_PROC_GetInstanceProcAddr:
         return (void *)vkGetInstanceProcAddr;
-    if (!strcmp(name, "CreateDevice"))
+    case VK_PROC_CreateDevice:
         return (void *)vkCreateDevice;
-
-    return NULL;
+    default:
+        return NULL;
+    }
 }
 
 static inline void *loader_non_passthrough_gdpa(const char *name) {
-    if (!name || name[0] != 'v' || name[1] != 'k')
-        return NULL;
-
-    name += 2;
-
-    if (!strcmp(name, "GetDeviceProcAddr"))
+    switch (vk_proc_index(name)) {
+    case VK_PROC_GetDeviceProcAddr:
         return (void *)vkGetDeviceProcAddr;
-    if (!strcmp(name, "DestroyDevice"))
+    case VK_PROC_DestroyDevice:
         return (void *)vkDestroyDevice;
-    if (!strcmp(name, "GetDeviceQueue"))
+    case VK_PROC_GetDeviceQueue:
         return (void *)vkGetDeviceQueue;
-    if (!strcmp(name, "AllocateCommandBuffers"))
+    case VK_PROC_AllocateCommandBuffers:
         return (void *)vkAllocateCommandBuffers;
-
-    return NULL;
+    default:
+        return NULL;
+    }
 }
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include "json_stream.h"
+
+// Manifests nest three or four levels deep; anything past this is malformed
+#define LOADER_JSON_MAX_DEPTH 64
+
+static bool loader_json_fail(struct loader_json *json) {
+    json->error = true;
+    json->pos = json->end;
+    return false;
+}
+
+static void loader_json_skip_space(struct loader_json *json) {
+    while (json->pos < json->end &&
+           (*json->pos == ' ' || *json->pos == '\t' || *json->pos == '\n' ||
+            *json->pos == '\r'))
+        json->pos++;
+}
+
+// Consume c, after any whitespace, if it is the next character
+static bool loader_json_accept(struct loader_json *json, char c) {
+    loader_json_skip_space(json);
+    if (json->pos < json->end && *json->pos == c) {
+        json->pos++;
+        return true;
+    }
+    return false;
+}
+
+static bool loader_json_is_hex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+           (c >= 'A' && c <= 'F');
+}
+
+// A \u escape followed by four hex digits starts at p
+static bool loader_json_is_unicode_escape(const char *p, const char *end) {
+    return end - p >= 6 && p[0] == '\\' && p[1] == 'u' &&
+           loader_json_is_hex(p[2]) && loader_json_is_hex(p[3]) &&
+           loader_json_is_hex(p[4]) && loader_json_is_hex(p[5]);
+}
+
+static uint32_t loader_json_hex_value(const char *p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = p[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+            value |= (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            value |= (uint32_t)(c - 'a' + 10);
+        else
+            value |= (uint32_t)(c - 'A' + 10);
+    }
+    return value;
+}
+
+// Read a string starting at the opening quote.  Like cJSON, this accepts
+// control characters and unknown escapes rather than rejecting the file;
+// loader_json_copy keeps an unknown escape as written, so an unescaped
+// Windows path survives.
+static bool loader_json_read_string(struct loader_json *json,
+                                    struct loader_json_value *value) {
+    const char *p = json->pos + 1;
+    const char *quote, *backslash;
+    value->type = LOADER_JSON_STRING;
+    value->text = p;
+    for (;;) {
+        // Most strings have no escapes, so find the quote first and only
+        // look closer if there is a backslash before it
+        quote = memchr(p, '"', (size_t)(json->end - p));
+        if (quote == NULL)
+            return loader_json_fail(json);
+        backslash = memchr(p, '\\', (size_t)(quote - p));
+        if (backslash == NULL)
+            break;
+        // Step over the escape; an escaped quote doesn't end the string
+        p = backslash + 2;
+        if (p > json->end)
+            return loader_json_fail(json);
+    }
+    value->length = (size_t)(quote - value->text);
+    json->pos = quote + 1;
+    return true;
+}
+
+static bool loader_json_read_number(struct loader_json *json,
+                                    struct loader_json_value *value) {
+    const char *p = json->pos;
+    const char *digits;
+    if (p < json->end && *p == '-')
+        p++;
+    digits = p;
+    while (p < json->end && *p >= '0' && *p <= '9')
+        p++;
+    if (p == digits)
+        return loader_json_fail(json);
+    if (p < json->end && *p == '.') {
+        digits = ++p;
+        while (p < json->end && *p >= '0' && *p <= '9')
+            p++;
+        if (p == digits)
+            return loader_json_fail(json);
+    }
+    if (p < json->end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < json->end && (*p == '+' || *p == '-'))
+            p++;
+        digits = p;
+        while (p < json->end && *p >= '0' && *p <= '9')
+            p++;
+        if (p == digits)
+            return loader_json_fail(json);
+    }
+    value->type = LOADER_JSON_NUMBER;
+    value->text = json->pos;
+    value->length = (size_t)(p - json->pos);
+    json->pos = p;
+    return true;
+}
+
+static bool loader_json_read_literal(struct loader_json *json,
+                                     struct loader_json_value *value) {
+    static const char *const literals[] = {"true", "false", "null"};
+    size_t remaining = (size_t)(json->end - json->pos);
+    for (size_t i = 0; i < sizeof(literals) / sizeof(literals[0]); i++) {
+        size_t length = strlen(literals[i]);
+        if (remaining >= length &&
+            memcmp(json->pos, literals[i], length) == 0) {
+            value->type = LOADER_JSON_LITERAL;
+            value->text = json->pos;
+            value->length = length;
+            json->pos += length;
+            return true;
+        }
+    }
+    return loader_json_fail(json);
+}
+
+void loader_json_init(struct loader_json *json, const char *data, size_t size) {
+    json->pos = data;
+    json->end = data + size;
+    json->depth = 0;
+    json->error = false;
+
+    // Skip a UTF-8 byte order mark, which some editors write
+    if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+        json->pos += 3;
+}
+
+enum loader_json_type loader_json_peek(struct loader_json *json) {
+    loader_json_skip_space(json);
+    if (json->error || json->pos >= json->end)
+        return LOADER_JSON_NONE;
+    switch (*json->pos) {
+    case '{':
+        return LOADER_JSON_OBJECT;
+    case '[':
+        return LOADER_JSON_ARRAY;
+    case '"':
+        return LOADER_JSON_STRING;
+    case 't':
+    case 'f':
+    case 'n':
+        return LOADER_JSON_LITERAL;
+    default:
+        if (*json->pos == '-' || (*json->pos >= '0' && *json->pos <= '9'))
+            return LOADER_JSON_NUMBER;
+        return LOADER_JSON_NONE;
+    }
+}
+
+bool loader_json_read(struct loader_json *json,
+                      struct loader_json_value *value) {
+    value->type = LOADER_JSON_NONE;
+    value->text = NULL;
+    value->length = 0;
+    switch (loader_json_peek(json)) {
+    case LOADER_JSON_OBJECT:
+    case LOADER_JSON_ARRAY:
+        if (json->depth >= LOADER_JSON_MAX_DEPTH)
+            return loader_json_fail(json);
+        value->type = (*json->pos == '{') ? LOADER_JSON_OBJECT
+                                          : LOADER_JSON_ARRAY;
+        value->text = json->pos++;
+        value->length = 1;
+        json->depth++;
+        return true;
+    case LOADER_JSON_STRING:
+        return loader_json_read_string(json, value);
+    case LOADER_JSON_NUMBER:
+        return loader_json_read_number(json, value);
+    case LOADER_JSON_LITERAL:
+        return loader_json_read_literal(json, value);
+    default:
+        return loader_json_fail(json);
+    }
+}
+
+bool loader_json_skip(struct loader_json *json) {
+    struct loader_json_value value;
+    uint32_t index = 0;
+
+    if (!loader_json_read(json, &value))
+        return false;
+    if (value.type == LOADER_JSON_OBJECT) {
+        struct loader_json_value key;
+        while (loader_json_next_member(json, &index, &key)) {
+            if (!loader_json_skip(json))
+                return false;
+        }
+    } else if (value.type == LOADER_JSON_ARRAY) {
+        while (loader_json_next_element(json, &index)) {
+            if (!loader_json_skip(json))
+                return false;
+        }
+    }
+    return !json->error;
+}
+
+// Shared by next_member and next_element: consumes the closing bracket or the
+// separator before the next item
+static bool loader_json_next_item(struct loader_json *json, uint32_t *index,
+                                  char close) {
+    if (json->error)
+        return false;
+    if (loader_json_accept(json, close)) {
+        json->depth--;
+        return false;
+    }
+    if (*index > 0 && !loader_json_accept(json, ','))
+        return loader_json_fail(json);
+    (*index)++;
+    return true;
+}
+
+bool loader_json_next_member(struct loader_json *json, uint32_t *index,
+                             struct loader_json_value *key) {
+    if (!loader_json_next_item(json, index, '}'))
+        return false;
+    if (loader_json_peek(json) != LOADER_JSON_STRING ||
+        !loader_json_read_string(json, key))
+        return loader_json_fail(json);
+    if (!loader_json_accept(json, ':'))
+        return loader_json_fail(json);
+    return true;
+}
+
+bool loader_json_next_element(struct loader_json *json, uint32_t *index) {
+    return loader_json_next_item(json, index, ']');
+}
+
+bool loader_json_key_is(const struct loader_json_value *key, const char *str) {
+    size_t i;
+    for (i = 0; i < key->length; i++) {
+        char a = key->text[i];
+        char b = str[i];
+        if (b == '\0')
+            return false;
+        if (a >= 'A' && a <= 'Z')
+            a = (char)(a - 'A' + 'a');
+        if (b >= 'A' && b <= 'Z')
+            b = (char)(b - 'A' + 'a');
+        if (a != b)
+            return false;
+    }
+    return str[i] == '\0';
+}
+
+// Append a code point as UTF-8 if it fits in the remaining space
+static size_t loader_json_put_utf8(uint32_t code, char *dst, size_t space) {
+    char bytes[4];
+    size_t length;
+    if (code < 0x80) {
+        bytes[0] = (char)code;
+        length = 1;
+    } else if (code < 0x800) {
+        bytes[0] = (char)(0xC0 | (code >> 6));
+        bytes[1] = (char)(0x80 | (code & 0x3F));
+        length = 2;
+    } else if (code < 0x10000) {
+        bytes[0] = (char)(0xE0 | (code >> 12));
+        bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = (char)(0x80 | (code & 0x3F));
+        length = 3;
+    } else {
+        bytes[0] = (char)(0xF0 | (code >> 18));
+        bytes[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+        bytes[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+        bytes[3] = (char)(0x80 | (code & 0x3F));
+        length = 4;
+    }
+    if (length > space)
+        return 0;
+    memcpy(dst, bytes, length);
+    return length;
+}
+
+bool loader_json_copy(const struct loader_json_value *value, char *dst,
+                      size_t dst_size) {
+    const char *p, *end;
+    size_t out = 0;
+
+    if (dst_size == 0)
+        return false;
+    dst[0] = '\0';
+    if (value->type != LOADER_JSON_STRING &&
+        value->type != LOADER_JSON_NUMBER &&
+        value->type != LOADER_JSON_LITERAL)
+        return false;
+
+    p = value->text;
+    end = value->text + value->length;
+    while (p < end && out + 1 < dst_size) {
+        uint32_t code;
+        size_t written;
+
+        if (value->type != LOADER_JSON_STRING || *p != '\\') {
+            dst[out++] = *p++;
+            continue;
+        }
+        if (end - p < 2) {
+            dst[out++] = *p++;
+            continue;
+        }
+        switch (p[1]) {
+        case '"':
+        case '\\':
+        case '/':
+            dst[out++] = p[1];
+            p += 2;
+            continue;
+        case 'b':
+            dst[out++] = '\b';
+            p += 2;
+            continue;
+        case 'f':
+            dst[out++] = '\f';
+            p += 2;
+            continue;
+        case 'n':
+            dst[out++] = '\n';
+            p += 2;
+            continue;
+        case 'r':
+            dst[out++] = '\r';
+            p += 2;
+            continue;
+        case 't':
+            dst[out++] = '\t';
+            p += 2;
+            continue;
+        case 'u':
+            if (loader_json_is_unicode_escape(p, end))
+                break;
+            // fall through
+        default:
+            // Not an escape JSON knows; keep the backslash
+            dst[out++] = *p++;
+            continue;
+        }
+
+        code = loader_json_hex_value(p + 2);
+        p += 6;
+        if (code >= 0xD800 && code < 0xDC00 &&
+            loader_json_is_unicode_escape(p, end)) {
+            uint32_t low = loader_json_hex_value(p + 2);
+            if (low >= 0xDC00 && low < 0xE000) {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                p += 6;
+            }
+        }
+        if (code == 0)
+            break;
+        written = loader_json_put_utf8(code, dst + out, dst_size - 1 - out);
+        if (written == 0)
+            break;
+        out += written;
+    }
+    dst[out] = '\0';
+    return true;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Streaming JSON reader
+ *
+ * Reads a JSON document in place, one value at a time, without building a
+ * tree or allocating.  Strings and numbers are returned as slices of the
+ * input and only decoded when copied out with loader_json_copy, so a caller
+ * extracting a few fields from a manifest pays nothing for the rest.
+ *
+ * The reader is a cursor.  Objects and arrays are entered by loader_json_read
+ * and walked with loader_json_next_member / loader_json_next_element; values
+ * the caller has no use for are passed over with loader_json_skip.  Copying
+ * the struct saves the position, so a value can be read again later.  Any
+ * syntax error sets error, after which every call fails.
+ *
+ * The reader is as forgiving as cJSON, which the loader used before, so that
+ * manifests that loaded then still load: content after the top-level value is
+ * ignored, and control characters and unknown escapes in strings are allowed.
+ */
+struct loader_json {
+    const char *pos;
+    const char *end;
+    uint32_t depth;
+    bool error;
+};
+
+enum loader_json_type {
+    LOADER_JSON_NONE = 0, // missing, or a syntax error
+    LOADER_JSON_OBJECT,
+    LOADER_JSON_ARRAY,
+    LOADER_JSON_STRING,
+    LOADER_JSON_NUMBER,
+    LOADER_JSON_LITERAL, // true, false or null
+};
+
+struct loader_json_value {
+    enum loader_json_type type;
+    // String contents between the quotes (still escaped), or the text of a
+    // number or literal.  Not NUL terminated.
+    const char *text;
+    size_t length;
+};
+
+void loader_json_init(struct loader_json *json, const char *data, size_t size);
+
+// Type of the next value, without consuming it
+enum loader_json_type loader_json_peek(struct loader_json *json);
+
+// Read the next value.  For an object or array this consumes only the
+// opening bracket; read the contents with next_member or next_element.
+bool loader_json_read(struct loader_json *json,
+                      struct loader_json_value *value);
+
+// Skip the next value, including everything nested in it
+bool loader_json_skip(struct loader_json *json);
+
+// Move to the next member of the object being read, returning its key.  The
+// member's value must then be read or skipped.  index counts the members
+// read so far and must start at zero.  Returns false after the closing brace
+// or on error.
+bool loader_json_next_member(struct loader_json *json, uint32_t *index,
+                             struct loader_json_value *key);
+
+// Move to the next element of the array being read, as next_member does
+bool loader_json_next_element(struct loader_json *json, uint32_t *index);
+
+// Compare a key or string value with str.  Keys are matched without regard to
+// ASCII case, as cJSON_GetObjectItem does.
+bool loader_json_key_is(const struct loader_json_value *key, const char *str);
+
+// Copy a string, number or literal out as a NUL terminated string, decoding
+// escapes and truncating to dst_size.  Returns false for objects, arrays and
+// missing values.
+bool loader_json_copy(const struct loader_json_value *value, char *dst,
+                      size_t dst_size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -43,7 +43,7 @@
 #include "debug_report.h"
 #include "wsi.h"
 #include "vulkan/vk_icd.h"
-#include "cJSON.h"
+#include "json_stream.h"
 #include "murmurhash.h"
 
 #if defined(__GNUC__)
@@ -80,6 +80,9 @@ uint32_t g_loader_log_msgs = 0;
 // additionally CreateDevice and DestroyDevice needs to be locked
 loader_platform_thread_mutex loader_lock;
 loader_platform_thread_mutex loader_json_lock;
+// protects loader.instance_map and loader.device_map, which are read without
+// loader_lock held
+loader_platform_thread_mutex loader_dispatch_map_lock;
 
 const char *std_validation_str = "VK_LAYER_LUNARG_standard_validation";
 
@@ -395,6 +398,87 @@ void loader_log(const struct loader_instance *inst, VkFlags msg_type,
     fputc('\n', stderr);
 }
 
+/*
+ * Startup tracing.  When VK_LOADER_TRACE_FILE names a file, the time spent
+ * finding and reading manifests, loading ICD and layer libraries, negotiating
+ * interface versions and building call chains is written there as Chrome
+ * trace events, ready for chrome://tracing, and each span is logged as an
+ * information message too.  Otherwise loader_trace_begin returns 0 and
+ * loader_trace_end does nothing.
+ */
+static FILE *loader_trace_file;
+static loader_platform_thread_mutex loader_trace_lock;
+
+static void loader_trace_init(void) {
+    char *path = loader_getenv("VK_LOADER_TRACE_FILE", NULL);
+    if (path == NULL)
+        return;
+#if !defined(_WIN32)
+    if (geteuid() != getuid() || getegid() != getgid()) {
+        /* Don't let setuid apps write to a file named by the env var */
+        loader_free_getenv(path, NULL);
+        return;
+    }
+#endif
+    if (path[0] != '\0') {
+        loader_trace_file = fopen(path, "w");
+        if (loader_trace_file == NULL) {
+            loader_log(NULL, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                       "Couldn't open loader trace file %s", path);
+        } else {
+            // The trace viewer accepts an array without its closing bracket,
+            // so events can be appended until the process exits
+            fputs("[\n", loader_trace_file);
+            fflush(loader_trace_file);
+        }
+    }
+    loader_free_getenv(path, NULL);
+}
+
+uint64_t loader_trace_begin(void) {
+    return loader_trace_file != NULL ? loader_platform_time_ns() : 0;
+}
+
+void loader_trace_end(const struct loader_instance *inst, uint64_t start,
+                      const char *name, const char *detail) {
+    char escaped[2 * MAX_STRING_SIZE];
+    uint64_t end;
+    size_t len = 0;
+
+    if (start == 0 || loader_trace_file == NULL)
+        return;
+    end = loader_platform_time_ns();
+
+    loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
+               "Trace: %s%s%s took %.3f ms", name, detail ? " " : "",
+               detail ? detail : "", (double)(end - start) / 1e6);
+
+    // Paths are the only strings that need escaping for JSON
+    for (const char *c = detail ? detail : "";
+         *c != '\0' && len + 7 < sizeof(escaped); c++) {
+        if (*c == '"' || *c == '\\') {
+            escaped[len++] = '\\';
+            escaped[len++] = *c;
+        } else if ((unsigned char)*c < 0x20) {
+            len += snprintf(escaped + len, sizeof(escaped) - len, "\\u%04x",
+                            (unsigned char)*c);
+        } else {
+            escaped[len++] = *c;
+        }
+    }
+    escaped[len] = '\0';
+
+    loader_platform_thread_lock_mutex(&loader_trace_lock);
+    fprintf(loader_trace_file,
+            "{\"name\":\"%s\",\"cat\":\"loader\",\"ph\":\"X\",\"pid\":0,"
+            "\"tid\":%llu,\"ts\":%.3f,\"dur\":%.3f,"
+            "\"args\":{\"detail\":\"%s\"}},\n",
+            name, (unsigned long long)loader_platform_get_thread_id(),
+            (double)start / 1000.0, (double)(end - start) / 1000.0, escaped);
+    fflush(loader_trace_file);
+    loader_platform_thread_unlock_mutex(&loader_trace_lock);
+}
+
 VKAPI_ATTR VkResult VKAPI_CALL
 vkSetInstanceDispatch(VkInstance instance, void *object) {
 
@@ -579,7 +663,8 @@ static uint32_t loader_make_version(const char *vers_str) {
         }
         cstr = str + 1;
     }
-    patch = atoi(patch_str);
+    if (patch_str != NULL)
+        patch = atoi(patch_str);
 
     return VK_MAKE_VERSION(major, minor, patch);
 }
@@ -675,6 +760,10 @@ loader_get_next_layer_property(const struct loader_instance *inst,
                        "realloc failed for layer list");
             return NULL;
         }
+        // New entries are filled in field by field, so clear them as the
+        // first allocation does
+        memset((uint8_t *)layer_list->list + layer_list->capacity, 0,
+               layer_list->capacity);
         layer_list->capacity *= 2;
     }
 
@@ -1201,48 +1290,159 @@ get_dev_extension_property(const char *name,
 void loader_get_icd_loader_instance_extensions(
     const struct loader_instance *inst, struct loader_icd_libs *icd_libs,
     struct loader_extension_list *inst_exts) {
-    struct loader_extension_list icd_exts;
+    const struct loader_extension_list *icd_exts;
     loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0,
                "Build ICD instance extension list");
     // traverse scanned icd list adding non-duplicate extensions to the list
     for (uint32_t i = 0; i < icd_libs->count; i++) {
-        loader_init_generic_list(inst, (struct loader_generic_list *)&icd_exts,
-                                 sizeof(VkExtensionProperties));
-        loader_add_instance_extensions(
-            inst, icd_libs->list[i].EnumerateInstanceExtensionProperties,
-            icd_libs->list[i].lib_name, &icd_exts);
-        loader_add_to_ext_list(inst, inst_exts, icd_exts.count, icd_exts.list);
-        loader_destroy_generic_list(inst,
-                                    (struct loader_generic_list *)&icd_exts);
+        icd_exts = &icd_libs->list[i].instance_extension_list;
+        loader_add_to_ext_list(inst, inst_exts, icd_exts->count,
+                               icd_exts->list);
     };
 
     // Traverse loader's extensions, adding non-duplicate extensions to the list
     debug_report_add_instance_extensions(inst, inst_exts);
 }
 
+/*
+ * Dispatch map
+ *
+ * Instances and devices are looked up from a dispatchable handle by value
+ * comparison of the handle's dispatch table pointer, which layers leave alone
+ * even when they wrap the handle.  Each loader_instance owns its instance
+ * dispatch table and each loader_device embeds its device dispatch table, so
+ * the pointer identifies the object uniquely.  These maps replace a walk over
+ * every instance, ICD and device with an open addressed hash table lookup.
+ */
+static uint32_t loader_dispatch_map_hash(const void *disp) {
+    // Dispatch tables are at least pointer aligned, drop the low bits
+    uint64_t bits = (uint64_t)(uintptr_t)disp >> 3;
+    return (uint32_t)((bits * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+// Returns the slot holding disp, or the empty slot where it would go
+static uint32_t
+loader_dispatch_map_slot(const struct loader_dispatch_map *map,
+                         const void *disp) {
+    uint32_t mask = map->capacity - 1;
+    uint32_t slot = loader_dispatch_map_hash(disp) & mask;
+    while (map->entries[slot].disp != NULL &&
+           map->entries[slot].disp != disp) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static bool loader_dispatch_map_insert(struct loader_dispatch_map *map,
+                                       const void *disp, void *object,
+                                       struct loader_icd *icd) {
+    struct loader_dispatch_map_entry *entry;
+
+    // Keep the load factor at or below one half
+    if ((map->count + 1) * 2 > map->capacity) {
+        struct loader_dispatch_map grown;
+        grown.count = 0;
+        grown.capacity = map->capacity ? map->capacity * 2 : 16;
+        grown.entries = loader_instance_heap_alloc(
+            NULL, grown.capacity * sizeof(*grown.entries),
+            VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (grown.entries == NULL) {
+            return false;
+        }
+        memset(grown.entries, 0, grown.capacity * sizeof(*grown.entries));
+        for (uint32_t i = 0; i < map->capacity; i++) {
+            if (map->entries[i].disp != NULL) {
+                grown.entries[loader_dispatch_map_slot(
+                    &grown, map->entries[i].disp)] = map->entries[i];
+                grown.count++;
+            }
+        }
+        loader_instance_heap_free(NULL, map->entries);
+        *map = grown;
+    }
+
+    entry = &map->entries[loader_dispatch_map_slot(map, disp)];
+    if (entry->disp == NULL) {
+        map->count++;
+    }
+    entry->disp = disp;
+    entry->object = object;
+    entry->icd = icd;
+    return true;
+}
+
+static void loader_dispatch_map_remove(struct loader_dispatch_map *map,
+                                       const void *disp) {
+    uint32_t mask, slot, next;
+
+    if (map->count == 0) {
+        return;
+    }
+    mask = map->capacity - 1;
+    slot = loader_dispatch_map_slot(map, disp);
+    if (map->entries[slot].disp == NULL) {
+        return;
+    }
+
+    // Shift later entries of the probe sequence back so no tombstone is needed
+    next = slot;
+    for (;;) {
+        uint32_t home;
+        next = (next + 1) & mask;
+        if (map->entries[next].disp == NULL) {
+            break;
+        }
+        home = loader_dispatch_map_hash(map->entries[next].disp) & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            map->entries[slot] = map->entries[next];
+            slot = next;
+        }
+    }
+    memset(&map->entries[slot], 0, sizeof(map->entries[slot]));
+    map->count--;
+
+    if (map->count == 0) {
+        loader_instance_heap_free(NULL, map->entries);
+        memset(map, 0, sizeof(*map));
+    }
+}
+
+static const struct loader_dispatch_map_entry *
+loader_dispatch_map_find(const struct loader_dispatch_map *map,
+                         const void *disp) {
+    const struct loader_dispatch_map_entry *entry;
+    if (map->count == 0 || disp == NULL) {
+        return NULL;
+    }
+    entry = &map->entries[loader_dispatch_map_slot(map, disp)];
+    return entry->disp != NULL ? entry : NULL;
+}
+
 struct loader_icd *loader_get_icd_and_device(const VkDevice device,
                                              struct loader_device **found_dev) {
+    const struct loader_dispatch_map_entry *entry;
+    struct loader_icd *icd = NULL;
+
     *found_dev = NULL;
-    for (struct loader_instance *inst = loader.instances; inst;
-         inst = inst->next) {
-        for (struct loader_icd *icd = inst->icds; icd; icd = icd->next) {
-            for (struct loader_device *dev = icd->logical_device_list; dev;
-                 dev = dev->next)
-                /* Value comparison of device prevents object wrapping by layers
-                 */
-                if (loader_get_dispatch(dev->device) ==
-                    loader_get_dispatch(device)) {
-                    *found_dev = dev;
-                    return icd;
-                }
-        }
-    }
-    return NULL;
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    /* Value comparison of device prevents object wrapping by layers */
+    entry = loader_dispatch_map_find(&loader.device_map,
+                                     loader_get_dispatch(device));
+    if (entry != NULL) {
+        *found_dev = entry->object;
+        icd = entry->icd;
+    }
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
+    return icd;
 }
 
 void loader_destroy_logical_device(const struct loader_instance *inst,
                                    struct loader_device *dev,
                                    const VkAllocationCallbacks *pAllocator) {
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    loader_dispatch_map_remove(&loader.device_map, &dev->loader_dispatch);
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
+
     if (pAllocator) {
         dev->alloc_callbacks = *pAllocator;
     }
@@ -1285,11 +1485,25 @@ loader_create_logical_device(const struct loader_instance *inst,
     return new_dev;
 }
 
-void loader_add_logical_device(const struct loader_instance *inst,
-                               struct loader_icd *icd,
-                               struct loader_device *dev) {
+VkResult loader_add_logical_device(const struct loader_instance *inst,
+                                   struct loader_icd *icd,
+                                   struct loader_device *dev) {
+    bool added;
+
+    // The device's dispatch pointer will be &dev->loader_dispatch
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    added = loader_dispatch_map_insert(&loader.device_map,
+                                       &dev->loader_dispatch, dev, icd);
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
+    if (!added) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "Failed to add device to the dispatch map");
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
     dev->next = icd->logical_device_list;
     icd->logical_device_list = dev;
+    return VK_SUCCESS;
 }
 
 void loader_remove_logical_device(const struct loader_instance *inst,
@@ -1411,6 +1625,9 @@ void loader_scanned_icd_clear(const struct loader_instance *inst,
     for (uint32_t i = 0; i < icd_libs->count; i++) {
         loader_platform_close_library(icd_libs->list[i].handle);
         loader_instance_heap_free(inst, icd_libs->list[i].lib_name);
+        loader_destroy_generic_list(
+            inst, (struct loader_generic_list *)&icd_libs->list[i]
+                      .instance_extension_list);
     }
     loader_instance_heap_free(inst, icd_libs->list);
     icd_libs->capacity = 0;
@@ -1443,10 +1660,14 @@ static void loader_scanned_icd_add(const struct loader_instance *inst,
     PFN_vkNegotiateLoaderICDInterfaceVersion fp_negotiate_icd_version;
     struct loader_scanned_icds *new_node;
     uint32_t interface_vers;
+    uint64_t trace;
+    bool negotiated;
 
     /* TODO implement smarter opening/closing of libraries. For now this
      * function leaves libraries open and the scanned_icd_clear closes them */
+    trace = loader_trace_begin();
     handle = loader_platform_open_library(filename);
+    loader_trace_end(inst, trace, "Open ICD library", filename);
     if (!handle) {
         loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                    loader_platform_open_library_error(filename));
@@ -1457,8 +1678,11 @@ static void loader_scanned_icd_add(const struct loader_instance *inst,
     fp_negotiate_icd_version = loader_platform_get_proc_address(
         handle, "vk_icdNegotiateLoaderICDInterfaceVersion");
 
-    if (!loader_get_icd_interface_version(fp_negotiate_icd_version,
-                                          &interface_vers)) {
+    trace = loader_trace_begin();
+    negotiated = loader_get_icd_interface_version(fp_negotiate_icd_version,
+                                                  &interface_vers);
+    loader_trace_end(inst, trace, "Negotiate ICD interface", filename);
+    if (!negotiated) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "ICD (%s) doesn't support interface version compatible"
                    "with loader, skip this ICD %s",
@@ -1545,6 +1769,7 @@ static void loader_scanned_icd_add(const struct loader_instance *inst,
         icd_libs->capacity *= 2;
     }
     new_node = &(icd_libs->list[icd_libs->count]);
+    memset(new_node, 0, sizeof(*new_node));
 
     new_node->handle = handle;
     new_node->api_version = api_version;
@@ -1561,6 +1786,13 @@ static void loader_scanned_icd_add(const struct loader_instance *inst,
         return;
     }
     strcpy(new_node->lib_name, filename);
+
+    // The ICD's instance extensions are needed both to build the loader's
+    // extension list and to filter the extensions each ICD is created with.
+    // Query them once here, so repeated instance creation through the scan
+    // cache doesn't call back into the ICD.
+    loader_add_instance_extensions(inst, fp_get_inst_ext_props, filename,
+                                   &new_node->instance_extension_list);
     icd_libs->count++;
 }
 
@@ -1591,38 +1823,35 @@ static bool loader_icd_init_entrys(struct loader_icd *icd, VkInstance inst,
     LOOKUP_GIPA(GetPhysicalDeviceQueueFamilyProperties, true);
     LOOKUP_GIPA(EnumerateDeviceExtensionProperties, true);
     LOOKUP_GIPA(GetPhysicalDeviceSparseImageFormatProperties, true);
-    LOOKUP_GIPA(CreateDebugReportCallbackEXT, false);
-    LOOKUP_GIPA(DestroyDebugReportCallbackEXT, false);
-    LOOKUP_GIPA(GetPhysicalDeviceSurfaceSupportKHR, false);
-    LOOKUP_GIPA(GetPhysicalDeviceSurfaceCapabilitiesKHR, false);
-    LOOKUP_GIPA(GetPhysicalDeviceSurfaceFormatsKHR, false);
-    LOOKUP_GIPA(GetPhysicalDeviceSurfacePresentModesKHR, false);
-    LOOKUP_GIPA(GetPhysicalDeviceDisplayPropertiesKHR, false);
-    LOOKUP_GIPA(GetDisplayModePropertiesKHR, false);
-    LOOKUP_GIPA(CreateDisplayPlaneSurfaceKHR, false);
-    LOOKUP_GIPA(GetPhysicalDeviceDisplayPlanePropertiesKHR, false);
-    LOOKUP_GIPA(GetDisplayPlaneSupportedDisplaysKHR, false);
-    LOOKUP_GIPA(CreateDisplayModeKHR, false);
-    LOOKUP_GIPA(GetDisplayPlaneCapabilitiesKHR, false);
-    LOOKUP_GIPA(DestroySurfaceKHR, false);
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-    LOOKUP_GIPA(GetPhysicalDeviceWin32PresentationSupportKHR, false);
-#endif
-#ifdef VK_USE_PLATFORM_XCB_KHR
-    LOOKUP_GIPA(GetPhysicalDeviceXcbPresentationSupportKHR, false);
-#endif
-#ifdef VK_USE_PLATFORM_XLIB_KHR
-    LOOKUP_GIPA(GetPhysicalDeviceXlibPresentationSupportKHR, false);
-#endif
-#ifdef VK_USE_PLATFORM_WAYLAND_KHR
-    LOOKUP_GIPA(GetPhysicalDeviceWaylandPresentationSupportKHR, false);
-#endif
 
 #undef LOOKUP_GIPA
 
+    // The optional WSI, display and debug report entrypoints are left NULL
+    // and resolved by loader_icd_get_proc on first use.  An ICD that doesn't
+    // implement them has to search its whole table to say so, and most
+    // instances never call them.
     return true;
 }
 
+/* Stored for an optional entrypoint the ICD doesn't provide, so the lookup
+ * isn't repeated on every call */
+static void VKAPI_CALL loader_icd_missing_proc(void) {}
+
+PFN_vkVoidFunction loader_icd_get_proc(struct loader_icd *icd,
+                                       PFN_vkVoidFunction *slot,
+                                       const char *name) {
+    PFN_vkVoidFunction proc = *slot;
+    if (proc == NULL) {
+        // Threads racing here all store the same value
+        proc = icd->this_icd_lib->GetInstanceProcAddr(icd->instance, name);
+        if (proc == NULL) {
+            proc = loader_icd_missing_proc;
+        }
+        *slot = proc;
+    }
+    return proc == loader_icd_missing_proc ? NULL : proc;
+}
+
 static void loader_debug_init(void) {
     char *env, *orig;
 
@@ -1678,16 +1907,12 @@ void loader_initialize(void) {
     // initialize mutexs
     loader_platform_thread_create_mutex(&loader_lock);
     loader_platform_thread_create_mutex(&loader_json_lock);
+    loader_platform_thread_create_mutex(&loader_dispatch_map_lock);
+    loader_platform_thread_create_mutex(&loader_trace_lock);
 
     // initialize logging
     loader_debug_init();
-
-    // initial cJSON to use alloc callbacks
-    cJSON_Hooks alloc_fns = {
-        .malloc_fn = loader_instance_tls_heap_alloc,
-        .free_fn = loader_instance_tls_heap_free,
-    };
-    cJSON_InitHooks(&alloc_fns);
+    loader_trace_init();
 }
 
 struct loader_manifest_files {
@@ -1770,49 +1995,138 @@ static void loader_get_fullpath(const char *file, const char *dirs,
 }
 
 /**
- * Read a JSON file into a buffer.
+ * The contents of a manifest file, read for parsing.
+ */
+struct loader_manifest {
+    const struct loader_instance *inst;
+    const char *filename;
+    uint64_t trace;
+    char *data;
+    size_t size;
+};
+
+/**
+ * Read a JSON manifest file and start a reader at its beginning.  Manifests
+ * are parsed in place with the streaming reader in json_stream.h rather than
+ * turned into a cJSON tree, since the loader only wants a handful of fields
+ * from each.
  *
  * \returns
- * A pointer to a cJSON object representing the JSON parse tree.
- * This returned buffer should be freed by caller.
+ * false if the file could not be read.  Otherwise the manifest must be
+ * released with loader_close_manifest.
  */
-static cJSON *loader_get_json(const struct loader_instance *inst,
-                              const char *filename) {
+static bool loader_open_manifest(const struct loader_instance *inst,
+                                 const char *filename,
+                                 struct loader_manifest *manifest,
+                                 struct loader_json *json) {
     FILE *file;
-    char *json_buf;
-    cJSON *json;
-    size_t len;
+    long len;
+
+    manifest->inst = inst;
+    manifest->filename = filename;
+    manifest->trace = loader_trace_begin();
     file = fopen(filename, "rb");
     if (!file) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "Couldn't open JSON file %s", filename);
-        return NULL;
+        return false;
     }
     fseek(file, 0, SEEK_END);
     len = ftell(file);
     fseek(file, 0, SEEK_SET);
-    json_buf = (char *)loader_stack_alloc(len + 1);
-    if (json_buf == NULL) {
+    if (len < 0) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "Couldn't read JSON file %s", filename);
+        fclose(file);
+        return false;
+    }
+    manifest->size = (size_t)len;
+    manifest->data = loader_instance_heap_alloc(
+        inst, manifest->size + 1, VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+    if (manifest->data == NULL) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "Out of memory can't get JSON file");
         fclose(file);
-        return NULL;
+        return false;
     }
-    if (fread(json_buf, sizeof(char), len, file) != len) {
+    if (fread(manifest->data, sizeof(char), manifest->size, file) !=
+        manifest->size) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    "fread failed can't get JSON file");
+        loader_instance_heap_free(inst, manifest->data);
         fclose(file);
-        return NULL;
+        return false;
     }
     fclose(file);
-    json_buf[len] = '\0';
+    loader_json_init(json, manifest->data, manifest->size);
+    return true;
+}
 
-    // parse text from file
-    json = cJSON_Parse(json_buf);
-    if (json == NULL)
-        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                   "Can't parse JSON file %s", filename);
-    return json;
+static void loader_close_manifest(struct loader_manifest *manifest) {
+    loader_instance_heap_free(manifest->inst, manifest->data);
+    loader_trace_end(manifest->inst, manifest->trace, "Read manifest",
+                     manifest->filename);
+}
+
+/**
+ * Copy a string or number from a manifest into buf, which holds size bytes.
+ * Manifests are untrusted, so a value too long for buf is rejected with a
+ * warning rather than truncated or copied to an unbounded buffer.
+ *
+ * \returns
+ * buf, or NULL if the value is missing, an object or array, or too long
+ */
+static char *loader_json_copy_field(const struct loader_instance *inst,
+                                    const struct loader_json_value *value,
+                                    char *buf, size_t size, const char *field) {
+    if (!loader_json_copy(value, buf, size))
+        return NULL;
+    // Decoding never lengthens a string, so only a long raw value can have
+    // been cut short
+    if (value->length >= size && strlen(buf) + 1 >= size) {
+        loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                   "Manifest value %s is longer than %d characters, "
+                   "ignoring it",
+                   field, (int)size - 1);
+        return NULL;
+    }
+    return buf;
+}
+
+/**
+ * Read a member value that should be a string or number into slot.  Only the
+ * first member with a given key is kept, matching the cJSON_GetObjectItem
+ * lookups this replaces; objects and arrays are skipped and recorded by type
+ * only, so they read back as missing.
+ */
+static bool loader_json_read_field(struct loader_json *json,
+                                   struct loader_json_value *slot) {
+    struct loader_json_value value;
+    enum loader_json_type type = loader_json_peek(json);
+    if (type == LOADER_JSON_OBJECT || type == LOADER_JSON_ARRAY) {
+        if (!loader_json_skip(json))
+            return false;
+        memset(&value, 0, sizeof(value));
+        value.type = type;
+    } else if (!loader_json_read(json, &value)) {
+        return false;
+    }
+    if (slot->type == LOADER_JSON_NONE)
+        *slot = value;
+    return true;
+}
+
+/**
+ * Remember where a member value starts so it can be read after the rest of
+ * its object, then skip it.
+ */
+static bool loader_json_mark_field(struct loader_json *json, bool *found,
+                                   struct loader_json *mark) {
+    if (!*found) {
+        *found = true;
+        *mark = *json;
+    }
+    return loader_json_skip(json);
 }
 
 /**
@@ -2055,15 +2369,330 @@ static void loader_add_layer_property_meta(
 
 }
 
-static void loader_read_json_layer(
-    const struct loader_instance *inst,
-    struct loader_layer_list *layer_instance_list, cJSON *layer_node,
-    cJSON *item, cJSON *disable_environment, bool is_implicit, char *filename) {
-    char *temp;
-    char *name, *type, *library_path, *api_version;
-    char *implementation_version, *description;
-    cJSON *ext_item;
+/**
+ * An environment variable named by a manifest, such as a layer's
+ * disable_environment: the first member of an object.
+ */
+struct loader_json_env {
+    bool found;
+    struct loader_json_value name;
+    struct loader_json_value value;
+};
+
+/**
+ * The fields of a "layer" object in a manifest, as slices of the file.  The
+ * extension arrays are only marked; they are read once the layer has been
+ * accepted.
+ */
+struct loader_json_layer {
+    struct loader_json_value name;
+    struct loader_json_value type;
+    struct loader_json_value library_path;
+    struct loader_json_value api_version;
+    struct loader_json_value implementation_version;
+    struct loader_json_value description;
+    struct loader_json_env disable_environment;
+    struct loader_json_env enable_environment;
+    bool has_functions;
+    struct loader_json_value vkGetInstanceProcAddr;
+    struct loader_json_value vkGetDeviceProcAddr;
+    bool has_instance_extensions;
+    struct loader_json instance_extensions;
+    bool has_device_extensions;
+    struct loader_json device_extensions;
+};
+
+/**
+ * The fields of an instance_extensions or device_extensions entry.
+ */
+struct loader_json_extension {
+    struct loader_json_value name;
+    struct loader_json_value spec_version;
+    bool has_entrypoints;
+    struct loader_json entrypoints;
+};
+
+static bool loader_json_read_env(struct loader_json *json,
+                                 struct loader_json_env *env) {
+    struct loader_json_value value, key;
+    uint32_t index = 0;
+
+    if (env->found || loader_json_peek(json) != LOADER_JSON_OBJECT)
+        return loader_json_skip(json);
+    env->found = true;
+    loader_json_read(json, &value);
+    while (loader_json_next_member(json, &index, &key)) {
+        if (index == 1) {
+            env->name = key;
+            if (!loader_json_read_field(json, &env->value))
+                return false;
+        } else if (!loader_json_skip(json)) {
+            return false;
+        }
+    }
+    return !json->error;
+}
+
+static bool loader_json_read_functions(struct loader_json *json,
+                                       struct loader_json_layer *layer) {
+    struct loader_json_value value, key;
+    uint32_t index = 0;
+    bool ok;
+
+    if (layer->has_functions || loader_json_peek(json) != LOADER_JSON_OBJECT)
+        return loader_json_skip(json);
+    layer->has_functions = true;
+    loader_json_read(json, &value);
+    while (loader_json_next_member(json, &index, &key)) {
+        if (loader_json_key_is(&key, "vkGetInstanceProcAddr"))
+            ok = loader_json_read_field(json, &layer->vkGetInstanceProcAddr);
+        else if (loader_json_key_is(&key, "vkGetDeviceProcAddr"))
+            ok = loader_json_read_field(json, &layer->vkGetDeviceProcAddr);
+        else
+            ok = loader_json_skip(json);
+        if (!ok)
+            return false;
+    }
+    return !json->error;
+}
+
+/**
+ * Read one layer object.  Anything that isn't an object is skipped and reads
+ * as a layer with no fields.
+ */
+static bool loader_json_read_layer(struct loader_json *json,
+                                   struct loader_json_layer *layer) {
+    struct loader_json_value value, key;
+    uint32_t index = 0;
+    bool ok;
+
+    memset(layer, 0, sizeof(*layer));
+    if (loader_json_peek(json) != LOADER_JSON_OBJECT)
+        return loader_json_skip(json);
+    loader_json_read(json, &value);
+    while (loader_json_next_member(json, &index, &key)) {
+        if (loader_json_key_is(&key, "name"))
+            ok = loader_json_read_field(json, &layer->name);
+        else if (loader_json_key_is(&key, "type"))
+            ok = loader_json_read_field(json, &layer->type);
+        else if (loader_json_key_is(&key, "library_path"))
+            ok = loader_json_read_field(json, &layer->library_path);
+        else if (loader_json_key_is(&key, "api_version"))
+            ok = loader_json_read_field(json, &layer->api_version);
+        else if (loader_json_key_is(&key, "implementation_version"))
+            ok = loader_json_read_field(json, &layer->implementation_version);
+        else if (loader_json_key_is(&key, "description"))
+            ok = loader_json_read_field(json, &layer->description);
+        else if (loader_json_key_is(&key, "disable_environment"))
+            ok = loader_json_read_env(json, &layer->disable_environment);
+        else if (loader_json_key_is(&key, "enable_environment"))
+            ok = loader_json_read_env(json, &layer->enable_environment);
+        else if (loader_json_key_is(&key, "functions"))
+            ok = loader_json_read_functions(json, layer);
+        else if (loader_json_key_is(&key, "instance_extensions"))
+            ok = loader_json_mark_field(json, &layer->has_instance_extensions,
+                                        &layer->instance_extensions);
+        else if (loader_json_key_is(&key, "device_extensions"))
+            ok = loader_json_mark_field(json, &layer->has_device_extensions,
+                                        &layer->device_extensions);
+        else
+            ok = loader_json_skip(json);
+        if (!ok)
+            return false;
+    }
+    return !json->error;
+}
+
+static bool loader_json_read_extension(struct loader_json *json,
+                                       struct loader_json_extension *ext) {
+    struct loader_json_value value, key;
+    uint32_t index = 0;
+    bool ok;
+
+    memset(ext, 0, sizeof(*ext));
+    if (loader_json_peek(json) != LOADER_JSON_OBJECT)
+        return loader_json_skip(json);
+    loader_json_read(json, &value);
+    while (loader_json_next_member(json, &index, &key)) {
+        if (loader_json_key_is(&key, "name"))
+            ok = loader_json_read_field(json, &ext->name);
+        else if (loader_json_key_is(&key, "spec_version"))
+            ok = loader_json_read_field(json, &ext->spec_version);
+        else if (loader_json_key_is(&key, "entrypoints"))
+            ok = loader_json_mark_field(json, &ext->has_entrypoints,
+                                        &ext->entrypoints);
+        else
+            ok = loader_json_skip(json);
+        if (!ok)
+            return false;
+    }
+    return !json->error;
+}
+
+/**
+ * Fill in ext_prop from an extension entry, or return false if the entry has
+ * no name.
+ */
+static bool loader_json_extension_props(const struct loader_instance *inst,
+                                        const struct loader_json_extension *ext,
+                                        const char *filename,
+                                        VkExtensionProperties *ext_prop) {
+    char spec_version[32];
+
+    memset(ext_prop, 0, sizeof(*ext_prop));
+    if (!loader_json_copy(&ext->name, ext_prop->extensionName,
+                          sizeof(ext_prop->extensionName))) {
+        loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                   "Didn't find name of an extension in manifest JSON file "
+                   "%s, skipping this extension",
+                   filename);
+        return false;
+    }
+    loader_json_copy(&ext->spec_version, spec_version, sizeof(spec_version));
+    ext_prop->specVersion = atoi(spec_version);
+    return true;
+}
+
+/**
+ * instance_extensions
+ * array of
+ *     name
+ *     spec_version
+ */
+static void
+loader_read_json_instance_extensions(const struct loader_instance *inst,
+                                     struct loader_json *json,
+                                     struct loader_layer_properties *props,
+                                     const char *filename) {
+    struct loader_json_value value;
+    struct loader_json_extension ext;
+    VkExtensionProperties ext_prop;
+    uint32_t index = 0;
+
+    if (loader_json_peek(json) != LOADER_JSON_ARRAY)
+        return;
+    loader_json_read(json, &value);
+    while (loader_json_next_element(json, &index)) {
+        if (!loader_json_read_extension(json, &ext))
+            return;
+        if (!loader_json_extension_props(inst, &ext, filename, &ext_prop))
+            continue;
+        if (!wsi_unsupported_instance_extension(&ext_prop)) {
+            loader_add_to_ext_list(inst, &props->instance_extension_list, 1,
+                                   &ext_prop);
+        }
+    }
+}
+
+/**
+ * device_extensions
+ * array of
+ *     name
+ *     spec_version
+ *     entrypoints
+ */
+static void
+loader_read_json_device_extensions(const struct loader_instance *inst,
+                                   struct loader_json *json,
+                                   struct loader_layer_properties *props,
+                                   const char *filename) {
+    struct loader_json_value value;
+    struct loader_json_extension ext;
     VkExtensionProperties ext_prop;
+    uint32_t index = 0;
+
+    if (loader_json_peek(json) != LOADER_JSON_ARRAY)
+        return;
+    loader_json_read(json, &value);
+    while (loader_json_next_element(json, &index)) {
+        struct loader_json entries;
+        uint32_t entry_index, entry_count = 0;
+        size_t entry_bytes;
+        char **entry_array = NULL;
+
+        if (!loader_json_read_extension(json, &ext))
+            return;
+        if (!loader_json_extension_props(inst, &ext, filename, &ext_prop))
+            continue;
+        if (!ext.has_entrypoints ||
+            loader_json_peek(&ext.entrypoints) != LOADER_JSON_ARRAY) {
+            loader_add_to_dev_ext_list(inst, &props->device_extension_list,
+                                       &ext_prop, 0, NULL);
+            continue;
+        }
+
+        // Count and size the entrypoint names, then copy them into one heap
+        // block, as a manifest can list any number of them;
+        // loader_add_to_dev_ext_list makes its own copies.  Decoding never
+        // lengthens a string, so the raw lengths are enough.
+        entries = ext.entrypoints;
+        entry_index = 0;
+        entry_bytes = 0;
+        loader_json_read(&entries, &value);
+        while (loader_json_next_element(&entries, &entry_index)) {
+            if (loader_json_peek(&entries) == LOADER_JSON_STRING) {
+                loader_json_read(&entries, &value);
+                entry_count++;
+                entry_bytes += value.length + 1;
+            } else {
+                loader_json_skip(&entries);
+            }
+        }
+        if (entry_count) {
+            entry_array = (char **)loader_instance_heap_alloc(
+                inst, sizeof(char *) * entry_count + entry_bytes,
+                VK_SYSTEM_ALLOCATION_SCOPE_COMMAND);
+            if (entry_array == NULL) {
+                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                           "Out of memory reading the entrypoints of device "
+                           "extension %s in %s, skipping them",
+                           ext_prop.extensionName, filename);
+                entry_count = 0;
+            }
+        }
+        if (entry_count) {
+            char *entry_name = (char *)(entry_array + entry_count);
+            entry_count = 0;
+            entries = ext.entrypoints;
+            entry_index = 0;
+            loader_json_read(&entries, &value);
+            while (loader_json_next_element(&entries, &entry_index)) {
+                if (loader_json_peek(&entries) != LOADER_JSON_STRING) {
+                    loader_json_skip(&entries);
+                    continue;
+                }
+                loader_json_read(&entries, &value);
+                loader_json_copy(&value, entry_name, value.length + 1);
+                entry_array[entry_count++] = entry_name;
+                entry_name += value.length + 1;
+            }
+        }
+        loader_add_to_dev_ext_list(inst, &props->device_extension_list,
+                                   &ext_prop, entry_count, entry_array);
+        loader_instance_heap_free(inst, entry_array);
+    }
+}
+
+/**
+ * Read the layer object at json into a new entry of layer_instance_list,
+ * leaving json after the object.
+ *
+ * \returns
+ * false if the manifest is malformed
+ */
+static bool
+loader_read_json_layer(const struct loader_instance *inst,
+                       struct loader_layer_list *layer_instance_list,
+                       struct loader_json *json, bool is_implicit,
+                       const char *filename) {
+    struct loader_json_layer layer;
+    char name[MAX_STRING_SIZE], type[MAX_STRING_SIZE];
+    char library_path[MAX_STRING_SIZE], api_version[MAX_STRING_SIZE];
+    char implementation_version[MAX_STRING_SIZE];
+    char description[MAX_STRING_SIZE];
+
+    if (!loader_json_read_layer(json, &layer))
+        return false;
 
 /*
  * The following are required in the "layer" object:
@@ -2075,83 +2704,64 @@ static void loader_read_json_layer(
  * (required) “description”
  * (required for implicit layers) “disable_environment”
  */
-
-#define GET_JSON_OBJECT(node, var)                                             \
-    {                                                                          \
-        var = cJSON_GetObjectItem(node, #var);                                 \
-        if (var == NULL) {                                                     \
-            layer_node = layer_node->next;                                     \
-            loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,               \
-                       "Didn't find required layer object %s in manifest "     \
-                       "JSON file, skipping this layer",                       \
-                       #var);                                                  \
-            return;                                                            \
-        }                                                                      \
-    }
-#define GET_JSON_ITEM(node, var)                                               \
+#define GET_JSON_ITEM(var)                                                     \
     {                                                                          \
-        item = cJSON_GetObjectItem(node, #var);                                \
-        if (item == NULL) {                                                    \
-            layer_node = layer_node->next;                                     \
+        if (!loader_json_copy_field(inst, &layer.var, var, sizeof(var),        \
+                                    #var)) {                                   \
             loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,               \
                        "Didn't find required layer value %s in manifest JSON " \
                        "file, skipping this layer",                            \
                        #var);                                                  \
-            return;                                                            \
+            return true;                                                       \
         }                                                                      \
-        temp = cJSON_Print(item);                                              \
-        if (temp == NULL) {                                                    \
-            layer_node = layer_node->next;                                     \
-            loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,               \
-                       "Problem accessing layer value %s in manifest JSON "    \
-                       "file, skipping this layer",                            \
-                       #var);                                                  \
-            return;                                                            \
-        }                                                                      \
-        temp[strlen(temp) - 1] = '\0';                                         \
-        var = loader_stack_alloc(strlen(temp) + 1);                            \
-        strcpy(var, &temp[1]);                                                 \
-        cJSON_Free(temp);                                                      \
-    }
-    GET_JSON_ITEM(layer_node, name)
-    GET_JSON_ITEM(layer_node, type)
-    GET_JSON_ITEM(layer_node, library_path)
-    GET_JSON_ITEM(layer_node, api_version)
-    GET_JSON_ITEM(layer_node, implementation_version)
-    GET_JSON_ITEM(layer_node, description)
-    if (is_implicit) {
-        GET_JSON_OBJECT(layer_node, disable_environment)
     }
+    GET_JSON_ITEM(name)
+    GET_JSON_ITEM(type)
+    GET_JSON_ITEM(library_path)
+    GET_JSON_ITEM(api_version)
+    GET_JSON_ITEM(implementation_version)
+    GET_JSON_ITEM(description)
 #undef GET_JSON_ITEM
-#undef GET_JSON_OBJECT
+    if (is_implicit) {
+        if (!layer.disable_environment.found) {
+            loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                       "Didn't find required layer object disable_environment "
+                       "in manifest JSON file, skipping this layer");
+            return true;
+        }
+        if (layer.disable_environment.name.type == LOADER_JSON_NONE) {
+            loader_log(
+                inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                "Didn't find required layer child value disable_environment"
+                "in manifest JSON file, skipping this layer");
+            return true;
+        }
+    }
 
     // add list entry
     struct loader_layer_properties *props = NULL;
     if (!strcmp(type, "DEVICE")) {
         loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                    "Device layers are deprecated skipping this layer");
-        layer_node = layer_node->next;
-        return;
+        return true;
     }
     // Allow either GLOBAL or INSTANCE type interchangeably to handle
     // layers that must work with older loaders
     if (!strcmp(type, "INSTANCE") || !strcmp(type, "GLOBAL")) {
         if (layer_instance_list == NULL) {
-            layer_node = layer_node->next;
-            return;
+            return true;
         }
         props = loader_get_next_layer_property(inst, layer_instance_list);
         if (NULL == props) {
             // Error already triggered in loader_get_next_layer_property.
-            return;
+            return true;
         }
         props->type = (is_implicit) ? VK_LAYER_TYPE_INSTANCE_IMPLICIT
                                     : VK_LAYER_TYPE_INSTANCE_EXPLICIT;
     }
 
     if (props == NULL) {
-        layer_node = layer_node->next;
-        return;
+        return true;
     }
 
     strncpy(props->info.layerName, name, sizeof(props->info.layerName));
@@ -2176,191 +2786,92 @@ static void loader_read_json_layer(
             sizeof(props->info.description));
     props->info.description[sizeof(props->info.description) - 1] = '\0';
     if (is_implicit) {
-        if (!disable_environment || !disable_environment->child) {
-            loader_log(
-                inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
-                "Didn't find required layer child value disable_environment"
-                "in manifest JSON file, skipping this layer");
-            layer_node = layer_node->next;
-            return;
-        }
-        strncpy(props->disable_env_var.name, disable_environment->child->string,
-                sizeof(props->disable_env_var.name));
-        props->disable_env_var.name[sizeof(props->disable_env_var.name) - 1] =
-            '\0';
-        strncpy(props->disable_env_var.value,
-                disable_environment->child->valuestring,
-                sizeof(props->disable_env_var.value));
-        props->disable_env_var.value[sizeof(props->disable_env_var.value) - 1] =
-            '\0';
+        loader_json_copy(&layer.disable_environment.name,
+                         props->disable_env_var.name,
+                         sizeof(props->disable_env_var.name));
+        loader_json_copy(&layer.disable_environment.value,
+                         props->disable_env_var.value,
+                         sizeof(props->disable_env_var.value));
     }
 
-/**
-* Now get all optional items and objects and put in list:
-* functions
-* instance_extensions
-* device_extensions
-* enable_environment (implicit layers only)
-*/
-#define GET_JSON_OBJECT(node, var)                                             \
-    { var = cJSON_GetObjectItem(node, #var); }
-#define GET_JSON_ITEM(node, var)                                               \
-    {                                                                          \
-        item = cJSON_GetObjectItem(node, #var);                                \
-        if (item != NULL) {                                                    \
-            temp = cJSON_Print(item);                                          \
-            if (temp != NULL) {                                                \
-                temp[strlen(temp) - 1] = '\0';                                 \
-                var = loader_stack_alloc(strlen(temp) + 1);                    \
-                strcpy(var, &temp[1]);                                         \
-                cJSON_Free(temp);                                              \
-            }                                                                  \
-        }                                                                      \
-    }
-
-    cJSON *instance_extensions, *device_extensions, *functions,
-        *enable_environment;
-    cJSON *entrypoints;
-    char *vkGetInstanceProcAddr, *vkGetDeviceProcAddr, *spec_version;
-    char **entry_array;
-    vkGetInstanceProcAddr = NULL;
-    vkGetDeviceProcAddr = NULL;
-    spec_version = NULL;
-    entrypoints = NULL;
-    entry_array = NULL;
-    int i, j;
-
     /**
+    * Now get all optional items and objects and put in list:
     * functions
     *     vkGetInstanceProcAddr
     *     vkGetDeviceProcAddr
-    */
-    GET_JSON_OBJECT(layer_node, functions)
-    if (functions != NULL) {
-        GET_JSON_ITEM(functions, vkGetInstanceProcAddr)
-        GET_JSON_ITEM(functions, vkGetDeviceProcAddr)
-        if (vkGetInstanceProcAddr != NULL)
-            strncpy(props->functions.str_gipa, vkGetInstanceProcAddr,
-                    sizeof(props->functions.str_gipa));
-        props->functions.str_gipa[sizeof(props->functions.str_gipa) - 1] = '\0';
-        if (vkGetDeviceProcAddr != NULL)
-            strncpy(props->functions.str_gdpa, vkGetDeviceProcAddr,
-                    sizeof(props->functions.str_gdpa));
-        props->functions.str_gdpa[sizeof(props->functions.str_gdpa) - 1] = '\0';
-    }
-    /**
     * instance_extensions
-    * array of
-    *     name
-    *     spec_version
-    */
-    GET_JSON_OBJECT(layer_node, instance_extensions)
-    if (instance_extensions != NULL) {
-        int count = cJSON_GetArraySize(instance_extensions);
-        for (i = 0; i < count; i++) {
-            ext_item = cJSON_GetArrayItem(instance_extensions, i);
-            GET_JSON_ITEM(ext_item, name)
-            if (name != NULL) {
-                strncpy(ext_prop.extensionName, name,
-                        sizeof(ext_prop.extensionName));
-                ext_prop.extensionName[sizeof(ext_prop.extensionName) - 1] =
-                    '\0';
-            }
-            GET_JSON_ITEM(ext_item, spec_version)
-            if (NULL != spec_version) {
-                ext_prop.specVersion = atoi(spec_version);
-            } else {
-                ext_prop.specVersion = 0;
-            }
-            bool ext_unsupported =
-                wsi_unsupported_instance_extension(&ext_prop);
-            if (!ext_unsupported) {
-                loader_add_to_ext_list(inst, &props->instance_extension_list, 1,
-                                       &ext_prop);
-            }
-        }
-    }
-    /**
     * device_extensions
-    * array of
-    *     name
-    *     spec_version
-    *     entrypoints
+    * enable_environment (implicit layers only)
     */
-    GET_JSON_OBJECT(layer_node, device_extensions)
-    if (device_extensions != NULL) {
-        int count = cJSON_GetArraySize(device_extensions);
-        for (i = 0; i < count; i++) {
-            ext_item = cJSON_GetArrayItem(device_extensions, i);
-            GET_JSON_ITEM(ext_item, name)
-            GET_JSON_ITEM(ext_item, spec_version)
-            if (name != NULL) {
-                strncpy(ext_prop.extensionName, name,
-                        sizeof(ext_prop.extensionName));
-                ext_prop.extensionName[sizeof(ext_prop.extensionName) - 1] =
-                    '\0';
-            }
-            if (NULL != spec_version) {
-                ext_prop.specVersion = atoi(spec_version);
-            } else {
-                ext_prop.specVersion = 0;
-            }
-            // entrypoints = cJSON_GetObjectItem(ext_item, "entrypoints");
-            GET_JSON_OBJECT(ext_item, entrypoints)
-            int entry_count;
-            if (entrypoints == NULL) {
-                loader_add_to_dev_ext_list(inst, &props->device_extension_list,
-                                           &ext_prop, 0, NULL);
-                continue;
-            }
-            entry_count = cJSON_GetArraySize(entrypoints);
-            if (entry_count) {
-                entry_array =
-                    (char **)loader_stack_alloc(sizeof(char *) * entry_count);
-            }
-            for (j = 0; j < entry_count; j++) {
-                ext_item = cJSON_GetArrayItem(entrypoints, j);
-                if (ext_item != NULL) {
-                    temp = cJSON_Print(ext_item);
-                    if (NULL == temp) {
-                        entry_array[j] = NULL;
-                        continue;
-                    }
-                    temp[strlen(temp) - 1] = '\0';
-                    entry_array[j] = loader_stack_alloc(strlen(temp) + 1);
-                    strcpy(entry_array[j], &temp[1]);
-                    cJSON_Free(temp);
-                }
-            }
-            loader_add_to_dev_ext_list(inst, &props->device_extension_list,
-                                       &ext_prop, entry_count, entry_array);
-        }
+    if (layer.has_functions) {
+        loader_json_copy(&layer.vkGetInstanceProcAddr,
+                         props->functions.str_gipa,
+                         sizeof(props->functions.str_gipa));
+        loader_json_copy(&layer.vkGetDeviceProcAddr, props->functions.str_gdpa,
+                         sizeof(props->functions.str_gdpa));
+    }
+    if (layer.has_instance_extensions) {
+        loader_read_json_instance_extensions(inst, &layer.instance_extensions,
+                                             props, filename);
+    }
+    if (layer.has_device_extensions) {
+        loader_read_json_device_extensions(inst, &layer.device_extensions,
+                                           props, filename);
+    }
+    // enable_environment is optional
+    if (is_implicit && layer.enable_environment.name.type != LOADER_JSON_NONE) {
+        loader_json_copy(&layer.enable_environment.name,
+                         props->enable_env_var.name,
+                         sizeof(props->enable_env_var.name));
+        loader_json_copy(&layer.enable_environment.value,
+                         props->enable_env_var.value,
+                         sizeof(props->enable_env_var.value));
     }
-    if (is_implicit) {
-        GET_JSON_OBJECT(layer_node, enable_environment)
-
-        // enable_environment is optional
-        if (enable_environment) {
-            strncpy(props->enable_env_var.name,
-                    enable_environment->child->string,
-                    sizeof(props->enable_env_var.name));
-            props->enable_env_var.name[sizeof(props->enable_env_var.name) - 1] =
-                '\0';
-            strncpy(props->enable_env_var.value,
-                    enable_environment->child->valuestring,
-                    sizeof(props->enable_env_var.value));
-            props->enable_env_var
-                .value[sizeof(props->enable_env_var.value) - 1] = '\0';
+    return true;
+}
+
+/**
+ * Copy a manifest's file_format_version into file_vers, log it, and split it
+ * into major, minor and patch numbers.
+ */
+static void loader_read_json_file_version(const struct loader_instance *inst,
+                                          const struct loader_json_value *item,
+                                          const char *filename, char *file_vers,
+                                          size_t file_vers_size,
+                                          uint16_t *major, uint16_t *minor,
+                                          uint16_t *patch) {
+    char *vers_copy, *vers_tok;
+
+    loader_json_copy(item, file_vers, file_vers_size);
+    loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
+               "Found manifest file %s, version %s", filename, file_vers);
+    // Get the major/minor/and patch as integers for easier comparison
+    *major = *minor = *patch = 0;
+    vers_copy = loader_stack_alloc(strlen(file_vers) + 1);
+    strcpy(vers_copy, file_vers);
+    vers_tok = strtok(vers_copy, ".\"\n\r");
+    if (NULL != vers_tok) {
+        *major = (uint16_t)atoi(vers_tok);
+        vers_tok = strtok(NULL, ".\"\n\r");
+        if (NULL != vers_tok) {
+            *minor = (uint16_t)atoi(vers_tok);
+            vers_tok = strtok(NULL, ".\"\n\r");
+            if (NULL != vers_tok) {
+                *patch = (uint16_t)atoi(vers_tok);
+            }
         }
     }
-#undef GET_JSON_ITEM
-#undef GET_JSON_OBJECT
 }
 
 /**
- * Given a cJSON struct (json) of the top level JSON object from layer manifest
- * file, add entry to the layer_list. Fill out the layer_properties in this list
- * entry from the input cJSON object.
+ * Given a reader (json) at the start of a layer manifest file, add entries to
+ * the layer_list.  Fill out the layer_properties in each list entry from the
+ * manifest's layer objects.
+ *
+ * The manifest is read in two passes over the mapped file.  The first checks
+ * that the whole file parses and finds the top-level fields, so nothing is
+ * added from a file that turns out to be malformed; the second reads each
+ * layer object straight into its list entry.
  *
  * \returns
  * void
@@ -2371,7 +2882,8 @@ static void loader_read_json_layer(
 static void
 loader_add_layer_properties(const struct loader_instance *inst,
                             struct loader_layer_list *layer_instance_list,
-                            cJSON *json, bool is_implicit, char *filename) {
+                            struct loader_json *json, bool is_implicit,
+                            const char *filename) {
     /* Fields in layer manifest file that are required:
      * (required) “file_format_version”
      *
@@ -2381,46 +2893,56 @@ loader_add_layer_properties(const struct loader_instance *inst,
      * First get all required items and if any missing abort
      */
 
-    cJSON *item, *layers_node, *layer_node;
+    struct loader_json start = *json;
+    struct loader_json layers_node;
+    struct loader_json_value value, key, item;
+    uint32_t index = 0;
+    bool has_layers = false;
+    uint16_t layer_count = 0;
     uint16_t file_major_vers = 0;
     uint16_t file_minor_vers = 0;
     uint16_t file_patch_vers = 0;
-    char *vers_tok;
-    cJSON *disable_environment = NULL;
-    item = cJSON_GetObjectItem(json, "file_format_version");
-    if (item == NULL) {
-        return;
+    char file_vers[64];
+
+    memset(&item, 0, sizeof(item));
+    if (loader_json_peek(json) == LOADER_JSON_OBJECT) {
+        loader_json_read(json, &value);
+        while (loader_json_next_member(json, &index, &key)) {
+            bool ok;
+            if (loader_json_key_is(&key, "file_format_version")) {
+                ok = loader_json_read_field(json, &item);
+            } else if (loader_json_key_is(&key, "layers")) {
+                ok = loader_json_mark_field(json, &has_layers, &layers_node);
+            } else {
+                if (loader_json_key_is(&key, "layer"))
+                    layer_count++;
+                ok = loader_json_skip(json);
+            }
+            if (!ok)
+                break;
+        }
+    } else {
+        loader_json_skip(json);
     }
-    char *file_vers = cJSON_PrintUnformatted(item);
-    if (NULL == file_vers) {
+    if (json->error) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "Can't parse JSON file %s", filename);
         return;
     }
-    loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
-               "Found manifest file %s, version %s", filename, file_vers);
-    // Get the major/minor/and patch as integers for easier comparison
-    vers_tok = strtok(file_vers, ".\"\n\r");
-    if (NULL != vers_tok) {
-        file_major_vers = (uint16_t)atoi(vers_tok);
-        vers_tok = strtok(NULL, ".\"\n\r");
-        if (NULL != vers_tok) {
-            file_minor_vers = (uint16_t)atoi(vers_tok);
-            vers_tok = strtok(NULL, ".\"\n\r");
-            if (NULL != vers_tok) {
-                file_patch_vers = (uint16_t)atoi(vers_tok);
-            }
-        }
+    if (item.type == LOADER_JSON_NONE) {
+        return;
     }
+    loader_read_json_file_version(inst, &item, filename, file_vers,
+                                  sizeof(file_vers), &file_major_vers,
+                                  &file_minor_vers, &file_patch_vers);
     if (file_major_vers != 1 || file_minor_vers != 0 || file_patch_vers > 1) {
         loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                    "%s Unexpected manifest file version (expected 1.0.0 or "
                    "1.0.1), may cause errors",
                    filename);
     }
-    cJSON_Free(file_vers);
     // If "layers" is present, read in the array of layer objects
-    layers_node = cJSON_GetObjectItem(json, "layers");
-    if (layers_node != NULL) {
-        int numItems = cJSON_GetArraySize(layers_node);
+    if (has_layers) {
         if (file_major_vers == 1 && file_minor_vers == 0 &&
             file_patch_vers == 0) {
             loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
@@ -2428,36 +2950,29 @@ loader_add_layer_properties(const struct loader_instance *inst,
                        "1.0.1, but %s is reporting version %s",
                        filename, file_vers);
         }
-        for (int curLayer = 0; curLayer < numItems; curLayer++) {
-            layer_node = cJSON_GetArrayItem(layers_node, curLayer);
-            if (layer_node == NULL) {
-                loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
-                           "Can't find \"layers\" array element %d object in "
-                           "manifest JSON file %s, skipping this file",
-                           curLayer, filename);
+        if (loader_json_peek(&layers_node) != LOADER_JSON_ARRAY) {
+            loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                       "Can't find \"layers\" array in manifest JSON file %s, "
+                       "skipping this file",
+                       filename);
+            return;
+        }
+        loader_json_read(&layers_node, &value);
+        index = 0;
+        while (loader_json_next_element(&layers_node, &index)) {
+            if (!loader_read_json_layer(inst, layer_instance_list, &layers_node,
+                                        is_implicit, filename))
                 return;
-            }
-            loader_read_json_layer(inst, layer_instance_list, layer_node, item,
-                                   disable_environment, is_implicit, filename);
         }
     } else {
         // Otherwise, try to read in individual layers
-        layer_node = cJSON_GetObjectItem(json, "layer");
-        if (layer_node == NULL) {
+        if (layer_count == 0) {
             loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                        "Can't find \"layer\" object in manifest JSON file %s, "
                        "skipping this file",
                        filename);
             return;
         }
-        // Loop through all "layer" objects in the file to get a count of them
-        // first.
-        uint16_t layer_count = 0;
-        cJSON *tempNode = layer_node;
-        do {
-            tempNode = tempNode->next;
-            layer_count++;
-        } while (tempNode != NULL);
         /*
          * Throw a warning if we encounter multiple "layer" objects in file
          * versions newer than 1.0.0.  Having multiple objects with the same
@@ -2471,16 +2986,217 @@ loader_add_layer_properties(const struct loader_instance *inst,
                        "file version \"1.0.1\".  Please use \"layers\" : [] "
                        "array instead in %s.",
                        filename);
+            return;
+        }
+        // Walk the top-level object again, reading each "layer" in turn
+        loader_json_read(&start, &value);
+        index = 0;
+        while (loader_json_next_member(&start, &index, &key)) {
+            if (!loader_json_key_is(&key, "layer")) {
+                loader_json_skip(&start);
+            } else if (!loader_read_json_layer(inst, layer_instance_list,
+                                               &start, is_implicit,
+                                               filename)) {
+                return;
+            }
+        }
+    }
+}
+
+/*
+ * Manifest scan cache
+ *
+ * Tools and applications commonly call vkEnumerateInstanceLayerProperties,
+ * vkEnumerateInstanceExtensionProperties and vkCreateInstance many times in
+ * one process.  Each of those used to search the manifest directories, read
+ * and parse every manifest, and load every ICD all over again.  The results
+ * of loader_icd_scan, loader_layer_scan and loader_implicit_layer_scan are
+ * now kept in a cache and reused for as long as their inputs are unchanged.
+ *
+ * A cache entry is keyed on the environment variables that pick the search
+ * locations, the modification time of every directory searched (which
+ * changes when manifests are added or removed), the modification time and
+ * size of every manifest and ICD library found, and on Windows the registry
+ * values listing the manifests.  Checking the key costs one stat per entry
+ * instead of reading the directories and the manifests.
+ *
+ * The cache keeps its own reference to each ICD library, so ICDs stay loaded
+ * between scans rather than being reloaded on every call.  All cache state
+ * is protected by loader_json_lock.
+ */
+#define LOADER_SCAN_ENV_COUNT 3
+
+struct loader_scan_stamp {
+    char *path;
+    // Registry values read from the key at path, or NULL for a file stamp
+    char *registry_files;
+    bool exists;
+    uint64_t mtime;
+    uint64_t size;
+};
+
+struct loader_scan_key {
+    const char *env_names[LOADER_SCAN_ENV_COUNT];
+    char *env_values[LOADER_SCAN_ENV_COUNT];
+    uint32_t count;
+    uint32_t capacity;
+    struct loader_scan_stamp *stamps;
+    // Set when recording failed, the key can't be trusted
+    bool incomplete;
+};
+
+struct loader_scan_cache {
+    bool valid;
+    struct loader_scan_key key;
+    struct loader_icd_libs icd_libs;
+    struct loader_layer_list layers;
+};
+
+static struct loader_scan_cache loader_icd_scan_cache;
+static struct loader_scan_cache loader_layer_scan_cache;
+static struct loader_scan_cache loader_implicit_layer_scan_cache;
+
+static char *loader_scan_strdup(const char *str) {
+    char *copy;
+    if (str == NULL)
+        return NULL;
+    copy = loader_instance_heap_alloc(NULL, strlen(str) + 1,
+                                      VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (copy != NULL)
+        strcpy(copy, str);
+    return copy;
+}
+
+static bool loader_scan_str_equal(const char *a, const char *b) {
+    if (a == NULL || b == NULL)
+        return a == b;
+    return strcmp(a, b) == 0;
+}
+
+static void loader_scan_key_destroy(struct loader_scan_key *key) {
+    for (uint32_t i = 0; i < LOADER_SCAN_ENV_COUNT; i++) {
+        loader_instance_heap_free(NULL, key->env_values[i]);
+    }
+    for (uint32_t i = 0; i < key->count; i++) {
+        loader_instance_heap_free(NULL, key->stamps[i].path);
+        loader_instance_heap_free(NULL, key->stamps[i].registry_files);
+    }
+    loader_instance_heap_free(NULL, key->stamps);
+    memset(key, 0, sizeof(*key));
+}
+
+/**
+ * Start a key, recording the current values of the environment variables
+ * that choose where a scan looks.  override_env is NULL for scans that
+ * can't be overridden.
+ */
+static void loader_scan_key_init(struct loader_scan_key *key,
+                                 const char *override_env) {
+    memset(key, 0, sizeof(*key));
+    key->env_names[0] = override_env;
+    key->env_names[1] = "XDG_DATA_HOME";
+    key->env_names[2] = "HOME";
+    for (uint32_t i = 0; i < LOADER_SCAN_ENV_COUNT; i++) {
+        char *value;
+        if (key->env_names[i] == NULL)
+            continue;
+        value = loader_getenv(key->env_names[i], NULL);
+        if (value != NULL) {
+            key->env_values[i] = loader_scan_strdup(value);
+            if (key->env_values[i] == NULL)
+                key->incomplete = true;
+        }
+        loader_free_getenv(value, NULL);
+    }
+}
+
+/**
+ * Record the current state of a file or directory the scan depends on, or
+ * when registry_files is non-NULL, the registry values read from path.
+ * key may be NULL, in which case nothing is recorded.
+ */
+static void loader_scan_key_add(struct loader_scan_key *key, const char *path,
+                                const char *registry_files) {
+    struct loader_scan_stamp *stamp;
+
+    if (key == NULL || key->incomplete)
+        return;
+    if (key->count == key->capacity) {
+        uint32_t capacity = key->capacity ? key->capacity * 2 : 16;
+        struct loader_scan_stamp *stamps = loader_instance_heap_realloc(
+            NULL, key->stamps, key->capacity * sizeof(*stamps),
+            capacity * sizeof(*stamps), VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (stamps == NULL) {
+            key->incomplete = true;
+            return;
+        }
+        key->stamps = stamps;
+        key->capacity = capacity;
+    }
+
+    stamp = &key->stamps[key->count];
+    memset(stamp, 0, sizeof(*stamp));
+    stamp->path = loader_scan_strdup(path);
+    if (stamp->path == NULL) {
+        key->incomplete = true;
+        return;
+    }
+    if (registry_files != NULL) {
+        stamp->registry_files = loader_scan_strdup(registry_files);
+        if (stamp->registry_files == NULL) {
+            loader_instance_heap_free(NULL, stamp->path);
+            key->incomplete = true;
+            return;
+        }
+    } else {
+        stamp->exists =
+            loader_platform_file_stamp(path, &stamp->mtime, &stamp->size);
+    }
+    key->count++;
+}
+
+/**
+ * Check whether everything recorded in the key is still the same, meaning
+ * a new scan would produce the same result as the cached one.
+ */
+static bool loader_scan_key_current(const struct loader_scan_key *key) {
+    for (uint32_t i = 0; i < LOADER_SCAN_ENV_COUNT; i++) {
+        char *value;
+        bool same;
+        if (key->env_names[i] == NULL)
+            continue;
+        value = loader_getenv(key->env_names[i], NULL);
+        same = loader_scan_str_equal(value, key->env_values[i]);
+        loader_free_getenv(value, NULL);
+        if (!same)
+            return false;
+    }
+
+    for (uint32_t i = 0; i < key->count; i++) {
+        const struct loader_scan_stamp *stamp = &key->stamps[i];
+        if (stamp->registry_files != NULL) {
+#if defined(_WIN32)
+            char *location, *reg;
+            bool same;
+            location = loader_stack_alloc(strlen(stamp->path) + 1);
+            if (location == NULL)
+                return false;
+            strcpy(location, stamp->path);
+            reg = loader_get_registry_files(NULL, location);
+            same = loader_scan_str_equal(reg, stamp->registry_files);
+            loader_instance_heap_free(NULL, reg);
+            if (!same)
+                return false;
+#endif
         } else {
-            do {
-                loader_read_json_layer(inst, layer_instance_list, layer_node,
-                                       item, disable_environment, is_implicit,
-                                       filename);
-                layer_node = layer_node->next;
-            } while (layer_node != NULL);
+            uint64_t mtime = 0, size = 0;
+            bool exists = loader_platform_file_stamp(stamp->path, &mtime, &size);
+            if (exists != stamp->exists ||
+                (exists && (mtime != stamp->mtime || size != stamp->size)))
+                return false;
         }
     }
-    return;
+    return true;
 }
 
 /**
@@ -2513,7 +3229,8 @@ loader_add_layer_properties(const struct loader_instance *inst,
 static VkResult loader_get_manifest_files(
     const struct loader_instance *inst, const char *env_override,
     char *source_override, bool is_layer, const char *location,
-    const char *home_location, struct loader_manifest_files *out_files) {
+    const char *home_location, struct loader_manifest_files *out_files,
+    struct loader_scan_key *key) {
     char * override = NULL;
     char *loc, *orig_loc = NULL;
     char *reg = NULL;
@@ -2524,19 +3241,24 @@ static VkResult loader_get_manifest_files(
     bool list_is_dirs = false;
     struct dirent *dent;
     VkResult res = VK_SUCCESS;
+    uint64_t trace = loader_trace_begin();
+    const char *trace_detail = location;
 
     out_files->count = 0;
     out_files->filename_list = NULL;
 
     if (source_override != NULL) {
         override = source_override;
+        trace_detail = source_override;
     } else if (env_override != NULL &&
                (override = loader_getenv(env_override, inst))) {
+        trace_detail = env_override;
 #if !defined(_WIN32)
         if (geteuid() != getuid() || getegid() != getgid()) {
             /* Don't allow setuid apps to use the env var: */
             loader_free_getenv(override, inst);
             override = NULL;
+            trace_detail = location;
         }
 #endif
     }
@@ -2592,6 +3314,7 @@ static VkResult loader_get_manifest_files(
             }
             goto out;
         }
+        loader_scan_key_add(key, location, reg);
         orig_loc = loc;
         loc = reg;
 #endif
@@ -2617,6 +3340,7 @@ static VkResult loader_get_manifest_files(
     while (*file) {
         next_file = loader_get_next_path(file);
         if (list_is_dirs) {
+            loader_scan_key_add(key, file, NULL);
             sysdir = opendir(file);
             name = NULL;
             if (sysdir) {
@@ -2682,6 +3406,7 @@ static VkResult loader_get_manifest_files(
                 }
                 strcpy(out_files->filename_list[out_files->count], name);
                 out_files->count++;
+                loader_scan_key_add(key, name, NULL);
             } else if (!list_is_dirs) {
                 loader_log(
                     inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
@@ -2799,9 +3524,137 @@ out:
     if (NULL != reg && reg != orig_loc) {
         loader_instance_heap_free(inst, reg);
     }
+    loader_trace_end(inst, trace, "Find manifest files", trace_detail);
     return res;
 }
 
+/**
+ * Append a copy of a scanned ICD to icd_libs, taking another reference on
+ * its library.
+ */
+static void loader_scanned_icd_copy(const struct loader_instance *inst,
+                                    struct loader_icd_libs *icd_libs,
+                                    const struct loader_scanned_icds *src) {
+    struct loader_scanned_icds *new_node;
+    loader_platform_dl_handle handle;
+    uint64_t trace;
+
+    // check for enough capacity
+    if ((icd_libs->count * sizeof(struct loader_scanned_icds)) >=
+        icd_libs->capacity) {
+        icd_libs->list = loader_instance_heap_realloc(
+            inst, icd_libs->list, icd_libs->capacity, icd_libs->capacity * 2,
+            VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+        if (NULL == icd_libs->list) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "realloc failed on icd library list");
+            return;
+        }
+        icd_libs->capacity *= 2;
+    }
+
+    trace = loader_trace_begin();
+    handle = loader_platform_open_library(src->lib_name);
+    loader_trace_end(inst, trace, "Open ICD library", src->lib_name);
+    if (!handle) {
+        loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                   loader_platform_open_library_error(src->lib_name));
+        return;
+    }
+
+    new_node = &(icd_libs->list[icd_libs->count]);
+    *new_node = *src;
+    new_node->handle = handle;
+    memset(&new_node->instance_extension_list, 0,
+           sizeof(new_node->instance_extension_list));
+    if (src->instance_extension_list.count > 0 &&
+        loader_add_to_ext_list(inst, &new_node->instance_extension_list,
+                               src->instance_extension_list.count,
+                               src->instance_extension_list.list) !=
+            VK_SUCCESS) {
+        loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                   "Out of memory can't add icd");
+        loader_destroy_generic_list(
+            inst,
+            (struct loader_generic_list *)&new_node->instance_extension_list);
+        loader_platform_close_library(handle);
+        return;
+    }
+    new_node->lib_name = (char *)loader_instance_heap_alloc(
+        inst, strlen(src->lib_name) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (NULL == new_node->lib_name) {
+        loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
+                   "Out of memory can't add icd");
+        loader_destroy_generic_list(
+            inst,
+            (struct loader_generic_list *)&new_node->instance_extension_list);
+        loader_platform_close_library(handle);
+        return;
+    }
+    strcpy(new_node->lib_name, src->lib_name);
+    icd_libs->count++;
+}
+
+/**
+ * Copy every entry of a layer list onto the end of another.
+ */
+static VkResult loader_copy_layer_list(const struct loader_instance *inst,
+                                       struct loader_layer_list *dst,
+                                       const struct loader_layer_list *src) {
+    for (uint32_t i = 0; i < src->count; i++) {
+        struct loader_layer_properties *props =
+            loader_get_next_layer_property(inst, dst);
+        if (props == NULL)
+            return VK_ERROR_OUT_OF_HOST_MEMORY;
+        VkResult res = loader_copy_layer_properties(inst, props, &src->list[i]);
+        if (res != VK_SUCCESS)
+            return res;
+    }
+    return VK_SUCCESS;
+}
+
+static void loader_scan_cache_clear(struct loader_scan_cache *cache) {
+    loader_scanned_icd_clear(NULL, &cache->icd_libs);
+    loader_delete_layer_properties(NULL, &cache->layers);
+    loader_scan_key_destroy(&cache->key);
+    cache->valid = false;
+}
+
+/**
+ * Replace the contents of a cache entry with copies of a scan's results.
+ * The cache takes ownership of key.
+ */
+static void loader_scan_cache_store(struct loader_scan_cache *cache,
+                                    struct loader_scan_key *key,
+                                    const struct loader_icd_libs *icd_libs,
+                                    const struct loader_layer_list *layers) {
+    loader_scan_cache_clear(cache);
+    if (key->incomplete)
+        goto fail;
+
+    if (icd_libs != NULL) {
+        if (loader_scanned_icd_init(NULL, &cache->icd_libs) != VK_SUCCESS)
+            goto fail;
+        for (uint32_t i = 0; i < icd_libs->count; i++) {
+            loader_scanned_icd_copy(NULL, &cache->icd_libs, &icd_libs->list[i]);
+        }
+        if (cache->icd_libs.count != icd_libs->count)
+            goto fail;
+    }
+    if (layers != NULL &&
+        loader_copy_layer_list(NULL, &cache->layers, layers) != VK_SUCCESS)
+        goto fail;
+
+    cache->key = *key;
+    memset(key, 0, sizeof(*key));
+    cache->valid = true;
+    return;
+
+fail:
+    loader_scan_cache_clear(cache);
+    loader_scan_key_destroy(key);
+}
+
 void loader_init_icd_lib_list() {}
 
 void loader_destroy_icd_lib_list() {}
@@ -2823,99 +3676,125 @@ VkResult loader_icd_scan(const struct loader_instance *inst,
     uint16_t file_major_vers = 0;
     uint16_t file_minor_vers = 0;
     uint16_t file_patch_vers = 0;
-    char *vers_tok;
+    char file_vers[64];
     struct loader_manifest_files manifest_files;
     VkResult res = VK_SUCCESS;
     bool lockedMutex = false;
-    cJSON *json = NULL;
+    bool scanned = false;
+    struct loader_scan_key key;
+    struct loader_manifest manifest;
+    struct loader_json json;
+    bool manifest_open = false;
 
     memset(&manifest_files, 0, sizeof(struct loader_manifest_files));
+    memset(&key, 0, sizeof(key));
 
     res = loader_scanned_icd_init(inst, icds);
     if (VK_SUCCESS != res) {
         goto out;
     }
 
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+    lockedMutex = true;
+
+    if (loader_icd_scan_cache.valid &&
+        loader_scan_key_current(&loader_icd_scan_cache.key)) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0,
+                   "ICD manifests unchanged, using cached ICD list");
+        for (uint32_t i = 0; i < loader_icd_scan_cache.icd_libs.count; i++) {
+            loader_scanned_icd_copy(inst, icds,
+                                    &loader_icd_scan_cache.icd_libs.list[i]);
+        }
+        goto out;
+    }
+    loader_scan_key_init(&key, "VK_ICD_FILENAMES");
+    scanned = true;
+
     // Get a list of manifest files for ICDs
     res = loader_get_manifest_files(inst, "VK_ICD_FILENAMES", NULL, false,
                                     DEFAULT_VK_DRIVERS_INFO,
-                                    HOME_VK_DRIVERS_INFO, &manifest_files);
+                                    HOME_VK_DRIVERS_INFO, &manifest_files,
+                                    &key);
     if (VK_SUCCESS != res || manifest_files.count == 0) {
         goto out;
     }
-    loader_platform_thread_lock_mutex(&loader_json_lock);
-    lockedMutex = true;
     for (uint32_t i = 0; i < manifest_files.count; i++) {
         file_str = manifest_files.filename_list[i];
         if (file_str == NULL) {
             continue;
         }
 
-        json = loader_get_json(inst, file_str);
-        if (!json) {
+        if (!loader_open_manifest(inst, file_str, &manifest, &json)) {
             continue;
         }
-        cJSON *item, *itemICD;
-        item = cJSON_GetObjectItem(json, "file_format_version");
-        if (item == NULL) {
-            res = VK_ERROR_INITIALIZATION_FAILED;
-            goto out;
+        manifest_open = true;
+
+        struct loader_json_value value, member, item, library_path_item,
+            api_version_item;
+        struct loader_json itemICD;
+        bool has_icd = false;
+        uint32_t index = 0;
+        memset(&item, 0, sizeof(item));
+        memset(&library_path_item, 0, sizeof(library_path_item));
+        memset(&api_version_item, 0, sizeof(api_version_item));
+        if (loader_json_peek(&json) == LOADER_JSON_OBJECT) {
+            loader_json_read(&json, &value);
+            while (loader_json_next_member(&json, &index, &member)) {
+                bool ok;
+                if (loader_json_key_is(&member, "file_format_version"))
+                    ok = loader_json_read_field(&json, &item);
+                else if (loader_json_key_is(&member, "ICD"))
+                    ok = loader_json_mark_field(&json, &has_icd, &itemICD);
+                else
+                    ok = loader_json_skip(&json);
+                if (!ok)
+                    break;
+            }
+        } else {
+            loader_json_skip(&json);
         }
-        char *file_vers = cJSON_Print(item);
-        if (NULL == file_vers) {
-            // Only reason the print can fail is if there was an allocation
-            // issue
-            res = VK_ERROR_OUT_OF_HOST_MEMORY;
-            goto out;
+        if (json.error) {
+            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                       "Can't parse JSON file %s", file_str);
+            loader_close_manifest(&manifest);
+            manifest_open = false;
+            continue;
         }
-        loader_log(inst, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, 0,
-                   "Found manifest file %s, version %s", file_str, file_vers);
-        // Get the major/minor/and patch as integers for easier comparison
-        vers_tok = strtok(file_vers, ".\"\n\r");
-        if (NULL != vers_tok) {
-            file_major_vers = (uint16_t)atoi(vers_tok);
-            vers_tok = strtok(NULL, ".\"\n\r");
-            if (NULL != vers_tok) {
-                file_minor_vers = (uint16_t)atoi(vers_tok);
-                vers_tok = strtok(NULL, ".\"\n\r");
-                if (NULL != vers_tok) {
-                    file_patch_vers = (uint16_t)atoi(vers_tok);
-                }
-            }
+        if (item.type == LOADER_JSON_NONE) {
+            res = VK_ERROR_INITIALIZATION_FAILED;
+            goto out;
         }
+        loader_read_json_file_version(inst, &item, file_str, file_vers,
+                                      sizeof(file_vers), &file_major_vers,
+                                      &file_minor_vers, &file_patch_vers);
         if (file_major_vers != 1 || file_minor_vers != 0 || file_patch_vers > 1)
             loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                        "Unexpected manifest file version (expected 1.0.0 or "
                        "1.0.1), may "
                        "cause errors");
-        cJSON_Free(file_vers);
-        itemICD = cJSON_GetObjectItem(json, "ICD");
-        if (itemICD != NULL) {
-            item = cJSON_GetObjectItem(itemICD, "library_path");
-            if (item != NULL) {
-                char *temp = cJSON_Print(item);
-                if (!temp || strlen(temp) == 0) {
-                    loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
-                               "Can't find \"library_path\" in ICD JSON file "
-                               "%s, skipping",
-                               file_str);
-                    cJSON_Free(temp);
-                    cJSON_Delete(json);
-                    json = NULL;
-                    continue;
-                }
-                // strip out extra quotes
-                temp[strlen(temp) - 1] = '\0';
-                char *library_path = loader_stack_alloc(strlen(temp) + 1);
-                strcpy(library_path, &temp[1]);
-                cJSON_Free(temp);
-                if (!library_path || strlen(library_path) == 0) {
+        if (has_icd && loader_json_peek(&itemICD) == LOADER_JSON_OBJECT) {
+            loader_json_read(&itemICD, &value);
+            index = 0;
+            while (loader_json_next_member(&itemICD, &index, &member)) {
+                if (loader_json_key_is(&member, "library_path"))
+                    loader_json_read_field(&itemICD, &library_path_item);
+                else if (loader_json_key_is(&member, "api_version"))
+                    loader_json_read_field(&itemICD, &api_version_item);
+                else
+                    loader_json_skip(&itemICD);
+            }
+            if (library_path_item.type != LOADER_JSON_NONE) {
+                char library_path[MAX_STRING_SIZE];
+                if (!loader_json_copy_field(inst, &library_path_item,
+                                            library_path, sizeof(library_path),
+                                            "library_path") ||
+                    strlen(library_path) == 0) {
                     loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                                "Can't find \"library_path\" in ICD JSON file "
                                "%s, skipping",
                                file_str);
-                    cJSON_Delete(json);
-                    json = NULL;
+                    loader_close_manifest(&manifest);
+                    manifest_open = false;
                     continue;
                 }
                 char fullpath[MAX_STRING_SIZE];
@@ -2938,20 +3817,12 @@ VkResult loader_icd_scan(const struct loader_instance *inst,
                                         sizeof(fullpath), fullpath);
                 }
 
-                uint32_t vers = 0;
-                item = cJSON_GetObjectItem(itemICD, "api_version");
-                if (item != NULL) {
-                    temp = cJSON_Print(item);
-                    if (NULL == temp) {
-                        // Only reason the print can fail is if there was an
-                        // allocation issue
-                        res = VK_ERROR_OUT_OF_HOST_MEMORY;
-                        goto out;
-                    }
-                    vers = loader_make_version(temp);
-                    cJSON_Free(temp);
-                }
+                char api_version[MAX_STRING_SIZE];
+                uint32_t vers = loader_make_version(loader_json_copy_field(
+                    inst, &api_version_item, api_version, sizeof(api_version),
+                    "api_version"));
                 loader_scanned_icd_add(inst, icds, fullpath, vers);
+                loader_scan_key_add(&key, fullpath, NULL);
             } else {
                 loader_log(inst, VK_DEBUG_REPORT_WARNING_BIT_EXT, 0,
                            "Can't find \"library_path\" object in ICD JSON "
@@ -2965,13 +3836,20 @@ VkResult loader_icd_scan(const struct loader_instance *inst,
                 file_str);
         }
 
-        cJSON_Delete(json);
-        json = NULL;
+        loader_close_manifest(&manifest);
+        manifest_open = false;
     }
 
 out:
-    if (NULL != json) {
-        cJSON_Delete(json);
+    if (manifest_open) {
+        loader_close_manifest(&manifest);
+    }
+    if (scanned) {
+        if (VK_SUCCESS == res) {
+            loader_scan_cache_store(&loader_icd_scan_cache, &key, icds, NULL);
+        } else {
+            loader_scan_key_destroy(&key);
+        }
     }
     if (NULL != manifest_files.filename_list) {
         for (uint32_t i = 0; i < manifest_files.count; i++) {
@@ -2993,17 +3871,34 @@ void loader_layer_scan(const struct loader_instance *inst,
     char *file_str;
     struct loader_manifest_files
         manifest_files[2]; // [0] = explicit, [1] = implicit
-    cJSON *json;
+    struct loader_manifest manifest;
+    struct loader_json json;
     uint32_t implicit;
-    bool lockedMutex = false;
+    struct loader_scan_key key;
+    bool scanned = false;
 
     memset(manifest_files, 0, sizeof(struct loader_manifest_files) * 2);
 
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+
+    if (loader_layer_scan_cache.valid &&
+        loader_scan_key_current(&loader_layer_scan_cache.key)) {
+        loader_log(inst, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0,
+                   "Layer manifests unchanged, using cached layer list");
+        loader_delete_layer_properties(inst, instance_layers);
+        loader_copy_layer_list(inst, instance_layers,
+                               &loader_layer_scan_cache.layers);
+        goto out;
+    }
+    loader_scan_key_init(&key, LAYERS_PATH_ENV);
+
     // Get a list of manifest files for explicit layers
     if (VK_SUCCESS !=
         loader_get_manifest_files(inst, LAYERS_PATH_ENV, LAYERS_SOURCE_PATH,
                                   true, DEFAULT_VK_ELAYERS_INFO,
-                                  HOME_VK_ELAYERS_INFO, &manifest_files[0])) {
+                                  HOME_VK_ELAYERS_INFO, &manifest_files[0],
+                                  &key)) {
+        loader_scan_key_destroy(&key);
         goto out;
     }
 
@@ -3012,35 +3907,33 @@ void loader_layer_scan(const struct loader_instance *inst,
     // overridden by LAYERS_PATH_ENV
     if (VK_SUCCESS != loader_get_manifest_files(
                           inst, NULL, NULL, true, DEFAULT_VK_ILAYERS_INFO,
-                          HOME_VK_ILAYERS_INFO, &manifest_files[1])) {
+                          HOME_VK_ILAYERS_INFO, &manifest_files[1], &key)) {
+        loader_scan_key_destroy(&key);
         goto out;
     }
+    scanned = true;
+
+    // cleanup any previously scanned libraries
+    loader_delete_layer_properties(inst, instance_layers);
 
     // Make sure we have at least one layer, if not, go ahead and return
     if (manifest_files[0].count == 0 && manifest_files[1].count == 0) {
         goto out;
     }
 
-    // cleanup any previously scanned libraries
-    loader_delete_layer_properties(inst, instance_layers);
-
-    loader_platform_thread_lock_mutex(&loader_json_lock);
-    lockedMutex = true;
     for (implicit = 0; implicit < 2; implicit++) {
         for (uint32_t i = 0; i < manifest_files[implicit].count; i++) {
             file_str = manifest_files[implicit].filename_list[i];
             if (file_str == NULL)
                 continue;
 
-            // parse file into JSON struct
-            json = loader_get_json(inst, file_str);
-            if (!json) {
+            if (!loader_open_manifest(inst, file_str, &manifest, &json)) {
                 continue;
             }
 
-            loader_add_layer_properties(inst, instance_layers, json,
+            loader_add_layer_properties(inst, instance_layers, &json,
                                         (implicit == 1), file_str);
-            cJSON_Delete(json);
+            loader_close_manifest(&manifest);
         }
     }
 
@@ -3050,6 +3943,10 @@ void loader_layer_scan(const struct loader_instance *inst,
                                    std_validation_names, instance_layers);
 
 out:
+    if (scanned) {
+        loader_scan_cache_store(&loader_layer_scan_cache, &key, NULL,
+                                instance_layers);
+    }
 
     for (uint32_t manFile = 0; manFile < 2; manFile++) {
         if (NULL != manifest_files[manFile].filename_list) {
@@ -3063,49 +3960,66 @@ out:
                                       manifest_files[manFile].filename_list);
         }
     }
-    if (lockedMutex) {
-        loader_platform_thread_unlock_mutex(&loader_json_lock);
-    }
+    loader_platform_thread_unlock_mutex(&loader_json_lock);
 }
 
 void loader_implicit_layer_scan(const struct loader_instance *inst,
                                 struct loader_layer_list *instance_layers) {
     char *file_str;
     struct loader_manifest_files manifest_files;
-    cJSON *json;
+    struct loader_manifest manifest;
+    struct loader_json json;
     uint32_t i;
+    struct loader_scan_key key;
+    VkResult res;
+
+    loader_platform_thread_lock_mutex(&loader_json_lock);
+
+    if (loader_implicit_layer_scan_cache.valid &&
+        loader_scan_key_current(&loader_implicit_layer_scan_cache.key)) {
+        loader_delete_layer_properties(inst, instance_layers);
+        loader_copy_layer_list(inst, instance_layers,
+                               &loader_implicit_layer_scan_cache.layers);
+        loader_platform_thread_unlock_mutex(&loader_json_lock);
+        return;
+    }
+    loader_scan_key_init(&key, NULL);
 
     // Pass NULL for environment variable override - implicit layers are not
     // overridden by LAYERS_PATH_ENV
-    VkResult res = loader_get_manifest_files(
-        inst, NULL, NULL, true, DEFAULT_VK_ILAYERS_INFO, HOME_VK_ILAYERS_INFO,
-        &manifest_files);
+    res = loader_get_manifest_files(inst, NULL, NULL, true,
+                                    DEFAULT_VK_ILAYERS_INFO,
+                                    HOME_VK_ILAYERS_INFO, &manifest_files, &key);
     if (VK_SUCCESS != res || manifest_files.count == 0) {
+        if (VK_SUCCESS == res) {
+            loader_delete_layer_properties(inst, instance_layers);
+            loader_scan_cache_store(&loader_implicit_layer_scan_cache, &key,
+                                    NULL, instance_layers);
+        } else {
+            loader_scan_key_destroy(&key);
+        }
+        loader_platform_thread_unlock_mutex(&loader_json_lock);
         return;
     }
 
     /* cleanup any previously scanned libraries */
     loader_delete_layer_properties(inst, instance_layers);
 
-    loader_platform_thread_lock_mutex(&loader_json_lock);
-
     for (i = 0; i < manifest_files.count; i++) {
         file_str = manifest_files.filename_list[i];
         if (file_str == NULL) {
             continue;
         }
 
-        // parse file into JSON struct
-        json = loader_get_json(inst, file_str);
-        if (!json) {
+        if (!loader_open_manifest(inst, file_str, &manifest, &json)) {
             continue;
         }
 
-        loader_add_layer_properties(inst, instance_layers, json, true,
+        loader_add_layer_properties(inst, instance_layers, &json, true,
                                     file_str);
 
         loader_instance_heap_free(inst, file_str);
-        cJSON_Delete(json);
+        loader_close_manifest(&manifest);
     }
     loader_instance_heap_free(inst, manifest_files.filename_list);
 
@@ -3114,6 +4028,8 @@ void loader_implicit_layer_scan(const struct loader_instance *inst,
                                              sizeof(std_validation_names[0]),
                                    std_validation_names, instance_layers);
 
+    loader_scan_cache_store(&loader_implicit_layer_scan_cache, &key, NULL,
+                            instance_layers);
     loader_platform_thread_unlock_mutex(&loader_json_lock);
 }
 
@@ -3203,10 +4119,9 @@ static void loader_init_dispatch_dev_ext_entry(struct loader_instance *inst,
  */
 void loader_init_dispatch_dev_ext(struct loader_instance *inst,
                                   struct loader_device *dev) {
-    for (uint32_t i = 0; i < MAX_NUM_DEV_EXTS; i++) {
-        if (inst->disp_hash[i].func_name != NULL)
-            loader_init_dispatch_dev_ext_entry(inst, dev, i,
-                                               inst->disp_hash[i].func_name);
+    for (uint32_t i = 0; i < inst->dev_ext_count; i++) {
+        loader_init_dispatch_dev_ext_entry(inst, dev, i,
+                                           inst->dev_ext_names[i]);
     }
 }
 
@@ -3260,105 +4175,161 @@ loader_check_layers_for_address(const struct loader_instance *const inst,
 }
 
 static void loader_free_dev_ext_table(struct loader_instance *inst) {
-    for (uint32_t i = 0; i < MAX_NUM_DEV_EXTS; i++) {
-        loader_instance_heap_free(inst, inst->disp_hash[i].func_name);
-        loader_instance_heap_free(inst, inst->disp_hash[i].list.index);
+    for (uint32_t i = 0; i < inst->dev_ext_count; i++) {
+        loader_instance_heap_free(inst, inst->dev_ext_names[i]);
     }
-    memset(inst->disp_hash, 0, sizeof(inst->disp_hash));
+    loader_instance_heap_free(inst, inst->dev_ext_map.entries);
+    inst->dev_ext_count = 0;
+    memset(inst->dev_ext_names, 0, sizeof(inst->dev_ext_names));
+    memset(&inst->dev_ext_map, 0, sizeof(inst->dev_ext_map));
 }
 
-static bool loader_add_dev_ext_table(struct loader_instance *inst,
-                                     uint32_t *ptr_idx, const char *funcName) {
-    uint32_t i;
-    uint32_t idx = *ptr_idx;
-    struct loader_dispatch_hash_list *list = &inst->disp_hash[idx].list;
-
-    if (!inst->disp_hash[idx].func_name) {
-        // no entry here at this idx, so use it
-        assert(list->capacity == 0);
-        inst->disp_hash[idx].func_name = (char *)loader_instance_heap_alloc(
-            inst, strlen(funcName) + 1, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (inst->disp_hash[idx].func_name == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_dev_ext_table() can't allocate memory for "
-                       "func_name");
-            return false;
+/*
+ * The name to trampoline slot map is open addressed with linear probing.  It
+ * is kept at most half full, and is also grown whenever an entry lands more
+ * than DEV_EXT_MAP_MAX_PROBE places from where it hashed, so a lookup
+ * compares against only a few entries however the names happen to collide.
+ * Entries are never removed; the whole map goes with the instance.
+ */
+#define DEV_EXT_MAP_MAX_PROBE 8
+#define DEV_EXT_MAP_MAX_CAPACITY (16 * MAX_NUM_DEV_EXTS)
+
+static const struct loader_dev_ext_map_entry *
+loader_dev_ext_map_find(const struct loader_dev_ext_map *map, uint32_t hash,
+                        const char *funcName) {
+    uint32_t mask, slot;
+    if (map->count == 0) {
+        return NULL;
+    }
+    mask = map->capacity - 1;
+    slot = hash & mask;
+    while (map->entries[slot].func_name != NULL) {
+        if (map->entries[slot].hash == hash &&
+            !strcmp(map->entries[slot].func_name, funcName)) {
+            return &map->entries[slot];
         }
-        strncpy(inst->disp_hash[idx].func_name, funcName, strlen(funcName) + 1);
-        return true;
+        slot = (slot + 1) & mask;
     }
+    return NULL;
+}
 
-    // check for enough capacity
-    if (list->capacity == 0) {
-        list->index = loader_instance_heap_alloc(inst, 8 * sizeof(*(list->index)),
-                                        VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (list->index == NULL) {
-            loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                       "loader_add_dev_ext_table() can't allocate list memory");
-            return false;
+// Stores entry in the first free place of its probe sequence and returns how
+// far that is from where it hashed
+static uint32_t
+loader_dev_ext_map_place(struct loader_dev_ext_map *map,
+                         const struct loader_dev_ext_map_entry *entry) {
+    uint32_t mask = map->capacity - 1;
+    uint32_t slot = entry->hash & mask;
+    uint32_t distance = 0;
+    while (map->entries[slot].func_name != NULL) {
+        slot = (slot + 1) & mask;
+        distance++;
+    }
+    map->entries[slot] = *entry;
+    map->count++;
+    return distance;
+}
+
+static bool loader_dev_ext_map_resize(struct loader_instance *inst,
+                                      struct loader_dev_ext_map *map,
+                                      uint32_t capacity,
+                                      uint32_t *max_distance) {
+    struct loader_dev_ext_map grown;
+    grown.count = 0;
+    grown.capacity = capacity;
+    grown.entries = loader_instance_heap_alloc(
+        inst, capacity * sizeof(*grown.entries),
+        VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (grown.entries == NULL) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loader_dev_ext_map_resize() can't allocate memory for "
+                   "%u entries",
+                   capacity);
+        return false;
+    }
+    memset(grown.entries, 0, capacity * sizeof(*grown.entries));
+
+    *max_distance = 0;
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        if (map->entries[i].func_name != NULL) {
+            uint32_t distance =
+                loader_dev_ext_map_place(&grown, &map->entries[i]);
+            if (distance > *max_distance) {
+                *max_distance = distance;
+            }
         }
-        list->capacity = 8 * sizeof(*(list->index));
-    } else if (list->capacity < (list->count + 1) * sizeof(*(list->index))) {
-        list->index = loader_instance_heap_realloc(inst, list->index, list->capacity,
-                                          list->capacity * 2,
-                                          VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-        if (list->index == NULL) {
-            loader_log(
-                inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                "loader_add_dev_ext_table() can't reallocate list memory");
+    }
+    loader_instance_heap_free(inst, map->entries);
+    *map = grown;
+    return true;
+}
+
+static bool
+loader_dev_ext_map_insert(struct loader_instance *inst,
+                          struct loader_dev_ext_map *map,
+                          const struct loader_dev_ext_map_entry *entry) {
+    uint32_t distance;
+
+    if ((map->count + 1) * 2 > map->capacity) {
+        if (!loader_dev_ext_map_resize(inst, map,
+                                       map->capacity ? map->capacity * 2 : 32,
+                                       &distance)) {
             return false;
         }
-        list->capacity *= 2;
     }
+    distance = loader_dev_ext_map_place(map, entry);
 
-    // find an unused index in the hash table and use it
-    i = (idx + 1) % MAX_NUM_DEV_EXTS;
-    do {
-        if (!inst->disp_hash[i].func_name) {
-            assert(inst->disp_hash[i].list.capacity == 0);
-            inst->disp_hash[i].func_name =
-                (char *)loader_instance_heap_alloc(inst, strlen(funcName) + 1,
-                                          VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
-            if (inst->disp_hash[i].func_name == NULL) {
-                loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-                           "loader_add_dev_ext_table() can't rallocate "
-                           "func_name memory");
-                return false;
-            }
-            strncpy(inst->disp_hash[i].func_name, funcName,
-                    strlen(funcName) + 1);
-            list->index[list->count] = i;
-            list->count++;
-            *ptr_idx = i;
-            return true;
+    // Spread out a long probe run; names whose hashes are equal can't be
+    // separated, so stop growing at some point and leave them in a run
+    while (distance > DEV_EXT_MAP_MAX_PROBE &&
+           map->capacity < DEV_EXT_MAP_MAX_CAPACITY) {
+        if (!loader_dev_ext_map_resize(inst, map, map->capacity * 2,
+                                       &distance)) {
+            // The entry is in the map already, just with a longer probe
+            break;
         }
-        i = (i + 1) % MAX_NUM_DEV_EXTS;
-    } while (i != idx);
-
-    loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
-               "loader_add_dev_ext_table() couldn't insert into hash table; is "
-               "it full?");
-    return false;
+    }
+    return true;
 }
 
-static bool loader_name_in_dev_ext_table(struct loader_instance *inst,
-                                         uint32_t *idx, const char *funcName) {
-    uint32_t alt_idx;
-    if (inst->disp_hash[*idx].func_name &&
-        !strcmp(inst->disp_hash[*idx].func_name, funcName))
-        return true;
+// Gives funcName the next free trampoline slot
+static bool loader_add_dev_ext_table(struct loader_instance *inst,
+                                     uint32_t hash, const char *funcName,
+                                     uint32_t *ptr_slot) {
+    struct loader_dev_ext_map_entry entry;
+    size_t len = strlen(funcName) + 1;
+    char *name;
 
-    // funcName wasn't at the primary spot in the hash table
-    // search the list of secondary locations (shallow search, not deep search)
-    for (uint32_t i = 0; i < inst->disp_hash[*idx].list.count; i++) {
-        alt_idx = inst->disp_hash[*idx].list.index[i];
-        if (!strcmp(inst->disp_hash[*idx].func_name, funcName)) {
-            *idx = alt_idx;
-            return true;
-        }
+    if (inst->dev_ext_count >= MAX_NUM_DEV_EXTS) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loader_add_dev_ext_table() can't add %s, all %u device "
+                   "extension trampolines are in use",
+                   funcName, MAX_NUM_DEV_EXTS);
+        return false;
     }
 
-    return false;
+    name = (char *)loader_instance_heap_alloc(
+        inst, len, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE);
+    if (name == NULL) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "loader_add_dev_ext_table() can't allocate memory for "
+                   "func_name");
+        return false;
+    }
+    memcpy(name, funcName, len);
+
+    entry.func_name = name;
+    entry.hash = hash;
+    entry.slot = inst->dev_ext_count;
+    if (!loader_dev_ext_map_insert(inst, &inst->dev_ext_map, &entry)) {
+        loader_instance_heap_free(inst, name);
+        return false;
+    }
+
+    inst->dev_ext_names[entry.slot] = name;
+    inst->dev_ext_count++;
+    *ptr_slot = entry.slot;
+    return true;
 }
 
 /**
@@ -3376,18 +4347,20 @@ static bool loader_name_in_dev_ext_table(struct loader_instance *inst,
  * has not been seen yet. Next check if a layer or ICD supports it.  If so then
  * a
  * new entry in the hash table is initialized and that trampoline address for
- * the new entry is returned. Null is returned if the hash table is full or
+ * the new entry is returned. Null is returned if every trampoline is in use or
  * if no discovered layer or ICD returns a non-NULL GetProcAddr for it.
  */
 void *loader_dev_ext_gpa(struct loader_instance *inst, const char *funcName) {
-    uint32_t idx;
+    const struct loader_dev_ext_map_entry *entry;
+    uint32_t hash, slot;
     uint32_t seed = 0;
 
-    idx = murmurhash(funcName, strlen(funcName), seed) % MAX_NUM_DEV_EXTS;
+    hash = murmurhash(funcName, strlen(funcName), seed);
 
-    if (loader_name_in_dev_ext_table(inst, &idx, funcName))
+    entry = loader_dev_ext_map_find(&inst->dev_ext_map, hash, funcName);
+    if (entry != NULL)
         // found funcName already in hash
-        return loader_get_dev_ext_trampoline(idx);
+        return loader_get_dev_ext_trampoline(entry->slot);
 
     // Check if funcName is supported in either ICDs or a layer library
     if (!loader_check_icds_for_address(inst, funcName) &&
@@ -3396,11 +4369,11 @@ void *loader_dev_ext_gpa(struct loader_instance *inst, const char *funcName) {
         return NULL;
     }
 
-    if (loader_add_dev_ext_table(inst, &idx, funcName)) {
+    if (loader_add_dev_ext_table(inst, hash, funcName, &slot)) {
         // successfully added new table entry
         // init any dev dispatch table entrys as needed
-        loader_init_dispatch_dev_ext_entry(inst, NULL, idx, funcName);
-        return loader_get_dev_ext_trampoline(idx);
+        loader_init_dispatch_dev_ext_entry(inst, NULL, slot, funcName);
+        return loader_get_dev_ext_trampoline(slot);
     }
 
     return NULL;
@@ -3412,24 +4385,79 @@ struct loader_instance *loader_get_instance(const VkInstance instance) {
      * layers which wrap the instance object.
      */
     const VkLayerInstanceDispatchTable *disp;
+    const struct loader_dispatch_map_entry *entry;
     struct loader_instance *ptr_instance = NULL;
     disp = loader_get_instance_dispatch(instance);
-    for (struct loader_instance *inst = loader.instances; inst;
-         inst = inst->next) {
-        if (inst->disp == disp) {
-            ptr_instance = inst;
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    entry = loader_dispatch_map_find(&loader.instance_map, disp);
+    if (entry != NULL) {
+        ptr_instance = entry->object;
+    }
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
+    return ptr_instance;
+}
+
+/**
+ * Add an instance to the loader's list of instances, making it visible to
+ * loader_get_instance.  inst->disp must already be allocated.
+ */
+VkResult loader_add_instance(struct loader_instance *inst) {
+    bool added;
+
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    added = loader_dispatch_map_insert(&loader.instance_map, inst->disp, inst,
+                                       NULL);
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
+    if (!added) {
+        loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
+                   "Failed to add instance to the dispatch map");
+        return VK_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    inst->next = loader.instances;
+    loader.instances = inst;
+    return VK_SUCCESS;
+}
+
+/**
+ * Remove an instance from the loader's list of instances.  Does nothing if
+ * the instance was never added.
+ */
+void loader_remove_instance(struct loader_instance *inst) {
+    struct loader_instance *prev = NULL;
+    struct loader_instance *next = loader.instances;
+
+    while (next != NULL) {
+        if (next == inst) {
+            if (prev)
+                prev->next = next->next;
+            else
+                loader.instances = next->next;
             break;
         }
+        prev = next;
+        next = next->next;
     }
-    return ptr_instance;
+
+    loader_platform_thread_lock_mutex(&loader_dispatch_map_lock);
+    if (inst->disp != NULL) {
+        const struct loader_dispatch_map_entry *entry =
+            loader_dispatch_map_find(&loader.instance_map, inst->disp);
+        if (entry != NULL && entry->object == inst) {
+            loader_dispatch_map_remove(&loader.instance_map, inst->disp);
+        }
+    }
+    loader_platform_thread_unlock_mutex(&loader_dispatch_map_lock);
 }
 
 static loader_platform_dl_handle
 loader_open_layer_lib(const struct loader_instance *inst, const char *chain_type,
                      struct loader_layer_properties *prop) {
 
-    if ((prop->lib_handle = loader_platform_open_library(prop->lib_name)) ==
-        NULL) {
+    uint64_t trace = loader_trace_begin();
+    prop->lib_handle = loader_platform_open_library(prop->lib_name);
+    loader_trace_end(inst, trace, "Open layer library", prop->lib_name);
+    if (prop->lib_handle == NULL) {
         loader_log(inst, VK_DEBUG_REPORT_ERROR_BIT_EXT, 0,
                    loader_platform_open_library_error(prop->lib_name));
     } else {
@@ -3850,7 +4878,12 @@ loader_create_device_chain(const struct loader_physical_device_tramp *pd,
         return VK_ERROR_INITIALIZATION_FAILED;
     }
 
-    /* Initialize device dispatch table */
+    /* Initialize device dispatch table.  Each entry comes from the top
+     * layer's GetDeviceProcAddr, and a layer that doesn't intercept a
+     * function hands back whatever the layer below it returns, so the entry
+     * already points at the first layer that does, or at the ICD.
+     * vkGetDeviceProcAddr returns these entries as they are.
+     */
     loader_init_device_dispatch_table(&dev->loader_dispatch, nextGDPA,
                                       dev->device);
 
@@ -4034,23 +5067,12 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateInstance(
             return VK_ERROR_OUT_OF_HOST_MEMORY;
         }
         icd_create_info.enabledExtensionCount = 0;
-        struct loader_extension_list icd_exts;
-
-        loader_log(ptr_instance, VK_DEBUG_REPORT_DEBUG_BIT_EXT, 0,
-                   "Build ICD instance extension list");
-        // traverse scanned icd list adding non-duplicate extensions to the
-        // list
-        loader_init_generic_list(ptr_instance,
-                                 (struct loader_generic_list *)&icd_exts,
-                                 sizeof(VkExtensionProperties));
-        loader_add_instance_extensions(
-            ptr_instance,
-            icd->this_icd_lib->EnumerateInstanceExtensionProperties,
-            icd->this_icd_lib->lib_name, &icd_exts);
 
+        // only pass down the extensions this ICD supports
         for (uint32_t j = 0; j < pCreateInfo->enabledExtensionCount; j++) {
             prop = get_extension_property(
-                pCreateInfo->ppEnabledExtensionNames[j], &icd_exts);
+                pCreateInfo->ppEnabledExtensionNames[j],
+                &icd->this_icd_lib->instance_extension_list);
             if (prop) {
                 filtered_extension_names[icd_create_info
                                              .enabledExtensionCount] =
@@ -4059,9 +5081,6 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateInstance(
             }
         }
 
-        loader_destroy_generic_list(ptr_instance,
-                                    (struct loader_generic_list *)&icd_exts);
-
         res = ptr_instance->icd_libs.list[i].CreateInstance(
             &icd_create_info, pAllocator, &(icd->instance));
         if (res == VK_SUCCESS)
@@ -4101,20 +5120,7 @@ VKAPI_ATTR void VKAPI_CALL terminator_DestroyInstance(
     struct loader_icd *next_icd;
 
     // Remove this instance from the list of instances:
-    struct loader_instance *prev = NULL;
-    struct loader_instance *next = loader.instances;
-    while (next != NULL) {
-        if (next == ptr_instance) {
-            // Remove this instance from the list:
-            if (prev)
-                prev->next = next->next;
-            else
-                loader.instances = next->next;
-            break;
-        }
-        prev = next;
-        next = next->next;
-    }
+    loader_remove_instance(ptr_instance);
 
     while (icds) {
         if (icds->instance) {
@@ -4218,9 +5224,19 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDevice(
         goto out;
     }
 
+    res = loader_add_logical_device(phys_dev->this_icd->this_instance,
+                                    phys_dev->this_icd, dev);
+    if (res != VK_SUCCESS) {
+        PFN_vkDestroyDevice destroy_device =
+            (PFN_vkDestroyDevice)phys_dev->this_icd->GetDeviceProcAddr(
+                dev->device, "vkDestroyDevice");
+        if (destroy_device != NULL) {
+            destroy_device(dev->device, pAllocator);
+        }
+        dev->device = VK_NULL_HANDLE;
+        goto out;
+    }
     *pDevice = dev->device;
-    loader_add_logical_device(phys_dev->this_icd->this_instance,
-                              phys_dev->this_icd, dev);
 
     /* Init dispatch pointer in new device object */
     loader_init_dispatch(*pDevice, &dev->loader_dispatch);
@@ -137,20 +137,21 @@ struct loader_layer_list {
     struct loader_layer_properties *list;
 };
 
-struct loader_dispatch_hash_list {
-    size_t capacity;
-    uint32_t count;
-    uint32_t *index; // index into the dev_ext dispatch table
+#define MAX_NUM_DEV_EXTS 1024
+// Unknown device entrypoints are given trampoline slots in the order they are
+// first looked up.  Each slot is a function in the generated
+// dev_ext_trampoline.c and an entry in loader_dev_ext_dispatch_table.DevExt;
+// loader_dev_ext_map finds the slot for a name.
+struct loader_dev_ext_map_entry {
+    const char *func_name; // NULL for an empty entry
+    uint32_t hash;
+    uint32_t slot;
 };
 
-#define MAX_NUM_DEV_EXTS 250
-// loader_dispatch_hash_entry and loader_dev_ext_dispatch_table.DevExt have one
-// to one
-// correspondence; one loader_dispatch_hash_entry for one DevExt dispatch entry.
-// Also have a one to one correspondence with functions in dev_ext_trampoline.c
-struct loader_dispatch_hash_entry {
-    char *func_name;
-    struct loader_dispatch_hash_list list; // to handle hashing collisions
+struct loader_dev_ext_map {
+    uint32_t count;
+    uint32_t capacity; // zero or a power of two
+    struct loader_dev_ext_map_entry *entries;
 };
 
 typedef void(VKAPI_PTR *PFN_vkDevExt)(VkDevice device);
@@ -264,7 +265,9 @@ struct loader_instance {
     struct loader_extension_list ext_list; // icds and loaders extensions
     struct loader_icd_libs icd_libs;
     struct loader_layer_list instance_layer_list;
-    struct loader_dispatch_hash_entry disp_hash[MAX_NUM_DEV_EXTS];
+    uint32_t dev_ext_count; // trampoline slots in use
+    char *dev_ext_names[MAX_NUM_DEV_EXTS];
+    struct loader_dev_ext_map dev_ext_map;
 
     struct loader_msg_callback_map_entry *icd_msg_callback_map;
 
@@ -329,8 +332,25 @@ struct loader_physical_device {
     VkPhysicalDevice phys_dev; // object from ICD
 };
 
+/* Index from a dispatch table pointer to the loader object that owns it */
+struct loader_dispatch_map_entry {
+    const void *disp;
+    void *object;
+    struct loader_icd *icd;
+};
+
+struct loader_dispatch_map {
+    uint32_t count;
+    uint32_t capacity; // zero or a power of two
+    struct loader_dispatch_map_entry *entries;
+};
+
 struct loader_struct {
     struct loader_instance *instances;
+
+    // Dispatchable handle lookups, protected by loader_dispatch_map_lock
+    struct loader_dispatch_map instance_map; // instance dispatch -> instance
+    struct loader_dispatch_map device_map;   // device dispatch -> device
 };
 
 struct loader_scanned_icds {
@@ -342,6 +362,8 @@ struct loader_scanned_icds {
     PFN_vkCreateInstance CreateInstance;
     PFN_vkEnumerateInstanceExtensionProperties
         EnumerateInstanceExtensionProperties;
+    // Queried once when the ICD is scanned
+    struct loader_extension_list instance_extension_list;
 };
 
 static inline struct loader_instance *loader_instance(VkInstance instance) {
@@ -389,6 +411,7 @@ extern THREAD_LOCAL_DECL struct loader_instance *tls_instance;
 extern LOADER_PLATFORM_THREAD_ONCE_DEFINITION(once_init);
 extern loader_platform_thread_mutex loader_lock;
 extern loader_platform_thread_mutex loader_json_lock;
+extern loader_platform_thread_mutex loader_dispatch_map_lock;
 extern const VkLayerInstanceDispatchTable instance_disp;
 extern const char *std_validation_str;
 
@@ -410,6 +433,10 @@ void *loader_device_heap_realloc(const struct loader_device *device, void *pMemo
 void loader_log(const struct loader_instance *inst, VkFlags msg_type,
                 int32_t msg_code, const char *format, ...);
 
+uint64_t loader_trace_begin(void);
+void loader_trace_end(const struct loader_instance *inst, uint64_t start,
+                      const char *name, const char *detail);
+
 bool compare_vk_extension_properties(const VkExtensionProperties *op1,
                                      const VkExtensionProperties *op2);
 
@@ -499,14 +526,25 @@ void loader_init_dispatch_dev_ext(struct loader_instance *inst,
 void *loader_dev_ext_gpa(struct loader_instance *inst, const char *funcName);
 void *loader_get_dev_ext_trampoline(uint32_t index);
 struct loader_instance *loader_get_instance(const VkInstance instance);
+VkResult loader_add_instance(struct loader_instance *inst);
+void loader_remove_instance(struct loader_instance *inst);
 void loader_deactivate_layers(const struct loader_instance *instance,
                               struct loader_device *device,
                               struct loader_layer_list *list);
 struct loader_device *
 loader_create_logical_device(const struct loader_instance *inst, const VkAllocationCallbacks *pAllocator);
-void loader_add_logical_device(const struct loader_instance *inst,
-                               struct loader_icd *icd,
-                               struct loader_device *found_dev);
+/* Optional ICD entrypoints (WSI, display and debug report) are resolved the
+ * first time they are used instead of at vkCreateInstance.  Read them with
+ * LOADER_ICD_PROC, which gives NULL if the ICD doesn't support the command. */
+#define LOADER_ICD_PROC(icd, func)                                             \
+    ((PFN_vk##func)loader_icd_get_proc(                                        \
+        (icd), (PFN_vkVoidFunction *)&(icd)->func, "vk" #func))
+PFN_vkVoidFunction loader_icd_get_proc(struct loader_icd *icd,
+                                       PFN_vkVoidFunction *slot,
+                                       const char *name);
+VkResult loader_add_logical_device(const struct loader_instance *inst,
+                                   struct loader_icd *icd,
+                                   struct loader_device *found_dev);
 void loader_remove_logical_device(const struct loader_instance *inst,
                                   struct loader_icd *icd,
                                   struct loader_device *found_dev,
@@ -271,8 +271,10 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(
     VkInstance created_instance = VK_NULL_HANDLE;
     bool loaderLocked = false;
     VkResult res = VK_ERROR_INITIALIZATION_FAILED;
+    uint64_t trace, chain_trace;
 
     loader_platform_thread_once(&once_init, loader_initialize);
+    trace = loader_trace_begin();
 
 #if (DEBUG_DISABLE_APP_ALLOCATORS == 1)
     {
@@ -383,8 +385,10 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(
         goto out;
     }
     memcpy(ptr_instance->disp, &instance_disp, sizeof(instance_disp));
-    ptr_instance->next = loader.instances;
-    loader.instances = ptr_instance;
+    res = loader_add_instance(ptr_instance);
+    if (res != VK_SUCCESS) {
+        goto out;
+    }
 
     /* activate any layers on instance chain */
     res = loader_enable_instance_layers(ptr_instance, &ici,
@@ -394,8 +398,10 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(
     }
 
     created_instance = (VkInstance)ptr_instance;
+    chain_trace = loader_trace_begin();
     res = loader_create_instance_chain(&ici, pAllocator, ptr_instance,
                                        &created_instance);
+    loader_trace_end(ptr_instance, chain_trace, "Create instance chain", NULL);
 
     if (res == VK_SUCCESS) {
         wsi_create_instance(ptr_instance, &ici);
@@ -418,9 +424,7 @@ out:
 
     if (NULL != ptr_instance) {
         if (res != VK_SUCCESS) {
-            if (NULL != ptr_instance->next) {
-                loader.instances = ptr_instance->next;
-            }
+            loader_remove_instance(ptr_instance);
             if (NULL != ptr_instance->disp) {
                 loader_instance_heap_free(ptr_instance, ptr_instance->disp);
             }
@@ -460,6 +464,8 @@ out:
         }
     }
 
+    loader_trace_end(res == VK_SUCCESS ? ptr_instance : NULL, trace,
+                     "vkCreateInstance", NULL);
     return res;
 }
 
@@ -647,10 +653,12 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateDevice(
     struct loader_physical_device_tramp *phys_dev = NULL;
     struct loader_device *dev = NULL;
     struct loader_instance *inst = NULL;
+    uint64_t trace, chain_trace;
 
     assert(pCreateInfo->queueCreateInfoCount >= 1);
 
     loader_platform_thread_lock_mutex(&loader_lock);
+    trace = loader_trace_begin();
 
     phys_dev = (struct loader_physical_device_tramp *)physicalDevice;
     inst = (struct loader_instance *)phys_dev->this_instance;
@@ -698,8 +706,10 @@ LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateDevice(
            sizeof(*dev->activated_layer_list.list) *
                dev->activated_layer_list.count);
 
+    chain_trace = loader_trace_begin();
     res = loader_create_device_chain(phys_dev, pCreateInfo, pAllocator, inst,
                                      dev);
+    loader_trace_end(inst, chain_trace, "Create device chain", NULL);
     if (res != VK_SUCCESS) {
         goto out;
     }
@@ -729,6 +739,7 @@ out:
         loader_destroy_generic_list(inst,
                                     (struct loader_generic_list *)&icd_exts);
     }
+    loader_trace_end(inst, trace, "vkCreateDevice", NULL);
     loader_platform_thread_unlock_mutex(&loader_lock);
     return res;
 }
@@ -116,33 +116,44 @@ class Subcommand(object):
         pass
 
 class DevExtTrampolineSubcommand(Subcommand):
+    def _max_num_dev_exts(self):
+        # One trampoline for every slot of loader_dev_ext_dispatch_table
+        with open(os.path.join(ld_path, "loader.h")) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) == 3 and fields[0] == "#define" and fields[1] == "MAX_NUM_DEV_EXTS":
+                    return int(fields[2])
+        raise Exception("MAX_NUM_DEV_EXTS not found in loader.h")
+
     def generate_header(self):
         lines = []
+        lines.append("#define _GNU_SOURCE")
         lines.append("#include \"vk_loader_platform.h\"")
         lines.append("#include \"loader.h\"")
         lines.append("#if defined(__linux__)")
-        lines.append("#pragma GCC optimize(3)  // force gcc to use tail-calls")
+        lines.append("#pragma GCC optimize(3) // force gcc to use tail-calls")
         lines.append("#endif")
         return "\n".join(lines)
 
     def generate_body(self):
+        count = self._max_num_dev_exts()
         lines = []
-        for i in range(250):
-            lines.append('\nVKAPI_ATTR void VKAPI_CALL vkDevExt%s(VkDevice device)' % i)
-            lines.append('{')
+        for i in range(count):
+            lines.append('static VKAPI_ATTR void VKAPI_CALL vkDevExt%s(VkDevice device) {' % i)
             lines.append('    const struct loader_dev_dispatch_table *disp;')
             lines.append('    disp = loader_get_dev_dispatch(device);')
             lines.append('    disp->ext_dispatch.DevExt[%s](device);' % i)
             lines.append('}')
+            lines.append('')
+        lines.append('static const PFN_vkDevExt loader_dev_ext_trampolines[MAX_NUM_DEV_EXTS] = {')
+        for i in range(count):
+            lines.append('    vkDevExt%s,' % i)
+        lines.append('};')
         lines.append('')
-        lines.append('void *loader_get_dev_ext_trampoline(uint32_t index)')
-        lines.append('{')
-        lines.append('    switch (index) {')
-        for i in range(250):
-            lines.append('        case %s:' % i)
-            lines.append('            return vkDevExt%s;' % i)
-        lines.append('    }')
-        lines.append('    return NULL;')
+        lines.append('void *loader_get_dev_ext_trampoline(uint32_t index) {')
+        lines.append('    if (index >= MAX_NUM_DEV_EXTS)')
+        lines.append('        return NULL;')
+        lines.append('    return (void *)loader_dev_ext_trampolines[index];')
         lines.append('}')
         return "\n".join(lines)
 
@@ -45,6 +45,8 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <libgen.h>
+#include <sys/stat.h>
+#include <time.h>
 
 // VK Library Filenames, Paths, etc.:
 #define PATH_SEPERATOR ':'
@@ -117,6 +119,26 @@ static inline char *loader_platform_dirname(char *path) {
     return dirname(path);
 }
 
+// Modification time and size of a file or directory, used to tell whether
+// manifests have changed since they were last read
+static inline bool loader_platform_file_stamp(const char *path,
+                                              uint64_t *mtime,
+                                              uint64_t *size) {
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return false;
+#if defined(st_mtime)
+    // glibc defines st_mtime in terms of st_mtim when the nanosecond
+    // timestamps are available
+    *mtime = (uint64_t)st.st_mtim.tv_sec * 1000000000ull +
+             (uint64_t)st.st_mtim.tv_nsec;
+#else
+    *mtime = (uint64_t)st.st_mtime * 1000000000ull;
+#endif
+    *size = (uint64_t)st.st_size;
+    return true;
+}
+
 // Dynamic Loading of libraries:
 typedef void *loader_platform_dl_handle;
 static inline loader_platform_dl_handle
@@ -162,6 +184,14 @@ static inline loader_platform_thread_id loader_platform_get_thread_id() {
     return pthread_self();
 }
 
+// Time:
+// Monotonic nanoseconds, for timing the loader's own work
+static inline uint64_t loader_platform_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
 // Thread mutex:
 typedef pthread_mutex_t loader_platform_thread_mutex;
 static inline void
@@ -252,6 +282,19 @@ static bool loader_platform_is_path_absolute(const char *path) {
     return !PathIsRelative(path);
 }
 
+// Modification time and size of a file or directory, used to tell whether
+// manifests have changed since they were last read
+static bool loader_platform_file_stamp(const char *path, uint64_t *mtime,
+                                       uint64_t *size) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data))
+        return false;
+    *mtime = ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) |
+             data.ftLastWriteTime.dwLowDateTime;
+    *size = ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    return true;
+}
+
 // WIN32 runtime doesn't have dirname().
 static inline char *loader_platform_dirname(char *path) {
     char *current, *next;
@@ -349,6 +392,17 @@ static loader_platform_thread_id loader_platform_get_thread_id() {
     return GetCurrentThreadId();
 }
 
+// Time:
+// Monotonic nanoseconds, for timing the loader's own work
+static uint64_t loader_platform_time_ns(void) {
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (uint64_t)(count.QuadPart / freq.QuadPart) * 1000000000ull +
+           (uint64_t)(count.QuadPart % freq.QuadPart) * 1000000000ull /
+               (uint64_t)freq.QuadPart;
+}
+
 // Thread mutex:
 typedef CRITICAL_SECTION loader_platform_thread_mutex;
 static void
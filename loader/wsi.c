@@ -263,10 +263,10 @@ terminator_GetPhysicalDeviceSurfaceSupportKHR(VkPhysicalDevice physicalDevice,
            "GetPhysicalDeviceSurfaceSupportKHR: Error, null pSupported");
     *pSupported = false;
 
-    assert(icd->GetPhysicalDeviceSurfaceSupportKHR &&
+    assert(LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceSupportKHR) &&
            "loader: null GetPhysicalDeviceSurfaceSupportKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceSurfaceSupportKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceSupportKHR)(
         phys_dev->phys_dev, queueFamilyIndex, surface, pSupported);
 }
 
@@ -314,10 +314,10 @@ terminator_GetPhysicalDeviceSurfaceCapabilitiesKHR(
     assert(pSurfaceCapabilities && "GetPhysicalDeviceSurfaceCapabilitiesKHR: "
                                    "Error, null pSurfaceCapabilities");
 
-    assert(icd->GetPhysicalDeviceSurfaceCapabilitiesKHR &&
+    assert(LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceCapabilitiesKHR) &&
            "loader: null GetPhysicalDeviceSurfaceCapabilitiesKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceSurfaceCapabilitiesKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceCapabilitiesKHR)(
         phys_dev->phys_dev, surface, pSurfaceCapabilities);
 }
 
@@ -365,10 +365,10 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceSurfaceFormatsKHR(
         pSurfaceFormatCount &&
         "GetPhysicalDeviceSurfaceFormatsKHR: Error, null pSurfaceFormatCount");
 
-    assert(icd->GetPhysicalDeviceSurfaceFormatsKHR &&
+    assert(LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceFormatsKHR) &&
            "loader: null GetPhysicalDeviceSurfaceFormatsKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceSurfaceFormatsKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfaceFormatsKHR)(
         phys_dev->phys_dev, surface, pSurfaceFormatCount, pSurfaceFormats);
 }
 
@@ -416,10 +416,10 @@ terminator_GetPhysicalDeviceSurfacePresentModesKHR(
     assert(pPresentModeCount && "GetPhysicalDeviceSurfacePresentModesKHR: "
                                 "Error, null pPresentModeCount");
 
-    assert(icd->GetPhysicalDeviceSurfacePresentModesKHR &&
+    assert(LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfacePresentModesKHR) &&
            "loader: null GetPhysicalDeviceSurfacePresentModesKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceSurfacePresentModesKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceSurfacePresentModesKHR)(
         phys_dev->phys_dev, surface, pPresentModeCount, pPresentModes);
 }
 
@@ -591,12 +591,13 @@ terminator_GetPhysicalDeviceWin32PresentationSupportKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetPhysicalDeviceWin32PresentationSupportKHR &&
-           "loader: null GetPhysicalDeviceWin32PresentationSupportKHR ICD "
-           "pointer");
+    assert(
+        LOADER_ICD_PROC(icd, GetPhysicalDeviceWin32PresentationSupportKHR) &&
+        "loader: null GetPhysicalDeviceWin32PresentationSupportKHR ICD "
+        "pointer");
 
-    return icd->GetPhysicalDeviceWin32PresentationSupportKHR(phys_dev->phys_dev,
-                                                             queueFamilyIndex);
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceWin32PresentationSupportKHR)(
+        phys_dev->phys_dev, queueFamilyIndex);
 }
 #endif // VK_USE_PLATFORM_WIN32_KHR
 
@@ -807,11 +808,12 @@ terminator_GetPhysicalDeviceWaylandPresentationSupportKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetPhysicalDeviceWaylandPresentationSupportKHR &&
-           "loader: null GetPhysicalDeviceWaylandPresentationSupportKHR ICD "
-           "pointer");
+    assert(
+        LOADER_ICD_PROC(icd, GetPhysicalDeviceWaylandPresentationSupportKHR) &&
+        "loader: null GetPhysicalDeviceWaylandPresentationSupportKHR ICD "
+        "pointer");
 
-    return icd->GetPhysicalDeviceWaylandPresentationSupportKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceWaylandPresentationSupportKHR)(
         phys_dev->phys_dev, queueFamilyIndex, display);
 }
 #endif // VK_USE_PLATFORM_WAYLAND_KHR
@@ -916,10 +918,10 @@ terminator_GetPhysicalDeviceXcbPresentationSupportKHR(
     struct loader_icd *icd = phys_dev->this_icd;
 
     assert(
-        icd->GetPhysicalDeviceXcbPresentationSupportKHR &&
+        LOADER_ICD_PROC(icd, GetPhysicalDeviceXcbPresentationSupportKHR) &&
         "loader: null GetPhysicalDeviceXcbPresentationSupportKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceXcbPresentationSupportKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceXcbPresentationSupportKHR)(
         phys_dev->phys_dev, queueFamilyIndex, connection, visual_id);
 }
 #endif // VK_USE_PLATFORM_XCB_KHR
@@ -1023,10 +1025,10 @@ terminator_GetPhysicalDeviceXlibPresentationSupportKHR(
     struct loader_icd *icd = phys_dev->this_icd;
 
     assert(
-        icd->GetPhysicalDeviceXlibPresentationSupportKHR &&
+        LOADER_ICD_PROC(icd, GetPhysicalDeviceXlibPresentationSupportKHR) &&
         "loader: null GetPhysicalDeviceXlibPresentationSupportKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceXlibPresentationSupportKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceXlibPresentationSupportKHR)(
         phys_dev->phys_dev, queueFamilyIndex, dpy, visualID);
 }
 #endif // VK_USE_PLATFORM_XLIB_KHR
@@ -1123,10 +1125,10 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetPhysicalDeviceDisplayPropertiesKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetPhysicalDeviceDisplayPropertiesKHR &&
+    assert(LOADER_ICD_PROC(icd, GetPhysicalDeviceDisplayPropertiesKHR) &&
            "loader: null GetPhysicalDeviceDisplayPropertiesKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceDisplayPropertiesKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceDisplayPropertiesKHR)(
         phys_dev->phys_dev, pPropertyCount, pProperties);
 }
 
@@ -1164,10 +1166,10 @@ terminator_GetPhysicalDeviceDisplayPlanePropertiesKHR(
     struct loader_icd *icd = phys_dev->this_icd;
 
     assert(
-        icd->GetPhysicalDeviceDisplayPlanePropertiesKHR &&
+        LOADER_ICD_PROC(icd, GetPhysicalDeviceDisplayPlanePropertiesKHR) &&
         "loader: null GetPhysicalDeviceDisplayPlanePropertiesKHR ICD pointer");
 
-    return icd->GetPhysicalDeviceDisplayPlanePropertiesKHR(
+    return LOADER_ICD_PROC(icd, GetPhysicalDeviceDisplayPlanePropertiesKHR)(
         phys_dev->phys_dev, pPropertyCount, pProperties);
 }
 
@@ -1205,10 +1207,10 @@ terminator_GetDisplayPlaneSupportedDisplaysKHR(VkPhysicalDevice physicalDevice,
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetDisplayPlaneSupportedDisplaysKHR &&
+    assert(LOADER_ICD_PROC(icd, GetDisplayPlaneSupportedDisplaysKHR) &&
            "loader: null GetDisplayPlaneSupportedDisplaysKHR ICD pointer");
 
-    return icd->GetDisplayPlaneSupportedDisplaysKHR(
+    return LOADER_ICD_PROC(icd, GetDisplayPlaneSupportedDisplaysKHR)(
         phys_dev->phys_dev, planeIndex, pDisplayCount, pDisplays);
 }
 
@@ -1243,11 +1245,11 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetDisplayModePropertiesKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetDisplayModePropertiesKHR &&
+    assert(LOADER_ICD_PROC(icd, GetDisplayModePropertiesKHR) &&
            "loader: null GetDisplayModePropertiesKHR ICD pointer");
 
-    return icd->GetDisplayModePropertiesKHR(phys_dev->phys_dev, display,
-                                            pPropertyCount, pProperties);
+    return LOADER_ICD_PROC(icd, GetDisplayModePropertiesKHR)(
+        phys_dev->phys_dev, display, pPropertyCount, pProperties);
 }
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateDisplayModeKHR(
@@ -1282,11 +1284,11 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_CreateDisplayModeKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->CreateDisplayModeKHR &&
+    assert(LOADER_ICD_PROC(icd, CreateDisplayModeKHR) &&
            "loader: null CreateDisplayModeKHR ICD pointer");
 
-    return icd->CreateDisplayModeKHR(phys_dev->phys_dev, display, pCreateInfo,
-                                     pAllocator, pMode);
+    return LOADER_ICD_PROC(icd, CreateDisplayModeKHR)(
+        phys_dev->phys_dev, display, pCreateInfo, pAllocator, pMode);
 }
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL
@@ -1320,11 +1322,11 @@ VKAPI_ATTR VkResult VKAPI_CALL terminator_GetDisplayPlaneCapabilitiesKHR(
     // Next, if so, proceed with the implementation of this function:
     struct loader_icd *icd = phys_dev->this_icd;
 
-    assert(icd->GetDisplayPlaneCapabilitiesKHR &&
+    assert(LOADER_ICD_PROC(icd, GetDisplayPlaneCapabilitiesKHR) &&
            "loader: null GetDisplayPlaneCapabilitiesKHR ICD pointer");
 
-    return icd->GetDisplayPlaneCapabilitiesKHR(phys_dev->phys_dev, mode,
-                                               planeIndex, pCapabilities);
+    return LOADER_ICD_PROC(icd, GetDisplayPlaneCapabilitiesKHR)(
+        phys_dev->phys_dev, mode, planeIndex, pCapabilities);
 }
 
 LOADER_EXPORT VKAPI_ATTR VkResult VKAPI_CALL vkCreateDisplayPlaneSurfaceKHR(
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Tests of the entrypoint patterns api_dump's entrypoints and exclude_entrypoints settings take,
+// and the frame ranges its frames setting takes.
+
+#include <string>
+#include "gtest/gtest.h"
+#include "api_dump_filter.h"
+
+TEST(ApiDumpFilter, MatchesExactNames) {
+    EXPECT_TRUE(matchEntrypointList("vkQueueSubmit", "vkQueueSubmit"));
+    EXPECT_FALSE(matchEntrypointList("vkQueueSubmit", "vkQueueSubmit2"));
+    EXPECT_FALSE(matchEntrypointList("vkQueueSubmit", "vkQueue"));
+    EXPECT_FALSE(matchEntrypointList("", "vkQueueSubmit"));
+}
+
+TEST(ApiDumpFilter, MatchesWildcards) {
+    EXPECT_TRUE(matchEntrypointList("vkCmdDraw*", "vkCmdDraw"));
+    EXPECT_TRUE(matchEntrypointList("vkCmdDraw*", "vkCmdDrawIndexedIndirect"));
+    EXPECT_TRUE(matchEntrypointList("*Image*", "vkCmdCopyBufferToImage"));
+    EXPECT_TRUE(matchEntrypointList("*", "vkCreateDevice"));
+    EXPECT_FALSE(matchEntrypointList("vkCmd*Image", "vkCmdCopyImageToBuffer"));
+}
+
+TEST(ApiDumpFilter, MatchesAnyPatternInList) {
+    const char *list = "vkQueueSubmit,vkCmdDraw*";
+    EXPECT_TRUE(matchEntrypointList(list, "vkQueueSubmit"));
+    EXPECT_TRUE(matchEntrypointList(list, "vkCmdDrawIndexed"));
+    EXPECT_FALSE(matchEntrypointList(list, "vkCmdDispatch"));
+    EXPECT_TRUE(matchEntrypointList(",,vkQueueSubmit,", "vkQueueSubmit"));
+}
+
+TEST(ApiDumpFilter, IgnoresWhitespaceAroundPatterns) {
+    const char *list = " vkQueueSubmit , \tvkCmdDraw* ,vkCreateImage\n";
+    EXPECT_TRUE(matchEntrypointList(list, "vkQueueSubmit"));
+    EXPECT_TRUE(matchEntrypointList(list, "vkCmdDrawIndirect"));
+    EXPECT_TRUE(matchEntrypointList(list, "vkCreateImage"));
+    EXPECT_FALSE(matchEntrypointList(list, "vkCreateImageView"));
+    EXPECT_FALSE(matchEntrypointList(" , ", "vkQueueSubmit"));
+}
+
+TEST(ApiDumpFilter, StepsThroughPatterns) {
+    const char *list = " vkQueueSubmit ,, vkCmd* ";
+    const char *begin, *end;
+    ASSERT_TRUE(nextEntrypointPattern(&list, &begin, &end));
+    EXPECT_EQ("vkQueueSubmit", std::string(begin, end));
+    ASSERT_TRUE(nextEntrypointPattern(&list, &begin, &end));
+    EXPECT_EQ("vkCmd*", std::string(begin, end));
+    EXPECT_FALSE(nextEntrypointPattern(&list, &begin, &end));
+}
+
+TEST(ApiDumpFilter, ParsesFrameRanges) {
+    uint64_t first = 0, last = 0;
+    EXPECT_TRUE(parseFrameRange("100-110", &first, &last));
+    EXPECT_EQ(100u, first);
+    EXPECT_EQ(110u, last);
+    EXPECT_TRUE(parseFrameRange(" 100 -110 ", &first, &last));
+    EXPECT_EQ(100u, first);
+    EXPECT_EQ(110u, last);
+    EXPECT_TRUE(parseFrameRange("7 - ", &first, &last));
+    EXPECT_EQ(7u, first);
+    EXPECT_EQ(UINT64_MAX, last);
+    EXPECT_TRUE(parseFrameRange("42", &first, &last));
+    EXPECT_EQ(42u, first);
+    EXPECT_EQ(42u, last);
+    EXPECT_TRUE(parseFrameRange("5-5", &first, &last));
+    EXPECT_EQ(5u, first);
+    EXPECT_EQ(5u, last);
+}
+
+TEST(ApiDumpFilter, RejectsBadFrameRanges) {
+    static const char *const bad[] = {
+        "", " ", "-", "-10", "abc", "10x", "10-abc", "10-2x", "1 0", "110-100", "1-2-3", "+5", "99999999999999999999",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+        uint64_t first = 3, last = 4;
+        EXPECT_FALSE(parseFrameRange(bad[i], &first, &last)) << "frames: " << bad[i];
+        EXPECT_EQ(3u, first) << "frames: " << bad[i];
+        EXPECT_EQ(4u, last) << "frames: " << bad[i];
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+#include "benchmark_util.h"
+
+// Replace the global allocation functions so benchmarks can report allocations per call.
+// Only allocations made from code linked into the benchmark executable are counted.
+static std::atomic<uint64_t> allocation_count(0);
+
+uint64_t benchmark_allocation_count() { return allocation_count.load(std::memory_order_relaxed); }
+
+void benchmark_count_allocation() { allocation_count.fetch_add(1, std::memory_order_relaxed); }
+
+static void *volatile escaped_ptr;
+
+void benchmark_escape(void *ptr) { escaped_ptr = ptr; }
+
+void *operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) throw() { free(ptr); }
+
+void operator delete[](void *ptr) throw() { free(ptr); }
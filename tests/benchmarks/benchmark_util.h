@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Minimal timing and allocation-counting helpers shared by the benchmark executables.
+// Benchmarks print one line per case; they are not part of the gtest suites.
+
+#ifndef BENCHMARK_UTIL_H
+#define BENCHMARK_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+// Number of operator new / new[] calls made by the process so far (see benchmark_util.cpp), plus
+// any C allocations a benchmark reports through benchmark_count_allocation
+uint64_t benchmark_allocation_count();
+
+// Counts one allocation made other than by operator new, e.g. from a malloc hook
+void benchmark_count_allocation();
+
+// Opaque to the optimizer: objects passed here must be assumed read and modified, which keeps
+// loop-invariant work inside timed loops
+void benchmark_escape(void *ptr);
+
+class BenchmarkTimer {
+  public:
+    BenchmarkTimer() : start_(std::chrono::high_resolution_clock::now()), allocs_(benchmark_allocation_count()) {}
+
+    double elapsed_ns() const {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_)
+            .count();
+    }
+
+    uint64_t allocations() const { return benchmark_allocation_count() - allocs_; }
+
+  private:
+    std::chrono::high_resolution_clock::time_point start_;
+    uint64_t allocs_;
+};
+
+static inline void benchmark_report(const char *name, uint64_t calls, const BenchmarkTimer &timer) {
+    printf("%-48s %10llu calls %12.1f ns/call %10.2f allocs/call\n", name, (unsigned long long)calls, timer.elapsed_ns() / calls,
+           (double)timer.allocations() / calls);
+}
+
+// For cases whose allocations go through malloc where the benchmark can't see them
+static inline void benchmark_report_time(const char *name, uint64_t calls, const BenchmarkTimer &timer) {
+    printf("%-48s %10llu calls %12.1f ns/call\n", name, (unsigned long long)calls, timer.elapsed_ns() / calls);
+}
+
+#endif // BENCHMARK_UTIL_H
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures what a command costs to call through the loader with layers enabled that don't
+// intercept it.  vkCmdSetLineWidth is recorded against the null driver through the loader's
+// exported entrypoint and through the pointer vkGetDeviceProcAddr returns, with no layers, with
+// layers that leave the command alone, and with layers that check it.
+//
+// Layers that don't intercept a command return the next layer's pointer for it, so the device
+// dispatch table and vkGetDeviceProcAddr should end up at the first layer that does, or at the
+// driver.  The benchmark reports which one each configuration resolves to.
+//
+// The loader must be able to find the null driver and the layers.  Unless VK_ICD_FILENAMES and
+// VK_LAYER_PATH are already set, the paths from the build tree are used.
+//
+// Usage: vk_call_chain_benchmark [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "benchmark_util.h"
+
+struct LayerConfig {
+    const char *name;
+    std::vector<const char *> layers;
+};
+
+struct DeviceContext {
+    VkInstance instance;
+    VkDevice device;
+    VkCommandPool pool;
+    VkCommandBuffer cmd;
+};
+
+static void set_default_env(const char *name, const char *value) {
+    if (getenv(name) != NULL)
+        return;
+#if defined(_WIN32)
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 0);
+#endif
+}
+
+static bool create_context(const LayerConfig &config, DeviceContext &ctx) {
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instance_info.enabledLayerCount = (uint32_t)config.layers.size();
+    instance_info.ppEnabledLayerNames = config.layers.empty() ? NULL : config.layers.data();
+    if (vkCreateInstance(&instance_info, NULL, &ctx.instance) != VK_SUCCESS) {
+        printf("%s: vkCreateInstance failed\n", config.name);
+        return false;
+    }
+
+    VkPhysicalDevice gpu;
+    uint32_t gpu_count = 1;
+    VkResult result = vkEnumeratePhysicalDevices(ctx.instance, &gpu_count, &gpu);
+    if (result < 0 || gpu_count == 0) {
+        printf("%s: no physical devices\n", config.name);
+        vkDestroyInstance(ctx.instance, NULL);
+        return false;
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = 0;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+    device_info.enabledLayerCount = instance_info.enabledLayerCount;
+    device_info.ppEnabledLayerNames = instance_info.ppEnabledLayerNames;
+    if (vkCreateDevice(gpu, &device_info, NULL, &ctx.device) != VK_SUCCESS) {
+        printf("%s: vkCreateDevice failed\n", config.name);
+        vkDestroyInstance(ctx.instance, NULL);
+        return false;
+    }
+
+    VkCommandPoolCreateInfo pool_info = {};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.queueFamilyIndex = 0;
+    vkCreateCommandPool(ctx.device, &pool_info, NULL, &ctx.pool);
+
+    VkCommandBufferAllocateInfo cmd_info = {};
+    cmd_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmd_info.commandPool = ctx.pool;
+    cmd_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmd_info.commandBufferCount = 1;
+    vkAllocateCommandBuffers(ctx.device, &cmd_info, &ctx.cmd);
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    vkBeginCommandBuffer(ctx.cmd, &begin_info);
+    return true;
+}
+
+static void destroy_context(DeviceContext &ctx) {
+    vkEndCommandBuffer(ctx.cmd);
+    vkDestroyCommandPool(ctx.device, ctx.pool, NULL);
+    vkDestroyDevice(ctx.device, NULL);
+    vkDestroyInstance(ctx.instance, NULL);
+}
+
+static void run_config(const LayerConfig &config, const DeviceContext &ctx, PFN_vkCmdSetLineWidth driver_entry,
+                       uint32_t iterations) {
+    PFN_vkCmdSetLineWidth entry = (PFN_vkCmdSetLineWidth)vkGetDeviceProcAddr(ctx.device, "vkCmdSetLineWidth");
+    std::string label;
+
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i)
+            vkCmdSetLineWidth(ctx.cmd, 1.0f);
+        label = std::string(config.name) + " vkCmdSetLineWidth(exported)";
+        benchmark_report(label.c_str(), iterations, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i)
+            entry(ctx.cmd, 1.0f);
+        label = std::string(config.name) + " vkCmdSetLineWidth(device proc)";
+        benchmark_report(label.c_str(), iterations, timer);
+    }
+    printf("%-48s %s\n", config.name, entry == driver_entry ? "resolves to the driver" : "resolves to a layer");
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = (argc > 1) ? (uint32_t)atoi(argv[1]) : 10000000;
+
+#if defined(BENCHMARK_ICD_FILENAMES)
+    set_default_env("VK_ICD_FILENAMES", BENCHMARK_ICD_FILENAMES);
+#endif
+#if defined(BENCHMARK_LAYER_PATH)
+    set_default_env("VK_LAYER_PATH", BENCHMARK_LAYER_PATH);
+#endif
+
+    std::vector<LayerConfig> configs;
+    configs.push_back(LayerConfig{"none", {}});
+    // None of these intercept vkCmdSetLineWidth
+    configs.push_back(LayerConfig{"image", {"VK_LAYER_LUNARG_image"}});
+    configs.push_back(LayerConfig{"three_layers",
+                                  {"VK_LAYER_LUNARG_image", "VK_LAYER_LUNARG_swapchain", "VK_LAYER_GOOGLE_unique_objects"}});
+    // These do
+    configs.push_back(LayerConfig{"param_check", {"VK_LAYER_LUNARG_parameter_validation"}});
+    configs.push_back(LayerConfig{"param_check+2",
+                                  {"VK_LAYER_LUNARG_parameter_validation", "VK_LAYER_LUNARG_image", "VK_LAYER_LUNARG_swapchain"}});
+
+    // The driver's entrypoint, as seen without layers; kept alive so the driver stays loaded
+    DeviceContext baseline;
+    if (!create_context(configs[0], baseline))
+        return 1;
+    PFN_vkCmdSetLineWidth driver_entry = (PFN_vkCmdSetLineWidth)vkGetDeviceProcAddr(baseline.device, "vkCmdSetLineWidth");
+
+    bool ok = true;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        DeviceContext ctx;
+        if (!create_context(configs[i], ctx)) {
+            ok = false;
+            continue;
+        }
+        run_config(configs[i], ctx, driver_entry, iterations);
+        destroy_context(ctx);
+    }
+
+    destroy_context(baseline);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Churns the Intel ICD's descriptor allocator (icd/intel/desc_allocator.c) the way desc.c drives
+// it: a device region hands out surface and sampler space to descriptor pools, and each pool hands
+// out space to its sets.  Pools are created and destroyed continuously, and sets are allocated and
+// freed individually as with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT.  Also reports how
+// many pools the old bump allocator would have created before running out of region.
+//
+// Usage: vk_desc_allocator_benchmark [pool count]
+
+#include <stdlib.h>
+#include <new>
+#include <random>
+#include <vector>
+#include "benchmark_util.h"
+
+extern "C" {
+#include "desc_allocator.h"
+}
+
+// desc.c sizes the region for 1M surface and 1M sampler descriptors
+static const uint32_t kSurfaceSize = 64;
+static const uint32_t kSamplerSize = 16;
+static const uint32_t kRegionDescCount = 1024 * 1024;
+static const uint32_t kLivePools = 64;
+
+// Counted by benchmark_util.cpp
+extern "C" void *intel_alloc(const void *handle, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    return ::operator new(size);
+}
+
+extern "C" void intel_free(const void *handle, void *ptr) { ::operator delete(ptr); }
+
+struct Space {
+    uint32_t surface;
+    uint32_t sampler;
+};
+
+struct Set {
+    Space begin;
+    Space size;
+};
+
+struct Pool {
+    Space begin;
+    Space size;
+    intel_desc_allocator surfaces;
+    intel_desc_allocator samplers;
+    std::vector<Set> sets;
+};
+
+static bool alloc_space(intel_desc_allocator *surfaces, intel_desc_allocator *samplers, const Space &size, Space *begin) {
+    if (intel_desc_allocator_alloc(surfaces, size.surface, &begin->surface) != VK_SUCCESS)
+        return false;
+    if (intel_desc_allocator_alloc(samplers, size.sampler, &begin->sampler) != VK_SUCCESS) {
+        intel_desc_allocator_free(surfaces, begin->surface, size.surface);
+        return false;
+    }
+    return true;
+}
+
+static void free_space(intel_desc_allocator *surfaces, intel_desc_allocator *samplers, const Space &begin, const Space &size) {
+    intel_desc_allocator_free(surfaces, begin.surface, size.surface);
+    intel_desc_allocator_free(samplers, begin.sampler, size.sampler);
+}
+
+int main(int argc, char **argv) {
+    const uint32_t pool_count = (argc > 1) ? atoi(argv[1]) : 200000;
+    std::mt19937 rng(42);
+
+    intel_desc_allocator region_surfaces, region_samplers;
+    intel_desc_allocator_init(&region_surfaces, NULL, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, 0, kSurfaceSize * kRegionDescCount);
+    intel_desc_allocator_init(&region_samplers, NULL, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, 0, kSamplerSize * kRegionDescCount);
+
+    std::vector<Pool *> pools(kLivePools, nullptr);
+    uint64_t bump_surface = 0, bump_sampler = 0;
+    uint32_t bump_exhausted_at = 0;
+    uint64_t set_allocs = 0, set_frees = 0, failures = 0;
+    double set_ns = 0.0;
+
+    BenchmarkTimer timer;
+    for (uint32_t i = 0; i < pool_count; i++) {
+        Pool *&slot = pools[rng() % kLivePools];
+        if (slot) {
+            // vkDestroyDescriptorPool
+            intel_desc_allocator_cleanup(&slot->samplers);
+            intel_desc_allocator_cleanup(&slot->surfaces);
+            free_space(&region_surfaces, &region_samplers, slot->begin, slot->size);
+            delete slot;
+            slot = nullptr;
+        }
+
+        // vkCreateDescriptorPool with maxSets from 16 to 256, each of up to 8 image/sampler pairs
+        // and 8 buffers
+        Pool *pool = new Pool;
+        const uint32_t max_sets = 16 << (rng() % 5);
+        pool->size.surface = max_sets * 16 * kSurfaceSize;
+        pool->size.sampler = max_sets * 8 * kSamplerSize;
+        if (!alloc_space(&region_surfaces, &region_samplers, pool->size, &pool->begin)) {
+            failures++;
+            delete pool;
+            continue;
+        }
+        intel_desc_allocator_init(&pool->surfaces, pool, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT, pool->begin.surface,
+                                  pool->begin.surface + pool->size.surface);
+        intel_desc_allocator_init(&pool->samplers, pool, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT, pool->begin.sampler,
+                                  pool->begin.sampler + pool->size.sampler);
+        pool->sets.reserve(max_sets);
+        slot = pool;
+
+        bump_surface += pool->size.surface;
+        bump_sampler += pool->size.sampler;
+        if (!bump_exhausted_at &&
+            (bump_surface > kSurfaceSize * kRegionDescCount || bump_sampler > kSamplerSize * kRegionDescCount))
+            bump_exhausted_at = i + 1;
+
+        // vkAllocateDescriptorSets and vkFreeDescriptorSets in random order, leaving the pool
+        // partly used
+        BenchmarkTimer set_timer;
+        for (uint32_t j = 0; j < max_sets * 2; j++) {
+            if (pool->sets.empty() || rng() % 3) {
+                Set set;
+                const uint32_t pairs = 1 + rng() % 8;
+                set.size.surface = (pairs + rng() % 9) * kSurfaceSize;
+                set.size.sampler = pairs * kSamplerSize;
+                if (!alloc_space(&pool->surfaces, &pool->samplers, set.size, &set.begin))
+                    continue;
+                pool->sets.push_back(set);
+                set_allocs++;
+            } else {
+                const size_t index = rng() % pool->sets.size();
+                free_space(&pool->surfaces, &pool->samplers, pool->sets[index].begin, pool->sets[index].size);
+                pool->sets[index] = pool->sets.back();
+                pool->sets.pop_back();
+                set_frees++;
+            }
+        }
+        set_ns += set_timer.elapsed_ns();
+    }
+    const double total_ns = timer.elapsed_ns();
+
+    printf("%-48s %10u pools  %12.1f ns/pool\n", "pool create, set churn, pool destroy", pool_count, total_ns / pool_count);
+    printf("%-48s %10llu ops    %12.1f ns/op\n", "set alloc and free", (unsigned long long)(set_allocs + set_frees),
+           set_ns / (set_allocs + set_frees));
+    printf("%-48s %10llu\n", "pool creations that ran out of region", (unsigned long long)failures);
+    if (bump_exhausted_at)
+        printf("%-48s %10u\n", "bump allocator would have run out at pool", bump_exhausted_at);
+    else
+        printf("%-48s %10s\n", "bump allocator would have run out at pool", "never");
+
+    for (uint32_t i = 0; i < kLivePools; i++) {
+        if (pools[i]) {
+            intel_desc_allocator_cleanup(&pools[i]->samplers);
+            intel_desc_allocator_cleanup(&pools[i]->surfaces);
+            delete pools[i];
+        }
+    }
+    intel_desc_allocator_cleanup(&region_samplers);
+    intel_desc_allocator_cleanup(&region_surfaces);
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
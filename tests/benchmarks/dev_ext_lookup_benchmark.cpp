@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures how the loader resolves device entrypoints it has no trampoline of its own for.  Writes
+// a layer manifest that lists many device extension entrypoints, which is enough for the loader to
+// hand out a trampoline for each, then looks every name up through vkGetInstanceProcAddr: once to
+// assign the trampolines, and repeatedly afterwards, which only searches the name index.  Names the
+// loader refuses are counted and reported.
+//
+// The manifest's library is never loaded since the layer isn't enabled.  Unless VK_ICD_FILENAMES
+// is already set, the null driver from the build tree is used.
+//
+// Usage: vk_dev_ext_lookup_benchmark [names] [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "benchmark_util.h"
+
+static void set_env(const char *name, const std::string &value, bool overwrite) {
+    if (!overwrite && getenv(name) != NULL)
+        return;
+#if defined(_WIN32)
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+static bool write_manifest(const std::string &path, const std::vector<std::string> &names) {
+    std::ofstream out(path.c_str(), std::ios::trunc);
+    out << "{\n"
+           "    \"file_format_version\" : \"1.0.0\",\n"
+           "    \"layer\" : {\n"
+           "        \"name\": \"VK_LAYER_BENCH_dev_ext_lookup\",\n"
+           "        \"type\": \"GLOBAL\",\n"
+           "        \"library_path\": \"./libVkLayer_bench_dev_ext_lookup.so\",\n"
+           "        \"api_version\": \"1.0.21\",\n"
+           "        \"implementation_version\": \"1\",\n"
+           "        \"description\": \"Synthetic layer for vk_dev_ext_lookup_benchmark\",\n"
+           "        \"device_extensions\": [\n"
+           "             {\n"
+           "                 \"name\": \"VK_BENCH_dev_ext_lookup\",\n"
+           "                 \"spec_version\": \"1\",\n"
+           "                 \"entrypoints\": [";
+    for (size_t i = 0; i < names.size(); ++i)
+        out << (i ? ",\n                        \"" : "\"") << names[i] << "\"";
+    out << "]\n"
+           "             }\n"
+           "         ]\n"
+           "    }\n"
+           "}\n";
+    return (bool)out;
+}
+
+static uint32_t resolve_all(VkInstance instance, const std::vector<std::string> &names) {
+    uint32_t resolved = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        PFN_vkVoidFunction addr = vkGetInstanceProcAddr(instance, names[i].c_str());
+        benchmark_escape((void *)addr);
+        resolved += addr ? 1 : 0;
+    }
+    return resolved;
+}
+
+int main(int argc, char **argv) {
+    uint32_t name_count = (argc > 1) ? (uint32_t)atoi(argv[1]) : 200;
+    uint32_t iterations = (argc > 2) ? (uint32_t)atoi(argv[2]) : 1000;
+
+    // Vendor style names sharing long prefixes, the case that matters for a string hash
+    std::vector<std::string> names(name_count);
+    for (uint32_t i = 0; i < name_count; ++i)
+        names[i] = "vkCmdBenchVendorExtension" + std::to_string(i) + "EXT";
+
+    std::string path = std::string(BENCHMARK_WORK_DIR) + "/VkLayer_bench_dev_ext_lookup.json";
+    if (!write_manifest(path, names)) {
+        printf("can't write %s\n", path.c_str());
+        return 1;
+    }
+    set_env("VK_LAYER_PATH", BENCHMARK_WORK_DIR, true);
+    set_env("VK_ICD_FILENAMES", BENCHMARK_ICD_FILENAMES, false);
+
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    VkInstance instance;
+    if (vkCreateInstance(&instance_info, NULL, &instance) != VK_SUCCESS) {
+        printf("vkCreateInstance failed\n");
+        return 1;
+    }
+
+    uint32_t resolved;
+    {
+        BenchmarkTimer timer;
+        resolved = resolve_all(instance, names);
+        benchmark_report("vkGetInstanceProcAddr(first lookup)", name_count, timer);
+    }
+    printf("%u of %u names given a trampoline\n", resolved, name_count);
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i)
+            resolved = resolve_all(instance, names);
+        benchmark_report("vkGetInstanceProcAddr(repeat lookup)", (uint64_t)iterations * name_count, timer);
+    }
+    printf("%u of %u names resolved on the last pass\n", resolved, name_count);
+
+    vkDestroyInstance(instance, NULL);
+    return 0;
+}
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the CPU overhead the validation layers add to common API usage, by running scripted
+// workloads through the loader against the null driver with each layer enabled on its own and with
+// the standard validation stack.  Every workload is valid usage, so the numbers reflect checking
+// and state tracking rather than message formatting.
+//
+// The loader must be able to find the null driver and the layers.  Unless VK_ICD_FILENAMES and
+// VK_LAYER_PATH are already set, the paths from the build tree are used.
+//
+// Usage: vk_layer_overhead_benchmark [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "benchmark_util.h"
+
+struct LayerConfig {
+    const char *name;
+    std::vector<const char *> layers;
+};
+
+// Minimal GLCompute shader: an empty "main" with a 1x1x1 local size
+static const uint32_t kComputeShader[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000, // header, id bound 5
+    0x00020011, 0x00000001,                                     // OpCapability Shader
+    0x0003000e, 0x00000000, 0x00000001,                         // OpMemoryModel Logical GLSL450
+    0x0005000f, 0x00000005, 0x00000004, 0x6e69616d, 0x00000000, // OpEntryPoint GLCompute %4 "main"
+    0x00060010, 0x00000004, 0x00000011, 0x00000001, 0x00000001, 0x00000001, // OpExecutionMode %4 LocalSize 1 1 1
+    0x00020013, 0x00000002,                                     // %2 = OpTypeVoid
+    0x00030021, 0x00000003, 0x00000002,                         // %3 = OpTypeFunction %2
+    0x00050036, 0x00000002, 0x00000004, 0x00000000, 0x00000003, // %4 = OpFunction %2 None %3
+    0x000200f8, 0x00000001,                                     // %1 = OpLabel
+    0x000100fd,                                                 // OpReturn
+    0x00010038,                                                 // OpFunctionEnd
+};
+
+static const uint32_t kBindingCount = 8;
+static const uint32_t kRecordBatch = 16;
+static const VkDeviceSize kBufferSize = 4096;
+
+class Workloads {
+  public:
+    Workloads() : instance_(VK_NULL_HANDLE), device_(VK_NULL_HANDLE) {}
+
+    ~Workloads() { destroy(); }
+
+    VkResult create(const std::vector<const char *> &layers) {
+        VkApplicationInfo app_info = {};
+        app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        app_info.pApplicationName = "vk_layer_overhead_benchmark";
+        app_info.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+
+        VkInstanceCreateInfo instance_info = {};
+        instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instance_info.pApplicationInfo = &app_info;
+        instance_info.enabledLayerCount = (uint32_t)layers.size();
+        instance_info.ppEnabledLayerNames = layers.empty() ? NULL : layers.data();
+
+        VkResult result = vkCreateInstance(&instance_info, NULL, &instance_);
+        if (result != VK_SUCCESS)
+            return result;
+
+        uint32_t gpu_count = 1;
+        result = vkEnumeratePhysicalDevices(instance_, &gpu_count, &gpu_);
+        if (result < 0 || gpu_count == 0)
+            return VK_ERROR_INITIALIZATION_FAILED;
+
+        float priority = 1.0f;
+        VkDeviceQueueCreateInfo queue_info = {};
+        queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_info.queueFamilyIndex = 0;
+        queue_info.queueCount = 1;
+        queue_info.pQueuePriorities = &priority;
+
+        VkDeviceCreateInfo device_info = {};
+        device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        device_info.queueCreateInfoCount = 1;
+        device_info.pQueueCreateInfos = &queue_info;
+        device_info.enabledLayerCount = instance_info.enabledLayerCount;
+        device_info.ppEnabledLayerNames = instance_info.ppEnabledLayerNames;
+
+        result = vkCreateDevice(gpu_, &device_info, NULL, &device_);
+        if (result != VK_SUCCESS)
+            return result;
+
+        vkGetDeviceQueue(device_, 0, 0, &queue_);
+        vkGetPhysicalDeviceMemoryProperties(gpu_, &memory_properties_);
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            create_buffer(&buffers_[i], &memories_[i]);
+        }
+
+        VkDescriptorSetLayoutBinding bindings[kBindingCount];
+        for (uint32_t i = 0; i < kBindingCount; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            bindings[i].pImmutableSamplers = NULL;
+        }
+        VkDescriptorSetLayoutCreateInfo set_layout_info = {};
+        set_layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        set_layout_info.bindingCount = kBindingCount;
+        set_layout_info.pBindings = bindings;
+        vkCreateDescriptorSetLayout(device_, &set_layout_info, NULL, &set_layout_);
+
+        VkPipelineLayoutCreateInfo pipeline_layout_info = {};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = 1;
+        pipeline_layout_info.pSetLayouts = &set_layout_;
+        vkCreatePipelineLayout(device_, &pipeline_layout_info, NULL, &pipeline_layout_);
+
+        VkDescriptorPoolSize pool_size = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, kBindingCount * 2};
+        VkDescriptorPoolCreateInfo pool_info = {};
+        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.maxSets = 2;
+        pool_info.poolSizeCount = 1;
+        pool_info.pPoolSizes = &pool_size;
+        vkCreateDescriptorPool(device_, &pool_info, NULL, &descriptor_pool_);
+
+        VkDescriptorSetAllocateInfo set_info = {};
+        set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        set_info.descriptorPool = descriptor_pool_;
+        set_info.descriptorSetCount = 1;
+        set_info.pSetLayouts = &set_layout_;
+        vkAllocateDescriptorSets(device_, &set_info, &descriptor_set_);
+        write_descriptors(descriptor_set_);
+        vkAllocateDescriptorSets(device_, &set_info, &update_set_);
+        write_descriptors(update_set_);
+
+        VkShaderModuleCreateInfo module_info = {};
+        module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        module_info.codeSize = sizeof(kComputeShader);
+        module_info.pCode = kComputeShader;
+        vkCreateShaderModule(device_, &module_info, NULL, &shader_module_);
+        pipeline_ = create_pipeline();
+
+        VkCommandPoolCreateInfo command_pool_info = {};
+        command_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        command_pool_info.queueFamilyIndex = 0;
+        vkCreateCommandPool(device_, &command_pool_info, NULL, &command_pool_);
+
+        VkCommandBufferAllocateInfo command_buffer_info = {};
+        command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_info.commandPool = command_pool_;
+        command_buffer_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_info.commandBufferCount = 1;
+        vkAllocateCommandBuffers(device_, &command_buffer_info, &command_buffer_);
+
+        VkFenceCreateInfo fence_info = {};
+        fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        vkCreateFence(device_, &fence_info, NULL, &fence_);
+
+        return VK_SUCCESS;
+    }
+
+    void destroy() {
+        if (device_ != VK_NULL_HANDLE) {
+            vkDeviceWaitIdle(device_);
+            vkDestroyFence(device_, fence_, NULL);
+            vkFreeCommandBuffers(device_, command_pool_, 1, &command_buffer_);
+            vkDestroyCommandPool(device_, command_pool_, NULL);
+            vkDestroyPipeline(device_, pipeline_, NULL);
+            vkDestroyShaderModule(device_, shader_module_, NULL);
+            vkDestroyDescriptorPool(device_, descriptor_pool_, NULL);
+            vkDestroyPipelineLayout(device_, pipeline_layout_, NULL);
+            vkDestroyDescriptorSetLayout(device_, set_layout_, NULL);
+            for (uint32_t i = 0; i < 2; ++i) {
+                vkDestroyBuffer(device_, buffers_[i], NULL);
+                vkFreeMemory(device_, memories_[i], NULL);
+            }
+            vkDestroyDevice(device_, NULL);
+            device_ = VK_NULL_HANDLE;
+        }
+        if (instance_ != VK_NULL_HANDLE) {
+            vkDestroyInstance(instance_, NULL);
+            instance_ = VK_NULL_HANDLE;
+        }
+    }
+
+    // Each workload returns the number of API calls it made
+
+    // Transfer and compute commands recorded into a resettable command buffer
+    uint32_t record() {
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkBeginCommandBuffer(command_buffer_, &begin_info);
+
+        VkBufferMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffers_[0];
+        barrier.size = VK_WHOLE_SIZE;
+
+        VkBufferCopy region = {0, 0, kBufferSize};
+
+        vkCmdBindPipeline(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_);
+        vkCmdBindDescriptorSets(command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline_layout_, 0, 1, &descriptor_set_, 0,
+                                NULL);
+        for (uint32_t i = 0; i < kRecordBatch; ++i) {
+            vkCmdFillBuffer(command_buffer_, buffers_[0], 0, kBufferSize, i);
+            vkCmdPipelineBarrier(command_buffer_, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, NULL, 1, &barrier, 0,
+                                 NULL);
+            vkCmdCopyBuffer(command_buffer_, buffers_[0], buffers_[1], 1, &region);
+            vkCmdDispatch(command_buffer_, 1, 1, 1);
+        }
+
+        vkEndCommandBuffer(command_buffer_);
+        return 4 + kRecordBatch * 4;
+    }
+
+    // Rewrites every binding of a descriptor set.  Updating the set bound by the recorded command
+    // buffer would invalidate it, so this uses a set no command buffer uses.
+    uint32_t update_descriptors() {
+        write_descriptors(update_set_);
+        return 1;
+    }
+
+    uint32_t pipeline_churn() {
+        VkPipeline pipeline = create_pipeline();
+        vkDestroyPipeline(device_, pipeline, NULL);
+        return 2;
+    }
+
+    // Submits the last recorded command buffer and waits for it
+    uint32_t submit() {
+        VkSubmitInfo submit_info = {};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &command_buffer_;
+        vkQueueSubmit(queue_, 1, &submit_info, fence_);
+        vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX);
+        vkResetFences(device_, 1, &fence_);
+        return 3;
+    }
+
+    // Creates, binds, and destroys short-lived resources
+    uint32_t object_churn() {
+        VkBuffer buffer;
+        VkDeviceMemory memory;
+        create_buffer(&buffer, &memory);
+        vkDestroyBuffer(device_, buffer, NULL);
+        vkFreeMemory(device_, memory, NULL);
+
+        VkEvent event;
+        VkEventCreateInfo event_info = {};
+        event_info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+        vkCreateEvent(device_, &event_info, NULL, &event);
+        vkDestroyEvent(device_, event, NULL);
+        return 8;
+    }
+
+  private:
+    void write_descriptors(VkDescriptorSet set) {
+        VkDescriptorBufferInfo buffer_infos[kBindingCount];
+        VkWriteDescriptorSet writes[kBindingCount];
+        for (uint32_t i = 0; i < kBindingCount; ++i) {
+            buffer_infos[i].buffer = buffers_[i & 1];
+            buffer_infos[i].offset = 0;
+            buffer_infos[i].range = VK_WHOLE_SIZE;
+
+            memset(&writes[i], 0, sizeof(writes[i]));
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &buffer_infos[i];
+        }
+        vkUpdateDescriptorSets(device_, kBindingCount, writes, 0, NULL);
+    }
+
+    void create_buffer(VkBuffer *buffer, VkDeviceMemory *memory) {
+        VkBufferCreateInfo buffer_info = {};
+        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_info.size = kBufferSize;
+        buffer_info.usage =
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        vkCreateBuffer(device_, &buffer_info, NULL, buffer);
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(device_, *buffer, &requirements);
+
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = requirements.size;
+        for (uint32_t i = 0; i < memory_properties_.memoryTypeCount; ++i) {
+            if (requirements.memoryTypeBits & (1 << i)) {
+                alloc_info.memoryTypeIndex = i;
+                break;
+            }
+        }
+        vkAllocateMemory(device_, &alloc_info, NULL, memory);
+        vkBindBufferMemory(device_, *buffer, *memory, 0);
+    }
+
+    VkPipeline create_pipeline() {
+        VkComputePipelineCreateInfo pipeline_info = {};
+        pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipeline_info.stage.module = shader_module_;
+        pipeline_info.stage.pName = "main";
+        pipeline_info.layout = pipeline_layout_;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        vkCreateComputePipelines(device_, VK_NULL_HANDLE, 1, &pipeline_info, NULL, &pipeline);
+        return pipeline;
+    }
+
+    VkInstance instance_;
+    VkPhysicalDevice gpu_;
+    VkDevice device_;
+    VkQueue queue_;
+    VkPhysicalDeviceMemoryProperties memory_properties_;
+    VkBuffer buffers_[2];
+    VkDeviceMemory memories_[2];
+    VkDescriptorSetLayout set_layout_;
+    VkPipelineLayout pipeline_layout_;
+    VkDescriptorPool descriptor_pool_;
+    VkDescriptorSet descriptor_set_;
+    VkDescriptorSet update_set_;
+    VkShaderModule shader_module_;
+    VkPipeline pipeline_;
+    VkCommandPool command_pool_;
+    VkCommandBuffer command_buffer_;
+    VkFence fence_;
+};
+
+typedef uint32_t (Workloads::*WorkloadFunc)();
+
+struct Workload {
+    const char *name;
+    WorkloadFunc func;
+    uint32_t iteration_divisor;
+};
+
+static void run_workload(Workloads &workloads, const char *config_name, const Workload &workload, uint32_t iterations) {
+    iterations /= workload.iteration_divisor;
+    if (iterations == 0)
+        iterations = 1;
+
+    // Warm up so one-time allocations in the layers are not counted
+    (workloads.*workload.func)();
+
+    uint64_t calls = 0;
+    BenchmarkTimer timer;
+    for (uint32_t i = 0; i < iterations; ++i) {
+        calls += (workloads.*workload.func)();
+    }
+
+    std::string name = std::string(config_name) + "/" + workload.name;
+    benchmark_report(name.c_str(), calls, timer);
+}
+
+static bool layers_available(const std::vector<const char *> &layers) {
+    uint32_t count = 0;
+    vkEnumerateInstanceLayerProperties(&count, NULL);
+    std::vector<VkLayerProperties> properties(count);
+    vkEnumerateInstanceLayerProperties(&count, properties.data());
+    for (size_t i = 0; i < layers.size(); ++i) {
+        bool found = false;
+        for (uint32_t j = 0; j < count; ++j) {
+            if (strcmp(layers[i], properties[j].layerName) == 0) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void set_default_env(const char *name, const char *value) {
+    if (getenv(name) != NULL)
+        return;
+#if defined(_WIN32)
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 0);
+#endif
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = (argc > 1) ? (uint32_t)atoi(argv[1]) : 2000;
+
+#if defined(BENCHMARK_ICD_FILENAMES)
+    set_default_env("VK_ICD_FILENAMES", BENCHMARK_ICD_FILENAMES);
+#endif
+#if defined(BENCHMARK_LAYER_PATH)
+    set_default_env("VK_LAYER_PATH", BENCHMARK_LAYER_PATH);
+#endif
+
+    std::vector<LayerConfig> configs;
+    configs.push_back(LayerConfig{"none", {}});
+    configs.push_back(LayerConfig{"threading", {"VK_LAYER_GOOGLE_threading"}});
+    configs.push_back(LayerConfig{"parameter_validation", {"VK_LAYER_LUNARG_parameter_validation"}});
+    configs.push_back(LayerConfig{"object_tracker", {"VK_LAYER_LUNARG_object_tracker"}});
+    configs.push_back(LayerConfig{"image", {"VK_LAYER_LUNARG_image"}});
+    configs.push_back(LayerConfig{"core_validation", {"VK_LAYER_LUNARG_core_validation"}});
+    configs.push_back(LayerConfig{"swapchain", {"VK_LAYER_LUNARG_swapchain"}});
+    configs.push_back(LayerConfig{"unique_objects", {"VK_LAYER_GOOGLE_unique_objects"}});
+    // Same order as VK_LAYER_LUNARG_standard_validation
+    configs.push_back(LayerConfig{"standard_validation",
+                                  {"VK_LAYER_GOOGLE_threading", "VK_LAYER_LUNARG_parameter_validation",
+                                   "VK_LAYER_LUNARG_object_tracker", "VK_LAYER_LUNARG_image", "VK_LAYER_LUNARG_core_validation",
+                                   "VK_LAYER_LUNARG_swapchain", "VK_LAYER_GOOGLE_unique_objects"}});
+
+    const Workload workloads[] = {
+        {"record", &Workloads::record, 1},
+        {"update_descriptors", &Workloads::update_descriptors, 1},
+        {"pipeline_churn", &Workloads::pipeline_churn, 4},
+        {"submit", &Workloads::submit, 1},
+        {"object_churn", &Workloads::object_churn, 1},
+    };
+
+    for (size_t i = 0; i < configs.size(); ++i) {
+        if (!layers_available(configs[i].layers)) {
+            printf("%-48s skipped (layer not found)\n", configs[i].name);
+            continue;
+        }
+        Workloads state;
+        VkResult result = state.create(configs[i].layers);
+        if (result != VK_SUCCESS) {
+            printf("%-48s skipped (setup returned %d)\n", configs[i].name, result);
+            continue;
+        }
+        // Submit needs a recorded command buffer
+        state.record();
+        for (size_t j = 0; j < sizeof(workloads) / sizeof(workloads[0]); ++j) {
+            run_workload(state, configs[i].name, workloads[j], iterations);
+        }
+    }
+
+    return 0;
+}
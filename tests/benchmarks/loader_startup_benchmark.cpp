@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures loader startup with several installed ICDs.  The null driver is copied once per ICD
+// under separate names, so the loader has to load and query each copy as it would distinct
+// drivers, and VK_ICD_FILENAMES is pointed at a manifest for each copy.
+//
+// The first vkEnumerateInstanceExtensionProperties and vkCreateInstance calls in the process are
+// reported on their own, since that is when ICDs are found and loaded; run the benchmark several
+// times to get a spread.  Steady-state instance creation and extension enumeration are then timed
+// over many iterations.
+//
+// Usage: vk_loader_startup_benchmark [icd copies] [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <string>
+#include "vulkan/vulkan.h"
+#include "benchmark_util.h"
+
+#if defined(_WIN32)
+static const char *kPathSeparator = ";";
+#else
+static const char *kPathSeparator = ":";
+#endif
+
+static bool copy_file(const std::string &from, const std::string &to) {
+    std::ifstream in(from.c_str(), std::ios::binary);
+    std::ofstream out(to.c_str(), std::ios::binary | std::ios::trunc);
+    if (!in || !out)
+        return false;
+    out << in.rdbuf();
+    return (bool)out;
+}
+
+// Copies the null driver and writes a manifest for each copy, returning the VK_ICD_FILENAMES value
+static bool install_icds(uint32_t count, std::string &icd_filenames) {
+    std::string library = BENCHMARK_NULLDRV_LIBRARY;
+    std::string extension = library.substr(library.find_last_of('.'));
+
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string base = std::string(BENCHMARK_WORK_DIR) + "/startup_nulldrv" + std::to_string(i);
+        std::string copy = base + extension;
+        std::string manifest = base + ".json";
+        if (!copy_file(library, copy)) {
+            printf("can't copy %s to %s\n", library.c_str(), copy.c_str());
+            return false;
+        }
+
+        // Backslashes in Windows paths have to be escaped in JSON
+        std::string json_path;
+        for (size_t c = 0; c < copy.size(); ++c) {
+            if (copy[c] == '\\')
+                json_path += '\\';
+            json_path += copy[c];
+        }
+        std::ofstream out(manifest.c_str(), std::ios::trunc);
+        out << "{\n    \"file_format_version\": \"1.0.0\",\n    \"ICD\": {\n        \"library_path\": \"" << json_path
+            << "\",\n        \"api_version\": \"1.0.21\"\n    }\n}\n";
+        if (!out) {
+            printf("can't write %s\n", manifest.c_str());
+            return false;
+        }
+
+        if (i > 0)
+            icd_filenames += kPathSeparator;
+        icd_filenames += manifest;
+    }
+    return true;
+}
+
+static void report_once(const char *name, const BenchmarkTimer &timer) {
+    printf("%-48s %12.1f us\n", name, timer.elapsed_ns() / 1000.0);
+}
+
+int main(int argc, char **argv) {
+    uint32_t icd_count = (argc > 1) ? (uint32_t)atoi(argv[1]) : 8;
+    uint32_t iterations = (argc > 2) ? (uint32_t)atoi(argv[2]) : 1000;
+
+    std::string icd_filenames;
+    if (icd_count == 0 || !install_icds(icd_count, icd_filenames))
+        return 1;
+#if defined(_WIN32)
+    _putenv_s("VK_ICD_FILENAMES", icd_filenames.c_str());
+#else
+    setenv("VK_ICD_FILENAMES", icd_filenames.c_str(), 1);
+#endif
+    printf("%u copies of the null driver\n", icd_count);
+
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    VkInstance instance;
+    uint32_t count = 0;
+
+    {
+        BenchmarkTimer timer;
+        vkEnumerateInstanceExtensionProperties(NULL, &count, NULL);
+        report_once("first vkEnumerateInstanceExtensionProperties", timer);
+    }
+    {
+        BenchmarkTimer timer;
+        if (vkCreateInstance(&instance_info, NULL, &instance) != VK_SUCCESS) {
+            printf("vkCreateInstance failed\n");
+            return 1;
+        }
+        report_once("first vkCreateInstance", timer);
+    }
+
+    uint32_t gpu_count = 0;
+    vkEnumeratePhysicalDevices(instance, &gpu_count, NULL);
+    vkDestroyInstance(instance, NULL);
+    if (gpu_count != icd_count) {
+        printf("expected %u physical devices, found %u\n", icd_count, gpu_count);
+        return 1;
+    }
+
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            vkCreateInstance(&instance_info, NULL, &instance);
+            vkDestroyInstance(instance, NULL);
+        }
+        benchmark_report("vkCreateInstance+vkDestroyInstance", iterations, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            count = 0;
+            vkEnumerateInstanceExtensionProperties(NULL, &count, NULL);
+            benchmark_escape(&count);
+        }
+        benchmark_report("vkEnumerateInstanceExtensionProperties", iterations, timer);
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures how fast the loader reads layer manifests.  Writes a directory of synthetic manifests,
+// shaped like the ones installed with the validation layers but with device extensions and
+// entrypoint lists as well, and times vkEnumerateInstanceLayerProperties over them.
+//
+// The loader keeps the results of a manifest scan until the search path or the files change, so
+// VK_LAYER_PATH is switched between two spellings of the same directory on every call; each call
+// then searches the directory and parses every manifest again.  The cached case is timed too.
+//
+// Reading the directories and building the layer list cost more than the parsing, so the parsers
+// are also timed on their own over the same manifests held in memory: cJSON, which the loader
+// used to build a tree of each manifest, and the streaming reader it uses now.
+//
+// The loader allocates with malloc, and vkEnumerateInstanceLayerProperties takes no allocation
+// callbacks, so its cases report time only.  cJSON's allocations are counted through its hooks; the
+// streaming reader doesn't allocate.
+//
+// Usage: vk_manifest_parse_benchmark [manifests] [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "vulkan/vulkan.h"
+#include "cJSON.h"
+#include "json_stream.h"
+#include "benchmark_util.h"
+
+static void *counting_malloc(size_t size) {
+    benchmark_count_allocation();
+    return malloc(size);
+}
+
+static void set_env(const char *name, const std::string &value) {
+#if defined(_WIN32)
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+static bool write_manifest(const std::string &path, uint32_t index) {
+    std::string name = "VK_LAYER_BENCH_manifest" + std::to_string(index);
+    std::ofstream out(path.c_str(), std::ios::trunc);
+    out << "{\n"
+           "    \"file_format_version\" : \"1.0.0\",\n"
+           "    \"layer\" : {\n"
+           "        \"name\": \"" << name << "\",\n"
+           "        \"type\": \"GLOBAL\",\n"
+           "        \"library_path\": \"./libVkLayer_bench_manifest" << index << ".so\",\n"
+           "        \"api_version\": \"1.0.21\",\n"
+           "        \"implementation_version\": \"1\",\n"
+           "        \"description\": \"Synthetic layer for vk_manifest_parse_benchmark\",\n"
+           "        \"functions\": {\n"
+           "            \"vkGetInstanceProcAddr\": \"bench_GetInstanceProcAddr\",\n"
+           "            \"vkGetDeviceProcAddr\": \"bench_GetDeviceProcAddr\"\n"
+           "        },\n"
+           "        \"instance_extensions\": [\n"
+           "             {\n"
+           "                 \"name\": \"VK_EXT_debug_report\",\n"
+           "                 \"spec_version\": \"3\"\n"
+           "             }\n"
+           "         ],\n"
+           "        \"device_extensions\": [\n"
+           "             {\n"
+           "                 \"name\": \"VK_EXT_debug_marker\",\n"
+           "                 \"spec_version\": \"3\",\n"
+           "                 \"entrypoints\": [\"vkDebugMarkerSetObjectTagEXT\",\n"
+           "                        \"vkDebugMarkerSetObjectNameEXT\",\n"
+           "                        \"vkCmdDebugMarkerBeginEXT\",\n"
+           "                        \"vkCmdDebugMarkerEndEXT\",\n"
+           "                        \"vkCmdDebugMarkerInsertEXT\"\n"
+           "                       ]\n"
+           "             }\n"
+           "         ]\n"
+           "    }\n"
+           "}\n";
+    return (bool)out;
+}
+
+static bool read_file(const std::string &path, std::string &contents) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in)
+        return false;
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool install_manifests(uint32_t count, std::string &dir) {
+    dir = std::string(BENCHMARK_WORK_DIR) + "/manifest_bench" + std::to_string(count);
+#if defined(_WIN32)
+    _mkdir(dir.c_str());
+#else
+    mkdir(dir.c_str(), 0755);
+#endif
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string path = dir + "/VkLayer_bench_manifest" + std::to_string(i) + ".json";
+        if (!write_manifest(path, i)) {
+            printf("can't write %s\n", path.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t manifest_count = (argc > 1) ? (uint32_t)atoi(argv[1]) : 500;
+    uint32_t iterations = (argc > 2) ? (uint32_t)atoi(argv[2]) : 100;
+
+    std::string dir;
+    if (manifest_count == 0 || !install_manifests(manifest_count, dir))
+        return 1;
+    // Both name the same directory, but the loader can't tell that without scanning it
+    std::string paths[2] = {dir, dir + "/"};
+    set_env("VK_LAYER_PATH", paths[0]);
+
+    uint32_t count = 0;
+    vkEnumerateInstanceLayerProperties(&count, NULL);
+    std::vector<VkLayerProperties> layers(count);
+    vkEnumerateInstanceLayerProperties(&count, layers.data());
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        found += (strncmp(layers[i].layerName, "VK_LAYER_BENCH_", 15) == 0) ? 1 : 0;
+    if (found != manifest_count) {
+        printf("expected %u layers, found %u\n", manifest_count, found);
+        return 1;
+    }
+    printf("%u layer manifests\n", manifest_count);
+
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            set_env("VK_LAYER_PATH", paths[(i + 1) & 1]);
+            count = 0;
+            vkEnumerateInstanceLayerProperties(&count, NULL);
+            benchmark_escape(&count);
+        }
+        benchmark_report_time("vkEnumerateInstanceLayerProperties(rescan)", iterations, timer);
+        benchmark_report_time("  per manifest", (uint64_t)iterations * manifest_count, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            count = 0;
+            vkEnumerateInstanceLayerProperties(&count, NULL);
+            benchmark_escape(&count);
+        }
+        benchmark_report_time("vkEnumerateInstanceLayerProperties(cached)", iterations, timer);
+    }
+
+    std::vector<std::string> manifests(manifest_count);
+    for (uint32_t i = 0; i < manifest_count; ++i) {
+        if (!read_file(dir + "/VkLayer_bench_manifest" + std::to_string(i) + ".json", manifests[i]))
+            return 1;
+    }
+    {
+        cJSON_Hooks hooks = {counting_malloc, free};
+        cJSON_InitHooks(&hooks);
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (uint32_t m = 0; m < manifest_count; ++m) {
+                cJSON *json = cJSON_Parse(manifests[m].c_str());
+                benchmark_escape(json);
+                cJSON_Delete(json);
+            }
+        }
+        benchmark_report("cJSON_Parse+cJSON_Delete per manifest", (uint64_t)iterations * manifest_count, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (uint32_t m = 0; m < manifest_count; ++m) {
+                struct loader_json json;
+                loader_json_init(&json, manifests[m].data(), manifests[m].size());
+                bool ok = loader_json_skip(&json);
+                benchmark_escape(&ok);
+            }
+        }
+        benchmark_report("loader_json_skip per manifest", (uint64_t)iterations * manifest_count, timer);
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures the per-call cost of the generated parameter_validation checks for a set of hot vkCmd*
+// entrypoints, using valid parameters so that no messages are logged.  Parameters are escaped on
+// every iteration so the checks cannot be hoisted out of the timed loops.
+
+#include <string.h>
+#include "vulkan/vulkan.h"
+#include "parameter_validation.h"
+#include "benchmark_util.h"
+
+using namespace parameter_validation;
+
+static const uint32_t kIterations = 1000000;
+
+// Handles only need to be non-null for parameter validation
+template <typename T> static T fake_handle(uint64_t value) { return reinterpret_cast<T>(static_cast<uintptr_t>(value)); }
+
+int main(int argc, char **argv) {
+    debug_report_data report_data;
+    memset(&report_data, 0, sizeof(report_data));
+
+    bool skip = false;
+
+    {
+        VkDescriptorSet sets[4];
+        for (uint32_t i = 0; i < 4; ++i) {
+            sets[i] = fake_handle<VkDescriptorSet>(0x1000 + i);
+        }
+        uint32_t dynamic_offsets[2] = {0, 256};
+        VkPipelineLayout layout = fake_handle<VkPipelineLayout>(0x2000);
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(sets);
+            benchmark_escape(&layout);
+            skip |= parameter_validation_vkCmdBindDescriptorSets(&report_data, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 4, sets,
+                                                                 2, dynamic_offsets);
+        }
+        benchmark_report("vkCmdBindDescriptorSets(4 sets)", kIterations, timer);
+    }
+    {
+        VkPipeline pipeline = fake_handle<VkPipeline>(0x3000);
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(&pipeline);
+            skip |= parameter_validation_vkCmdBindPipeline(&report_data, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        }
+        benchmark_report("vkCmdBindPipeline", kIterations, timer);
+    }
+    {
+        VkBuffer buffers[2] = {fake_handle<VkBuffer>(0x4000), fake_handle<VkBuffer>(0x4001)};
+        VkDeviceSize offsets[2] = {0, 4096};
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(buffers);
+            skip |= parameter_validation_vkCmdBindVertexBuffers(&report_data, 0, 2, buffers, offsets);
+        }
+        benchmark_report("vkCmdBindVertexBuffers(2 buffers)", kIterations, timer);
+    }
+    {
+        VkViewport viewport = {0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f};
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(&viewport);
+            skip |= parameter_validation_vkCmdSetViewport(&report_data, 0, 1, &viewport);
+        }
+        benchmark_report("vkCmdSetViewport", kIterations, timer);
+    }
+    {
+        uint32_t constants[4] = {1, 2, 3, 4};
+        VkPipelineLayout layout = fake_handle<VkPipelineLayout>(0x2000);
+        VkShaderStageFlags stages = VK_SHADER_STAGE_VERTEX_BIT;
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(&layout);
+            benchmark_escape(&stages);
+            skip |= parameter_validation_vkCmdPushConstants(&report_data, layout, stages, 0, sizeof(constants), constants);
+        }
+        benchmark_report("vkCmdPushConstants", kIterations, timer);
+    }
+    {
+        VkClearValue clear_values[2];
+        memset(clear_values, 0, sizeof(clear_values));
+        VkRenderPassBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        begin_info.renderPass = fake_handle<VkRenderPass>(0x5000);
+        begin_info.framebuffer = fake_handle<VkFramebuffer>(0x5001);
+        begin_info.renderArea.extent.width = 64;
+        begin_info.renderArea.extent.height = 64;
+        begin_info.clearValueCount = 2;
+        begin_info.pClearValues = clear_values;
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(&begin_info);
+            skip |= parameter_validation_vkCmdBeginRenderPass(&report_data, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+        }
+        benchmark_report("vkCmdBeginRenderPass", kIterations, timer);
+    }
+    {
+        VkBufferImageCopy regions[4];
+        memset(regions, 0, sizeof(regions));
+        for (uint32_t i = 0; i < 4; ++i) {
+            regions[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            regions[i].imageSubresource.mipLevel = i;
+            regions[i].imageSubresource.layerCount = 1;
+            regions[i].imageExtent.width = 64 >> i;
+            regions[i].imageExtent.height = 64 >> i;
+            regions[i].imageExtent.depth = 1;
+        }
+
+        VkBuffer buffer = fake_handle<VkBuffer>(0x4000);
+        VkImage image = fake_handle<VkImage>(0x6000);
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(regions);
+            benchmark_escape(&buffer);
+            benchmark_escape(&image);
+            skip |= parameter_validation_vkCmdCopyBufferToImage(&report_data, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 4,
+                                                                regions);
+        }
+        benchmark_report("vkCmdCopyBufferToImage(4 regions)", kIterations, timer);
+    }
+    {
+        VkImageMemoryBarrier barriers[4];
+        memset(barriers, 0, sizeof(barriers));
+        for (uint32_t i = 0; i < 4; ++i) {
+            barriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barriers[i].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barriers[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barriers[i].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barriers[i].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[i].image = fake_handle<VkImage>(0x6000 + i);
+            barriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barriers[i].subresourceRange.levelCount = 1;
+            barriers[i].subresourceRange.layerCount = 1;
+        }
+
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            benchmark_escape(barriers);
+            skip |= parameter_validation_vkCmdPipelineBarrier(&report_data, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                              VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 4,
+                                                              barriers);
+        }
+        benchmark_report("vkCmdPipelineBarrier(4 image barriers)", kIterations, timer);
+    }
+
+    // Keep the checks from being optimized away; none of the calls above should fail validation
+    if (skip) {
+        printf("unexpected validation failure\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Measures startup-style entrypoint resolution: every command in the API is looked up through
+// vkGetInstanceProcAddr and vkGetDeviceProcAddr, the way engines build their own dispatch tables
+// after device creation.  Runs against the null driver with no layers, with each layer whose
+// intercepts are looked up by name, and with the standard validation stack, where every layer
+// resolves the names again on the way down the chain.
+//
+// The loader must be able to find the null driver and the layers.  Unless VK_ICD_FILENAMES and
+// VK_LAYER_PATH are already set, the paths from the build tree are used.
+//
+// Usage: vk_proc_addr_benchmark [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "vk_proc_name_hash.h"
+#include "benchmark_util.h"
+
+struct LayerConfig {
+    const char *name;
+    std::vector<const char *> layers;
+};
+
+static void set_default_env(const char *name, const char *value) {
+    if (getenv(name) != NULL)
+        return;
+#if defined(_WIN32)
+    _putenv_s(name, value);
+#else
+    setenv(name, value, 0);
+#endif
+}
+
+static bool run_config(const LayerConfig &config, uint32_t iterations) {
+    VkApplicationInfo app_info = {};
+    app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app_info.pApplicationName = "vk_proc_addr_benchmark";
+    app_info.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+
+    VkInstanceCreateInfo instance_info = {};
+    instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instance_info.pApplicationInfo = &app_info;
+    instance_info.enabledLayerCount = (uint32_t)config.layers.size();
+    instance_info.ppEnabledLayerNames = config.layers.empty() ? NULL : config.layers.data();
+
+    VkInstance instance;
+    if (vkCreateInstance(&instance_info, NULL, &instance) != VK_SUCCESS) {
+        printf("%s: vkCreateInstance failed\n", config.name);
+        return false;
+    }
+
+    VkPhysicalDevice gpu;
+    uint32_t gpu_count = 1;
+    VkResult result = vkEnumeratePhysicalDevices(instance, &gpu_count, &gpu);
+    if (result < 0 || gpu_count == 0) {
+        printf("%s: no physical devices\n", config.name);
+        vkDestroyInstance(instance, NULL);
+        return false;
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_info = {};
+    queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_info.queueFamilyIndex = 0;
+    queue_info.queueCount = 1;
+    queue_info.pQueuePriorities = &priority;
+
+    const char *swapchain_extension = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
+    VkDeviceCreateInfo device_info = {};
+    device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_info.queueCreateInfoCount = 1;
+    device_info.pQueueCreateInfos = &queue_info;
+    device_info.enabledLayerCount = instance_info.enabledLayerCount;
+    device_info.ppEnabledLayerNames = instance_info.ppEnabledLayerNames;
+    device_info.enabledExtensionCount = 1;
+    device_info.ppEnabledExtensionNames = &swapchain_extension;
+
+    VkDevice device;
+    if (vkCreateDevice(gpu, &device_info, NULL, &device) != VK_SUCCESS) {
+        printf("%s: vkCreateDevice failed\n", config.name);
+        vkDestroyInstance(instance, NULL);
+        return false;
+    }
+
+    PFN_vkVoidFunction procs[VK_PROC_COUNT];
+    std::string label;
+
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (int p = 0; p < VK_PROC_COUNT; ++p)
+                procs[p] = vkGetInstanceProcAddr(instance, vk_proc_names[p]);
+            benchmark_escape(procs);
+        }
+        label = std::string(config.name) + " vkGetInstanceProcAddr(all)";
+        benchmark_report(label.c_str(), (uint64_t)iterations * VK_PROC_COUNT, timer);
+    }
+    {
+        uint32_t resolved = 0;
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (int p = 0; p < VK_PROC_COUNT; ++p)
+                procs[p] = vkGetDeviceProcAddr(device, vk_proc_names[p]);
+            benchmark_escape(procs);
+        }
+        for (int p = 0; p < VK_PROC_COUNT; ++p)
+            resolved += procs[p] ? 1 : 0;
+        label = std::string(config.name) + " vkGetDeviceProcAddr(all)";
+        benchmark_report(label.c_str(), (uint64_t)iterations * VK_PROC_COUNT, timer);
+        printf("%-48s %10u of %d entrypoints resolved\n", label.c_str(), resolved, VK_PROC_COUNT);
+    }
+
+    vkDestroyDevice(device, NULL);
+    vkDestroyInstance(instance, NULL);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = (argc > 1) ? (uint32_t)atoi(argv[1]) : 1000;
+
+#if defined(BENCHMARK_ICD_FILENAMES)
+    set_default_env("VK_ICD_FILENAMES", BENCHMARK_ICD_FILENAMES);
+#endif
+#if defined(BENCHMARK_LAYER_PATH)
+    set_default_env("VK_LAYER_PATH", BENCHMARK_LAYER_PATH);
+#endif
+
+    std::vector<LayerConfig> configs;
+    configs.push_back(LayerConfig{"none", {}});
+    configs.push_back(LayerConfig{"parameter_validation", {"VK_LAYER_LUNARG_parameter_validation"}});
+    configs.push_back(LayerConfig{"object_tracker", {"VK_LAYER_LUNARG_object_tracker"}});
+    configs.push_back(LayerConfig{"image", {"VK_LAYER_LUNARG_image"}});
+    configs.push_back(LayerConfig{"core_validation", {"VK_LAYER_LUNARG_core_validation"}});
+    configs.push_back(LayerConfig{"swapchain", {"VK_LAYER_LUNARG_swapchain"}});
+    // Same order as VK_LAYER_LUNARG_standard_validation
+    configs.push_back(LayerConfig{"standard_validation",
+                                  {"VK_LAYER_GOOGLE_threading", "VK_LAYER_LUNARG_parameter_validation",
+                                   "VK_LAYER_LUNARG_object_tracker", "VK_LAYER_LUNARG_image", "VK_LAYER_LUNARG_core_validation",
+                                   "VK_LAYER_LUNARG_swapchain", "VK_LAYER_GOOGLE_unique_objects"}});
+
+    bool ok = true;
+    for (size_t i = 0; i < configs.size(); ++i)
+        ok &= run_config(configs[i], iterations);
+
+    // The lookup itself, without any layers or driver involved
+    {
+        int sum = 0;
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            for (int p = 0; p < VK_PROC_COUNT; ++p) {
+                const char *name = vk_proc_names[p];
+                benchmark_escape(&name);
+                sum += vk_proc_index(name);
+            }
+        }
+        benchmark_report("vk_proc_index(all)", (uint64_t)iterations * VK_PROC_COUNT, timer);
+        benchmark_escape(&sum);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares the cost of the safe_Vk* deep copies unique_objects makes per call when they come from
+// the heap versus a per-call VkLayerScratchScope.
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "vulkan/vulkan.h"
+#include "vk_safe_struct.h"
+#include "vk_layer_scratch.h"
+#include "benchmark_util.h"
+
+static const uint32_t kIterations = 20000;
+static const uint32_t kWriteCount = 64;
+static const uint32_t kImageInfosPerWrite = 4;
+static const uint32_t kPipelineCount = 16;
+
+// Mirrors the generated unique_objects UpdateDescriptorSets intercept
+static void copy_descriptor_writes(const VkWriteDescriptorSet *pDescriptorWrites, uint32_t descriptorWriteCount) {
+    safe_VkWriteDescriptorSet *local_pDescriptorWrites = layer_scratch_new_array<safe_VkWriteDescriptorSet>(descriptorWriteCount);
+    for (uint32_t i = 0; i < descriptorWriteCount; ++i) {
+        local_pDescriptorWrites[i].initialize(&pDescriptorWrites[i]);
+    }
+    layer_scratch_delete_array(local_pDescriptorWrites);
+}
+
+// Mirrors explicit_CreateGraphicsPipelines in unique_objects.h
+static void copy_pipeline_create_infos(const VkGraphicsPipelineCreateInfo *pCreateInfos, uint32_t createInfoCount) {
+    safe_VkGraphicsPipelineCreateInfo *local_pCreateInfos = layer_scratch_new_array<safe_VkGraphicsPipelineCreateInfo>(createInfoCount);
+    for (uint32_t i = 0; i < createInfoCount; ++i) {
+        local_pCreateInfos[i].initialize(&pCreateInfos[i]);
+    }
+    layer_scratch_delete_array(local_pCreateInfos);
+}
+
+int main(int argc, char **argv) {
+    // UpdateDescriptorSets workload
+    std::vector<VkDescriptorImageInfo> image_infos(kWriteCount * kImageInfosPerWrite);
+    memset(image_infos.data(), 0, sizeof(VkDescriptorImageInfo) * image_infos.size());
+    std::vector<VkWriteDescriptorSet> writes(kWriteCount);
+    for (uint32_t i = 0; i < kWriteCount; ++i) {
+        memset(&writes[i], 0, sizeof(VkWriteDescriptorSet));
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = kImageInfosPerWrite;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[i].pImageInfo = &image_infos[i * kImageInfosPerWrite];
+    }
+
+    // CreateGraphicsPipelines workload
+    VkPipelineShaderStageCreateInfo stages[2];
+    memset(stages, 0, sizeof(stages));
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].pName = "main";
+    stages[1] = stages[0];
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkVertexInputBindingDescription binding = {0, 32, VK_VERTEX_INPUT_RATE_VERTEX};
+    VkVertexInputAttributeDescription attribs[2] = {{0, 0, VK_FORMAT_R32G32B32A32_SFLOAT, 0},
+                                                    {1, 0, VK_FORMAT_R32G32B32A32_SFLOAT, 16}};
+    VkPipelineVertexInputStateCreateInfo vertex_input = {};
+    vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertex_input.vertexBindingDescriptionCount = 1;
+    vertex_input.pVertexBindingDescriptions = &binding;
+    vertex_input.vertexAttributeDescriptionCount = 2;
+    vertex_input.pVertexAttributeDescriptions = attribs;
+
+    VkPipelineInputAssemblyStateCreateInfo input_assembly = {};
+    input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    input_assembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkViewport viewport = {0.0f, 0.0f, 64.0f, 64.0f, 0.0f, 1.0f};
+    VkRect2D scissor = {{0, 0}, {64, 64}};
+    VkPipelineViewportStateCreateInfo viewport_state = {};
+    viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport_state.viewportCount = 1;
+    viewport_state.pViewports = &viewport;
+    viewport_state.scissorCount = 1;
+    viewport_state.pScissors = &scissor;
+
+    VkPipelineRasterizationStateCreateInfo raster = {};
+    raster.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    raster.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState blend_attachment = {};
+    blend_attachment.colorWriteMask = 0xf;
+    VkPipelineColorBlendStateCreateInfo color_blend = {};
+    color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    color_blend.attachmentCount = 1;
+    color_blend.pAttachments = &blend_attachment;
+
+    VkDynamicState dynamic_states[2] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic = {};
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = 2;
+    dynamic.pDynamicStates = dynamic_states;
+
+    std::vector<VkGraphicsPipelineCreateInfo> pipelines(kPipelineCount);
+    for (uint32_t i = 0; i < kPipelineCount; ++i) {
+        memset(&pipelines[i], 0, sizeof(VkGraphicsPipelineCreateInfo));
+        pipelines[i].sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelines[i].stageCount = 2;
+        pipelines[i].pStages = stages;
+        pipelines[i].pVertexInputState = &vertex_input;
+        pipelines[i].pInputAssemblyState = &input_assembly;
+        pipelines[i].pViewportState = &viewport_state;
+        pipelines[i].pRasterizationState = &raster;
+        pipelines[i].pMultisampleState = &multisample;
+        pipelines[i].pColorBlendState = &color_blend;
+        pipelines[i].pDynamicState = &dynamic;
+    }
+
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            copy_descriptor_writes(writes.data(), kWriteCount);
+        }
+        benchmark_report("UpdateDescriptorSets(64 writes) heap", kIterations, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            VkLayerScratchScope scratch_scope;
+            copy_descriptor_writes(writes.data(), kWriteCount);
+        }
+        benchmark_report("UpdateDescriptorSets(64 writes) scratch", kIterations, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            copy_pipeline_create_infos(pipelines.data(), kPipelineCount);
+        }
+        benchmark_report("CreateGraphicsPipelines(16 pipelines) heap", kIterations, timer);
+    }
+    {
+        BenchmarkTimer timer;
+        for (uint32_t i = 0; i < kIterations; ++i) {
+            VkLayerScratchScope scratch_scope;
+            copy_pipeline_create_infos(pipelines.data(), kPipelineCount);
+        }
+        benchmark_report("CreateGraphicsPipelines(16 pipelines) scratch", kIterations, timer);
+    }
+
+    return 0;
+}
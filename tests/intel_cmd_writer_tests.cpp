@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// CPU-side tests of the Intel ICD's command buffer writers (icd/intel/cmd.c), which is built into
+// this executable on its own.  The kernel driver is replaced by a mock intel_winsys that keeps bos
+// in host memory and records relocs, and the commands emitted by cmd_pipeline.c at the start of a
+// batch are replaced by stubs.
+
+#include <stdlib.h>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "cmd_priv.h"
+#include "dev.h"
+#include "gpu.h"
+}
+
+struct MockReloc {
+    uint32_t offset;
+    struct intel_bo *target;
+    uint32_t target_offset;
+};
+
+// A bo of the mock winsys.  Like libdrm_intel, no reloc may be added to a bo once it is a reloc
+// target.
+struct intel_bo {
+    std::vector<char> data;
+    uint64_t address;
+    int refcount;
+    bool mapped;
+    bool reloc_target;
+    std::vector<MockReloc> relocs;
+};
+
+static int live_allocations = 0;
+static int live_bos = 0;
+static int bo_allocs = 0;
+static int bo_reloc_resets = 0;
+static int bo_alloc_failures_pending = -1;
+static uint64_t next_bo_address = 0x1000;
+static std::set<struct intel_bo *> all_bos;
+static std::vector<struct intel_bo *> submitted_bos;
+
+extern "C" {
+
+int intel_debug = 0;
+
+void *intel_alloc(const void *handle, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    live_allocations++;
+    return malloc(size);
+}
+
+void intel_free(const void *handle, void *ptr) {
+    if (ptr)
+        live_allocations--;
+    free(ptr);
+}
+
+struct intel_base *intel_base_create(const struct intel_handle *handle, size_t obj_size, bool debug,
+                                     VkDebugReportObjectTypeEXT type, const void *create_info, size_t dbg_size) {
+    live_allocations++;
+    return (struct intel_base *)calloc(1, obj_size);
+}
+
+void intel_base_destroy(struct intel_base *base) {
+    if (base)
+        live_allocations--;
+    free(base);
+}
+
+void intel_dev_log(struct intel_dev *dev, VkFlags msg_flags, struct intel_base *src_object, size_t location,
+                   int32_t msg_code, const char *format, ...) {}
+
+// Stand-ins for cmd_pipeline.c: four DWords with a reloc to the state writer, and nothing
+void cmd_batch_state_base_address(struct intel_cmd *cmd) {
+    uint32_t *dw;
+    const uint32_t pos = cmd_batch_pointer(cmd, 4, &dw);
+
+    dw[0] = GEN6_RENDER_CMD(COMMON, STATE_BASE_ADDRESS) | 2;
+    dw[1] = 0;
+    dw[2] = 0;
+    dw[3] = 0;
+
+    cmd_reserve_reloc(cmd, 1);
+    cmd_batch_reloc_writer(cmd, pos + 2, INTEL_CMD_WRITER_STATE, 1);
+}
+
+void cmd_batch_push_const_alloc(struct intel_cmd *cmd) {}
+
+struct intel_bo *intel_winsys_alloc_bo(struct intel_winsys *winsys, const char *name, unsigned long size,
+                                       bool cpu_init) {
+    if (bo_alloc_failures_pending == 0)
+        return NULL;
+    if (bo_alloc_failures_pending > 0)
+        bo_alloc_failures_pending--;
+
+    struct intel_bo *bo = new struct intel_bo();
+    bo->data.resize(size);
+    bo->address = next_bo_address;
+    bo->refcount = 1;
+    next_bo_address += (size + 0xfff) & ~0xfffull;
+
+    all_bos.insert(bo);
+    live_bos++;
+    bo_allocs++;
+    return bo;
+}
+
+bool intel_winsys_can_submit_bo(struct intel_winsys *winsys, struct intel_bo **bo_array, int count) {
+    submitted_bos.assign(bo_array, bo_array + count);
+    return true;
+}
+
+void intel_bo_unref(struct intel_bo *bo) {
+    if (!bo || --bo->refcount)
+        return;
+
+    EXPECT_FALSE(bo->mapped);
+    all_bos.erase(bo);
+    live_bos--;
+    delete bo;
+}
+
+void *intel_bo_map(struct intel_bo *bo, bool write_enable) {
+    EXPECT_FALSE(bo->mapped);
+    bo->mapped = true;
+    return bo->data.data();
+}
+
+void intel_bo_unmap(struct intel_bo *bo) {
+    EXPECT_TRUE(bo->mapped);
+    bo->mapped = false;
+}
+
+int intel_bo_add_reloc(struct intel_bo *bo, uint32_t offset, struct intel_bo *target_bo, uint32_t target_offset,
+                       uint32_t flags, uint64_t *presumed_offset) {
+    EXPECT_FALSE(bo->reloc_target) << "reloc added to a reloc target";
+    EXPECT_LE(offset + 4, bo->data.size());
+
+    bo->relocs.push_back({offset, target_bo, target_offset});
+    if (target_bo != bo)
+        target_bo->reloc_target = true;
+
+    *presumed_offset = target_bo->address + target_offset;
+    return 0;
+}
+
+void intel_bo_truncate_relocs(struct intel_bo *bo, int start) {
+    if (bo)
+        bo->relocs.resize(start);
+}
+
+void intel_bo_reset_relocs(struct intel_bo *bo) {
+    bo->relocs.clear();
+    bo->reloc_target = false;
+    bo_reloc_resets++;
+}
+}
+
+static const uint32_t kMiBatchBufferStart = GEN6_MI_CMD(MI_BATCH_BUFFER_START);
+static const uint32_t kMiBatchBufferEnd = GEN6_MI_CMD(MI_BATCH_BUFFER_END);
+static const uint32_t kMiNoop = GEN6_MI_CMD(MI_NOOP);
+static const uint32_t kMiCmdMask = 0xff800000;
+static const uint32_t kFirstValue = 0x1000;
+
+class IntelCmdWriterTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+        live_allocations = 0;
+        live_bos = 0;
+        bo_allocs = 0;
+        bo_reloc_resets = 0;
+        bo_alloc_failures_pending = -1;
+        submitted_bos.clear();
+
+        memset(&gpu_, 0, sizeof(gpu_));
+        gpu_.gen_opaque = INTEL_GEN(7.5);
+        gpu_.gt = 2;
+        gpu_.batch_buffer_reloc_count = 4096;
+        SetBlockSize(8192);
+
+        memset(&dev_, 0, sizeof(dev_));
+        dev_.gpu = &gpu_;
+
+        VkCommandPoolCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        info.queueFamilyIndex = INTEL_GPU_ENGINE_3D;
+        ASSERT_EQ(VK_SUCCESS, vkCreateCommandPool(Device(), &info, NULL, &pool_));
+    }
+
+    virtual void TearDown() {
+        if (pool_ != VK_NULL_HANDLE)
+            vkDestroyCommandPool(Device(), pool_, NULL);
+
+        EXPECT_EQ(0, live_allocations);
+        EXPECT_EQ(0, live_bos);
+        EXPECT_TRUE(all_bos.empty());
+    }
+
+    // The batch writer starts at half of max_batch_buffer_size, and so does each chained block
+    void SetBlockSize(uint32_t size) { gpu_.max_batch_buffer_size = size * 2; }
+
+    VkDevice Device() { return reinterpret_cast<VkDevice>(&dev_); }
+
+    struct intel_cmd_pool *Pool() { return intel_cmd_pool(pool_); }
+
+    struct intel_cmd *Allocate(VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY) {
+        VkCommandBufferAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool = pool_;
+        info.level = level;
+        info.commandBufferCount = 1;
+
+        VkCommandBuffer cmd_buf = VK_NULL_HANDLE;
+        EXPECT_EQ(VK_SUCCESS, vkAllocateCommandBuffers(Device(), &info, &cmd_buf));
+        return intel_cmd(cmd_buf);
+    }
+
+    void Free(struct intel_cmd *cmd) {
+        VkCommandBuffer cmd_buf = reinterpret_cast<VkCommandBuffer>(cmd);
+        vkFreeCommandBuffers(Device(), pool_, 1, &cmd_buf);
+    }
+
+    void Begin(struct intel_cmd *cmd) {
+        VkCommandBufferBeginInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        ASSERT_EQ(VK_SUCCESS, intel_cmd_begin(cmd, &info));
+    }
+
+    // Write \p count commands of three DWords, none of them MI_NOOP
+    void Record(struct intel_cmd *cmd, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t *dw;
+            cmd_batch_pointer(cmd, 3, &dw);
+            dw[0] = kFirstValue + i;
+            dw[1] = kFirstValue + i;
+            dw[2] = kFirstValue + i;
+        }
+    }
+
+    // The blocks of an ended batch, in execution order
+    std::vector<struct intel_bo *> Blocks(struct intel_cmd *cmd) {
+        const struct intel_cmd_writer *writer = &cmd->writers[INTEL_CMD_WRITER_BATCH];
+        std::vector<struct intel_bo *> blocks;
+
+        for (uint32_t i = 0; i < writer->chain_used; i++)
+            blocks.push_back(writer->chain[i].bo);
+        blocks.push_back(writer->bo);
+
+        return blocks;
+    }
+
+    size_t BlockUsed(struct intel_cmd *cmd, uint32_t block) {
+        const struct intel_cmd_writer *writer = &cmd->writers[INTEL_CMD_WRITER_BATCH];
+        return (block < writer->chain_used) ? writer->chain[block].used : writer->used;
+    }
+
+    static uint32_t Dword(const struct intel_bo *bo, size_t offset) {
+        return *reinterpret_cast<const uint32_t *>(bo->data.data() + offset);
+    }
+
+    // Follow the MI_BATCH_BUFFER_STARTs like the GPU and return the DWords executed, without the
+    // chaining commands and the padding
+    std::vector<uint32_t> Execute(struct intel_cmd *cmd) {
+        const std::vector<struct intel_bo *> blocks = Blocks(cmd);
+        std::vector<uint32_t> dwords;
+
+        for (size_t b = 0; b < blocks.size(); b++) {
+            const size_t used = BlockUsed(cmd, b);
+            const bool chained = (b + 1 < blocks.size());
+            const size_t end = chained ? used - 8 : used;
+
+            for (size_t offset = 0; offset < end; offset += 4)
+                dwords.push_back(Dword(blocks[b], offset));
+
+            if (chained) {
+                EXPECT_EQ(0u, used % 8) << "block " << b;
+                EXPECT_EQ(kMiBatchBufferStart, Dword(blocks[b], used - 8) & kMiCmdMask) << "block " << b;
+                EXPECT_EQ(blocks[b + 1]->address, Dword(blocks[b], used - 4)) << "block " << b;
+                if (dwords.back() == kMiNoop)
+                    dwords.pop_back();
+            }
+        }
+
+        EXPECT_EQ(0u, BlockUsed(cmd, blocks.size() - 1) % 8);
+        if (dwords.size() >= 2 && dwords.back() == kMiNoop && dwords[dwords.size() - 2] == kMiBatchBufferEnd)
+            dwords.pop_back();
+
+        return dwords;
+    }
+
+    // What Record(cmd, count) should have written, after the stand-in state base address
+    static std::vector<uint32_t> Expected(struct intel_cmd *cmd, uint32_t count) {
+        std::vector<uint32_t> dwords(4, 0);
+        dwords[0] = GEN6_RENDER_CMD(COMMON, STATE_BASE_ADDRESS) | 2;
+        dwords[2] = cmd->writers[INTEL_CMD_WRITER_STATE].bo->address + 1;
+
+        for (uint32_t i = 0; i < count; i++)
+            dwords.insert(dwords.end(), 3, kFirstValue + i);
+
+        dwords.push_back(kMiBatchBufferEnd);
+
+        return dwords;
+    }
+
+    struct intel_gpu gpu_;
+    struct intel_dev dev_;
+    VkCommandPool pool_ = VK_NULL_HANDLE;
+};
+
+TEST_F(IntelCmdWriterTest, SmallBatchIsNotChained) {
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+    Record(cmd, 100);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    EXPECT_EQ(0u, cmd->writers[INTEL_CMD_WRITER_BATCH].chain_used);
+    EXPECT_EQ(Expected(cmd, 100), Execute(cmd));
+
+    VkDeviceSize used;
+    EXPECT_EQ(cmd->writers[INTEL_CMD_WRITER_BATCH].bo, intel_cmd_get_batch(cmd, &used));
+    EXPECT_EQ(cmd->writers[INTEL_CMD_WRITER_BATCH].used, used);
+}
+
+TEST_F(IntelCmdWriterTest, ChainsFixedSizeBlocks) {
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+    const int allocs_after_begin = bo_allocs;
+
+    // About three and a half blocks
+    const uint32_t count = 8192 * 7 / 2 / 12;
+    Record(cmd, count);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    const std::vector<struct intel_bo *> blocks = Blocks(cmd);
+    ASSERT_EQ(4u, blocks.size());
+    EXPECT_EQ(allocs_after_begin + 3, bo_allocs);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        EXPECT_EQ(8192u, blocks[b]->data.size()) << "block " << b;
+        EXPECT_FALSE(blocks[b]->mapped) << "block " << b;
+    }
+
+    // Nothing is copied; the blocks run in order
+    EXPECT_EQ(Expected(cmd, count), Execute(cmd));
+
+    // Primary batches chain at the first level
+    const uint32_t dw0 = Dword(blocks[0], BlockUsed(cmd, 0) - 8);
+    EXPECT_TRUE(dw0 & GEN6_MI_BATCH_BUFFER_START_DW0_USE_PPGTT);
+    EXPECT_TRUE(dw0 & GEN75_MI_BATCH_BUFFER_START_DW0_NON_PRIVILEGED);
+    EXPECT_FALSE(dw0 & GEN75_MI_BATCH_BUFFER_START_DW0_SECOND_LEVEL);
+
+    // Each block has a reloc to the next one, for the kernel to find and patch
+    for (size_t b = 0; b + 1 < blocks.size(); b++) {
+        const MockReloc &reloc = blocks[b]->relocs.back();
+        EXPECT_EQ(BlockUsed(cmd, b) - 4, reloc.offset) << "block " << b;
+        EXPECT_EQ(blocks[b + 1], reloc.target) << "block " << b;
+        EXPECT_EQ(0u, reloc.target_offset) << "block " << b;
+    }
+    EXPECT_TRUE(blocks.back()->relocs.empty());
+
+    // The first block is submitted
+    VkDeviceSize used;
+    EXPECT_EQ(blocks[0], intel_cmd_get_batch(cmd, &used));
+    EXPECT_EQ(BlockUsed(cmd, 0), used);
+    ASSERT_EQ(1u, submitted_bos.size());
+    EXPECT_EQ(blocks[0], submitted_bos[0]);
+}
+
+TEST_F(IntelCmdWriterTest, SecondaryBatchesChainAtTheSecondLevel) {
+    struct intel_cmd *cmd = Allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+    // Secondary command buffers begin in a render pass; record as a primary, then chain as a
+    // secondary
+    cmd->primary = true;
+    Begin(cmd);
+    cmd->primary = false;
+    Record(cmd, 8192 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    const std::vector<struct intel_bo *> blocks = Blocks(cmd);
+    ASSERT_EQ(2u, blocks.size());
+    EXPECT_TRUE(Dword(blocks[0], BlockUsed(cmd, 0) - 8) & GEN75_MI_BATCH_BUFFER_START_DW0_SECOND_LEVEL);
+}
+
+TEST_F(IntelCmdWriterTest, RelocsStayInTheirBlock) {
+    struct intel_bo *target = intel_winsys_alloc_bo(NULL, "target", 4096, false);
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+
+    // One command with a reloc in each of three blocks
+    std::vector<uint32_t> offsets;
+    for (int b = 0; b < 3; b++) {
+        Record(cmd, 8192 / 12 - 4);
+
+        uint32_t *dw;
+        const uint32_t pos = cmd_batch_pointer(cmd, 2, &dw);
+        dw[0] = 0xcafe;
+        dw[1] = 0;
+        cmd_reserve_reloc(cmd, 1);
+        cmd_batch_reloc(cmd, pos + 1, target, 16 * b, 0);
+        offsets.push_back((pos + 1) * 4);
+    }
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    const std::vector<struct intel_bo *> blocks = Blocks(cmd);
+    ASSERT_EQ(3u, blocks.size());
+    for (int b = 0; b < 3; b++) {
+        const struct intel_bo *block = blocks[b];
+        const MockReloc *found = NULL;
+
+        for (size_t i = 0; i < block->relocs.size(); i++) {
+            if (block->relocs[i].target == target)
+                found = &block->relocs[i];
+        }
+        ASSERT_TRUE(found) << "block " << b;
+        EXPECT_EQ(offsets[b], found->offset) << "block " << b;
+        EXPECT_EQ(16u * b, found->target_offset) << "block " << b;
+        EXPECT_EQ(0xcafeu, Dword(block, offsets[b] - 4)) << "block " << b;
+        EXPECT_EQ(target->address + 16 * b, Dword(block, offsets[b])) << "block " << b;
+    }
+
+    // The stand-in state base address is in the first block and points to the state writer
+    const struct intel_bo *state = cmd->writers[INTEL_CMD_WRITER_STATE].bo;
+    bool found_sba = false;
+    for (size_t i = 0; i < blocks[0]->relocs.size(); i++) {
+        const MockReloc &reloc = blocks[0]->relocs[i];
+        if (reloc.target == state) {
+            EXPECT_EQ(8u, reloc.offset);
+            EXPECT_EQ(state->address + 1, Dword(blocks[0], 8));
+            found_sba = true;
+        }
+    }
+    EXPECT_TRUE(found_sba);
+
+    Free(cmd);
+    intel_bo_unref(target);
+}
+
+TEST_F(IntelCmdWriterTest, ResetReusesBos) {
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+    Record(cmd, 8192 * 5 / 2 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    const int allocs = bo_allocs;
+    const std::vector<struct intel_bo *> blocks = Blocks(cmd);
+    const std::set<struct intel_bo *> bos(all_bos);
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(VK_SUCCESS, vkResetCommandBuffer(reinterpret_cast<VkCommandBuffer>(cmd), 0));
+        EXPECT_EQ(allocs, bo_allocs);
+        EXPECT_EQ(bos.size(), Pool()->bo_used);
+
+        Begin(cmd);
+        Record(cmd, 8192 * 5 / 2 / 12);
+        ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+        // Same bos, reloc lists started over, nothing allocated
+        EXPECT_EQ(allocs, bo_allocs);
+        EXPECT_EQ(bos, all_bos);
+        EXPECT_EQ(blocks.size(), Blocks(cmd).size());
+        EXPECT_EQ(Expected(cmd, 8192 * 5 / 2 / 12), Execute(cmd));
+        EXPECT_EQ(0u, Pool()->bo_used);
+    }
+
+    EXPECT_LE((int)bos.size() * 3, bo_reloc_resets);
+}
+
+TEST_F(IntelCmdWriterTest, BeginReusesBos) {
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+    Record(cmd, 8192 * 3 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+
+    // vkBeginCommandBuffer resets implicitly
+    const int allocs = bo_allocs;
+    Begin(cmd);
+    Record(cmd, 8192 * 3 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+    EXPECT_EQ(allocs, bo_allocs);
+}
+
+TEST_F(IntelCmdWriterTest, CommandBuffersShareThePoolCache) {
+    struct intel_cmd *a = Allocate();
+    Begin(a);
+    Record(a, 8192 * 2 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(a));
+    Free(a);
+
+    const int allocs = bo_allocs;
+    struct intel_cmd *b = Allocate();
+    Begin(b);
+    Record(b, 8192 * 2 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(b));
+    EXPECT_EQ(allocs, bo_allocs);
+}
+
+TEST_F(IntelCmdWriterTest, PoolResetResetsCommandBuffers) {
+    struct intel_cmd *cmds[3];
+    for (int i = 0; i < 3; i++) {
+        cmds[i] = Allocate();
+        Begin(cmds[i]);
+        Record(cmds[i], 8192 * i / 12);
+        ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmds[i]));
+    }
+    const int bos = live_bos;
+
+    ASSERT_EQ(VK_SUCCESS, vkResetCommandPool(Device(), pool_, 0));
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(cmds[i]->writers[INTEL_CMD_WRITER_BATCH].bo == NULL);
+        EXPECT_EQ(0u, cmds[i]->writers[INTEL_CMD_WRITER_BATCH].chain_used);
+    }
+    EXPECT_EQ(bos, live_bos);
+    EXPECT_EQ((uint32_t)bos, Pool()->bo_used);
+
+    ASSERT_EQ(VK_SUCCESS, vkResetCommandPool(Device(), pool_, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT));
+    EXPECT_EQ(0, live_bos);
+    EXPECT_EQ(0u, Pool()->bo_used);
+    EXPECT_EQ(0u, Pool()->bo_cache_size);
+
+    // The command buffers are still usable
+    Begin(cmds[1]);
+    Record(cmds[1], 8192 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmds[1]));
+    EXPECT_EQ(Expected(cmds[1], 8192 / 12), Execute(cmds[1]));
+}
+
+TEST_F(IntelCmdWriterTest, DestroyPoolFreesCommandBuffers) {
+    for (int i = 0; i < 4; i++) {
+        struct intel_cmd *cmd = Allocate(i % 2 ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        if (i % 2)
+            continue;
+        Begin(cmd);
+        Record(cmd, 8192 * 2 / 12);
+    }
+    Free(Pool()->cmds);
+
+    vkDestroyCommandPool(Device(), pool_, NULL);
+    pool_ = VK_NULL_HANDLE;
+}
+
+TEST_F(IntelCmdWriterTest, CacheIsBounded) {
+    // Four command buffers use 4 x 8MB of bos
+    SetBlockSize(4 * 1024 * 1024);
+
+    std::vector<struct intel_cmd *> cmds;
+    for (int i = 0; i < 4; i++) {
+        cmds.push_back(Allocate());
+        Begin(cmds.back());
+        ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmds.back()));
+    }
+    for (size_t i = 0; i < cmds.size(); i++)
+        Free(cmds[i]);
+
+    EXPECT_LE(Pool()->bo_cache_size, (size_t)INTEL_CMD_POOL_BO_CACHE_SIZE);
+    EXPECT_GT(Pool()->bo_cache_size, (size_t)INTEL_CMD_POOL_BO_CACHE_SIZE / 2);
+    EXPECT_EQ((int)Pool()->bo_used, live_bos);
+}
+
+TEST_F(IntelCmdWriterTest, ChainFailureFailsTheCommandBuffer) {
+    struct intel_cmd *cmd = Allocate();
+    Begin(cmd);
+    Record(cmd, 600);
+
+    bo_alloc_failures_pending = 0;
+    Record(cmd, 200);
+    bo_alloc_failures_pending = -1;
+
+    EXPECT_EQ(VK_ERROR_OUT_OF_DEVICE_MEMORY, intel_cmd_end(cmd));
+    EXPECT_TRUE(submitted_bos.empty());
+
+    // A reset recovers
+    Begin(cmd);
+    Record(cmd, 8192 * 2 / 12);
+    ASSERT_EQ(VK_SUCCESS, intel_cmd_end(cmd));
+    EXPECT_EQ(Expected(cmd, 8192 * 2 / 12), Execute(cmd));
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// CPU-side tests of the Intel ICD's descriptor region allocator (icd/intel/desc_allocator.c), which
+// is built into this executable on its own.  intel_alloc() and intel_free() are provided here so
+// that allocation failures can be injected.
+
+#include <stdlib.h>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "desc_allocator.h"
+}
+
+static const uint32_t kBegin = 64;
+static const uint32_t kEnd = 64 + 1024;
+
+static int alloc_failures_pending = -1;
+static int live_allocations = 0;
+
+extern "C" void *intel_alloc(const void *handle, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    if (alloc_failures_pending == 0)
+        return NULL;
+    if (alloc_failures_pending > 0)
+        alloc_failures_pending--;
+    live_allocations++;
+    return malloc(size);
+}
+
+extern "C" void intel_free(const void *handle, void *ptr) {
+    if (ptr)
+        live_allocations--;
+    free(ptr);
+}
+
+class IntelDescAllocatorTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() {
+        alloc_failures_pending = -1;
+        live_allocations = 0;
+        ASSERT_EQ(VK_SUCCESS, intel_desc_allocator_init(&allocator_, this, VK_SYSTEM_ALLOCATION_SCOPE_DEVICE, kBegin, kEnd));
+    }
+
+    virtual void TearDown() {
+        intel_desc_allocator_cleanup(&allocator_);
+        EXPECT_EQ(0, live_allocations);
+        alloc_failures_pending = -1;
+    }
+
+    uint32_t Alloc(uint32_t size) {
+        uint32_t offset = ~0u;
+        EXPECT_EQ(VK_SUCCESS, intel_desc_allocator_alloc(&allocator_, size, &offset));
+        return offset;
+    }
+
+    bool IsEmpty() const {
+        return allocator_.alloc_count == 0 && allocator_.free_count == 1 && allocator_.free_ranges[0].begin == kBegin &&
+               allocator_.free_ranges[0].end == kEnd;
+    }
+
+    intel_desc_allocator allocator_;
+};
+
+TEST_F(IntelDescAllocatorTest, AllocatesFromTheBeginning) {
+    EXPECT_EQ(kBegin, Alloc(16));
+    EXPECT_EQ(kBegin + 16, Alloc(32));
+    EXPECT_EQ(kBegin + 48, Alloc(16));
+    EXPECT_EQ(3u, allocator_.alloc_count);
+}
+
+TEST_F(IntelDescAllocatorTest, FailsWhenExhausted) {
+    EXPECT_EQ(kBegin, Alloc(kEnd - kBegin - 16));
+    EXPECT_EQ(kEnd - 16, Alloc(16));
+
+    uint32_t offset;
+    EXPECT_EQ(VK_ERROR_OUT_OF_HOST_MEMORY, intel_desc_allocator_alloc(&allocator_, 16, &offset));
+    EXPECT_EQ(2u, allocator_.alloc_count);
+}
+
+TEST_F(IntelDescAllocatorTest, EmptyAllocationsTakeNoSpace) {
+    EXPECT_EQ(kBegin, Alloc(0));
+    EXPECT_EQ(kBegin, Alloc(kEnd - kBegin));
+    EXPECT_EQ(kBegin, Alloc(0));
+    EXPECT_EQ(1u, allocator_.alloc_count);
+
+    intel_desc_allocator_free(&allocator_, kBegin, 0);
+    EXPECT_EQ(1u, allocator_.alloc_count);
+}
+
+TEST_F(IntelDescAllocatorTest, ReusesFreedSpace) {
+    const uint32_t a = Alloc(64);
+    const uint32_t b = Alloc(64);
+    Alloc(64);
+
+    intel_desc_allocator_free(&allocator_, b, 64);
+    EXPECT_EQ(b, Alloc(32));
+    EXPECT_EQ(b + 32, Alloc(32));
+
+    intel_desc_allocator_free(&allocator_, a, 64);
+    EXPECT_EQ(a, Alloc(64));
+}
+
+TEST_F(IntelDescAllocatorTest, FirstFitSkipsSmallerHoles) {
+    const uint32_t a = Alloc(16);
+    Alloc(16);
+    const uint32_t c = Alloc(64);
+    Alloc(16);
+
+    intel_desc_allocator_free(&allocator_, a, 16);
+    intel_desc_allocator_free(&allocator_, c, 64);
+    EXPECT_EQ(c, Alloc(48));
+    EXPECT_EQ(a, Alloc(16));
+}
+
+TEST_F(IntelDescAllocatorTest, CoalescesInAnyOrder) {
+    const uint32_t orders[][4] = {{0, 1, 2, 3}, {3, 2, 1, 0}, {1, 3, 0, 2}, {2, 0, 3, 1}, {0, 2, 1, 3}};
+
+    for (size_t o = 0; o < sizeof(orders) / sizeof(orders[0]); o++) {
+        uint32_t offsets[4];
+        for (int i = 0; i < 4; i++)
+            offsets[i] = Alloc(i == 3 ? kEnd - kBegin - 3 * 48 : 48);
+
+        for (int i = 0; i < 4; i++) {
+            const uint32_t index = orders[o][i];
+            intel_desc_allocator_free(&allocator_, offsets[index], index == 3 ? kEnd - kBegin - 3 * 48 : 48);
+        }
+
+        EXPECT_TRUE(IsEmpty()) << "order " << o;
+    }
+}
+
+TEST_F(IntelDescAllocatorTest, ResetFreesEverything) {
+    Alloc(16);
+    const uint32_t b = Alloc(16);
+    Alloc(16);
+    intel_desc_allocator_free(&allocator_, b, 16);
+
+    intel_desc_allocator_reset(&allocator_);
+    EXPECT_TRUE(IsEmpty());
+    EXPECT_EQ(kBegin, Alloc(kEnd - kBegin));
+}
+
+TEST_F(IntelDescAllocatorTest, EmptyRange) {
+    intel_desc_allocator empty;
+    ASSERT_EQ(VK_SUCCESS, intel_desc_allocator_init(&empty, this, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT, 32, 32));
+
+    uint32_t offset = 0;
+    EXPECT_EQ(VK_SUCCESS, intel_desc_allocator_alloc(&empty, 0, &offset));
+    EXPECT_EQ(32u, offset);
+    EXPECT_EQ(VK_ERROR_OUT_OF_HOST_MEMORY, intel_desc_allocator_alloc(&empty, 16, &offset));
+
+    intel_desc_allocator_reset(&empty);
+    EXPECT_EQ(0u, empty.free_count);
+    intel_desc_allocator_cleanup(&empty);
+}
+
+// Growing the free range array is the only allocation; a failure leaves the allocator as it was
+// and a later free still has room to split a range
+TEST_F(IntelDescAllocatorTest, HostAllocationFailure) {
+    std::vector<uint32_t> offsets;
+    while (allocator_.free_capacity >= allocator_.alloc_count + 2)
+        offsets.push_back(Alloc(16));
+
+    alloc_failures_pending = 0;
+    uint32_t offset;
+    EXPECT_EQ(VK_ERROR_OUT_OF_HOST_MEMORY, intel_desc_allocator_alloc(&allocator_, 16, &offset));
+    EXPECT_EQ(offsets.size(), allocator_.alloc_count);
+    alloc_failures_pending = -1;
+
+    // Free every other allocation, so that each free adds a range
+    for (size_t i = 0; i < offsets.size(); i += 2)
+        intel_desc_allocator_free(&allocator_, offsets[i], 16);
+    EXPECT_LE(allocator_.free_count, allocator_.free_capacity);
+
+    for (size_t i = 1; i < offsets.size(); i += 2)
+        intel_desc_allocator_free(&allocator_, offsets[i], 16);
+    EXPECT_TRUE(IsEmpty());
+}
+
+// Random allocations and frees, checked against a map of which bytes are in use
+TEST_F(IntelDescAllocatorTest, RandomChurn) {
+    struct Allocation {
+        uint32_t offset;
+        uint32_t size;
+    };
+    std::vector<Allocation> live;
+    std::vector<bool> used(kEnd, false);
+    std::mt19937 rng(1234);
+
+    for (int step = 0; step < 20000; step++) {
+        if (live.empty() || rng() % 100 < 55) {
+            const uint32_t size = (rng() % 8) * 8;
+            uint32_t offset;
+            if (intel_desc_allocator_alloc(&allocator_, size, &offset) != VK_SUCCESS)
+                continue;
+            ASSERT_LE(kBegin, offset);
+            ASSERT_LE(offset + size, kEnd);
+            for (uint32_t i = offset; i < offset + size; i++) {
+                ASSERT_FALSE(used[i]) << "byte " << i << " allocated twice";
+                used[i] = true;
+            }
+            if (size)
+                live.push_back({offset, size});
+        } else {
+            const size_t index = rng() % live.size();
+            const Allocation a = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            for (uint32_t i = a.offset; i < a.offset + a.size; i++)
+                used[i] = false;
+            intel_desc_allocator_free(&allocator_, a.offset, a.size);
+        }
+
+        ASSERT_EQ(live.size(), allocator_.alloc_count);
+        ASSERT_LE(allocator_.free_count, allocator_.alloc_count + 1);
+        for (uint32_t i = 1; i < allocator_.free_count; i++)
+            ASSERT_LT(allocator_.free_ranges[i - 1].end, allocator_.free_ranges[i].begin);
+    }
+
+    for (size_t i = 0; i < live.size(); i++)
+        intel_desc_allocator_free(&allocator_, live[i].offset, live[i].size);
+    EXPECT_TRUE(IsEmpty());
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2016 The Khronos Group Inc.
+ * Copyright (c) 2016 Valve Corporation
+ * Copyright (c) 2016 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Tests of the loader's streaming JSON reader (loader/json_stream.c), which is built into this
+// executable on its own.
+
+#include <string.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "json_stream.h"
+
+class LoaderJsonStream : public ::testing::Test {
+  protected:
+    void Init(const std::string &text) {
+        text_ = text;
+        loader_json_init(&json_, text_.data(), text_.size());
+    }
+
+    // Reads the next value, which must be a string or number, and returns its decoded copy
+    std::string ReadString(size_t dst_size = 256) {
+        struct loader_json_value value;
+        EXPECT_TRUE(loader_json_read(&json_, &value));
+        std::string copy(dst_size, 'x');
+        EXPECT_TRUE(loader_json_copy(&value, &copy[0], dst_size));
+        return std::string(copy.c_str());
+    }
+
+    std::string text_;
+    struct loader_json json_;
+};
+
+TEST_F(LoaderJsonStream, DecodesEscapes) {
+    Init("\"quote\\\" backslash\\\\ slash\\/ \\b\\f\\n\\r\\t\"");
+    EXPECT_EQ("quote\" backslash\\ slash/ \b\f\n\r\t", ReadString());
+}
+
+TEST_F(LoaderJsonStream, DecodesUnicodeEscapes) {
+    Init("\"\\u0041\\u00e9\\u20AC\\ud83d\\ude00\"");
+    EXPECT_EQ("A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", ReadString());
+}
+
+TEST_F(LoaderJsonStream, KeepsUnknownEscapes) {
+    // Unescaped Windows paths in manifests loaded under cJSON and must still load
+    Init("\"C:\\Windows\\qt\\u12\"");
+    EXPECT_EQ("C:\\Windows\\qt\\u12", ReadString());
+}
+
+TEST_F(LoaderJsonStream, StopsAtEscapedNul) {
+    Init("\"before\\u0000after\"");
+    EXPECT_EQ("before", ReadString());
+}
+
+TEST_F(LoaderJsonStream, ReadsNestedValues) {
+    Init("{ \"file_format_version\": \"1.0.0\",\n"
+         "  \"layer\": { \"name\": \"VK_LAYER_test\", \"skip\": [1, [2, {\"a\": null}], -3.5e2],\n"
+         "             \"entrypoints\": [\"vkA\", \"vkB\"] } }");
+    struct loader_json_value value, key;
+    uint32_t index = 0;
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    EXPECT_EQ(LOADER_JSON_OBJECT, value.type);
+
+    ASSERT_TRUE(loader_json_next_member(&json_, &index, &key));
+    EXPECT_TRUE(loader_json_key_is(&key, "FILE_FORMAT_VERSION"));
+    EXPECT_EQ("1.0.0", ReadString());
+
+    ASSERT_TRUE(loader_json_next_member(&json_, &index, &key));
+    EXPECT_TRUE(loader_json_key_is(&key, "layer"));
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    EXPECT_EQ(LOADER_JSON_OBJECT, value.type);
+
+    uint32_t layer_index = 0;
+    ASSERT_TRUE(loader_json_next_member(&json_, &layer_index, &key));
+    EXPECT_TRUE(loader_json_key_is(&key, "name"));
+    EXPECT_EQ("VK_LAYER_test", ReadString());
+    ASSERT_TRUE(loader_json_next_member(&json_, &layer_index, &key));
+    EXPECT_TRUE(loader_json_key_is(&key, "skip"));
+    EXPECT_TRUE(loader_json_skip(&json_));
+    ASSERT_TRUE(loader_json_next_member(&json_, &layer_index, &key));
+    EXPECT_TRUE(loader_json_key_is(&key, "entrypoints"));
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    EXPECT_EQ(LOADER_JSON_ARRAY, value.type);
+
+    uint32_t element_index = 0;
+    ASSERT_TRUE(loader_json_next_element(&json_, &element_index));
+    EXPECT_EQ("vkA", ReadString());
+    ASSERT_TRUE(loader_json_next_element(&json_, &element_index));
+    EXPECT_EQ("vkB", ReadString());
+    EXPECT_FALSE(loader_json_next_element(&json_, &element_index));
+
+    EXPECT_FALSE(loader_json_next_member(&json_, &layer_index, &key));
+    EXPECT_FALSE(loader_json_next_member(&json_, &index, &key));
+    EXPECT_FALSE(json_.error);
+    EXPECT_EQ(0u, json_.depth);
+}
+
+TEST_F(LoaderJsonStream, SavesPositionByCopy) {
+    Init("[\"first\", \"second\"]");
+    struct loader_json_value value;
+    uint32_t index = 0;
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    ASSERT_TRUE(loader_json_next_element(&json_, &index));
+    struct loader_json saved = json_;
+    uint32_t saved_index = index;
+    EXPECT_EQ("first", ReadString());
+    json_ = saved;
+    index = saved_index;
+    EXPECT_EQ("first", ReadString());
+    ASSERT_TRUE(loader_json_next_element(&json_, &index));
+    EXPECT_EQ("second", ReadString());
+}
+
+TEST_F(LoaderJsonStream, RejectsDeepNesting) {
+    Init(std::string(100, '[') + std::string(100, ']'));
+    EXPECT_FALSE(loader_json_skip(&json_));
+    EXPECT_TRUE(json_.error);
+}
+
+TEST_F(LoaderJsonStream, FailsOnTruncatedInput) {
+    static const char *const truncated[] = {
+        "", "{", "{\"layer\"", "{\"layer\":", "{\"layer\": \"abc", "{\"layer\": \"abc\\", "[1, 2", "[1,", "tru", "-", "1.", "1e",
+    };
+    for (size_t i = 0; i < sizeof(truncated) / sizeof(truncated[0]); ++i) {
+        Init(truncated[i]);
+        EXPECT_FALSE(loader_json_skip(&json_)) << "input: " << truncated[i];
+        EXPECT_TRUE(json_.error) << "input: " << truncated[i];
+    }
+}
+
+TEST_F(LoaderJsonStream, StaysFailedAfterError) {
+    Init("[1 2] \"after\"");
+    EXPECT_FALSE(loader_json_skip(&json_));
+    struct loader_json_value value;
+    EXPECT_EQ(LOADER_JSON_NONE, loader_json_peek(&json_));
+    EXPECT_FALSE(loader_json_read(&json_, &value));
+    EXPECT_EQ(LOADER_JSON_NONE, value.type);
+}
+
+TEST_F(LoaderJsonStream, TruncatesOversizedStrings) {
+    std::string long_string(100000, 'a');
+    Init("\"" + long_string + "\"");
+    struct loader_json_value value;
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    EXPECT_EQ(long_string.size(), value.length);
+
+    char small[8];
+    memset(small, 'x', sizeof(small));
+    EXPECT_TRUE(loader_json_copy(&value, small, sizeof(small)));
+    EXPECT_STREQ("aaaaaaa", small);
+}
+
+TEST_F(LoaderJsonStream, DoesNotSplitMultibyteCharacters) {
+    // Three bytes of room: 'a' fits, the two-byte e-acute after it doesn't
+    Init("\"a\\u00e9b\"");
+    EXPECT_EQ("a", ReadString(3));
+}
+
+TEST_F(LoaderJsonStream, CopiesOnlyScalars) {
+    Init("{\"a\": 1}");
+    struct loader_json_value value;
+    ASSERT_TRUE(loader_json_read(&json_, &value));
+    char dst[8];
+    EXPECT_FALSE(loader_json_copy(&value, dst, sizeof(dst)));
+    EXPECT_STREQ("", dst);
+}
@@ -283,6 +283,206 @@ class DispatchTableOpsSubcommand(Subcommand):
 
         return "\n\n".join(body)
 
+class ProcNameHashSubcommand(Subcommand):
+    """Generate a perfect hash over every Vulkan entrypoint name.
+
+    vk_proc_index() maps a name to its VkProcIndex with one hash of the
+    string and a single strcmp, so vkGet*ProcAddr implementations in the
+    loader and layers don't need to walk long strcmp chains.  Offsets of
+    each command in VkLayerDispatchTable and VkLayerInstanceDispatchTable
+    are emitted alongside so table lookups are a single load.
+    """
+
+    platforms = [("Win32", "VK_USE_PLATFORM_WIN32_KHR"),
+                 ("Xlib", "VK_USE_PLATFORM_XLIB_KHR"),
+                 ("Xcb", "VK_USE_PLATFORM_XCB_KHR"),
+                 ("Mir", "VK_USE_PLATFORM_MIR_KHR"),
+                 ("Wayland", "VK_USE_PLATFORM_WAYLAND_KHR"),
+                 ("Android", "VK_USE_PLATFORM_ANDROID_KHR")]
+
+    def __init__(self, argv):
+        self.argv = argv
+        self.headers = vulkan.headers_all
+        self.protos = vulkan.protos_all
+        self.outfile = None
+
+    def run(self):
+        if len(self.argv) > 1:
+            print("ProcNameHashSubcommand: [outfile]")
+            return
+
+        if len(self.argv) == 1:
+            self.outfile = self.argv[0]
+
+        super(ProcNameHashSubcommand, self).run()
+
+    def generate_header(self):
+        return "\n".join(["#ifndef VK_PROC_NAME_HASH_H",
+                          "#define VK_PROC_NAME_HASH_H",
+                          "",
+                          "#include <stddef.h>",
+                          "#include <stdint.h>",
+                          "#include <string.h>",
+                          "#include <vulkan/vulkan.h>",
+                          "#include <vulkan/vk_layer.h>"])
+
+    def generate_footer(self):
+        return "#endif // VK_PROC_NAME_HASH_H"
+
+    @staticmethod
+    def _fnv1a(name):
+        h = 2166136261
+        for c in name.encode("ascii"):
+            h ^= c
+            h = (h * 16777619) & 0xffffffff
+        return h
+
+    @staticmethod
+    def _mix(h):
+        h ^= h >> 16
+        h = (h * 0x85ebca6b) & 0xffffffff
+        h ^= h >> 13
+        h = (h * 0xc2b2ae35) & 0xffffffff
+        h ^= h >> 16
+        return h
+
+    def _slot(self, h, displacement):
+        return self._mix(h ^ ((displacement * 0x9e3779b1) & 0xffffffff)) >> (32 - self.slot_bits)
+
+    def _build_hash(self, names):
+        # Hash-and-displace: names are grouped into buckets by their string
+        # hash, then each bucket (largest first) gets the smallest
+        # displacement that moves all of its names into free slots.
+        self.slot_bits = 1
+        while (1 << self.slot_bits) < len(names) * 5 // 4:
+            self.slot_bits += 1
+        self.bucket_bits = self.slot_bits - 1
+
+        hashes = [self._fnv1a(name) for name in names]
+        buckets = [[] for _ in range(1 << self.bucket_bits)]
+        for index, h in enumerate(hashes):
+            buckets[h & ((1 << self.bucket_bits) - 1)].append(index)
+
+        self.slots = [-1] * (1 << self.slot_bits)
+        self.displacements = [0] * len(buckets)
+        for bucket in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+            members = buckets[bucket]
+            if not members:
+                continue
+            for displacement in range(1 << 16):
+                slots = [self._slot(hashes[i], displacement) for i in members]
+                if len(set(slots)) == len(slots) and all(self.slots[slot] < 0 for slot in slots):
+                    break
+            else:
+                raise Exception("no perfect hash displacement for bucket %d" % bucket)
+            self.displacements[bucket] = displacement
+            for i, slot in zip(members, slots):
+                self.slots[slot] = i
+
+    def _platform(self, name):
+        if "KHR" not in name:
+            return None
+        for platform, define in self.platforms:
+            if platform in name:
+                return define
+        return None
+
+    def _is_device_command(self, proto):
+        if proto.name in ["CreateInstance", "EnumerateInstanceExtensionProperties", "EnumerateInstanceLayerProperties"]:
+            return False
+        return proto.params[0].ty not in ["VkInstance", "VkPhysicalDevice"]
+
+    def _is_instance_command(self, proto):
+        if proto.name == "CreateDevice":
+            return False
+        return proto.params[0].ty in ["VkInstance", "VkPhysicalDevice"]
+
+    def _generate_offsets(self, var, table, is_member):
+        lines = ["static const int16_t %s[VK_PROC_COUNT] = {" % var]
+        for proto in self.protos:
+            if not is_member(proto):
+                lines.append("    -1, // vk%s" % proto.name)
+                continue
+            define = self._platform(proto.name)
+            if define:
+                lines.append("#ifdef %s" % define)
+            lines.append("    offsetof(%s, %s)," % (table, proto.name))
+            if define:
+                lines.append("#else")
+                lines.append("    -1,")
+                lines.append("#endif")
+        lines.append("};")
+        return "\n".join(lines)
+
+    def generate_body(self):
+        names = ["vk" + proto.name for proto in self.protos]
+        self._build_hash(names)
+
+        body = []
+        body.append("typedef enum VkProcIndex {")
+        for index, proto in enumerate(self.protos):
+            body.append("    VK_PROC_%s = %d," % (proto.name, index))
+        body.append("    VK_PROC_COUNT = %d" % len(self.protos))
+        body.append("} VkProcIndex;")
+        body.append("")
+        body.append("static const char *const vk_proc_names[VK_PROC_COUNT] = {")
+        for name in names:
+            body.append("    \"%s\"," % name)
+        body.append("};")
+        body.append("")
+        body.append("#define VK_PROC_HASH_SLOT_BITS %d" % self.slot_bits)
+        body.append("#define VK_PROC_HASH_BUCKET_MASK 0x%xu" % ((1 << self.bucket_bits) - 1))
+        body.append("")
+        body.append("// VkProcIndex stored in each slot, or -1")
+        body.append("static const int16_t vk_proc_hash_slots[1 << VK_PROC_HASH_SLOT_BITS] = {")
+        for i in range(0, len(self.slots), 16):
+            body.append("    " + " ".join("%d," % v for v in self.slots[i:i + 16]))
+        body.append("};")
+        body.append("")
+        body.append("static const uint16_t vk_proc_hash_displacements[VK_PROC_HASH_BUCKET_MASK + 1] = {")
+        for i in range(0, len(self.displacements), 16):
+            body.append("    " + " ".join("%d," % v for v in self.displacements[i:i + 16]))
+        body.append("};")
+        body.append("")
+        body.append("static inline uint32_t vk_proc_hash_mix(uint32_t h) {")
+        body.append("    h ^= h >> 16;")
+        body.append("    h *= 0x85ebca6bu;")
+        body.append("    h ^= h >> 13;")
+        body.append("    h *= 0xc2b2ae35u;")
+        body.append("    h ^= h >> 16;")
+        body.append("    return h;")
+        body.append("}")
+        body.append("")
+        body.append("// Returns the VkProcIndex of a Vulkan entrypoint name, or -1 if name is not one")
+        body.append("static inline int vk_proc_index(const char *name) {")
+        body.append("    uint32_t h = 2166136261u;")
+        body.append("    const char *p;")
+        body.append("    uint32_t displacement;")
+        body.append("    int index;")
+        body.append("")
+        body.append("    if (!name || name[0] != 'v' || name[1] != 'k')")
+        body.append("        return -1;")
+        body.append("    for (p = name; *p; ++p) {")
+        body.append("        h ^= (uint8_t)*p;")
+        body.append("        h *= 16777619u;")
+        body.append("    }")
+        body.append("    displacement = vk_proc_hash_displacements[h & VK_PROC_HASH_BUCKET_MASK];")
+        body.append("    index = vk_proc_hash_slots[vk_proc_hash_mix(h ^ (displacement * 0x9e3779b1u)) >> (32 - VK_PROC_HASH_SLOT_BITS)];")
+        body.append("    if (index < 0 || strcmp(vk_proc_names[index], name))")
+        body.append("        return -1;")
+        body.append("    return index;")
+        body.append("}")
+        body.append("")
+        body.append("// Byte offset of each device command in VkLayerDispatchTable, or -1")
+        body.append(self._generate_offsets("vk_proc_device_table_offsets", "VkLayerDispatchTable",
+                                           self._is_device_command))
+        body.append("")
+        body.append("// Byte offset of each instance command in VkLayerInstanceDispatchTable, or -1")
+        body.append(self._generate_offsets("vk_proc_instance_table_offsets", "VkLayerInstanceDispatchTable",
+                                           self._is_instance_command))
+
+        return "\n".join(body)
+
 class WinDefFileSubcommand(Subcommand):
     def run(self):
         library_exports = {
@@ -372,6 +572,7 @@ def main():
     subcommands = {
             "dispatch-table-ops": DispatchTableOpsSubcommand,
             "win-def-file": WinDefFileSubcommand,
+            "proc-name-hash": ProcNameHashSubcommand,
     }
 
     if len(sys.argv) < 3 or sys.argv[1] not in wsi or sys.argv[2] not in subcommands:
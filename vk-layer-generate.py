@@ -784,9 +784,9 @@ class UniqueObjectsSubcommand(Subcommand):
                     idx = 'idx%s' % str(array_index)
                     array_index += 1
                     if first_level_param and name in param_type:
-                        pre_code += '%slocal_%s = new safe_%s[%s%s];\n' % (indent, name, param_type[name].strip('*'), count_prefix, array)
+                        pre_code += '%slocal_%s = layer_scratch_new_array<safe_%s>(%s%s);\n' % (indent, name, param_type[name].strip('*'), count_prefix, array)
                         post_code += '    if (local_%s)\n' % (name)
-                        post_code += '        delete[] local_%s;\n' % (name)
+                        post_code += '        layer_scratch_delete_array(local_%s);\n' % (name)
                     pre_code += '%sfor (uint32_t %s=0; %s<%s%s%s; ++%s) {\n' % (indent, idx, idx, count_prefix, prefix, array, idx)
                     indent += '    '
                     if first_level_param:
@@ -794,9 +794,9 @@ class UniqueObjectsSubcommand(Subcommand):
                     local_prefix = '%s[%s].' % (name, idx)
                 elif ptr_type:
                     if first_level_param and name in param_type:
-                        pre_code += '%slocal_%s = new safe_%s(%s);\n' % (indent, name, param_type[name].strip('*'), name)
+                        pre_code += '%slocal_%s = layer_scratch_new<safe_%s>(%s);\n' % (indent, name, param_type[name].strip('*'), name)
                         post_code += '    if (local_%s)\n' % (name)
-                        post_code += '        delete local_%s;\n' % (name)
+                        post_code += '        layer_scratch_delete(local_%s);\n' % (name)
                     local_prefix = '%s->' % (name)
                 else:
                     local_prefix = '%s.' % (name)
@@ -824,9 +824,9 @@ class UniqueObjectsSubcommand(Subcommand):
                         idx = 'idx%s' % str(array_index)
                         array_index += 1
                         if first_level_param:
-                            pre_code += '%slocal_%s = new %s[%s];\n' % (indent, name, struct_uses[obj], array)
+                            pre_code += '%slocal_%s = layer_scratch_new_array<%s>(%s);\n' % (indent, name, struct_uses[obj], array)
                             post_code += '    if (local_%s)\n' % (name)
-                            post_code += '        delete[] local_%s;\n' % (name)
+                            post_code += '        layer_scratch_delete_array(local_%s);\n' % (name)
                         pre_code += '%sfor (uint32_t %s=0; %s<%s%s; ++%s) {\n' % (indent, idx, idx, prefix, array, idx)
                         indent += '    '
                         name = '%s[%s]' % (name, idx)
@@ -925,6 +925,8 @@ class UniqueObjectsSubcommand(Subcommand):
                     pre_decl += '    safe_%s local_%s = %s;\n' % (local_decls[ld], ld, init_null_txt)
             if pre_code != '': # lock around map uses
                 pre_code = '%s{\n%sstd::lock_guard<std::mutex> lock(global_lock);\n%s%s}\n' % (indent, indent, pre_code, indent)
+            if len(local_decls) > 0: # local deep copies are carved from a per-call scratch arena, released on return
+                pre_decl = '%sVkLayerScratchScope scratch_scope;\n%s' % (indent, pre_decl)
             pre_call_txt += '%s%s' % (pre_decl, pre_code)
             post_call_txt += '%s' % (post_code)
         elif create_func:
@@ -318,8 +318,8 @@ class Subcommand(object):
 
     def _gen_layer_get_global_layer_props(self, layer="generic"):
         ggep_body = []
-        if layer == 'generic':
-            # Do nothing, extension definition part of generic.h
+        if layer in ['generic', 'timing']:
+            # Do nothing, extension definition part of generic.h or timing.h
             ggep_body.append('%s' % self.lineinfo.get())
         else:
             layer_name = re.sub('(.)([A-Z][a-z]+)', r'\1_\2', layer)
@@ -344,8 +344,8 @@ class Subcommand(object):
 
     def _gen_layer_get_physical_device_layer_props(self, layer="generic"):
         gpdlp_body = []
-        if layer == 'generic':
-            # Do nothing, extension definition part of generic.h
+        if layer in ['generic', 'timing']:
+            # Do nothing, extension definition part of generic.h or timing.h
             gpdlp_body.append('%s' % self.lineinfo.get())
         else:
             gpdlp_body.append('%s' % self.lineinfo.get())
@@ -544,7 +544,7 @@ class Subcommand(object):
             func_body.append("VK_LAYER_EXPORT VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(VkDevice device, const char* funcName)\n"
                              "{\n"
                              "    PFN_vkVoidFunction addr;\n")
-            if self.layer_name == 'generic':
+            if self.layer_name in ['generic', 'timing']:
                 func_body.append("\n"
                              "    if (!strcmp(\"vkGetDeviceProcAddr\", funcName)) {\n"
                              "        return (PFN_vkVoidFunction) vkGetDeviceProcAddr;\n"
@@ -596,7 +596,7 @@ class Subcommand(object):
                              "    if (!strcmp(funcName, \"vkCreateDevice\"))\n"
                              "        return (PFN_vkVoidFunction) vkCreateDevice;\n"
                              )
-            if self.layer_name == 'generic':
+            if self.layer_name in ['generic', 'timing']:
                 func_body.append("\n"
                              "    addr = layer_intercept_instance_proc(funcName);\n"
                              "    if (addr)\n"
@@ -695,10 +695,10 @@ class GenericLayerSubcommand(Subcommand):
         gen_header.append('#define LAYER_EXT_ARRAY_SIZE 1')
         gen_header.append('#define LAYER_DEV_EXT_ARRAY_SIZE 1')
         gen_header.append('//static LOADER_PLATFORM_THREAD_ONCE_DECLARATION(initOnce);')
-        gen_header.append('static std::unordered_map<void *, layer_data *> layer_data_map;\n')
+        gen_header.append('static dispatch_key_map<layer_data> layer_data_map;\n')
         gen_header.append('template layer_data *get_my_data_ptr<layer_data>(')
         gen_header.append('        void *data_key,')
-        gen_header.append('        std::unordered_map<void *, layer_data *> &data_map);\n')
+        gen_header.append('        dispatch_key_map<layer_data> &data_map);\n')
         gen_header.append('')
         return "\n".join(gen_header)
 
@@ -723,9 +723,9 @@ class GenericLayerSubcommand(Subcommand):
                      '{\n'
                      '    layer_data *my_instance_data = get_my_data_ptr(get_dispatch_key(physicalDevice), layer_data_map);\n'
                      '    char str[1024];\n'
-                     '    sprintf(str, "At start of Generic layered %s\\n");\n'
+                     '    sprintf(str, "At start of %s layered %s\\n");\n'
                      '    log_msg(my_instance_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_PHYSICAL_DEVICE_EXT,'
-                     '            (uint64_t)physicalDevice, __LINE__, 0, (char *) "generic", "%%s", (char *) str);\n'
+                     '            (uint64_t)physicalDevice, __LINE__, 0, (char *) "%s", "%%s", (char *) str);\n'
                      '    VkLayerDeviceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);\n'
                      '    PFN_vkGetInstanceProcAddr fpGetInstanceProcAddr = chain_info->u.pLayerInfo->pfnNextGetInstanceProcAddr;\n'
                      '    PFN_vkGetDeviceProcAddr fpGetDeviceProcAddr = chain_info->u.pLayerInfo->pfnNextGetDeviceProcAddr;\n'
@@ -743,10 +743,10 @@ class GenericLayerSubcommand(Subcommand):
                      '    initDeviceTable(*pDevice, fpGetDeviceProcAddr);\n'
                      '    my_device_data->report_data = layer_debug_report_create_device(my_instance_data->report_data, *pDevice);\n'
                      '    createDeviceRegisterExtensions(pCreateInfo, *pDevice);\n'
-                     '    sprintf(str, "Completed generic layered %s\\n");\n'
-                     '    log_msg(my_device_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_PHYSICAL_DEVICE_EXT, (uint64_t)physicalDevice, __LINE__, 0, (char *) "generic", "%%s", (char *) str);\n'
+                     '    sprintf(str, "Completed %s layered %s\\n");\n'
+                     '    log_msg(my_device_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_PHYSICAL_DEVICE_EXT, (uint64_t)physicalDevice, __LINE__, 0, (char *) "%s", "%%s", (char *) str);\n'
                      '    %s'
-                     '}' % (qual, decl, proto.name, proto.name, stmt))
+                     '}' % (qual, decl, self.layer_name.capitalize(), proto.name, self.layer_name, self.layer_name, proto.name, self.layer_name, stmt))
         elif proto.name == "DestroyDevice":
             funcs.append('%s' % self.lineinfo.get())
             funcs.append('%s%s\n'
@@ -764,6 +764,7 @@ class GenericLayerSubcommand(Subcommand):
                          '    dispatch_key key = get_dispatch_key(instance);\n'
                          '    VkLayerInstanceDispatchTable *pDisp  =  instance_dispatch_table(instance);\n'
                          '    pDisp->DestroyInstance(instance, pAllocator);\n'
+                         '%s'
                          '    // Clean up logging callback, if any\n'
                          '    layer_data *my_data = get_my_data_ptr(key, layer_data_map);\n'
                          '    while (my_data->logging_callback.size() > 0) {'
@@ -775,7 +776,7 @@ class GenericLayerSubcommand(Subcommand):
                          '    layer_data_map.erase(key);\n'
                          '    instanceExtMap.erase(pDisp);\n'
                          '    destroy_instance_dispatch_table(key);\n'
-                         '}\n' % (qual, decl))
+                         '}\n' % (qual, decl, self._gen_destroy_instance_hook()))
         elif proto.name == "CreateInstance":
             funcs.append('%s' % self.lineinfo.get())
             # CreateInstance needs to use the second parm instead of the first to set the correct dispatch table
@@ -802,11 +803,11 @@ class GenericLayerSubcommand(Subcommand):
                          '            *pInstance,\n'
                          '            pCreateInfo->enabledExtensionCount,\n'
                          '            pCreateInfo->ppEnabledExtensionNames);\n'
-                         '    init_generic(my_data, pAllocator);\n'
-                         '    sprintf(str, "Completed generic layered %s\\n");\n'
-                         '    log_msg(my_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_INSTANCE_EXT, (uint64_t)*pInstance, __LINE__, 0, (char *) "generic", "%%s", (char *) str);\n'
+                         '    init_%s(my_data, pAllocator);\n'
+                         '    sprintf(str, "Completed %s layered %s\\n");\n'
+                         '    log_msg(my_data->report_data, VK_DEBUG_REPORT_INFORMATION_BIT_EXT, VK_DEBUG_REPORT_OBJECT_TYPE_INSTANCE_EXT, (uint64_t)*pInstance, __LINE__, 0, (char *) "%s", "%%s", (char *) str);\n'
                          '    return result;\n'
-                         '}\n' % (qual, decl, proto.name))
+                         '}\n' % (qual, decl, self.layer_name, self.layer_name, proto.name, self.layer_name))
         else:
             if wsi_name(proto.name):
                 funcs.append('%s' % wsi_ifdef(proto.name))
@@ -820,13 +821,21 @@ class GenericLayerSubcommand(Subcommand):
                 table_type = "device"
             funcs.append('%s%s\n'
                      '{\n'
-                     '    %s%s_dispatch_table(%s)->%s;\n'
                      '%s'
-                     '}' % (qual, decl, ret_val, table_type, dispatch_param, proto.c_call(), stmt))
+                     '}' % (qual, decl, self._gen_call_down(proto, ret_val, table_type, dispatch_param, stmt)))
             if wsi_name(proto.name):
                 funcs.append('%s' % wsi_endif(proto.name))
         return "\n\n".join(funcs)
 
+    # Body of an entrypoint that passes the call on to the next layer
+    def _gen_call_down(self, proto, ret_val, table_type, dispatch_param, stmt):
+        return ('    %s%s_dispatch_table(%s)->%s;\n'
+                '%s' % (ret_val, table_type, dispatch_param, proto.c_call(), stmt))
+
+    # Statements vkDestroyInstance runs once the instance below has been destroyed
+    def _gen_destroy_instance_hook(self):
+        return ''
+
     def generate_body(self):
         self.layer_name = "generic"
         instance_extensions=[('msg_callback_get_proc_addr', []),
@@ -848,18 +857,125 @@ class GenericLayerSubcommand(Subcommand):
 
         return "\n\n".join(body)
 
+class TimingLayerSubcommand(GenericLayerSubcommand):
+    # Entrypoints the generic layer implements itself rather than passing straight down
+    untimed = ['GetDeviceProcAddr', 'GetInstanceProcAddr',
+               'EnumerateInstanceLayerProperties', 'EnumerateInstanceExtensionProperties',
+               'EnumerateDeviceLayerProperties', 'EnumerateDeviceExtensionProperties',
+               'CreateInstance', 'DestroyInstance', 'CreateDevice', 'DestroyDevice']
+
+    def generate_header(self):
+        gen_header = []
+        gen_header.append('%s' % self.lineinfo.get())
+        gen_header.append('#include <stdio.h>')
+        gen_header.append('#include <stdlib.h>')
+        gen_header.append('#include <string.h>')
+        gen_header.append('#include <unordered_map>')
+        gen_header.append('#include "vk_loader_platform.h"')
+        gen_header.append('#include "vulkan/vk_layer.h"')
+        gen_header.append('#include "vk_layer_config.h"')
+        gen_header.append('#include "vk_layer_logging.h"')
+        gen_header.append('#include "vk_layer_table.h"')
+        gen_header.append('#include "vk_layer_extension_utils.h"')
+        gen_header.append('#include "vk_layer_utils.h"')
+        gen_header.append('')
+        gen_header.append('%s' % self.lineinfo.get())
+        gen_header.append('enum TimingCallId {')
+        for proto in self.protos:
+            if proto.name not in self.untimed:
+                gen_header.append('    TIMING_CALL_%s,' % proto.name)
+        gen_header.append('    TIMING_CALL_COUNT')
+        gen_header.append('};')
+        gen_header.append('')
+        gen_header.append('static const char *const timing_call_names[TIMING_CALL_COUNT] = {')
+        for proto in self.protos:
+            if proto.name not in self.untimed:
+                gen_header.append('    "vk%s",' % proto.name)
+        gen_header.append('};')
+        gen_header.append('')
+        gen_header.append('#include "timing.h"')
+        gen_header.append('')
+        gen_header.append('%s' % self.lineinfo.get())
+        gen_header.append('static dispatch_key_map<layer_data> layer_data_map;\n')
+        gen_header.append('template layer_data *get_my_data_ptr<layer_data>(')
+        gen_header.append('        void *data_key,')
+        gen_header.append('        dispatch_key_map<layer_data> &data_map);\n')
+        gen_header.append('')
+        return "\n".join(gen_header)
+
+    # Times the call into the next layer.  vkQueuePresentKHR ends the frame once its own time is
+    # recorded, so the summary isn't counted against it.
+    def _gen_call_down(self, proto, ret_val, table_type, dispatch_param, stmt):
+        call = '%s_dispatch_table(%s)->%s' % (table_type, dispatch_param, proto.c_call())
+        if proto.name == 'QueuePresentKHR':
+            return ('    %s result;\n'
+                    '    {\n'
+                    '        TimingScope timing(TIMING_CALL_%s);\n'
+                    '        result = %s;\n'
+                    '    }\n'
+                    '    timing_profiler.end_frame();\n'
+                    '%s' % (proto.ret, proto.name, call, stmt))
+        return ('    TimingScope timing(TIMING_CALL_%s);\n'
+                '    %s%s;\n'
+                '%s' % (proto.name, ret_val, call, stmt))
+
+    def _gen_destroy_instance_hook(self):
+        return '    timing_profiler.report_totals();\n'
+
+    def _generate_layer_initialization(self, init_opts=False, prefix='vk', lockname=None, condname=None):
+        func_body = ["#include \"vk_dispatch_table_helper.h\""]
+        func_body.append('%s' % self.lineinfo.get())
+        func_body.append('static void init_timing(layer_data *my_data, const VkAllocationCallbacks *pAllocator)\n'
+                         '{\n'
+                         '    layer_debug_actions(my_data->report_data, my_data->logging_callback, pAllocator, TIMING_LAYER_SETTINGS);\n'
+                         '    timing_profiler.configure();\n'
+                         '}\n')
+        return "\n".join(func_body)
+
+    def generate_body(self):
+        self.layer_name = "timing"
+        instance_extensions=[('msg_callback_get_proc_addr', []),
+                     ('wsi_enabled',
+                     ['vkGetPhysicalDeviceSurfaceSupportKHR',
+                      'vkGetPhysicalDeviceSurfaceCapabilitiesKHR',
+                      'vkGetPhysicalDeviceSurfaceFormatsKHR',
+                      'vkGetPhysicalDeviceSurfacePresentModesKHR'])]
+        extensions=[('wsi_enabled',
+                     ['vkCreateSwapchainKHR',
+                      'vkDestroySwapchainKHR', 'vkGetSwapchainImagesKHR',
+                      'vkAcquireNextImageKHR', 'vkQueuePresentKHR'])]
+        body = [self._generate_layer_initialization(),
+                self._generate_dispatch_entrypoints("VK_LAYER_EXPORT"),
+                self._gen_create_msg_callback(),
+                self._gen_destroy_msg_callback(),
+                self._gen_debug_report_msg(),
+                self._generate_layer_gpa_function(extensions, instance_extensions)]
+
+        return "\n\n".join(body)
+
 class ApiDumpSubcommand(Subcommand):
+    def __init__(self, argv):
+        super(ApiDumpSubcommand, self).__init__(argv)
+        self.payloads = {}
+
     def generate_header(self):
         header_txt = []
         header_txt.append('%s' % self.lineinfo.get())
+        header_txt.append('#include <algorithm>')
+        header_txt.append('#include <atomic>')
         header_txt.append('#include <fstream>')
         header_txt.append('#include <iostream>')
         header_txt.append('#include <string>')
+        header_txt.append('#include <stdint.h>')
+        header_txt.append('#include <stdlib.h>')
         header_txt.append('#include <string.h>')
         header_txt.append('')
         header_txt.append('#include "vk_loader_platform.h"')
         header_txt.append('#include "vulkan/vk_layer.h"')
         header_txt.append('#include "vk_api_dump_helper_cpp.h"')
+        header_txt.append('#include "api_dump_capture.h"')
+        header_txt.append('#include "api_dump_filter.h"')
+        header_txt.append('#include "api_dump_output.h"')
         header_txt.append('#include "vk_layer_table.h"')
         header_txt.append('#include "vk_layer_extension_utils.h"')
         header_txt.append('#include "vk_layer_config.h"')
@@ -910,28 +1026,45 @@ class ApiDumpSubcommand(Subcommand):
         header_txt.append('')
         header_txt.append('static LOADER_PLATFORM_THREAD_ONCE_DECLARATION(initOnce);')
         header_txt.append('')
-        header_txt.append('static int printLockInitialized = 0;')
-        header_txt.append('static loader_platform_thread_mutex printLock;')
-        header_txt.append('')
         header_txt.append('%s' % self.lineinfo.get())
         header_txt.append('#define LAYER_EXT_ARRAY_SIZE 1')
         header_txt.append('#define LAYER_DEV_EXT_ARRAY_SIZE 1')
-        header_txt.append('#define MAX_TID 513')
-        header_txt.append('static loader_platform_thread_id tidMapping[MAX_TID] = {0};')
-        header_txt.append('static uint32_t maxTID = 0;')
-        header_txt.append('// Map actual TID to an index value and return that index')
-        header_txt.append('//  This keeps TIDs in range from 0-MAX_TID and simplifies compares between runs')
-        header_txt.append('static uint32_t getTIDIndex() {')
-        header_txt.append('    loader_platform_thread_id tid = loader_platform_get_thread_id();')
-        header_txt.append('    for (uint32_t i = 0; i < maxTID; i++) {')
-        header_txt.append('        if (tid == tidMapping[i])')
-        header_txt.append('            return i;')
+        header_txt.append('')
+        header_txt.append('%s' % self.lineinfo.get())
+        header_txt.append('static bool g_ApiDumpBinary = false;')
+        header_txt.append('static std::ofstream captureStream;')
+        header_txt.append('')
+        header_txt.append('// Each thread formats into its own buffer; a writer thread puts the calls in order')
+        header_txt.append('static ApiDumpOutput g_output;')
+        header_txt.append('')
+        header_txt.append('// Opens the binary capture and writes its header.  Returns false, having said why, if it can\'t.')
+        header_txt.append('static bool OpenCaptureFile(const std::string &captureName)')
+        header_txt.append('{')
+        header_txt.append('    captureStream.open(captureName, std::ios::out | std::ios::binary);')
+        header_txt.append('    if ((captureStream.rdstate() & captureStream.failbit) != 0) {')
+        header_txt.append('        std::cout << std::endl << "api_dump ERROR: Bad capture filename specified: " << captureName << ". Writing text instead" << std::endl << std::endl;')
+        header_txt.append('        return false;')
         header_txt.append('    }')
-        header_txt.append("    // Don't yet have mapping, set it and return newly set index")
-        header_txt.append('    uint32_t retVal = (uint32_t) maxTID;')
-        header_txt.append('    tidMapping[maxTID++] = tid;')
-        header_txt.append('    assert(maxTID < MAX_TID);')
-        header_txt.append('    return retVal;')
+        header_txt.append('')
+        header_txt.append('    ApiDumpCaptureHeader header = {};')
+        header_txt.append('    memcpy(header.magic, API_DUMP_CAPTURE_MAGIC, sizeof(header.magic));')
+        header_txt.append('    header.version = API_DUMP_CAPTURE_VERSION;')
+        header_txt.append('    header.pointerSize = sizeof(void*);')
+        header_txt.append('    header.flags = (g_ApiDumpDetailed ? API_DUMP_CAPTURE_DETAILED : 0) | (StreamControl::writeAddress ? API_DUMP_CAPTURE_ADDRESSES : 0);')
+        header_txt.append('    captureStream.write((const char *)&header, sizeof(header));')
+        header_txt.append('    return true;')
+        header_txt.append('}')
+        header_txt.append('')
+        header_txt.append('static void writeRecord(ApiDumpRecordWriter &record)')
+        header_txt.append('{')
+        header_txt.append('    // Drop a record that could not be built rather than write a truncated one')
+        header_txt.append('    if (record.failed())')
+        header_txt.append('        return;')
+        header_txt.append('    const char *data = (const char *)record.finish();')
+        header_txt.append('    ApiDumpThread &thread = g_output.thread();')
+        header_txt.append('    record.header()->thread = thread.index();')
+        header_txt.append('    g_output.begin(thread).write(data, record.size());')
+        header_txt.append('    g_output.end(thread);')
         header_txt.append('}')
         header_txt.append('')
         return "\n".join(header_txt)
@@ -1008,52 +1141,84 @@ class ApiDumpSubcommand(Subcommand):
         func_body.append('        }')
         func_body.append('    }')
         func_body.append('')
-        func_body.append('%s' % self.lineinfo.get())
-        func_body.append('    ConfigureOutputStream(writeToFile, flushAfterWrite);')
+        func_body.append('    char const*const binaryStr = getLayerOption("lunarg_api_dump.binary");')
+        func_body.append('    if(binaryStr != NULL)')
+        func_body.append('    {')
+        func_body.append('        if(strcmp(binaryStr, "TRUE") == 0)')
+        func_body.append('        {')
+        func_body.append('            g_ApiDumpBinary = true;')
+        func_body.append('        }')
+        func_body.append('        else if(strcmp(binaryStr, "FALSE") == 0)')
+        func_body.append('        {')
+        func_body.append('            g_ApiDumpBinary = false;')
+        func_body.append('        }')
+        func_body.append('    }')
+        func_body.append('')
+        func_body.append('    configureCallFilter(getLayerOption("lunarg_api_dump.entrypoints"),')
+        func_body.append('                        getLayerOption("lunarg_api_dump.exclude_entrypoints"),')
+        func_body.append('                        getLayerOption("lunarg_api_dump.frames"));')
         func_body.append('')
-        func_body.append('    if (!printLockInitialized)')
+        func_body.append('%s' % self.lineinfo.get())
+        func_body.append('    if(g_ApiDumpBinary)')
         func_body.append('    {')
-        func_body.append('        // TODO/TBD: Need to delete this mutex sometime.  How???')
-        func_body.append('        loader_platform_thread_create_mutex(&printLock);')
-        func_body.append('        printLockInitialized = 1;')
+        func_body.append('        // A capture always goes to a file; log_filename names it unless it says stdout')
+        func_body.append('        outputStream = &std::cout;')
+        func_body.append('        g_ApiDumpBinary = OpenCaptureFile((logName != NULL && fileName != "stdout") ? fileName : "vk_apidump.bin");')
         func_body.append('    }')
+        func_body.append('    if(!g_ApiDumpBinary)')
+        func_body.append('    {')
+        func_body.append('        ConfigureOutputStream(writeToFile, flushAfterWrite);')
+        func_body.append('    }')
+        func_body.append('')
+        func_body.append('    // flush now means flushing each time the writer catches up, rather than after every call')
+        func_body.append('    g_output.configure(g_ApiDumpBinary ? &captureStream : outputStream, flushAfterWrite);')
         func_body.append('}')
         func_body.append('')
         return "\n".join(func_body)
 
-    def generate_intercept(self, proto, qual):
-        if proto.name in [ 'EnumerateInstanceLayerProperties','EnumerateInstanceExtensionProperties','EnumerateDeviceLayerProperties','EnumerateDeviceExtensionProperties']:
-            return None
-        decl = proto.c_func(prefix="vk", attr="VKAPI")
-        ret_val = ''
-        stmt = ''
-        funcs = []
-        sp_param_dict = {} # Store 'index' for struct param to print, or an name of binding "Count" param for array to print
+    # Works out which parameters are returned by the call, and which the detailed output prints in
+    # full: 'index' for a struct, or the name of the count for an array
+    def _get_dump_params(self, proto):
+        output_params = []
+        sp_param_dict = {}
         create_params = 0 # Num of params at end of function that are created and returned as output values
         if 'AllocateDescriptorSets' in proto.name:
             create_params = -1
         elif 'Create' in proto.name or 'Alloc' in proto.name or 'MapMemory' in proto.name:
             create_params = -1
-        if proto.ret != "void":
-            ret_val = "%s result = " % proto.ret
-            stmt = "    return result;\n"
-        f_open = 'loader_platform_thread_lock_mutex(&printLock);\n    '
-        log_func = '%s\n' % self.lineinfo.get()
-        log_func += '    if (StreamControl::writeAddress == true) {'
-        log_func += '\n        (*outputStream) << "t{" << getTIDIndex() << "} f{" << g_frameCounter << "} vk%s(' % proto.name
-        log_func_no_addr = '\n        (*outputStream) << "t{" << getTIDIndex() << "} f{" << g_frameCounter << "} vk%s(' % proto.name
-        f_close = '\n    loader_platform_thread_unlock_mutex(&printLock);'
-        pindex = 0
         prev_count_name = ''
-        for p in proto.params:
+        for pindex, p in enumerate(proto.params):
             cp = False
             if 0 != create_params:
                 # If this is any of the N last params of the func, treat as output
                 for y in range(-1, create_params-1, -1):
                     if p.name == proto.params[y].name:
                         cp = True
-            (pft, pfi, cast) = self._get_printf_params(p.ty, p.name, cp, count=4)
+            output_params.append(cp)
+            if prev_count_name != '' and (prev_count_name.replace('Count', '')[1:] in p.name):
+                sp_param_dict[pindex] = prev_count_name
+                prev_count_name = ''
+            elif vk_helper_api_dump.is_type(p.ty.strip('*').replace('const ', ''), 'struct'):
+                sp_param_dict[pindex] = 'index'
+            if p.name.endswith('Count'):
+                if '*' in p.ty:
+                    prev_count_name = "*%s" % p.name
+                else:
+                    prev_count_name = p.name
+            else:
+                prev_count_name = ''
+        return (output_params, sp_param_dict)
 
+    # Text output for one call.  The layer and vk_api_dump_print both call this, so text dumps and
+    # printed binary captures read the same.
+    def _generate_dump_func(self, proto):
+        (output_params, sp_param_dict) = self._get_dump_params(proto)
+        log_func = '%s\n' % self.lineinfo.get()
+        log_func += '    if (StreamControl::writeAddress == true) {'
+        log_func += '\n        out << "t{" << tid << "} f{" << frame << "} vk%s(' % proto.name
+        log_func_no_addr = '\n        out << "t{" << tid << "} f{" << frame << "} vk%s(' % proto.name
+        for pindex, p in enumerate(proto.params):
+            (pft, pfi, cast) = self._get_printf_params(p.ty, p.name, output_params[pindex], count=4)
             if p.name == "pSwapchain" or p.name == "pSwapchainImages":
                 log_func += '%s = 0x" << nouppercase <<  hex << HandleCast(%s) << dec << ", ' % (p.name, p.name)
             elif p.name == "swapchain":
@@ -1071,19 +1236,6 @@ class ApiDumpSubcommand(Subcommand):
                 log_func_no_addr += '%s = address, ' % (p.name)
             else:
                 log_func_no_addr += '%s%s = " << %s << ", ' % (cast, p.name, pfi)
-            if prev_count_name != '' and (prev_count_name.replace('Count', '')[1:] in p.name):
-                sp_param_dict[pindex] = prev_count_name
-                prev_count_name = ''
-            elif vk_helper_api_dump.is_type(p.ty.strip('*').replace('const ', ''), 'struct'):
-                sp_param_dict[pindex] = 'index'
-            if p.name.endswith('Count'):
-                if '*' in p.ty:
-                    prev_count_name = "*%s" % p.name
-                else:
-                    prev_count_name = p.name
-            else:
-                prev_count_name = ''
-            pindex += 1
         log_func = log_func.strip(', ')
         log_func_no_addr = log_func_no_addr.strip(', ')
         if proto.ret == "VkResult":
@@ -1119,7 +1271,7 @@ class ApiDumpSubcommand(Subcommand):
                     log_func += '\n%sif (%s) {' % (indent, local_name)
                     indent += '    '
                     log_func += '\n%sstring tmp_str = %s(%s, "    ");' % (indent, cis_print_func, local_name)
-                    log_func += '\n%s(*outputStream) << "   %s:\\n" << tmp_str << endl;' % (indent, local_name)
+                    log_func += '\n%sout << "   %s:\\n" << tmp_str << endl;' % (indent, local_name)
                     indent = indent[4:]
                     log_func += '\n%s}' % (indent)
                 else: # We have a count value stored to iterate over an array
@@ -1145,11 +1297,11 @@ class ApiDumpSubcommand(Subcommand):
                         log_func += '\n%sif (StreamControl::writeAddress == true) {' % (indent)
                         indent += '    '
                         log_func += '\n%s%s' % (indent, cis_print_func)
-                        log_func += '\n%s(*outputStream) << "   %s[" << i << "]:\\n" << tmp_str << endl;' % (indent, proto.params[sp_index].name)
+                        log_func += '\n%sout << "   %s[" << i << "]:\\n" << tmp_str << endl;' % (indent, proto.params[sp_index].name)
                     else:
                         log_func += '\n%sif (StreamControl::writeAddress == true) {' % (indent)
                         indent += '    '
-                        log_func += '\n%s(*outputStream) << "   %s[" << i << "] = 0x" << nouppercase << hex << HandleCast(%s[i]) << dec << endl;' % (indent, proto.params[sp_index].name, proto.params[sp_index].name)
+                        log_func += '\n%sout << "   %s[" << i << "] = 0x" << nouppercase << hex << HandleCast(%s[i]) << dec << endl;' % (indent, proto.params[sp_index].name, proto.params[sp_index].name)
                     indent = indent[4:]
                     log_func += '\n%s}' % (indent)
                     indent = indent[4:]
@@ -1158,6 +1310,420 @@ class ApiDumpSubcommand(Subcommand):
                     log_func += '\n%s}' % (indent)
             indent = indent[4:]
             log_func += '\n%s}' % (indent)
+        params = proto.c_params()
+        if proto.ret != "void":
+            params += ', %s result' % proto.ret
+        return ('static void dump_vk%s(std::ostream &out, uint32_t tid, uint64_t frame, %s)\n'
+                '{\n'
+                '    using namespace StreamControl;\n'
+                '    using namespace std;\n'
+                '%s\n'
+                '}' % (proto.name, params, log_func))
+
+    # The binary capture identifies each call by its position in the API
+    def _generate_call_ids(self):
+        ids = []
+        ids.append('%s' % self.lineinfo.get())
+        ids.append('enum ApiDumpCallId {')
+        for proto in self.protos:
+            ids.append('    API_DUMP_CALL_%s,' % proto.name)
+        ids.append('    API_DUMP_CALL_COUNT')
+        ids.append('};')
+        return "\n".join(ids)
+
+    # Which calls are dumped.  Each intercept checks g_dumpCalls[its id] before doing anything else;
+    # the pointer is switched between the selected calls and none as frames enter and leave the
+    # selected range.
+    def _generate_call_filter(self):
+        f = []
+        f.append('%s' % self.lineinfo.get())
+        f.append('static const char *const g_callNames[API_DUMP_CALL_COUNT] = {')
+        for proto in self.protos:
+            f.append('    "vk%s",' % proto.name)
+        f.append('};')
+        f.append('')
+        f.append('static bool g_selectedCalls[API_DUMP_CALL_COUNT];')
+        f.append('static const bool g_noCalls[API_DUMP_CALL_COUNT] = {};')
+        f.append('static std::atomic<const bool *> g_dumpCalls(g_noCalls);')
+        f.append('static uint64_t g_firstFrame = 0;')
+        f.append('static uint64_t g_lastFrame = UINT64_MAX;')
+        f.append('')
+        f.append('static inline bool shouldDump(ApiDumpCallId call)')
+        f.append('{')
+        f.append('    return g_dumpCalls.load(std::memory_order_relaxed)[call];')
+        f.append('}')
+        f.append('')
+        f.append('static void selectFrame(uint64_t frame)')
+        f.append('{')
+        f.append('    bool inRange = frame >= g_firstFrame && frame <= g_lastFrame;')
+        f.append('    g_dumpCalls.store(inRange ? g_selectedCalls : g_noCalls, std::memory_order_relaxed);')
+        f.append('}')
+        f.append('')
+        f.append('// Says which patterns in an entrypoints setting match none of the calls, and so are ignored')
+        f.append('static void checkEntrypointPatterns(const char *setting, const char *list)')
+        f.append('{')
+        f.append('    const char *begin, *end;')
+        f.append('    while (list != NULL && nextEntrypointPattern(&list, &begin, &end)) {')
+        f.append('        bool matched = false;')
+        f.append('        for (uint32_t i = 0; i < API_DUMP_CALL_COUNT && !matched; ++i)')
+        f.append('            matched = matchEntrypoint(begin, end, g_callNames[i]);')
+        f.append('        if (!matched)')
+        f.append('            std::cout << "api_dump WARNING: No calls match " << setting << " pattern " << std::string(begin, end) << ". Ignoring it" << std::endl;')
+        f.append('    }')
+        f.append('}')
+        f.append('')
+        f.append('// Selects the calls to dump from the entrypoints and exclude_entrypoints settings, and the')
+        f.append('// frames from the frames setting: "first-last", "first-" or a single frame.  Settings that')
+        f.append('// aren\'t given come back empty and select everything, as does a frames setting that can\'t be')
+        f.append('// read.')
+        f.append('static void configureCallFilter(const char *include, const char *exclude, const char *frames)')
+        f.append('{')
+        f.append('    checkEntrypointPatterns("lunarg_api_dump.entrypoints", include);')
+        f.append('    checkEntrypointPatterns("lunarg_api_dump.exclude_entrypoints", exclude);')
+        f.append('    for (uint32_t i = 0; i < API_DUMP_CALL_COUNT; ++i) {')
+        f.append('        g_selectedCalls[i] = (include == NULL || *include == \'\\0\' || matchEntrypointList(include, g_callNames[i])) &&')
+        f.append('                             (exclude == NULL || !matchEntrypointList(exclude, g_callNames[i]));')
+        f.append('    }')
+        f.append('')
+        f.append('    if (frames != NULL && *frames != \'\\0\' && !parseFrameRange(frames, &g_firstFrame, &g_lastFrame))')
+        f.append('        std::cout << "api_dump ERROR: Bad lunarg_api_dump.frames specified: " << frames << ". Dumping all frames" << std::endl;')
+        f.append('    selectFrame(g_frameCounter);')
+        f.append('}')
+        return "\n".join(f)
+
+    def _struct_key(self, ty):
+        ty = ty.replace('const ', '').strip('*').strip()
+        ty = vk_helper_api_dump.typedef_rev_dict.get(ty, ty)
+        if ty in vk_helper_api_dump.struct_dict and vk_helper_api_dump.struct_dict[ty]:
+            return ty
+        return None
+
+    # Members the struct's text output reads through a pointer, itself or in an embedded struct,
+    # as (kind, member, element struct, condition) in declaration order.  This follows what
+    # vk_helper_api_dump's printers dereference, so that a capture holds exactly what printing it
+    # needs.
+    def _get_struct_payload(self, s):
+        if s in self.payloads:
+            return self.payloads[s]
+        self.payloads[s] = [] # Guards against structs that reach themselves
+        payload = []
+        struct = vk_helper_api_dump.struct_dict[s]
+        for m in sorted(struct):
+            member = struct[m]
+            name = member['name']
+            ty = member['type']
+            elem = self._struct_key(ty)
+            if elem and (ty in vk_helper_api_dump.opaque_types or not vk_helper_api_dump.is_type(ty, 'struct')):
+                elem = None
+            if 'pNext' == name:
+                payload.append(('pnext', member, None, None))
+            elif member['array'] and 'char' == ty:
+                if member['ptr'] and 1 == member['full_type'].count('*'):
+                    payload.append(('string', member, None, None))
+            elif member['dyn_array']:
+                cond = None
+                if 'pQueueFamilyIndices' == name:
+                    if 'VkSwapchainCreateInfoKHR' == vk_helper_api_dump.typedef_fwd_dict[s]:
+                        cond = 'pStruct->imageSharingMode == VK_SHARING_MODE_CONCURRENT'
+                    else:
+                        cond = 'pStruct->sharingMode == VK_SHARING_MODE_CONCURRENT'
+                elif 'pImageInfo' == name:
+                    cond = ' || '.join(['pStruct->descriptorType == VK_DESCRIPTOR_TYPE_%s' % t for t in
+                                        ['SAMPLER', 'COMBINED_IMAGE_SAMPLER', 'SAMPLED_IMAGE', 'STORAGE_IMAGE']])
+                elif 'pBufferInfo' == name:
+                    cond = ' || '.join(['pStruct->descriptorType == VK_DESCRIPTOR_TYPE_%s' % t for t in
+                                        ['STORAGE_BUFFER', 'UNIFORM_BUFFER', 'UNIFORM_BUFFER_DYNAMIC', 'STORAGE_BUFFER_DYNAMIC']])
+                elif 'pTexelBufferView' == name:
+                    cond = ' || '.join(['pStruct->descriptorType == VK_DESCRIPTOR_TYPE_%s' % t for t in
+                                        ['UNIFORM_TEXEL_BUFFER', 'STORAGE_TEXEL_BUFFER']])
+                if elem and not self._get_struct_payload(elem):
+                    elem = None
+                payload.append(('array', member, elem, cond))
+            elif member['array']:
+                if elem and self._get_struct_payload(elem):
+                    payload.append(('embedded_array', member, elem, None))
+            elif member['ptr'] and 'char' in ty.lower():
+                payload.append(('string', member, None, None))
+            elif member['ptr'] and elem:
+                if not self._get_struct_payload(elem):
+                    elem = None
+                payload.append(('pointer', member, elem, None))
+            elif elem and self._get_struct_payload(elem):
+                payload.append(('embedded', member, elem, None))
+        self.payloads[s] = payload
+        return payload
+
+    def _struct_func_name(self, prefix, s):
+        return 'vk_%s_%s' % (prefix, s.lower().strip('_'))
+
+    # Structs with a payload that some call's capture reaches
+    def _get_captured_structs(self):
+        pending = [self._get_pnext_struct(v) for v in self._get_pnext_types()]
+        for proto in self.protos:
+            pending.extend([c[4] for c in self._get_capture_params(proto)])
+        structs = set()
+        while pending:
+            s = pending.pop()
+            if s is None or s in structs or not self._get_struct_payload(s):
+                continue
+            structs.add(s)
+            pending.extend([elem for (kind, member, elem, cond) in self.payloads[s]])
+        return sorted(structs)
+
+    # The sTypes dynamic_display prints a pNext struct for
+    def _get_pnext_types(self):
+        types = []
+        for e in vk_helper_api_dump.enum_type_dict:
+            if "StructureType" not in e:
+                continue
+            for v in sorted(vk_helper_api_dump.enum_type_dict[e]):
+                if vk_helper_api_dump.get_struct_name_from_struct_type(v) in vk_helper_api_dump.struct_dict:
+                    types.append(v)
+        return types
+
+    def _get_pnext_struct(self, sType):
+        return vk_helper_api_dump.get_struct_name_from_struct_type(sType)
+
+    # Writer and reader for every struct with a payload, and for pNext chains.  The layer only uses
+    # the writers and vk_api_dump_print only the readers.
+    def _generate_struct_capture(self, write):
+        structs = self._get_captured_structs()
+        if write:
+            proto_fmt = 'static void %s(ApiDumpRecordWriter &w, const %s* pStruct)'
+            pnext_proto = 'static void vk_write_pnext(ApiDumpRecordWriter &w, const void* pNext)'
+        else:
+            proto_fmt = 'static void %s(ApiDumpRecordReader &r, %s* pStruct)'
+            pnext_proto = 'static const void* vk_read_pnext(ApiDumpRecordReader &r, const void* pNext)'
+        func_prefix = 'write' if write else 'read'
+        funcs = []
+        funcs.append('%s' % self.lineinfo.get())
+        funcs.append('%s;' % pnext_proto)
+        for s in structs:
+            typedef = vk_helper_api_dump.typedef_fwd_dict[s]
+            vk_helper_api_dump.add_platform_wrapper_entry(funcs, typedef)
+            funcs.append('%s;' % (proto_fmt % (self._struct_func_name(func_prefix, s), typedef)))
+            vk_helper_api_dump.add_platform_wrapper_exit(funcs, typedef)
+        funcs.append('')
+        for s in structs:
+            typedef = vk_helper_api_dump.typedef_fwd_dict[s]
+            vk_helper_api_dump.add_platform_wrapper_entry(funcs, typedef)
+            funcs.append('%s' % self.lineinfo.get())
+            funcs.append('%s\n{' % (proto_fmt % (self._struct_func_name(func_prefix, s), typedef)))
+            for (kind, member, elem, cond) in self.payloads[s]:
+                name = member['name']
+                indent = '    '
+                if 'pnext' == kind:
+                    funcs.append('%sif (pStruct->pNext)' % indent)
+                    if write:
+                        funcs.append('%s    vk_write_pnext(w, pStruct->pNext);' % indent)
+                    else:
+                        funcs.append('%s    pStruct->pNext = vk_read_pnext(r, pStruct->pNext);' % indent)
+                    continue
+                if 'embedded' == kind or 'embedded_array' == kind:
+                    elem_func = self._struct_func_name(func_prefix, elem)
+                    if 'embedded' == kind:
+                        funcs.append('%s%s(%s, &pStruct->%s);' % (indent, elem_func, func_prefix[0], name))
+                    else:
+                        funcs.append('%sfor (uint32_t i = 0; i < %s; i++)' % (indent, member['array_size']))
+                        funcs.append('%s    %s(%s, &pStruct->%s[i]);' % (indent, elem_func, func_prefix[0], name))
+                    continue
+                if cond:
+                    funcs.append('%sif (%s) {' % (indent, cond))
+                    indent += '    '
+                funcs.append('%sif (pStruct->%s) {' % (indent, name))
+                indent += '    '
+                if write:
+                    if 'string' == kind:
+                        funcs.append('%sw.write_string(pStruct->%s);' % (indent, name))
+                    elif 'array' == kind:
+                        funcs.append('%sw.write_array(pStruct->%s, pStruct->%s);' % (indent, name, member['array_size']))
+                    else:
+                        funcs.append('%sw.write_array(pStruct->%s, 1);' % (indent, name))
+                    count = 'pStruct->%s' % member['array_size']
+                elif elem and 'array' == kind:
+                    funcs.append('%suint32_t count = r.read_array(pStruct->%s);' % (indent, name))
+                    count = 'count'
+                elif elem:
+                    funcs.append('%sif (r.read_array(pStruct->%s))' % (indent, name))
+                else:
+                    funcs.append('%sr.read_array(pStruct->%s);' % (indent, name))
+                if elem and 'pointer' == kind:
+                    if write:
+                        funcs.append('%s%s(w, pStruct->%s);' % (indent, self._struct_func_name('write', elem), name))
+                    else:
+                        funcs.append('%s    %s(r, const_cast<%s*>(pStruct->%s));' %
+                                     (indent, self._struct_func_name('read', elem), vk_helper_api_dump.typedef_fwd_dict[elem], name))
+                elif elem:
+                    funcs.append('%sfor (uint32_t i = 0; i < %s; i++)' % (indent, count))
+                    if write:
+                        funcs.append('%s    %s(w, &pStruct->%s[i]);' % (indent, self._struct_func_name('write', elem), name))
+                    else:
+                        funcs.append('%s    %s(r, const_cast<%s*>(&pStruct->%s[i]));' %
+                                     (indent, self._struct_func_name('read', elem), vk_helper_api_dump.typedef_fwd_dict[elem], name))
+                while len(indent) > 4:
+                    indent = indent[4:]
+                    funcs.append('%s}' % indent)
+            funcs.append('}')
+            vk_helper_api_dump.add_platform_wrapper_exit(funcs, typedef)
+            funcs.append('')
+
+        # pNext is followed by its sType, then the struct the text output shows for it
+        funcs.append('%s' % self.lineinfo.get())
+        funcs.append('%s\n{' % pnext_proto)
+        if write:
+            funcs.append('    VkStructureType sType = ((const VkApplicationInfo*)pNext)->sType;')
+            funcs.append('    w.write_value(sType);')
+        else:
+            funcs.append('    VkStructureType sType;')
+            funcs.append('    r.read_value(sType);')
+        funcs.append('    switch (sType)')
+        funcs.append('    {')
+        for v in self._get_pnext_types():
+            struct_name = self._get_pnext_struct(v)
+            vk_helper_api_dump.add_platform_wrapper_entry(funcs, struct_name)
+            funcs.append('        case %s:' % v)
+            funcs.append('        {')
+            has_payload = struct_name in self.payloads and self.payloads[struct_name]
+            if write:
+                funcs.append('            w.write_array((const %s*)pNext, 1);' % struct_name)
+                if has_payload:
+                    funcs.append('            %s(w, (const %s*)pNext);' % (self._struct_func_name('write', struct_name), struct_name))
+                funcs.append('            return;')
+            else:
+                funcs.append('            const %s* pStruct = (const %s*)pNext;' % (struct_name, struct_name))
+                funcs.append('            r.read_array(pStruct);')
+                if has_payload:
+                    funcs.append('            if (pStruct)')
+                    funcs.append('                %s(r, const_cast<%s*>(pStruct));' % (self._struct_func_name('read', struct_name), struct_name))
+                funcs.append('            return pStruct;')
+            funcs.append('        }')
+            vk_helper_api_dump.add_platform_wrapper_exit(funcs, struct_name)
+        funcs.append('        default:')
+        if write:
+            funcs.append('            return;')
+        else:
+            funcs.append('        {')
+            funcs.append('            // Only the sType of a struct the text output doesn\'t show is captured')
+            funcs.append('            VkApplicationInfo* pStruct = (VkApplicationInfo*)r.alloc(sizeof(VkApplicationInfo), (uint64_t)(uintptr_t)pNext);')
+            funcs.append('            pStruct->sType = sType;')
+            funcs.append('            return pStruct;')
+            funcs.append('        }')
+        funcs.append('    }')
+        funcs.append('}')
+        return "\n".join(funcs)
+
+    # How a parameter is captured: 'fixed' for an array parameter, 'value', 'pointer' for a pointer
+    # only printed as an address, or 'array' for one the text output reads through, with the
+    # element count to copy and the struct to deep copy each element of.
+    def _get_capture_params(self, proto):
+        (output_params, sp_param_dict) = self._get_dump_params(proto)
+        capture = []
+        for pindex, p in enumerate(proto.params):
+            if '[' in p.ty:
+                (elem, size) = p.ty.replace('const ', '').split('[', 1)
+                capture.append(('fixed', p, elem.strip(), size.strip(']'), None))
+                continue
+            elem = self._struct_key(p.ty)
+            if elem and (not vk_helper_api_dump.is_type(p.ty.strip('*').replace('const ', ''), 'struct') or
+                         p.ty.strip('*').replace('const ', '') in vk_helper_api_dump.opaque_types or
+                         not self._get_struct_payload(elem)):
+                elem = None
+            if '*' not in p.ty:
+                capture.append(('value', p, None, None, elem if sp_param_dict.get(pindex) == 'index' else None))
+                continue
+            (pft, pfi, cast) = self._get_printf_params(p.ty, p.name, output_params[pindex], count=4)
+            deref = '0x' in pft and '*' in cast and p.name not in ['pSwapchain', 'pSwapchainImages']
+            count = None
+            deep = None
+            detail = sp_param_dict.get(pindex)
+            if 'index' == detail:
+                if not p.ty.strip('*').replace('const ', '') in vk_helper_api_dump.opaque_types:
+                    count = '1'
+                    deep = elem
+            elif detail:
+                if detail.startswith('*'):
+                    count = '(%s ? %s : 0)' % (detail[1:], detail)
+                else:
+                    count = detail
+                deep = elem
+            if deref:
+                count = 'std::max<uint32_t>(%s, 1)' % count if count and count != '1' else '1'
+            if count is None or 'void' == p.ty.replace('const ', '').strip()[:-1].strip():
+                capture.append(('pointer', p, None, None, None))
+            else:
+                capture.append(('array', p, None, count, deep))
+        return capture
+
+    def _generate_capture_func(self, proto):
+        func = []
+        params = proto.c_params()
+        if proto.ret != "void":
+            params += ', %s result' % proto.ret
+        func.append('%s' % self.lineinfo.get())
+        func.append('static void capture_vk%s(%s)' % (proto.name, params))
+        func.append('{')
+        func.append('    ApiDumpRecordWriter w(API_DUMP_CALL_%s, g_frameCounter);' % proto.name)
+        for (kind, p, elem, count, deep) in self._get_capture_params(proto):
+            if 'fixed' == kind:
+                func.append('    w.write(%s, sizeof(%s) * %s);' % (p.name, elem, count))
+            elif 'value' == kind:
+                func.append('    w.write_value(%s);' % p.name)
+                if deep:
+                    func.append('    %s(w, &%s);' % (self._struct_func_name('write', deep), p.name))
+            elif 'pointer' == kind:
+                func.append('    w.write_pointer(%s);' % p.name)
+            elif '1' == count:
+                func.append('    w.write_pointer(%s);' % p.name)
+                func.append('    if (%s) {' % p.name)
+                func.append('        w.write_array(%s, 1);' % p.name)
+                if deep:
+                    func.append('        %s(w, %s);' % (self._struct_func_name('write', deep), p.name))
+                func.append('    }')
+            else:
+                func.append('    w.write_pointer(%s);' % p.name)
+                func.append('    if (%s) {' % p.name)
+                func.append('        uint32_t count = %s;' % count)
+                func.append('        w.write_array(%s, count);' % p.name)
+                if deep:
+                    func.append('        for (uint32_t i = 0; i < count; i++)')
+                    func.append('            %s(w, &%s[i]);' % (self._struct_func_name('write', deep), p.name))
+                func.append('    }')
+        if proto.ret != "void":
+            func.append('    w.write_value(result);')
+        func.append('    writeRecord(w);')
+        func.append('}')
+        return "\n".join(func)
+
+    def generate_intercept(self, proto, qual):
+        if proto.name in [ 'EnumerateInstanceLayerProperties','EnumerateInstanceExtensionProperties','EnumerateDeviceLayerProperties','EnumerateDeviceExtensionProperties']:
+            return None
+        decl = proto.c_func(prefix="vk", attr="VKAPI")
+        ret_val = ''
+        stmt = ''
+        funcs = []
+        if proto.ret != "void":
+            ret_val = "%s result = " % proto.ret
+            stmt = "    return result;\n"
+        funcs.append(self._generate_dump_func(proto))
+        funcs.append(self._generate_capture_func(proto))
+        if wsi_name(decl):
+            funcs.insert(0, wsi_ifdef(decl))
+            funcs.append(wsi_endif(decl))
+        call_args = [p.name for p in proto.params]
+        if proto.ret != "void":
+            call_args.append('result')
+        f_open = ''
+        log_func = '%s\n' % self.lineinfo.get()
+        log_func += '    if (shouldDump(API_DUMP_CALL_%s)) {\n' % proto.name
+        log_func += '        if (g_ApiDumpBinary) {\n'
+        log_func += '            capture_vk%s(%s);\n' % (proto.name, ', '.join(call_args))
+        log_func += '        } else {\n'
+        log_func += '            ApiDumpThread &thread = g_output.thread();\n'
+        log_func += '            dump_vk%s(%s);\n' % (proto.name, ', '.join(['g_output.begin(thread)', 'thread.index()', 'g_frameCounter'] + call_args))
+        log_func += '            g_output.end(thread);\n'
+        log_func += '        }\n'
+        log_func += '    }'
+        f_close = ''
         table_type = ''
         if proto_is_global(proto):
            table_type = 'instance'
@@ -1172,11 +1738,14 @@ class ApiDumpSubcommand(Subcommand):
                      '    using namespace StreamControl;\n'
                      '    using namespace std;\n'
                      '    loader_platform_thread_once(&initOnce, initapi_dump);\n'
+                     '    g_output.start();\n'
                      '    VkLayerInstanceCreateInfo *chain_info = get_chain_info(pCreateInfo, VK_LAYER_LINK_INFO);\n'
                      '    PFN_vkGetInstanceProcAddr fpGetInstanceProcAddr = chain_info->u.pLayerInfo->pfnNextGetInstanceProcAddr;\n'
                      '    PFN_vkCreateInstance fpCreateInstance = (PFN_vkCreateInstance) fpGetInstanceProcAddr(NULL, "vkCreateInstance");\n'
                      '    if (fpCreateInstance == NULL) {\n'
-                     '        (*outputStream) << "t{" << getTIDIndex() << "} " << g_frameCounter << " vkCreateInstance FAILED TO FIND PROC ADDRESS" << endl;\n'
+                     '        ApiDumpThread &thread = g_output.thread();\n'
+                     '        g_output.begin(thread) << "t{" << thread.index() << "} " << g_frameCounter << " vkCreateInstance FAILED TO FIND PROC ADDRESS" << endl;\n'
+                     '        g_output.end(thread);\n'
                      '        return VK_ERROR_INITIALIZATION_FAILED;\n'
                      '    }\n'
                      '    // Advance the link info for the next element on the chain\n'
@@ -1225,6 +1794,9 @@ class ApiDumpSubcommand(Subcommand):
                  '    instanceExtMap.erase(pDisp);\n'
                  '    destroy_instance_dispatch_table(key);\n'
                  '    %s%s%s\n'
+                 '    // The writer thread has to be gone before the loader unloads the layer\n'
+                 '    if (instanceExtMap.empty())\n'
+                 '        g_output.stop();\n'
                  '%s'
                  '}' % (qual, decl, table_type, dispatch_param, ret_val, proto.c_call(), f_open, log_func, f_close, stmt))
         elif proto.name == "QueuePresentKHR":
@@ -1236,7 +1808,7 @@ class ApiDumpSubcommand(Subcommand):
                  '    VkLayerDispatchTable *pDisp  = %s_dispatch_table(%s);\n'
                  '    %spDisp->%s;\n'
                  '    %s%s%s\n'
-                 '    ++g_frameCounter;\n'
+                 '    selectFrame(++g_frameCounter);\n'
                  '%s'
                  '}' % (qual, decl, table_type, dispatch_param, ret_val, proto.c_call(), f_open, log_func, f_close, stmt))
         else:
@@ -1316,11 +1888,190 @@ class ApiDumpSubcommand(Subcommand):
                      ['vkCreateSwapchainKHR',
                       'vkDestroySwapchainKHR', 'vkGetSwapchainImagesKHR',
                       'vkAcquireNextImageKHR', 'vkQueuePresentKHR'])]
-        body = [self.generate_init(),
+        body = [self._generate_call_ids(),
+                self._generate_call_filter(),
+                self.generate_init(),
+                self._generate_struct_capture(True),
                 self._generate_dispatch_entrypoints("VK_LAYER_EXPORT"),
                 self._generate_layer_gpa_function(extensions, instance_extensions)]
         return "\n\n".join(body)
 
+class ApiDumpPrintSubcommand(ApiDumpSubcommand):
+    def generate_header(self):
+        header_txt = []
+        header_txt.append('%s' % self.lineinfo.get())
+        header_txt.append('#include <stdio.h>')
+        header_txt.append('#include <string.h>')
+        header_txt.append('#include <algorithm>')
+        header_txt.append('#include <fstream>')
+        header_txt.append('#include <iostream>')
+        header_txt.append('#include <string>')
+        header_txt.append('#include <vector>')
+        header_txt.append('')
+        header_txt.append('#include "vulkan/vulkan.h"')
+        header_txt.append('#include "vk_api_dump_helper_cpp.h"')
+        header_txt.append('#include "api_dump_capture.h"')
+        header_txt.append('')
+        header_txt.append('std::ostream* outputStream = &std::cout;')
+        header_txt.append('static bool g_ApiDumpDetailed = true;')
+        header_txt.append('')
+        header_txt.append('// The record being printed, whose copies stand in for the captured objects')
+        header_txt.append('static ApiDumpRecordReader *currentRecord = NULL;')
+        header_txt.append('')
+        header_txt.append('static uint64_t capturedAddress(uint64_t address)')
+        header_txt.append('{')
+        header_txt.append('    return currentRecord ? currentRecord->original_address(address) : address;')
+        header_txt.append('}')
+        return "\n".join(header_txt)
+
+    def _printed_protos(self):
+        return [proto for proto in self.protos if proto.name not in
+                ['GetDeviceProcAddr', 'GetInstanceProcAddr', 'EnumerateInstanceLayerProperties',
+                 'EnumerateInstanceExtensionProperties', 'EnumerateDeviceLayerProperties',
+                 'EnumerateDeviceExtensionProperties']]
+
+    # Reads back what capture_vk<Name> wrote and prints it with the layer's own text output
+    def _generate_print_func(self, proto):
+        func = []
+        func.append('%s' % self.lineinfo.get())
+        func.append('static bool print_vk%s(ApiDumpRecordReader &r, const ApiDumpRecordHeader &header)' % proto.name)
+        func.append('{')
+        args = []
+        for (kind, p, elem, count, deep) in self._get_capture_params(proto):
+            args.append(p.name)
+            if 'fixed' == kind:
+                func.append('    %s %s[%s];' % (elem, p.name, count))
+                func.append('    r.read(%s, sizeof(%s));' % (p.name, p.name))
+            elif 'value' == kind:
+                func.append('    %s %s;' % (p.ty, p.name))
+                func.append('    r.read_value(%s);' % p.name)
+                if deep:
+                    func.append('    %s(r, &%s);' % (self._struct_func_name('read', deep), p.name))
+            elif 'pointer' == kind:
+                func.append('    %s %s = (%s)(uintptr_t)r.read_pointer();' % (p.ty, p.name, p.ty))
+            else:
+                func.append('    %s %s = (%s)(uintptr_t)r.read_pointer();' % (p.ty, p.name, p.ty))
+                if deep and '1' == count:
+                    func.append('    if (%s && r.read_array(%s))' % (p.name, p.name))
+                    func.append('        %s(r, const_cast<%s*>(%s));' %
+                                (self._struct_func_name('read', deep), vk_helper_api_dump.typedef_fwd_dict[deep], p.name))
+                elif deep:
+                    func.append('    if (%s) {' % p.name)
+                    func.append('        uint32_t count = r.read_array(%s);' % p.name)
+                    func.append('        for (uint32_t i = 0; i < count; i++)')
+                    func.append('            %s(r, const_cast<%s*>(&%s[i]));' %
+                                (self._struct_func_name('read', deep), vk_helper_api_dump.typedef_fwd_dict[deep], p.name))
+                    func.append('    }')
+                else:
+                    func.append('    if (%s)' % p.name)
+                    func.append('        r.read_array(%s);' % p.name)
+        if proto.ret != "void":
+            func.append('    %s result;' % proto.ret)
+            func.append('    r.read_value(result);')
+            args.append('result')
+        func.append('    if (!r.complete())')
+        func.append('        return false;')
+        func.append('    dump_vk%s(%s);' % (proto.name, ', '.join(['*outputStream', 'header.thread', 'header.frame'] + args)))
+        func.append('    return true;')
+        func.append('}')
+        return "\n".join(func)
+
+    def _generate_main(self):
+        body = []
+        body.append('%s' % self.lineinfo.get())
+        body.append('static bool print_record(ApiDumpRecordReader &r, const ApiDumpRecordHeader &header)')
+        body.append('{')
+        body.append('    switch (header.call)')
+        body.append('    {')
+        for proto in self._printed_protos():
+            decl = proto.c_func(prefix="vk", attr="VKAPI")
+            if wsi_name(decl):
+                body.append(wsi_ifdef(decl))
+            body.append('        case API_DUMP_CALL_%s:' % proto.name)
+            body.append('            return print_vk%s(r, header);' % proto.name)
+            if wsi_name(decl):
+                body.append(wsi_endif(decl))
+        body.append('        default:')
+        body.append('            return false;')
+        body.append('    }')
+        body.append('}')
+        body.append('')
+        body.append('%s' % self.lineinfo.get())
+        body.append('int main(int argc, char **argv)')
+        body.append('{')
+        body.append('    if (argc < 2 || argc > 3) {')
+        body.append('        std::cerr << "Usage: vk_api_dump_print <capture> [output]" << std::endl;')
+        body.append('        return 1;')
+        body.append('    }')
+        body.append('')
+        body.append('    FILE *capture = fopen(argv[1], "rb");')
+        body.append('    if (capture == NULL) {')
+        body.append('        std::cerr << "Can\'t open " << argv[1] << std::endl;')
+        body.append('        return 1;')
+        body.append('    }')
+        body.append('    ApiDumpCaptureHeader captureHeader;')
+        body.append('    if (fread(&captureHeader, sizeof(captureHeader), 1, capture) != 1 ||')
+        body.append('        memcmp(captureHeader.magic, API_DUMP_CAPTURE_MAGIC, sizeof(captureHeader.magic)) != 0) {')
+        body.append('        std::cerr << argv[1] << " is not an api_dump capture" << std::endl;')
+        body.append('        return 1;')
+        body.append('    }')
+        body.append('    if (captureHeader.version != API_DUMP_CAPTURE_VERSION) {')
+        body.append('        std::cerr << argv[1] << " has capture version " << captureHeader.version << ", expected " << API_DUMP_CAPTURE_VERSION << std::endl;')
+        body.append('        return 1;')
+        body.append('    }')
+        body.append('    if (captureHeader.pointerSize != sizeof(void*)) {')
+        body.append('        std::cerr << argv[1] << " was captured by a " << captureHeader.pointerSize * 8 << "-bit process; print it with a "')
+        body.append('                  << captureHeader.pointerSize * 8 << "-bit build of vk_api_dump_print" << std::endl;')
+        body.append('        return 1;')
+        body.append('    }')
+        body.append('')
+        body.append('    std::ofstream fileStream;')
+        body.append('    if (argc == 3) {')
+        body.append('        fileStream.open(argv[2]);')
+        body.append('        if ((fileStream.rdstate() & fileStream.failbit) != 0) {')
+        body.append('            std::cerr << "Can\'t write " << argv[2] << std::endl;')
+        body.append('            return 1;')
+        body.append('        }')
+        body.append('        outputStream = &fileStream;')
+        body.append('    }')
+        body.append('    g_ApiDumpDetailed = (captureHeader.flags & API_DUMP_CAPTURE_DETAILED) != 0;')
+        body.append('    StreamControl::writeAddress = (captureHeader.flags & API_DUMP_CAPTURE_ADDRESSES) != 0;')
+        body.append('    StreamControl::originalAddress = capturedAddress;')
+        body.append('')
+        body.append('    std::vector<uint64_t> data;')
+        body.append('    ApiDumpRecordHeader header;')
+        body.append('    uint64_t records = 0;')
+        body.append('    while (fread(&header, sizeof(header), 1, capture) == 1) {')
+        body.append('        data.resize(header.size / sizeof(uint64_t) + 1);')
+        body.append('        if (header.size != 0 && fread(&data[0], header.size, 1, capture) != 1) {')
+        body.append('            std::cerr << "Capture ends partway through record " << records << std::endl;')
+        body.append('            break;')
+        body.append('        }')
+        body.append('        ApiDumpRecordReader r(&data[0], header.size);')
+        body.append('        currentRecord = &r;')
+        body.append('        if (!print_record(r, header))')
+        body.append('            std::cerr << "Skipping record " << records << ", which can\'t be read as call " << header.call << std::endl;')
+        body.append('        currentRecord = NULL;')
+        body.append('        records++;')
+        body.append('    }')
+        body.append('    fclose(capture);')
+        body.append('    return 0;')
+        body.append('}')
+        return "\n".join(body)
+
+    def generate_body(self):
+        body = [self._generate_call_ids(),
+                self._generate_struct_capture(False)]
+        for proto in self._printed_protos():
+            decl = proto.c_func(prefix="vk", attr="VKAPI")
+            funcs = [self._generate_dump_func(proto), self._generate_print_func(proto)]
+            if wsi_name(decl):
+                funcs.insert(0, wsi_ifdef(decl))
+                funcs.append(wsi_endif(decl))
+            body.append("\n\n".join(funcs))
+        body.append(self._generate_main())
+        return "\n\n".join(body)
+
 def main():
 
     wsi = {
@@ -1335,7 +2086,9 @@ def main():
     subcommands = {
             "layer-funcs" : LayerFuncsSubcommand,
             "generic" : GenericLayerSubcommand,
+            "timing" : TimingLayerSubcommand,
             "api_dump" : ApiDumpSubcommand,
+            "api_dump_print" : ApiDumpPrintSubcommand,
     }
 
     if len(sys.argv) < 4 or sys.argv[1] not in wsi or sys.argv[2] not in subcommands or not os.path.exists(sys.argv[3]):
@@ -1632,7 +1632,7 @@ class StructWrapperGen:
     def _generateSafeStructSourceHeader(self):
         header = []
         header.append("//#includes, #defines, globals and such...\n")
-        header.append('#include "vk_safe_struct.h"\n#include <string.h>\n\n')
+        header.append('#include "vk_safe_struct.h"\n#include "vk_layer_scratch.h"\n#include <string.h>\n\n')
         return "".join(header)
 
     def _generateSafeStructSource(self):
@@ -1658,7 +1658,7 @@ class StructWrapperGen:
                                     '        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:\n'
                                     '        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:\n'
                                     '        if (descriptorCount && pInStruct->pImageInfo) {\n'
-                                    '            pImageInfo = new VkDescriptorImageInfo[descriptorCount];\n'
+                                    '            pImageInfo = layer_scratch_new_array<VkDescriptorImageInfo>(descriptorCount);\n'
                                     '            for (uint32_t i=0; i<descriptorCount; ++i) {\n'
                                     '                pImageInfo[i] = pInStruct->pImageInfo[i];\n'
                                     '            }\n'
@@ -1669,7 +1669,7 @@ class StructWrapperGen:
                                     '        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:\n'
                                     '        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:\n'
                                     '        if (descriptorCount && pInStruct->pBufferInfo) {\n'
-                                    '            pBufferInfo = new VkDescriptorBufferInfo[descriptorCount];\n'
+                                    '            pBufferInfo = layer_scratch_new_array<VkDescriptorBufferInfo>(descriptorCount);\n'
                                     '            for (uint32_t i=0; i<descriptorCount; ++i) {\n'
                                     '                pBufferInfo[i] = pInStruct->pBufferInfo[i];\n'
                                     '            }\n'
@@ -1678,7 +1678,7 @@ class StructWrapperGen:
                                     '        case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:\n'
                                     '        case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:\n'
                                     '        if (descriptorCount && pInStruct->pTexelBufferView) {\n'
-                                    '            pTexelBufferView = new VkBufferView[descriptorCount];\n'
+                                    '            pTexelBufferView = layer_scratch_new_array<VkBufferView>(descriptorCount);\n'
                                     '            for (uint32_t i=0; i<descriptorCount; ++i) {\n'
                                     '                pTexelBufferView[i] = pInStruct->pTexelBufferView[i];\n'
                                     '            }\n'
@@ -1705,18 +1705,18 @@ class StructWrapperGen:
                         if 'pNext' != m_name and 'void' not in m_type:
                             if not self.struct_dict[s][m]['array']:
                                 construct_txt += '    if (pInStruct->%s) {\n' % (m_name)
-                                construct_txt += '        %s = new %s(*pInStruct->%s);\n' % (m_name, m_type, m_name)
+                                construct_txt += '        %s = layer_scratch_new<%s>(*pInStruct->%s);\n' % (m_name, m_type, m_name)
                                 construct_txt += '    }\n'
                                 destruct_txt += '    if (%s)\n' % (m_name)
-                                destruct_txt += '        delete %s;\n' % (m_name)
+                                destruct_txt += '        layer_scratch_delete(%s);\n' % (m_name)
                             else: # new array and then init each element
                                 construct_txt += '    if (pInStruct->%s) {\n' % (m_name)
-                                construct_txt += '        %s = new %s[pInStruct->%s];\n' % (m_name, m_type, self.struct_dict[s][m]['array_size'])
+                                construct_txt += '        %s = layer_scratch_new_array<%s>(pInStruct->%s);\n' % (m_name, m_type, self.struct_dict[s][m]['array_size'])
                                 #construct_txt += '        std::copy (pInStruct->%s, pInStruct->%s+pInStruct->%s, %s);\n' % (m_name, m_name, self.struct_dict[s][m]['array_size'], m_name)
                                 construct_txt += '        memcpy ((void *)%s, (void *)pInStruct->%s, sizeof(%s)*pInStruct->%s);\n' % (m_name, m_name, m_type, self.struct_dict[s][m]['array_size'])
                                 construct_txt += '    }\n'
                                 destruct_txt += '    if (%s)\n' % (m_name)
-                                destruct_txt += '        delete[] %s;\n' % (m_name)
+                                destruct_txt += '        layer_scratch_delete_array(%s);\n' % (m_name)
                 elif self.struct_dict[s][m]['array']:
                     if not self.struct_dict[s][m]['dyn_array']:
                         # Handle static array case
@@ -1732,9 +1732,9 @@ class StructWrapperGen:
                         if is_type(self.struct_dict[s][m]['type'], 'struct') and self._hasSafeStruct(self.struct_dict[s][m]['type']):
                             array_element = '%s(&pInStruct->%s[i])' % (self._getSafeStructName(self.struct_dict[s][m]['type']), m_name)
                         construct_txt += '    if (%s && pInStruct->%s) {\n' % (self.struct_dict[s][m]['array_size'], m_name)
-                        construct_txt += '        %s = new %s[%s];\n' % (m_name, m_type, self.struct_dict[s][m]['array_size'])
+                        construct_txt += '        %s = layer_scratch_new_array<%s>(%s);\n' % (m_name, m_type, self.struct_dict[s][m]['array_size'])
                         destruct_txt += '    if (%s)\n' % (m_name)
-                        destruct_txt += '        delete[] %s;\n' % (m_name)
+                        destruct_txt += '        layer_scratch_delete_array(%s);\n' % (m_name)
                         construct_txt += '        for (uint32_t i=0; i<%s; ++i) {\n' % (self.struct_dict[s][m]['array_size'])
                         if 'safe_' in m_type:
                             construct_txt += '            %s[i].initialize(&pInStruct->%s[i]);\n' % (m_name, m_name)
@@ -1744,11 +1744,11 @@ class StructWrapperGen:
                         construct_txt += '    }\n'
                 elif self.struct_dict[s][m]['ptr']:
                     construct_txt += '    if (pInStruct->%s)\n' % (m_name)
-                    construct_txt += '        %s = new %s(pInStruct->%s);\n' % (m_name, m_type, m_name)
+                    construct_txt += '        %s = layer_scratch_new<%s>(pInStruct->%s);\n' % (m_name, m_type, m_name)
                     construct_txt += '    else\n'
                     construct_txt += '        %s = NULL;\n' % (m_name)
                     destruct_txt += '    if (%s)\n' % (m_name)
-                    destruct_txt += '        delete %s;\n' % (m_name)
+                    destruct_txt += '        layer_scratch_delete(%s);\n' % (m_name)
                 elif 'safe_' in m_type: # inline struct, need to pass in reference for constructor
                     init_list += '\n\t%s(&pInStruct->%s),' % (m_name, m_name)
                     init_func_txt += '        %s.initialize(&pInStruct->%s);\n' % (m_name, m_name)
@@ -1766,7 +1766,7 @@ class StructWrapperGen:
             # Create slight variation of init and construct txt for copy constructor that takes a src object reference vs. struct ptr
             copy_construct_init = init_func_txt.replace('pInStruct->', 'src.')
             copy_construct_txt = construct_txt.replace(' (pInStruct->', ' (src.') # Exclude 'if' blocks from next line
-            copy_construct_txt = copy_construct_txt.replace('(pInStruct->', '(*src.') # Pass object to copy constructors
+            copy_construct_txt = re.sub(r'layer_scratch_new<(\w+)>\(pInStruct->', r'layer_scratch_new<\1>(*src.', copy_construct_txt) # Pass object to copy constructors
             copy_construct_txt = copy_construct_txt.replace('pInStruct->', 'src.') # Modify remaining struct refs for src object
             ss_src.append("\n%s::%s(const %s& src)\n{\n%s%s}" % (ss_name, ss_name, ss_name, copy_construct_init, copy_construct_txt)) # Copy constructor
             ss_src.append("\n%s::~%s()\n{\n%s}" % (ss_name, ss_name, destruct_txt))
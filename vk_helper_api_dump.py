@@ -1324,12 +1324,17 @@ class StructWrapperGen:
         header.append('namespace StreamControl\n')
         header.append('{\n')
         header.append('bool writeAddress = true;\n')
+        header.append('// Set when printing a binary capture, to show the addresses it was taken with\n')
+        header.append('uint64_t (*originalAddress)(uint64_t address) = NULL;\n')
         header.append('template <typename T>\n')
         header.append('std::ostream& operator<< (std::ostream &out, T const* pointer)\n')
         header.append('{\n')
         header.append('    if(writeAddress)\n')
         header.append('    {\n')
-        header.append('        out.operator<<(pointer);\n')
+        header.append('        if(originalAddress)\n')
+        header.append('            out.operator<<((const void*)(uintptr_t)originalAddress(reinterpret_cast<uint64_t>(pointer)));\n')
+        header.append('        else\n')
+        header.append('            out.operator<<(pointer);\n')
         header.append('    }\n')
         header.append('    else\n')
         header.append('    {\n')
@@ -1339,6 +1344,8 @@ class StructWrapperGen:
         header.append('}\n')
         header.append('template <typename HandleType> uint64_t HandleCast(HandleType * handle)\n')
         header.append('{\n')
+        header.append('    if(originalAddress)\n')
+        header.append('        return originalAddress(reinterpret_cast<uint64_t>(handle));\n')
         header.append('    return reinterpret_cast<uint64_t>(handle);\n')
         header.append('}\n')
         header.append('uint64_t HandleCast(uint64_t handle)\n')